@@ -76,10 +76,10 @@ public:
       srsran_assert(idx < ptr->capacity(), "Iterator out-of-bounds (%zd >= %zd)", idx, ptr->capacity());
       return &ptr->get_obj_(idx);
     }
-    const obj_t* operator*() const
+    const obj_t& operator*() const
     {
       srsran_assert(idx < ptr->capacity(), "Iterator out-of-bounds (%zd >= %zd)", idx, ptr->capacity());
-      return &ptr->get_obj_(idx);
+      return ptr->get_obj_(idx);
     }
     const obj_t* operator->() const
     {
@@ -113,7 +113,7 @@ public:
       return *this;
     }
 
-    const obj_t* operator*() const { return &ptr->buffer[idx].get(); }
+    const obj_t& operator*() const { return ptr->buffer[idx].get(); }
     const obj_t* operator->() const { return &ptr->buffer[idx].get(); }
 
     bool operator==(const const_iterator& other) const { return ptr == other.ptr and idx == other.idx; }
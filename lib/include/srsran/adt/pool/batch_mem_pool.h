@@ -26,6 +26,7 @@
 #include "pool_utils.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/support/srsran_assert.h"
+#include <array>
 #include <memory>
 #include <mutex>
 
@@ -97,8 +98,11 @@ private:
 /**
  * Thread-safe object pool specialized in allocating batches of objects in a preemptive way in a background thread
  * to minimize latency.
- * Note: The dispatched allocation jobs may outlive the pool. To handle this, the pool state is passed to jobs via a
- *       shared ptr.
+ * Each thread keeps a small local cache of nodes per pool, which it accesses without locks. When the local cache
+ * gets depleted, it is refilled with a batch of nodes from the central pool. When it grows above its capacity, half
+ * of its nodes are returned to the central pool. The central pool mutex is, thus, only taken once per batch.
+ * Note: The dispatched allocation jobs and the thread local caches may outlive the pool. To handle this, the pool
+ *       state is passed to them via a shared ptr.
  */
 class background_mem_pool
 {
@@ -107,11 +111,17 @@ public:
 
   explicit background_mem_pool(size_t nodes_per_batch_, size_t node_size_, size_t thres_, int initial_size = -1) :
     batch_threshold(thres_),
+    local_batch_size(std::max(thres_ / 2, (size_t)1)),
+    local_capacity(std::max(thres_, (size_t)2)),
     state(std::make_shared<detached_pool_state>(this)),
     grow_pool(nodes_per_batch_, node_size_, detail::max_alignment, initial_size)
   {
     srsran_assert(batch_threshold > 1, "Invalid arguments for background memory pool");
   }
+  background_mem_pool(const background_mem_pool&) = delete;
+  background_mem_pool(background_mem_pool&&)      = delete;
+  background_mem_pool& operator=(const background_mem_pool&) = delete;
+  background_mem_pool& operator=(background_mem_pool&&) = delete;
   ~background_mem_pool()
   {
     std::lock_guard<std::mutex> lock(state->mutex);
@@ -126,10 +136,21 @@ public:
                   "Mismatch of allocated node size=%zd and object size=%zd",
                   sz,
                   grow_pool.get_node_max_size());
+    local_cache_t* local = get_local_cache();
+    if (local != nullptr and not local->nodes.empty()) {
+      return local->nodes.pop();
+    }
+
     std::lock_guard<std::mutex> lock(state->mutex);
     void*                       node = grow_pool.allocate_node();
+    if (local != nullptr) {
+      // refill the local cache for the next allocations, without growing the pool
+      while (local->nodes.size() < local_batch_size and grow_pool.cache_size() > 0) {
+        local->nodes.push(grow_pool.allocate_node());
+      }
+    }
 
-    if (grow_pool.size() < batch_threshold) {
+    if (grow_pool.cache_size() < batch_threshold) {
       allocate_batch_in_background_nolock();
     }
     return node;
@@ -137,8 +158,21 @@ public:
 
   void deallocate_node(void* p)
   {
-    std::lock_guard<std::mutex> lock(state->mutex);
-    grow_pool.deallocate_node(p);
+    local_cache_t* local = get_local_cache();
+    if (local == nullptr) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      grow_pool.deallocate_node(p);
+      return;
+    }
+
+    local->nodes.push(p);
+    if (local->nodes.size() > local_capacity) {
+      // if local cache reached max capacity, send half of the nodes back to the central pool
+      std::lock_guard<std::mutex> lock(state->mutex);
+      while (local->nodes.size() > local_capacity / 2) {
+        grow_pool.deallocate_node(local->nodes.pop());
+      }
+    }
   }
 
   void allocate_batch()
@@ -148,6 +182,8 @@ public:
   }
 
   size_t get_node_max_size() const { return grow_pool.get_node_max_size(); }
+
+  /// Number of nodes in the central pool. Nodes held in thread local caches are not included.
   size_t cache_size() const
   {
     std::lock_guard<std::mutex> lock(state->mutex);
@@ -183,6 +219,82 @@ private:
     bool                 dispatched = false;
     explicit detached_pool_state(background_mem_pool* pool_) : pool(pool_) {}
   };
+
+  /// Nodes of one pool cached by a thread
+  struct local_cache_t {
+    std::shared_ptr<detached_pool_state> state;
+    free_memblock_list                   nodes;
+
+    /// Returns the cached nodes to the pool, if it still exists, and detaches from it
+    void release()
+    {
+      if (state != nullptr) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->pool != nullptr) {
+          while (not nodes.empty()) {
+            state->pool->grow_pool.deallocate_node(nodes.pop());
+          }
+        }
+      }
+      // Nodes of destroyed pools point to freed memory and must not be traversed
+      nodes.clear();
+      state.reset();
+    }
+  };
+
+  /// Thread local caches of the pools accessed by a thread. They are given back to their pools on thread exit
+  struct local_cache_list {
+    const static size_t                  max_pools = 8;
+    std::array<local_cache_t, max_pools> caches;
+
+    ~local_cache_list()
+    {
+      thread_exiting() = true;
+      for (local_cache_t& c : caches) {
+        c.release();
+      }
+    }
+  };
+
+  /// Set once the thread local caches have been destroyed. Pools destroyed afterwards (e.g. static pools, whose
+  /// dtors run after the ones of the main thread's thread_local objects) fall back to the central pool
+  static bool& thread_exiting()
+  {
+    thread_local bool exiting = false;
+    return exiting;
+  }
+
+  /// Finds or creates the local cache of this pool for the calling thread. Returns nullptr if no slot is available.
+  local_cache_t* get_local_cache()
+  {
+    if (thread_exiting()) {
+      return nullptr;
+    }
+    thread_local local_cache_list list;
+    for (local_cache_t& c : list.caches) {
+      if (c.state == state) {
+        return &c;
+      }
+    }
+    // First access to this pool by this thread. Take an unused slot or one of a destroyed pool
+    for (local_cache_t& c : list.caches) {
+      if (c.state == nullptr or is_detached(*c.state)) {
+        c.release();
+        c.state = state;
+        return &c;
+      }
+    }
+    return nullptr;
+  }
+
+  static bool is_detached(detached_pool_state& s)
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.pool == nullptr;
+  }
+
+  const size_t                         local_batch_size;
+  const size_t                         local_capacity;
   std::shared_ptr<detached_pool_state> state;
 
   growing_batch_mem_pool grow_pool;
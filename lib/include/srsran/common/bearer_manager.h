@@ -24,11 +24,15 @@
 
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/common/common.h"
+#include "srsran/common/common_nr.h"
 #include "srsran/common/rwlock_guard.h"
 #include "srsran/srslog/srslog.h"
-#include <map>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <stdint.h>
-#include <unordered_map>
+#include <vector>
 
 namespace srsran {
 
@@ -50,6 +54,12 @@ public:
   };
   static const radio_bearer_t invalid_rb;
 
+  /// EPS bearer IDs and LCIDs are both looked up in flat tables. The size covers the LCIDs of both RATs and the EPS
+  /// bearer IDs, including the ones derived from NR LCIDs
+  static const uint32_t max_nof_bearers = srsran::MAX_NR_NOF_BEARERS;
+
+  ue_bearer_manager_impl() { reset(); }
+
   /// Registers EPS bearer with PDCP RAT type and LCID
   bool add_eps_bearer(uint8_t eps_bearer_id, srsran::srsran_rat_t rat, uint32_t lcid);
 
@@ -58,19 +68,45 @@ public:
 
   void reset();
 
-  bool has_active_radio_bearer(uint32_t eps_bearer_id);
+  // The lookups only do atomic loads, so they can run in parallel with one thread modifying the bearers
+  bool has_active_radio_bearer(uint32_t eps_bearer_id) const { return get_radio_bearer(eps_bearer_id).is_valid(); }
 
-  radio_bearer_t get_radio_bearer(uint32_t eps_bearer_id) const;
+  radio_bearer_t get_radio_bearer(uint32_t eps_bearer_id) const
+  {
+    return eps_bearer_id < max_nof_bearers ? unpack(bearers[eps_bearer_id].load(std::memory_order_acquire))
+                                           : invalid_rb;
+  }
 
-  radio_bearer_t get_eps_bearer_id_for_lcid(uint32_t lcid) const;
+  radio_bearer_t get_eps_bearer_id_for_lcid(uint32_t lcid) const
+  {
+    if (lcid >= max_nof_bearers) {
+      return invalid_rb;
+    }
+    uint8_t eps_bearer_id = lcid_to_eps_bearer_id[lcid].load(std::memory_order_acquire);
+    return unpack(bearers[eps_bearer_id].load(std::memory_order_acquire));
+  }
 
   bool set_five_qi(uint32_t eps_bearer_id, uint16_t five_qi);
 
 private:
-  using eps_rb_map_t = std::map<uint32_t, radio_bearer_t>;
+  /// LCIDs without EPS bearer point to this entry of "bearers", which always holds invalid_rb
+  static const uint8_t no_eps_bearer = max_nof_bearers;
+
+  /// A bearer is packed in a single word, so that readers never see a partially written bearer
+  static uint64_t pack(const radio_bearer_t& rb)
+  {
+    return (uint64_t)rb.rat | (uint64_t)rb.lcid << 8U | (uint64_t)rb.eps_bearer_id << 16U | (uint64_t)rb.five_qi << 32U;
+  }
+  static radio_bearer_t unpack(uint64_t word)
+  {
+    return radio_bearer_t{(srsran::srsran_rat_t)(word & 0xffU),
+                          (uint32_t)(word >> 8U) & 0xffU,
+                          (uint32_t)(word >> 16U) & 0xffU,
+                          (uint32_t)(word >> 32U)};
+  }
 
-  eps_rb_map_t                 bearers;
-  std::map<uint32_t, uint32_t> lcid_to_eps_bearer_id;
+  std::array<std::atomic<uint64_t>, max_nof_bearers + 1> bearers;
+  std::array<std::atomic<uint8_t>, max_nof_bearers>      lcid_to_eps_bearer_id;
 };
 
 } // namespace detail
@@ -151,21 +187,41 @@ public:
   using radio_bearer_t = srsran::detail::ue_bearer_manager_impl::radio_bearer_t;
 
   enb_bearer_manager();
+  enb_bearer_manager(const enb_bearer_manager&) = delete;
+  enb_bearer_manager& operator=(const enb_bearer_manager&) = delete;
   ~enb_bearer_manager();
 
   /// Multi-user interface (see comments above)
   void           add_eps_bearer(uint16_t rnti, uint8_t eps_bearer_id, srsran::srsran_rat_t rat, uint32_t lcid);
   void           remove_eps_bearer(uint16_t rnti, uint8_t eps_bearer_id);
   void           rem_user(uint16_t rnti);
-  bool           has_active_radio_bearer(uint16_t rnti, uint32_t eps_bearer_id);
-  radio_bearer_t get_radio_bearer(uint16_t rnti, uint32_t eps_bearer_id);
+  bool           has_active_radio_bearer(uint16_t rnti, uint32_t eps_bearer_id) const;
+  radio_bearer_t get_radio_bearer(uint16_t rnti, uint32_t eps_bearer_id) const;
   radio_bearer_t get_lcid_bearer(uint16_t rnti, uint32_t lcid) const;
   bool           set_five_qi(uint16_t rnti, uint32_t eps_bearer_id, uint16_t five_qi);
 
 private:
+  using ue_bearers_t = srsran::detail::ue_bearer_manager_impl;
+
+  /// Bearer table of a user. Tables are recycled by rem_user() but only freed with the manager, so that a racing lookup
+  /// never reads freed memory. The generation is incremented whenever the table is released, which lets a lookup
+  /// detect that the table was handed to another user while it was reading it
+  struct user_bearers_t {
+    std::atomic<uint32_t> generation{0};
+    ue_bearers_t          bearers;
+  };
+
+  /// Runs the given lookup on the bearer table of a user. Returns invalid_rb if the user does not exist or if its table
+  /// was released during the lookup
+  template <typename Lookup>
+  radio_bearer_t find_bearer(uint16_t rnti, const Lookup& lookup) const;
+
+  std::mutex            mutex; ///< Serializes the RRC-side modifications. The lookups do not take it
   srslog::basic_logger& logger;
 
-  std::unordered_map<uint16_t, srsran::detail::ue_bearer_manager_impl> users_map;
+  std::unique_ptr<std::atomic<user_bearers_t*>[]> rnti_to_user; ///< Bearer table of every RNTI value, or nullptr
+  std::vector<std::unique_ptr<user_bearers_t>>    users;
+  std::vector<user_bearers_t*>                    free_users;
 };
 
 } // namespace srsenb
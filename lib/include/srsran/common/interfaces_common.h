@@ -62,6 +62,7 @@ struct rf_args_t {
   std::string device_args;
   std::string time_adv_nsamples;
   std::string continuous_tx;
+  std::string resampler; // Resampler used when the sampling rate is fixed: auto, fft or polyphase
 
   std::array<rf_args_band_t, SRSRAN_MAX_CARRIERS> ch_rx_bands;
   std::array<rf_args_band_t, SRSRAN_MAX_CARRIERS> ch_tx_bands;
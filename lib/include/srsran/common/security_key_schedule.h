@@ -0,0 +1,83 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SECURITY_KEY_SCHEDULE_H
+#define SRSRAN_SECURITY_KEY_SCHEDULE_H
+
+#include "srsran/common/security.h"
+#include "srsran/common/ssl.h"
+
+namespace srsran {
+
+/**
+ * Caches the per-key state of the 128-EIA/128-EEA algorithms of one security context, so that it is derived once
+ * per key instead of once per message. The state is rebuilt whenever the key or the algorithm passed in changes.
+ *
+ * Only the AES based algorithms have per-key state that does not depend on COUNT, BEARER and DIRECTION: the AES-128
+ * key schedule and, for 128-EIA2, the CMAC subkeys K1/K2. SNOW 3G and ZUC load the key together with the IV, so
+ * EIA1/EEA1 and EIA3/EEA3 are forwarded to the regular implementation.
+ */
+class security_key_schedule
+{
+public:
+  security_key_schedule() = default;
+  // The AES context points into itself and must not be copied
+  security_key_schedule(const security_key_schedule&) = delete;
+  security_key_schedule& operator=(const security_key_schedule&) = delete;
+
+  /// Computes the 4 byte MAC of msg. EIA0 leaves mac untouched.
+  uint8_t integrity_generate(INTEGRITY_ALGORITHM_ID_ENUM algo,
+                             const uint8_t*              key,
+                             uint32_t                    count,
+                             uint32_t                    bearer,
+                             uint8_t                     direction,
+                             uint8_t*                    msg,
+                             uint32_t                    msg_len,
+                             uint8_t*                    mac);
+
+  /// Ciphers or deciphers msg_len bytes of msg into msg_out, which may be equal to msg. EEA0 leaves msg_out untouched.
+  uint8_t cipher(CIPHERING_ALGORITHM_ID_ENUM algo,
+                 const uint8_t*              key,
+                 uint32_t                    count,
+                 uint8_t                     bearer,
+                 uint8_t                     direction,
+                 uint8_t*                    msg,
+                 uint32_t                    msg_len,
+                 uint8_t*                    msg_out);
+
+private:
+  struct aes_key_t {
+    bool        valid   = false;
+    uint8_t     key[16] = {};
+    aes_context ctx     = {};
+    uint8_t     k1[16]  = {};
+    uint8_t     k2[16]  = {};
+  };
+
+  static void set_aes_key(aes_key_t& aes_key, const uint8_t* key, bool cmac_subkeys);
+
+  aes_key_t int_key;
+  aes_key_t enc_key;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_SECURITY_KEY_SCHEDULE_H
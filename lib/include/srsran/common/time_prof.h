@@ -23,8 +23,11 @@
 #define SRSRAN_TIME_PROF_H
 
 #include "srsran/srslog/srslog.h"
+#include <array>
+#include <atomic>
 #include <chrono>
-#include <mutex>
+#include <string>
+#include <vector>
 
 #ifdef ENABLE_TIMEPROF
 #define TPROF_ENABLE_DEFAULT true
@@ -87,11 +90,116 @@ public:
   std::chrono::nanoseconds stop() { return std::chrono::nanoseconds{0}; }
 };
 
-template <typename Prof, bool Enabled = TPROF_ENABLE_DEFAULT>
-struct mutexed_tprof {
+/// Cycle counter for the histogram profiler. It reads the TSC on x86 and the steady clock elsewhere, ticks are
+/// converted to time only when reporting.
+struct tprof_clock {
+  static uint64_t now();
+
+  /// Duration of a tick, calibrated against the steady clock since the process started
+  static double ns_per_tick();
+};
+
+/// Latency histogram with logarithmic buckets. Every power of two is split in 2^sub_bits linear buckets, so the
+/// relative error is bounded by 2^-sub_bits regardless of the magnitude. Each histogram has a single writer, the
+/// counters are atomic only so they can be read concurrently when reporting.
+class tprof_histogram
+{
+public:
+  static constexpr uint32_t sub_bits    = 3;
+  static constexpr uint32_t nof_sub     = 1U << sub_bits;
+  static constexpr uint32_t nof_buckets = (64 - sub_bits + 1) * nof_sub;
+
+  static uint32_t bucket_idx(uint64_t ticks)
+  {
+    if (ticks < nof_sub) {
+      return static_cast<uint32_t>(ticks);
+    }
+    uint32_t shift = 63 - __builtin_clzll(ticks) - sub_bits;
+    return (shift + 1) * nof_sub + static_cast<uint32_t>((ticks >> shift) & (nof_sub - 1));
+  }
+
+  /// Smallest number of ticks that falls in the given bucket
+  static uint64_t bucket_lower(uint32_t idx)
+  {
+    if (idx < nof_sub) {
+      return idx;
+    }
+    uint32_t shift = idx / nof_sub - 1;
+    return static_cast<uint64_t>(nof_sub + idx % nof_sub) << shift;
+  }
+
+  /// Number of ticks covered by the given bucket
+  static uint64_t bucket_width(uint32_t idx) { return (idx < nof_sub) ? 1 : 1ULL << (idx / nof_sub - 1); }
+
+  /// Records a sample, only the owner thread shall call it
+  void add(uint64_t ticks)
+  {
+    increment(buckets[bucket_idx(ticks)], 1);
+    increment(count, 1);
+    increment(sum, ticks);
+    if (ticks > max.load(std::memory_order_relaxed)) {
+      max.store(ticks, std::memory_order_relaxed);
+    }
+  }
+
+  /// Records a sample from any thread
+  void add_shared(uint64_t ticks)
+  {
+    buckets[bucket_idx(ticks)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(ticks, std::memory_order_relaxed);
+    uint64_t prev = max.load(std::memory_order_relaxed);
+    while (ticks > prev and not max.compare_exchange_weak(prev, ticks, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// Accumulates a snapshot of this histogram into a plain one
+  void merge_into(std::array<uint64_t, nof_buckets>& dst, uint64_t& dst_count, uint64_t& dst_sum, uint64_t& dst_max)
+      const
+  {
+    for (uint32_t i = 0; i < nof_buckets; i++) {
+      dst[i] += buckets[i].load(std::memory_order_relaxed);
+    }
+    dst_count += count.load(std::memory_order_relaxed);
+    dst_sum += sum.load(std::memory_order_relaxed);
+    dst_max = std::max(dst_max, max.load(std::memory_order_relaxed));
+  }
+
+private:
+  static void increment(std::atomic<uint64_t>& v, uint64_t n)
+  {
+    v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<uint64_t>, nof_buckets> buckets = {};
+  std::atomic<uint64_t>                          count   = {0};
+  std::atomic<uint64_t>                          sum     = {0};
+  std::atomic<uint64_t>                          max     = {0};
+};
+
+/// Summary of a histogram profiler, durations in microseconds.
+struct tprof_metrics_t {
+  std::string name;
+  uint64_t    count   = 0;
+  double      mean_us = 0.0;
+  double      p50_us  = 0.0;
+  double      p90_us  = 0.0;
+  double      p99_us  = 0.0;
+  double      max_us  = 0.0;
+};
+
+/**
+ * Lock-free latency profiler. Every thread that stops a measurement records it in its own histogram, the histograms
+ * are only merged when reporting. A measure can be started and stopped in different threads.
+ */
+template <bool Enabled = TPROF_ENABLE_DEFAULT>
+class hist_tprof
+{
+public:
   struct measure {
   public:
-    explicit measure(mutexed_tprof<Prof>* h_) : h(h_) { meas.start(); }
+    measure() = default;
+    explicit measure(hist_tprof<Enabled>* h_) : h(h_), t1(tprof_clock::now()) {}
     ~measure()
     {
       if (deferred) {
@@ -100,43 +208,66 @@ struct mutexed_tprof {
     }
     std::chrono::nanoseconds stop()
     {
-      auto                        d = meas.stop();
-      std::lock_guard<std::mutex> lock(h->mutex);
-      h->prof(d);
-      return d;
+      uint64_t ticks = tprof_clock::now() - t1;
+      if (h != nullptr) {
+        h->add(ticks);
+      }
+      deferred = false;
+      return std::chrono::nanoseconds{static_cast<int64_t>(ticks * tprof_clock::ns_per_tick())};
     }
     void defer_stop() { deferred = true; }
 
-    tprof_measure        meas;
-    mutexed_tprof<Prof>* h;
+    hist_tprof<Enabled>* h        = nullptr;
+    uint64_t             t1       = 0;
     bool                 deferred = false;
   };
 
-  template <typename... Args>
-  explicit mutexed_tprof(Args&&... args) : prof(std::forward<Args>(args)...)
-  {}
+  explicit hist_tprof(const char* name_);
+  ~hist_tprof();
+  hist_tprof(const hist_tprof&) = delete;
+  hist_tprof& operator=(const hist_tprof&) = delete;
+
   measure start() { return measure{this}; }
 
-  Prof prof;
+  /// Records a duration in ticks in the calling thread histogram
+  void add(uint64_t ticks);
+
+  tprof_metrics_t get_metrics() const;
 
 private:
-  std::mutex mutex;
+  struct node_t {
+    tprof_histogram hist;
+    node_t*         next = nullptr;
+  };
+
+  node_t* register_thread();
+
+  std::string          name;
+  uint32_t             slot       = 0; ///< Index of the per-thread histogram pointers, recycled on destruction
+  uint64_t             generation = 0; ///< Unique among all profilers, tells apart the profilers using the same slot
+  std::atomic<node_t*> head       = {nullptr};
+  node_t               shared_node; ///< Used by every thread when all the thread slots are taken
 };
 
-template <typename Prof>
-struct mutexed_tprof<Prof, false> {
+template <>
+class hist_tprof<false>
+{
+public:
   struct measure {
   public:
     std::chrono::nanoseconds stop() { return std::chrono::nanoseconds{0}; }
     void                     defer_stop() {}
   };
 
-  template <typename... Args>
-  explicit mutexed_tprof(Args&&... args)
-  {}
-  measure start() { return measure{}; }
+  explicit hist_tprof(const char* name_) {}
+  measure         start() { return measure{}; }
+  void            add(uint64_t ticks) {}
+  tprof_metrics_t get_metrics() const { return {}; }
 };
 
+/// Collects the metrics of every histogram profiler alive
+std::vector<tprof_metrics_t> get_tprof_metrics();
+
 struct avg_time_stats {
   avg_time_stats(const char* name_, const char* logname, size_t print_period_);
   void operator()(std::chrono::nanoseconds duration);
@@ -30,6 +30,7 @@
 #include "srsenb/hdr/stack/rrc/rrc_metrics.h"
 #include "srsenb/hdr/stack/s1ap/s1ap_metrics.h"
 #include "srsran/common/metrics_hub.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/radio/radio_metrics.h"
 #include "srsran/rlc/rlc_metrics.h"
 #include "srsran/system/sys_metrics.h"
@@ -55,12 +56,13 @@ struct stack_metrics_t {
 };
 
 struct enb_metrics_t {
-  srsran::rf_metrics_t       rf;
-  std::vector<phy_metrics_t> phy;
-  stack_metrics_t            stack;
-  stack_metrics_t            nr_stack;
-  srsran::sys_metrics_t      sys;
-  bool                       running;
+  srsran::rf_metrics_t                 rf;
+  std::vector<phy_metrics_t>           phy;
+  stack_metrics_t                      stack;
+  stack_metrics_t                      nr_stack;
+  srsran::sys_metrics_t                sys;
+  std::vector<srsran::tprof_metrics_t> tprof;
+  bool                                 running;
 };
 
 // ENB interface
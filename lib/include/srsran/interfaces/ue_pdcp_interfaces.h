@@ -23,6 +23,7 @@
 #define SRSRAN_UE_PDCP_INTERFACES_H
 
 #include "pdcp_interface_types.h"
+#include "srsran/adt/bounded_vector.h"
 #include "srsran/common/byte_buffer.h"
 
 namespace srsue {
@@ -79,9 +80,19 @@ public:
 class stack_interface_gw
 {
 public:
+  static const uint32_t max_ul_sdu_burst = 32; ///< Max. number of UL SDUs handed over by the GW at once
+  using ul_sdu_burst_t                   = srsran::bounded_vector<srsran::unique_byte_buffer_t, max_ul_sdu_burst>;
+
   virtual bool is_registered()         = 0;
   virtual bool start_service_request() = 0;
   virtual void write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu) = 0;
+  ///< Burst of SDUs read by the GW for the same EPS bearer. Stacks may override it to hand the burst over at once
+  virtual void write_sdus(uint32_t eps_bearer_id, ul_sdu_burst_t sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(eps_bearer_id, std::move(sdu));
+    }
+  }
   ///< Allow GW to query if a radio bearer for a given EPS bearer ID is currently active
   virtual bool has_active_radio_bearer(uint32_t eps_bearer_id) = 0;
 };
@@ -63,7 +63,7 @@ public:
   // SDUs up to 256 B can use the short 8-bit L field
   static const int32_t MAC_SUBHEADER_LEN_THRESHOLD = 256;
 
-  mac_sch_subpdu_nr(mac_sch_pdu_nr* parent_) : parent(parent_), logger(&srslog::fetch_basic_logger("MAC-NR")){};
+  mac_sch_subpdu_nr(mac_sch_pdu_nr* parent_);
 
   nr_lcid_sch_t get_type();
   bool          is_sdu() const;
@@ -187,6 +187,9 @@ private:
       return sdu;
     }
 
+    /// Returns true if the SDU pointer points to the internal buffer.
+    bool uses_internal_storage() const { return sdu == ce_write_buffer.data(); }
+
     /// Returns the SDU pointer.
     const uint8_t* ptr() const { return sdu; }
     uint8_t*       ptr() { return sdu; }
@@ -223,11 +226,18 @@ public:
 
   uint32_t get_remaing_len();
 
+  /// Returns the position where the payload of the next SDU is written if a subheader of header_len bytes precedes it.
+  /// This allows generating the SDU in place before calling add_sdu() with the returned pointer, which then avoids
+  /// copying the payload.
+  uint8_t* get_next_sdu_ptr(uint32_t header_len) { return buffer->msg + buffer->N_bytes + header_len; }
+
   void to_string(fmt::memory_buffer& buffer);
 
   uint32_t size_header_sdu(const uint32_t lcid_, const uint32_t nbytes);
 
 private:
+  friend class mac_sch_subpdu_nr;
+
   /// Private helper that adds a subPDU to the MAC PDU
   uint32_t add_sudpdu(mac_sch_subpdu_nr& subpdu);
 
@@ -44,6 +44,9 @@
 #define SRSRAN_AGC_MIN_MEASUREMENTS (10)  /* Minimum number of measurements  */
 #define SRSRAN_AGC_MIN_GAIN_OFFSET (2.0f) /* Mimum of gain offset to set the radio gain */
 
+/* Samples measured per frame by the UE sync AGC (one 5 MHz subframe), larger frames are decimated */
+#define SRSRAN_AGC_DEFAULT_MAX_NOF_SAMPLES (7680)
+
 typedef enum SRSRAN_API { SRSRAN_AGC_MODE_ENERGY = 0, SRSRAN_AGC_MODE_PEAK_AMPLITUDE } srsran_agc_mode_t;
 
 /*
@@ -79,6 +82,7 @@ typedef struct SRSRAN_API {
   srsran_agc_mode_t  mode;
   float              target;
   uint32_t           nof_frames;
+  uint32_t           max_nof_samples;
   uint32_t           frame_cnt;
   uint32_t           hold_cnt;
   float*             y_tmp;
@@ -103,6 +107,15 @@ SRSRAN_API float srsran_agc_get_gain(srsran_agc_t* q);
 
 SRSRAN_API void srsran_agc_set_gain(srsran_agc_t* q, float init_gain_value_db);
 
+/**
+ * @brief Limits the number of samples the power estimate is computed on. Longer frames are decimated by the smallest
+ * integer factor that brings them within the limit, reducing the AGC cost in the receive path at high bandwidths.
+ *
+ * @param q AGC object
+ * @param max_nof_samples Maximum number of measured samples per frame, 0 measures every sample (default)
+ */
+SRSRAN_API void srsran_agc_set_max_nof_samples(srsran_agc_t* q, uint32_t max_nof_samples);
+
 SRSRAN_API void srsran_agc_process(srsran_agc_t* q, cf_t* signal, uint32_t len);
 
 #endif // SRSRAN_AGC_H
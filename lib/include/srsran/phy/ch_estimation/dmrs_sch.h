@@ -51,11 +51,8 @@ typedef struct {
 
   srsran_carrier_nr_t carrier;
 
-  srsran_interp_lin_t interpolator_type1; /// Type 1 DMRS: 1 pilot every 2 RE
-  srsran_interp_lin_t interpolator_type2; /// Type 2 DMRS: 2 consecutive pilots every 6 RE
-
   uint32_t max_nof_prb;
-  cf_t*    pilot_estimates; /// Pilots least squares estimates
+  cf_t*    pilot_estimates; /// Pilots least squares estimates, room for SRSRAN_DMRS_SCH_MAX_SYMBOLS symbols
   cf_t*    temp;            /// Temporal data vector of size SRSRAN_NRE * carrier.nof_prb
 
   float* filter; ///< Smoothing filter
@@ -112,6 +112,16 @@ SRSRAN_API void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* d
 
 SRSRAN_API void srsran_enb_dl_put_phich(srsran_enb_dl_t* q, srsran_phich_grant_t* grant, bool ack);
 
+/**
+ * @brief Encodes all the PHICH ACK/NACK of the subframe, each PHICH group is precoded and mapped once
+ * @param grants PHICH grant of each ACK/NACK
+ * @param acks ACK/NACK values
+ * @param nof_acks Number of ACK/NACK values
+ * @return SRSRAN_SUCCESS if the ACKs were encoded, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int
+srsran_enb_dl_put_phich_batch(srsran_enb_dl_t* q, srsran_phich_grant_t* grants, const bool* acks, uint32_t nof_acks);
+
 SRSRAN_API int srsran_enb_dl_put_pdcch_dl(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, srsran_dci_dl_t* dci_dl);
 
 SRSRAN_API int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, srsran_dci_ul_t* dci_ul);
@@ -49,6 +49,17 @@ typedef struct SRSRAN_API {
   float                 pusch_min_snr_dB; ///< Minimum measured DMRS SNR, below this threshold PUSCH is not decoded
 } srsran_gnb_ul_t;
 
+/**
+ * @brief PUCCH candidate for batched decoding
+ */
+typedef struct SRSRAN_API {
+  const srsran_pucch_nr_common_cfg_t* cfg;       ///< PUCCH common configuration
+  const srsran_pucch_nr_resource_t*   resource;  ///< PUCCH resource
+  const srsran_uci_cfg_nr_t*          uci_cfg;   ///< UCI configuration of the candidate
+  srsran_uci_value_nr_t*              uci_value; ///< Destination of the decoded UCI
+  srsran_csi_trs_measurements_t*      meas;      ///< Destination of the DMRS measurements, set to NULL if not used
+} srsran_gnb_ul_pucch_candidate_t;
+
 SRSRAN_API int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args_t* args);
 
 SRSRAN_API void srsran_gnb_ul_free(srsran_gnb_ul_t* q);
@@ -71,6 +82,24 @@ SRSRAN_API int srsran_gnb_ul_get_pucch(srsran_gnb_ul_t*                    q,
                                        srsran_uci_value_nr_t*              uci_value,
                                        srsran_csi_trs_measurements_t*      meas);
 
+/**
+ * @brief Decodes a batch of PUCCH candidates received in the same slot
+ *
+ * The DMRS based channel estimate is computed once for all the candidates that carry the same DMRS, this is, the same
+ * PUCCH resource and sequence configuration. The candidates only differ in the UCI payload hypothesis (e.g. HARQ-ACK
+ * with and without SR).
+ *
+ * @param q gNb UL object
+ * @param slot_cfg Slot configuration
+ * @param candidates PUCCH candidates, the UCI value and measurements are written in their destinations
+ * @param nof_candidates Number of candidates
+ * @return SRSRAN_SUCCESS if all candidates are decoded successfully, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_gnb_ul_get_pucch_batch(srsran_gnb_ul_t*                 q,
+                                             const srsran_slot_cfg_t*         slot_cfg,
+                                             srsran_gnb_ul_pucch_candidate_t* candidates,
+                                             uint32_t                         nof_candidates);
+
 SRSRAN_API uint32_t srsran_gnb_ul_pucch_info(srsran_gnb_ul_t*                     q,
                                              const srsran_pucch_nr_resource_t*    resource,
                                              const srsran_uci_data_nr_t*          uci_data,
@@ -52,6 +52,12 @@
 #define SRSRAN_PHICH_NORM_NSF 4
 #define SRSRAN_PHICH_EXT_NSF 2
 
+/* Maximum number of PHICH mapping units, given by Ng = 2 and m_i = 2 */
+#define SRSRAN_PHICH_MAX_NOF_UNITS (2 * ((2 * SRSRAN_MAX_PRB + 7) / 8))
+
+/* Maximum number of distinct PHICH resources in a subframe */
+#define SRSRAN_PHICH_MAX_NOF_ACKS (SRSRAN_PHICH_MAX_NOF_UNITS * SRSRAN_PHICH_NORM_NSEQUENCES)
+
 /* phich object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -77,6 +83,12 @@ typedef struct SRSRAN_API {
   srsran_modem_table_t mod;
   srsran_sequence_t    seq[SRSRAN_NOF_SF_X_FRAME];
 
+  /* batch encoder, spread sequences are combined for each mapping unit before precoding */
+  cf_t     d_unit[SRSRAN_PHICH_MAX_NOF_UNITS][SRSRAN_PHICH_MAX_NSYMB];
+  bool     unit_active[SRSRAN_PHICH_MAX_NOF_UNITS];
+  uint32_t active_units[SRSRAN_PHICH_MAX_NOF_UNITS];
+  uint32_t nof_active_units;
+
 } srsran_phich_t;
 
 typedef struct SRSRAN_API {
@@ -95,6 +107,11 @@ typedef struct SRSRAN_API {
   float distance;
 } srsran_phich_res_t;
 
+typedef struct SRSRAN_API {
+  srsran_phich_resource_t resource;
+  uint8_t                 ack;
+} srsran_phich_ack_t;
+
 SRSRAN_API int srsran_phich_init(srsran_phich_t* q, uint32_t nof_rx_antennas);
 
 SRSRAN_API void srsran_phich_free(srsran_phich_t* q);
@@ -118,6 +135,26 @@ SRSRAN_API int srsran_phich_encode(srsran_phich_t*         q,
                                    uint8_t                 ack,
                                    cf_t*                   sf_symbols[SRSRAN_MAX_PORTS]);
 
+/**
+ * @brief Encodes all the ACK/NACK of a subframe and adds them into the resource grid
+ *
+ * The orthogonal sequences sharing a PHICH group are combined before scrambling, so each group is scrambled, precoded
+ * and mapped once regardless of the number of ACKs it carries. The result is the same as calling srsran_phich_encode()
+ * for each ACK.
+ *
+ * @param q PHICH object
+ * @param sf Downlink subframe configuration
+ * @param acks ACK/NACK values and their PHICH resources
+ * @param nof_acks Number of ACK/NACK values
+ * @param sf_symbols Resource grid for each port
+ * @return SRSRAN_SUCCESS if the ACKs were encoded, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_phich_encode_batch(srsran_phich_t*           q,
+                                         srsran_dl_sf_cfg_t*       sf,
+                                         const srsran_phich_ack_t* acks,
+                                         uint32_t                  nof_acks,
+                                         cf_t*                     sf_symbols[SRSRAN_MAX_PORTS]);
+
 SRSRAN_API void srsran_phich_reset(srsran_phich_t* q, cf_t* slot_symbols[SRSRAN_MAX_PORTS]);
 
 SRSRAN_API uint32_t srsran_phich_ngroups(srsran_phich_t* q);
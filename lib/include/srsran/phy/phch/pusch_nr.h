@@ -61,6 +61,9 @@ typedef struct SRSRAN_API {
   srsran_evm_buffer_t* evm_buffer;
   bool                 meas_time_en;
   uint32_t             meas_time_us;
+  uint32_t             meas_time_eq_us;    ///< Last decode RE demapping and equalisation time
+  uint32_t             meas_time_demod_us; ///< Last decode demodulation and descrambling time
+  uint32_t             meas_time_sch_us;   ///< Last decode SCH time, includes LDPC decoding
   srsran_re_pattern_t  dmrs_re_pattern;
   uint8_t*             g_ulsch;   ///< Temporal Encoded UL-SCH data
   uint8_t*             g_ack;     ///< Temporal Encoded HARQ-ACK bits
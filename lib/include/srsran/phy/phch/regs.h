@@ -71,6 +71,12 @@ typedef struct SRSRAN_API {
   uint32_t           phich_mi;
   uint32_t           nof_regs;
   srsran_regs_reg_t* regs;
+
+  /* Flat resource element indexes in the subframe grid, computed once at initialization so the channels are mapped
+   * with a single gather/scatter instead of REG by REG */
+  uint32_t  pcfich_re_idx[REGS_PCFICH_NSYM];
+  uint32_t* phich_re_idx;    // REGS_PHICH_NSYM indexes for each PHICH mapping unit
+  uint32_t* pdcch_re_idx[3]; // Interleaved and shifted PDCCH REGs for each CFI
 } srsran_regs_t;
 
 SRSRAN_API int srsran_regs_init(srsran_regs_t* h, srsran_cell_t cell);
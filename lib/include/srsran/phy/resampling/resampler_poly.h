@@ -0,0 +1,142 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         resampler_poly.h
+ *
+ *  Description:  Rational (L/M) polyphase resampler. The prototype low-pass
+ *                filter is split in L phases of a fixed number of taps, each
+ *                output sample is the dot product of a single phase with the
+ *                most recent input samples.
+ *
+ *  Reference:    Multirate Signal Processing for Communication Systems
+ *                fredric j. harris
+ *****************************************************************************/
+
+#ifndef SRSRAN_RESAMPLER_POLY_H
+#define SRSRAN_RESAMPLER_POLY_H
+
+#include <stdint.h>
+
+#include "srsran/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of filter taps per polyphase branch when interpolating. When decimating, it is scaled by the ceiling of the
+ * decimation/interpolation ratio for keeping the same transition band at the output rate. It must be a multiple of 8
+ * for keeping every branch SIMD aligned.
+ */
+#define SRSRAN_RESAMPLER_POLY_NOF_TAPS 32
+
+/**
+ * Maximum number of polyphase branches (interpolation factor L), it limits the filter bank memory footprint
+ */
+#define SRSRAN_RESAMPLER_POLY_MAX_PHASES 1024
+
+/**
+ * @brief Polyphase resampler internal state and filter bank
+ */
+typedef struct {
+  uint32_t up;        ///< Interpolation factor (L)
+  uint32_t down;      ///< Decimation factor (M)
+  uint32_t nof_taps;  ///< Number of filter taps per polyphase branch
+  uint32_t window_sz; ///< Maximum number of input samples processed in a single filter pass
+  uint32_t phase;     ///< Polyphase branch for the next output sample
+  uint32_t offset;    ///< Input sample index of the next output sample, relative to the next input block
+  float*   filter;    ///< Filter bank, up branches of 2 x nof_taps coefficients duplicated for real and imaginary parts
+  cf_t*    buffer;    ///< Filter history followed by the current input window
+} srsran_resampler_poly_t;
+
+/**
+ * @brief Initialises a polyphase resampler with an output sampling rate of up/down times the input sampling rate.
+ * @param q Object pointer
+ * @param up Interpolation factor L
+ * @param down Decimation factor M
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t up, uint32_t down);
+
+/**
+ * @brief Initialises a polyphase resampler from the input and output sampling rates. The rates are reduced to their
+ * smallest integer ratio.
+ * @param q Object pointer
+ * @param input_srate_hz Input sampling rate in Hz, it must be an integer number of Hz
+ * @param output_srate_hz Output sampling rate in Hz, it must be an integer number of Hz
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int
+srsran_resampler_poly_init_srate(srsran_resampler_poly_t* q, double input_srate_hz, double output_srate_hz);
+
+/**
+ * @brief Resets the filter history and the phase of the resampler
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q);
+
+/**
+ * @brief Computes the minimum number of input samples that shall be provided for producing nof_output samples, given
+ * the current resampler state. The number of produced samples is exact when decimating (up <= down); otherwise,
+ * consecutive output samples can share the same newest input sample and the resampler might produce a few more.
+ * @param q Object pointer
+ * @param nof_output Number of desired output samples
+ * @return The number of input samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_get_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output);
+
+/**
+ * @brief Gets the filter group delay in number of output samples
+ * @param q Object pointer
+ * @return the delay in number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q);
+
+/**
+ * @brief Runs the polyphase resampler. The number of output samples depends on the number of input samples and the
+ * internal state; the output buffer shall be able to hold at least ceil(nsamples * up / down) samples.
+ *
+ * @note Setting the input to NULL is equivalent of feeding zeroes
+ * @note Setting the output to NULL is equivalent of dropping output samples
+ *
+ * @param q Object pointer, make sure it has been initialised
+ * @param input Points at the input complex buffer
+ * @param output Points at the output complex buffer
+ * @param nsamples Number of input samples
+ * @return The number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q,
+                                              const cf_t*              input,
+                                              cf_t*                    output,
+                                              uint32_t                 nsamples);
+
+/**
+ * @brief Frees polyphase resampler buffers
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_free(srsran_resampler_poly_t* q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_RESAMPLER_POLY_H
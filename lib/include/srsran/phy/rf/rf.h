@@ -23,6 +23,7 @@
 #define SRSRAN_RF_H
 
 #include <pthread.h>
+#include <semaphore.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -40,15 +41,15 @@ typedef struct {
   void* handler;
   void* dev;
 
-  // The following variables are for threaded RX gain control
-  bool            thread_gain_run;
-  pthread_t       thread_gain;
-  pthread_cond_t  cond;
-  pthread_mutex_t mutex;
-  double          cur_rx_gain;
-  double          new_rx_gain;
-  bool            tx_gain_same_rx;
-  float           tx_rx_gain_offset;
+  // The following variables are for threaded RX gain control. The receive path posts the latest requested gain in
+  // new_rx_gain and wakes the gain thread through gain_sem without taking any lock.
+  bool      thread_gain_run;
+  pthread_t thread_gain;
+  sem_t     gain_sem;
+  double    cur_rx_gain;
+  double    new_rx_gain;
+  bool      tx_gain_same_rx;
+  float     tx_rx_gain_offset;
 } srsran_rf_t;
 
 typedef struct {
@@ -181,6 +182,14 @@ SRSRAN_API int srsran_rf_set_rx_gain_ch(srsran_rf_t* h, uint32_t ch, double gain
 
 SRSRAN_API void srsran_rf_set_tx_rx_gain_offset(srsran_rf_t* h, double offset);
 
+/**
+ * @brief Requests a new Rx gain to the gain thread. It never blocks, so it is safe to call from the real-time receive
+ * path; a request that has not been applied yet is overwritten by the next one.
+ *
+ * @param h RF object with the gain thread started
+ * @param gain Requested Rx gain in dB, ignored if it is within 2 dB of the current gain
+ * @return SRSRAN_SUCCESS
+ */
 SRSRAN_API int srsran_rf_set_rx_gain_th(srsran_rf_t* h, double gain);
 
 SRSRAN_API double srsran_rf_get_rx_gain(srsran_rf_t* h);
@@ -34,17 +34,12 @@
 
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common.h"
-#include "srsran/phy/utils/cexptab.h"
-
-#define SRSRAN_CFO_CEXPTAB_SIZE 4096
 
 typedef struct SRSRAN_API {
-  float            last_freq;
-  float            tol;
-  int              nsamples;
-  int              max_samples;
-  srsran_cexptab_t tab;
-  cf_t*            cur_cexp;
+  float  last_freq;
+  float  tol;
+  int    nsamples;
+  double phase; ///< Oscillator phase in cycles for the continuous phase correction
 } srsran_cfo_t;
 
 SRSRAN_API int srsran_cfo_init(srsran_cfo_t* h, uint32_t nsamples);
@@ -60,6 +55,28 @@ SRSRAN_API void srsran_cfo_correct(srsran_cfo_t* h, const cf_t* input, cf_t* out
 SRSRAN_API void
 srsran_cfo_correct_offset(srsran_cfo_t* h, const cf_t* input, cf_t* output, float freq, int cexp_offset, int nsamples);
 
+/**
+ * @brief Corrects the frequency offset keeping the phase continuity with the previous call. All the channels are
+ * corrected from the same oscillator phase, which advances by the number of samples at the given frequency on every
+ * call, so the frequency can be updated on every call without phase discontinuities
+ * @param h CFO object
+ * @param input Input signal of each channel, NULL channels are skipped
+ * @param output Output signal of each channel
+ * @param nof_channels Number of channels
+ * @param freq Normalised frequency
+ */
+SRSRAN_API void srsran_cfo_correct_continuous(srsran_cfo_t* h,
+                                              cf_t* const*  input,
+                                              cf_t* const*  output,
+                                              uint32_t      nof_channels,
+                                              float         freq);
+
+/**
+ * @brief Resets the oscillator phase of the continuous phase correction
+ * @param h CFO object
+ */
+SRSRAN_API void srsran_cfo_reset_phase(srsran_cfo_t* h);
+
 SRSRAN_API float srsran_cfo_est_corr_cp(cf_t* input_buffer, uint32_t nof_prb);
 
 #endif // SRSRAN_CFO_H
@@ -48,6 +48,11 @@
  */
 #define SRSRAN_SSB_NOF_CANDIDATES 64
 
+/**
+ * @brief Maximum number of SSB center frequencies searched in a single pass by srsran_ssb_search_multi()
+ */
+#define SRSRAN_SSB_MAX_SEARCH_FREQS 128
+
 /**
  * @brief Describes SSB object initialization arguments
  */
@@ -97,6 +102,9 @@ typedef struct SRSRAN_API {
   uint32_t symbol_sz;     ///< Current SSB symbol size (for the given base-band sampling rate)
   uint32_t corr_sz;       ///< Correlation size
   uint32_t corr_window;   ///< Correlation window length
+  uint32_t corr_nb_sz;    ///< Narrowband correlation size, it covers the PSS bandwidth
+  uint32_t corr_nb_start; ///< First correlation bin of the narrowband correlation
+  int32_t  corr_f_offset; ///< SSB integer frequency offset the PSS correlation sequences are generated for
   uint32_t ssb_sz;        ///< SSB size in samples at the configured sampling rate
   int32_t  f_offset;      ///< SSB integer frequency offset (multiple of SCS) between DC and the SSB center
   uint32_t cp_sz;         ///< CP length for the given symbol size
@@ -106,18 +114,20 @@ typedef struct SRSRAN_API {
   uint32_t Lmax;                               ///< Number of SSB candidates
 
   /// Internal Objects
-  srsran_dft_plan_t ifft;      ///< IFFT object for modulating the SSB
-  srsran_dft_plan_t fft;       ///< FFT object for demodulate the SSB.
-  srsran_dft_plan_t fft_corr;  ///< FFT for correlation
-  srsran_dft_plan_t ifft_corr; ///< IFFT for correlation
-  srsran_pbch_nr_t  pbch;      ///< PBCH encoder and decoder
+  srsran_dft_plan_t ifft;         ///< IFFT object for modulating the SSB
+  srsran_dft_plan_t fft;          ///< FFT object for demodulate the SSB.
+  srsran_dft_plan_t fft_corr;     ///< FFT for correlation
+  srsran_dft_plan_t ifft_corr;    ///< IFFT for correlation
+  srsran_dft_plan_t ifft_corr_nb; ///< Decimated IFFT for the narrowband correlation
+  srsran_pbch_nr_t  pbch;         ///< PBCH encoder and decoder
 
   /// Frequency/Time domain temporal data
-  cf_t* tmp_freq;                     ///< Temporal frequency domain buffer
-  cf_t* tmp_time;                     ///< Temporal time domain buffer
-  cf_t* tmp_corr;                     ///< Temporal correlation frequency domain buffer
-  cf_t* sf_buffer;                    ///< subframe buffer
-  cf_t* pss_seq[SRSRAN_NOF_NID_2_NR]; ///< Possible frequency domain PSS for find
+  cf_t* tmp_freq;                        ///< Temporal frequency domain buffer
+  cf_t* tmp_time;                        ///< Temporal time domain buffer
+  cf_t* tmp_corr;                        ///< Temporal correlation frequency domain buffer
+  cf_t* sf_buffer;                       ///< subframe buffer
+  cf_t* pss_seq[SRSRAN_NOF_NID_2_NR];    ///< Possible frequency domain PSS for find
+  cf_t* pss_seq_nb[SRSRAN_NOF_NID_2_NR]; ///< Narrowband bins of the frequency domain PSS for search
 } srsran_ssb_t;
 
 /**
@@ -163,6 +173,31 @@ SRSRAN_API int srsran_ssb_set_cfg(srsran_ssb_t* q, const srsran_ssb_cfg_t* cfg);
  */
 SRSRAN_API int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res);
 
+/**
+ * @brief Searches for SSB transmissions in several SSB center frequencies and decodes their PBCH messages
+ *
+ * The input buffer is converted to frequency domain once per correlation window and it is correlated with the PSS
+ * sequences of every given SSB center frequency. It avoids running srsran_ssb_set_cfg() and srsran_ssb_search() for
+ * every synchronization raster point within the received bandwidth.
+ *
+ * @note The SSB object must be configured with srsran_ssb_set_cfg() first, the sampling rate, base-band center
+ * frequency, subcarrier spacing and pattern are shared by all the SSB center frequencies
+ *
+ * @param q SSB object
+ * @param in Input baseband buffer
+ * @param nof_samples Number of samples available in the buffer
+ * @param ssb_freq_hz SSB center frequencies to search, they must fit within the base-band bandwidth
+ * @param nof_freqs Number of SSB center frequencies, up to SRSRAN_SSB_MAX_SEARCH_FREQS
+ * @param res SSB Search result for each SSB center frequency
+ * @return SRSRAN_SUCCESS if the parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ssb_search_multi(srsran_ssb_t*            q,
+                                       const cf_t*              in,
+                                       uint32_t                 nof_samples,
+                                       const double*            ssb_freq_hz,
+                                       uint32_t                 nof_freqs,
+                                       srsran_ssb_search_res_t* res);
+
 /**
  * @brief Decides if the SSB object is configured and a given subframe is configured for SSB transmission
  * @param q SSB object
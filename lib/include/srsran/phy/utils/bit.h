@@ -44,6 +44,8 @@ typedef struct {
   uint16_t* interleaver;
   uint16_t* byte_idx;
   uint8_t*  bit_mask;
+  int32_t*  word_idx;   ///< Byte offset of the 32-bit word containing each input bit, used by gather based kernels
+  int32_t*  word_shift; ///< Left shift that moves each input bit to the word MSB, used by gather based kernels
   uint8_t   n_128;
 } srsran_bit_interleaver_t;
 
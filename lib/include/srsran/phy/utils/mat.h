@@ -205,6 +205,61 @@ static inline void srsran_mat_2x2_mmse_simd(simd_cf_t  y0,
 
 #endif /* SRSRAN_SIMD_CF_SIZE != 0 */
 
+/**
+ * Maximum matrix dimension supported by the batched small matrix functions
+ */
+#define SRSRAN_MAT_MAX_N 4
+
+/*
+ * Batched small matrix functions. The matrices are given in structure of arrays layout: m[i][j] points at the element
+ * in row i and column j of len consecutive matrices, so SIMD registers carry the same element of different matrices.
+ */
+
+/**
+ * @brief Computes the Cholesky decomposition A = L x L' of a batch of N x N Hermitian positive definite matrices. Only
+ * the lower triangle of A is read, the upper triangle of L is set to zero.
+ * @param a Input matrices, lower triangle
+ * @param l Output lower triangular matrices
+ * @param N Matrix dimension, up to SRSRAN_MAT_MAX_N
+ * @param len Number of matrices
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_mat_cholesky_batch(cf_t*    a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                         cf_t*    l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                         uint32_t N,
+                                         uint32_t len);
+
+/**
+ * @brief Inverts a batch of N x N Hermitian positive definite matrices through their Cholesky decomposition. Only the
+ * lower triangle of A is read, the whole inverse is written.
+ * @param a Input matrices, lower triangle
+ * @param r Output inverse matrices
+ * @param N Matrix dimension, up to SRSRAN_MAT_MAX_N
+ * @param len Number of matrices
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_mat_hermitian_inv_batch(cf_t*    a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                              cf_t*    r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                              uint32_t N,
+                                              uint32_t len);
+
+/**
+ * @brief Estimates the condition number of a batch of nof_rows x nof_cols matrices, defined as in srsran_mat_2x2_cn:
+ * the ratio in dB between the largest and the smallest eigenvalue of H x H' (or H' x H, whichever is smaller). The
+ * 2x2 case is solved in closed form, larger dimensions use power and inverse iterations.
+ * @param h Input matrices
+ * @param nof_rows Number of rows, up to SRSRAN_MAT_MAX_N
+ * @param nof_cols Number of columns, up to SRSRAN_MAT_MAX_N
+ * @param len Number of matrices
+ * @param cn Output condition numbers in dB, one per matrix
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_mat_cn_batch(cf_t*    h[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                   uint32_t nof_rows,
+                                   uint32_t nof_cols,
+                                   uint32_t len,
+                                   float*   cn);
+
 typedef struct {
   uint32_t N;
   cf_t*    row_buffer;
@@ -198,6 +198,16 @@ SRSRAN_API void srsran_vec_lut_sss(const short* x, const unsigned short* lut, sh
 SRSRAN_API void srsran_vec_lut_bbb(const int8_t* x, const unsigned short* lut, int8_t* y, const uint32_t len);
 SRSRAN_API void srsran_vec_lut_sis(const short* x, const unsigned int* lut, short* y, const uint32_t len);
 
+/**
+ * @brief Indexed complex copies, used for mapping resource elements through precomputed index tables
+ *  - gather:     y[i] = x[idx[i]]
+ *  - scatter:    y[idx[i]] = x[i]
+ *  - scatter sum: y[idx[i]] += x[i], the indexes shall not repeat
+ */
+SRSRAN_API void srsran_vec_gather_c(const cf_t* x, const uint32_t* idx, cf_t* y, const uint32_t len);
+SRSRAN_API void srsran_vec_scatter_c(const cf_t* x, const uint32_t* idx, cf_t* y, const uint32_t len);
+SRSRAN_API void srsran_vec_scatter_sum_c(const cf_t* x, const uint32_t* idx, cf_t* y, const uint32_t len);
+
 /* vector product (element-wise) */
 SRSRAN_API void srsran_vec_prod_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len);
 SRSRAN_API void srsran_vec_prod_ccc_split(const float*   x_re,
@@ -369,6 +379,27 @@ SRSRAN_API cf_t srsran_vec_gen_sine(cf_t amplitude, float freq, cf_t* z, int len
 
 SRSRAN_API void srsran_vec_apply_cfo(const cf_t* x, float cfo, cf_t* z, int len);
 
+/*!
+ * @brief Applies a frequency offset starting at a given phase. The oscillator phase is periodically recomputed from the
+ * initial phase, so the rounding error does not accumulate along long vectors
+ * @param x Input vector
+ * @param cfo Normalised frequency offset
+ * @param phase Phase of the first sample in cycles
+ * @param z Output vector
+ * @param len Number of samples
+ */
+SRSRAN_API void srsran_vec_apply_cfo_phase(const cf_t* x, float cfo, double phase, cf_t* z, int len);
+
+/*!
+ * @brief Accumulates a vector after applying a frequency offset, equivalent to srsran_vec_apply_cfo() followed by
+ * srsran_vec_acc_cc() without storing the frequency shifted vector
+ * @param x Input vector
+ * @param cfo Normalised frequency offset
+ * @param len Number of samples
+ * @return The sum of the frequency shifted samples
+ */
+SRSRAN_API cf_t srsran_vec_acc_cfo_cc(const cf_t* x, float cfo, int len);
+
 SRSRAN_API float srsran_vec_estimate_frequency(const cf_t* x, int len);
 
 /*!
@@ -120,6 +120,12 @@ SRSRAN_API void srsran_vec_lut_sss_simd(const short* x, const unsigned short* lu
 
 SRSRAN_API void srsran_vec_lut_bbb_simd(const int8_t* x, const unsigned short* lut, int8_t* y, const int len);
 
+SRSRAN_API void srsran_vec_gather_c_simd(const cf_t* x, const uint32_t* idx, cf_t* y, const int len);
+
+SRSRAN_API void srsran_vec_scatter_c_simd(const cf_t* x, const uint32_t* idx, cf_t* y, const int len);
+
+SRSRAN_API void srsran_vec_scatter_sum_c_simd(const cf_t* x, const uint32_t* idx, cf_t* y, const int len);
+
 SRSRAN_API void srsran_vec_convert_if_simd(const int16_t* x, float* z, const float scale, const int len);
 
 SRSRAN_API void srsran_vec_convert_fi_simd(const float* x, int16_t* z, const float scale, const int len);
@@ -136,6 +142,10 @@ SRSRAN_API cf_t srsran_vec_gen_sine_simd(cf_t amplitude, float freq, cf_t* z, in
 
 SRSRAN_API void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int len);
 
+SRSRAN_API void srsran_vec_apply_cfo_phase_simd(const cf_t* x, float cfo, double phase, cf_t* z, int len);
+
+SRSRAN_API cf_t srsran_vec_acc_cfo_cc_simd(const cf_t* x, float cfo, int len);
+
 SRSRAN_API float srsran_vec_estimate_frequency_simd(const cf_t* x, int len);
 
 /* SIMD Find Max functions */
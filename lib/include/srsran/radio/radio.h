@@ -26,6 +26,7 @@
 #include "srsran/common/interfaces_common.h"
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/resampling/resampler_poly.h"
 #include "srsran/phy/rf/rf.h"
 #include "srsran/radio/radio_base.h"
 #include "srsran/srslog/srslog.h"
@@ -110,8 +111,19 @@ private:
   std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      rx_buffer;
   std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> interpolators = {};
   std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> poly_interpolators = {}; ///< Non-integer ratio interpolators
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> poly_decimators    = {}; ///< Non-integer ratio decimators
   std::atomic<bool> decimator_busy = {false}; ///< Indicates the decimator is changing the rate
 
+  /**
+   * Resampler selection when the sampling rate is fixed
+   */
+  enum resampler_mode_t {
+    RESAMPLER_AUTO = 0, ///< FFT resampler for integer ratios, otherwise polyphase
+    RESAMPLER_FFT,      ///< FFT resampler only, the sampling rate ratio must be integer
+    RESAMPLER_POLYPHASE ///< Polyphase resampler for any ratio
+  } resampler_mode = RESAMPLER_AUTO;
+
   rf_timestamp_t    end_of_burst_time = {};
   std::atomic<bool> is_start_of_burst{false};
   uint32_t          tx_adv_nsamples    = 0;
@@ -214,6 +214,29 @@ public:
     backend.push(std::move(entry));
   }
 
+  /// Passes a log entry that has already been formatted by the caller to the
+  /// backend, which writes it to the sink as is, bypassing the sink
+  /// formatter. When the channel is disabled the log entry will be discarded.
+  void write_formatted(std::string str)
+  {
+    if (!enabled()) {
+      return;
+    }
+
+    // Send the log entry to the backend.
+    detail::log_entry entry = {&log_sink,
+                               [s = std::move(str)](detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) {
+                                 buffer.append(s.data(), s.data() + s.size());
+                               },
+                               {std::chrono::high_resolution_clock::now(),
+                                {ctx_value, should_print_context},
+                                nullptr,
+                                nullptr,
+                                log_name,
+                                log_tag}};
+    backend.push(std::move(entry));
+  }
+
 private:
   const std::string     log_id;
   sink&                 log_sink;
@@ -59,6 +59,7 @@ extern "C" {
 #include "srsran/phy/resampling/decim.h"
 #include "srsran/phy/resampling/interp.h"
 #include "srsran/phy/resampling/resample_arb.h"
+#include "srsran/phy/resampling/resampler_poly.h"
 
 #include "srsran/phy/channel/ch_awgn.h"
 
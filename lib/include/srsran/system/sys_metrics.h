@@ -27,18 +27,28 @@
 
 namespace srsran {
 
-constexpr uint32_t metrics_max_supported_cpu = 32u;
+constexpr uint32_t metrics_max_supported_cpu     = 32u;
+constexpr uint32_t metrics_max_supported_threads = 128u;
+
+/// CPU usage of a single thread of the process.
+struct sys_thread_metrics_t {
+  uint32_t             tid       = 0;
+  std::array<char, 16> name      = {};  ///< Name given to the thread, null terminated
+  float                cpu_usage = 0.f; ///< Percentage of one CPU used since the last measure
+};
 
 /// Metrics of cpu usage, memory consumption and number of thread used by the process.
 struct sys_metrics_t {
-  uint32_t                                     process_realmem_kB    = 0;
-  uint32_t                                     process_virtualmem_kB = 0;
-  float                                        process_realmem       = 0.f;
-  uint32_t                                     thread_count          = 0;
-  float                                        process_cpu_usage     = 0.f;
-  float                                        system_mem            = 0.f;
-  uint32_t                                     cpu_count             = 0;
-  std::array<float, metrics_max_supported_cpu> cpu_load              = {};
+  uint32_t                                                        process_realmem_kB    = 0;
+  uint32_t                                                        process_virtualmem_kB = 0;
+  float                                                           process_realmem       = 0.f;
+  uint32_t                                                        thread_count          = 0;
+  float                                                           process_cpu_usage     = 0.f;
+  float                                                           system_mem            = 0.f;
+  uint32_t                                                        cpu_count             = 0;
+  std::array<float, metrics_max_supported_cpu>                    cpu_load              = {};
+  uint32_t                                                        nof_thread_metrics    = 0; ///< Valid thread_metrics
+  std::array<sys_thread_metrics_t, metrics_max_supported_threads> thread_metrics        = {};
 };
 
 } // namespace srsran
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SYS_METRICS_PARSERS_H
+#define SRSRAN_SYS_METRICS_PARSERS_H
+
+#include <array>
+#include <cstdint>
+
+/// Parsers of the /proc/ system files used by the sys_metrics_processor. They work on the null terminated contents of
+/// the file, already read in memory, and do not allocate.
+
+namespace srsran {
+
+/// Fields of the /proc/[pid]/stat and /proc/[pid]/task/[tid]/stat files, as documented in proc(5).
+struct proc_stat_fields {
+  std::array<char, 16> name        = {}; ///< Name of the process or thread, null terminated
+  uint64_t             utime       = 0;  ///< Time spent in user mode, in clock ticks
+  uint64_t             stime       = 0;  ///< Time spent in kernel mode, in clock ticks
+  int32_t              num_threads = 0;
+  uint64_t             start_time  = 0; ///< Time the process or thread started after boot, in clock ticks
+};
+
+/// Memory fields of the /proc/meminfo file, in kB.
+struct meminfo_fields {
+  uint32_t total_kB   = 0;
+  uint32_t free_kB    = 0;
+  uint32_t buffers_kB = 0;
+  uint32_t cached_kB  = 0;
+  uint32_t slab_kB    = 0;
+};
+
+/// Parses the contents of a stat file. Returns false when the contents are truncated or malformed.
+bool parse_proc_stat(const char* buffer, proc_stat_fields& fields);
+
+/// Parses the contents of the /proc/meminfo file. Returns false when the total memory is missing.
+bool parse_meminfo(const char* buffer, meminfo_fields& fields);
+
+/// Extracts the memory size of the given label, e.g. "\nVmRSS:", from the contents of a /proc/ file. Returns 0 if the
+/// label is not found.
+uint32_t parse_memory_value(const char* buffer, const char* label);
+
+/// Parses the idle time of every CPU from the contents of the /proc/stat file, skipping the aggregated first line.
+/// Returns the number of CPUs written in idle_ticks, at most max_nof_cpus.
+uint32_t parse_cpu_idle_times(const char* buffer, uint64_t* idle_ticks, uint32_t max_nof_cpus);
+
+/// Parses the time spent on CPU, in nanoseconds, from the contents of a /proc/[pid]/task/[tid]/schedstat file. Returns
+/// false when the contents are malformed.
+bool parse_schedstat_runtime(const char* buffer, uint64_t& runtime_ns);
+
+} // namespace srsran
+
+#endif // SRSRAN_SYS_METRICS_PARSERS_H
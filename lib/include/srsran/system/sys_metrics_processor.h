@@ -24,72 +24,98 @@
 
 #include "srsran/srslog/logger.h"
 #include "srsran/system/sys_metrics.h"
+#include "srsran/system/sys_metrics_parsers.h"
+#include <array>
 #include <chrono>
-#include <string>
+#include <vector>
 
 namespace srsran {
 
 /// Process information from the system to create sys_metrics_t. The information is processed from the /proc/ system.
+/// The files are opened once and re-read from the start every measure, without allocating memory.
 class sys_metrics_processor
 {
-  /// Helper class used to parse the information from the /proc/[pid]/stats.
-  struct proc_stats_info {
-    proc_stats_info();
-
-    // Initialize the variables that will be used.
-    int32_t  num_threads = 0;
-    uint32_t utime       = 0;
-    uint32_t stime       = 0;
-
-    // Rest of the information of the stats file.
-    int32_t pid, ppid, pgrp, session, tty_nr, tpgid, exit_signal, processor, exit_code, cutime, cstime, priority, nice,
-        itrealvalue, rss, cguest_time;
-    uint32_t minflt, cminflt, majflt, cmajflt, vsize, rsslim, startcode, endcode, startstack, kstkesp, kstkeip, signal,
-        blocked, sigignore, sigcatch, wchan, nswap, cnswap, guest_time, start_data, end_data, start_brk, arg_start,
-        arg_end, env_start, env_end, flags, rt_priority, policy;
-    uint64_t    starttime, delaycct_blkio_ticks;
-    uint8_t     state;
-    std::string comm;
+  /// File of the /proc/ system that is kept open between measures.
+  class proc_file
+  {
+  public:
+    proc_file() = default;
+    proc_file(int dir_fd, const char* path);
+    ~proc_file();
+    proc_file(proc_file&& other) noexcept;
+    proc_file& operator=(proc_file&& other) noexcept;
+    proc_file(const proc_file&) = delete;
+    proc_file& operator=(const proc_file&) = delete;
+
+    bool is_open() const { return fd >= 0; }
+
+    /// Reads the whole file in the given buffer and null terminates it. Returns the number of bytes read, or -1 on
+    /// error.
+    int read(char* buffer, size_t size) const;
+
+  private:
+    int fd = -1;
   };
 
-  /// Helper class to read the cpu metrics.
-  struct cpu_metrics_t {
-    std::string name    = "";
-    int32_t     user    = 0;
-    int32_t     nice    = 0;
-    int32_t     system  = 0;
-    int32_t     idle    = 0;
-    int32_t     iowait  = 0;
-    int32_t     irq     = 0;
-    int32_t     softirq = 0;
+  /// Thread of the process being tracked.
+  struct thread_info_t {
+    uint32_t             tid        = 0;
+    proc_file            stat       = {};
+    proc_file            schedstat  = {};
+    std::array<char, 16> name       = {};
+    uint64_t             start_time = 0; ///< Tells apart the threads that reuse the identifier of a finished one
+    uint64_t             runtime_ns = 0; ///< Time spent on CPU at the last measure
+    bool                 alive      = false;
   };
 
 public:
   explicit sys_metrics_processor(srslog::basic_logger& logger);
+  ~sys_metrics_processor();
+  sys_metrics_processor(const sys_metrics_processor&) = delete;
+  sys_metrics_processor& operator=(const sys_metrics_processor&) = delete;
+
   /// Measures and returns the system metrics.
   sys_metrics_t get_metrics();
 
 private:
-  /// Calculates and returns the cpu usage in %. current_query is the most recent proc_stats_info, and
+  /// Reads the process stats. Returns false on error.
+  bool read_proc_stats(proc_stat_fields& info);
+
+  /// Calculates and returns the cpu usage in %. current_query is the most recent proc_stat_fields, and
   /// delta_time_in_seconds is the elapsed time between the last measure and current in seconds. NOTE: Returns -1.0f on
   /// error.
-  float calculate_cpu_usage(const proc_stats_info& current_query, float delta_time_in_seconds) const;
+  float calculate_cpu_usage(const proc_stat_fields& current_query, float delta_time_in_seconds) const;
 
   /// Calculate the memory parameters and writes them in metrics.
   /// NOTE: on error, metrics memory parameters are set to 0.
-  void calculate_mem_usage(sys_metrics_t& metrics) const;
+  void calculate_mem_usage(sys_metrics_t& metrics);
 
   /// Calculate the cpu metrics and stores them in the given metrics. delta_time_in_seconds is the number of seconds
   /// elapsed since the last cpu metrics measurement.
   void calculate_cpu_metrics(sys_metrics_t& metrics, float delta_time_in_seconds);
 
-  /// Returns the cpu metrics from the given line.
-  cpu_metrics_t read_cpu_idle_from_line(const std::string& line) const;
+  /// Calculate the cpu usage of every thread of the process from their scheduler stats, and stores them in the given
+  /// metrics.
+  void calculate_thread_metrics(sys_metrics_t& metrics, float delta_time_in_seconds);
+
+  /// Opens the /proc/ files of the given thread and reads its name, start time and current runtime. On error, the
+  /// files are opened again on the next measure.
+  void open_thread(thread_info_t& thread);
 
 private:
+  /// Large enough for /proc/stat with the maximum number of supported CPUs.
+  static constexpr size_t buffer_size = 16384;
+
   srslog::basic_logger&                              logger;
-  proc_stats_info                                    last_query                                 = {};
-  cpu_metrics_t                                      last_cpu_thread[metrics_max_supported_cpu] = {};
+  proc_file                                          self_stat;
+  proc_file                                          self_status;
+  proc_file                                          stat;
+  proc_file                                          meminfo;
+  int                                                task_dir_fd = -1;
+  std::vector<thread_info_t>                         threads;
+  std::array<char, buffer_size>                      buffer          = {};
+  proc_stat_fields                                   last_query      = {};
+  std::array<uint64_t, metrics_max_supported_cpu>    last_cpu_idle   = {};
   std::chrono::time_point<std::chrono::steady_clock> last_query_time = std::chrono::steady_clock::now();
 };
 
@@ -20,66 +20,58 @@
  */
 
 #include "srsran/common/bearer_manager.h"
+#include <limits>
 
 namespace srsran {
 
 namespace detail {
 
 const ue_bearer_manager_impl::radio_bearer_t ue_bearer_manager_impl::invalid_rb{srsran::srsran_rat_t::nulltype, 0, 0};
+const uint32_t                               ue_bearer_manager_impl::max_nof_bearers;
+const uint8_t                                ue_bearer_manager_impl::no_eps_bearer;
 
 bool ue_bearer_manager_impl::add_eps_bearer(uint8_t eps_bearer_id, srsran::srsran_rat_t rat, uint32_t lcid)
 {
-  auto bearer_it = bearers.find(eps_bearer_id);
-  if (bearer_it != bearers.end()) {
+  if (eps_bearer_id >= max_nof_bearers or lcid >= max_nof_bearers or has_active_radio_bearer(eps_bearer_id)) {
     return false;
   }
-  bearers.emplace(eps_bearer_id, radio_bearer_t{rat, lcid, eps_bearer_id});
-  lcid_to_eps_bearer_id.emplace(lcid, eps_bearer_id);
+  // The bearer is written before the LCID that points to it
+  bearers[eps_bearer_id].store(pack(radio_bearer_t{rat, lcid, eps_bearer_id}), std::memory_order_release);
+  if (lcid_to_eps_bearer_id[lcid].load(std::memory_order_relaxed) == no_eps_bearer) {
+    lcid_to_eps_bearer_id[lcid].store(eps_bearer_id, std::memory_order_release);
+  }
   return true;
 }
 
 bool ue_bearer_manager_impl::remove_eps_bearer(uint8_t eps_bearer_id)
 {
-  auto bearer_it = bearers.find(eps_bearer_id);
-  if (bearer_it == bearers.end()) {
+  radio_bearer_t rb = get_radio_bearer(eps_bearer_id);
+  if (not rb.is_valid()) {
     return false;
   }
-  uint32_t lcid = bearer_it->second.lcid;
-  bearers.erase(bearer_it);
-  lcid_to_eps_bearer_id.erase(lcid);
+  lcid_to_eps_bearer_id[rb.lcid].store(no_eps_bearer, std::memory_order_release);
+  bearers[eps_bearer_id].store(pack(invalid_rb), std::memory_order_release);
   return true;
 }
 
 void ue_bearer_manager_impl::reset()
 {
-  lcid_to_eps_bearer_id.clear();
-  bearers.clear();
-}
-
-bool ue_bearer_manager_impl::has_active_radio_bearer(uint32_t eps_bearer_id)
-{
-  return bearers.count(eps_bearer_id) > 0;
-}
-
-ue_bearer_manager_impl::radio_bearer_t ue_bearer_manager_impl::get_radio_bearer(uint32_t eps_bearer_id) const
-{
-  auto it = bearers.find(eps_bearer_id);
-  return it != bearers.end() ? it->second : invalid_rb;
-}
-
-ue_bearer_manager_impl::radio_bearer_t ue_bearer_manager_impl::get_eps_bearer_id_for_lcid(uint32_t lcid) const
-{
-  auto lcid_it = lcid_to_eps_bearer_id.find(lcid);
-  return lcid_it != lcid_to_eps_bearer_id.end() ? bearers.at(lcid_it->second) : invalid_rb;
+  for (std::atomic<uint8_t>& eps_bearer_id : lcid_to_eps_bearer_id) {
+    eps_bearer_id.store(no_eps_bearer, std::memory_order_release);
+  }
+  for (std::atomic<uint64_t>& rb : bearers) {
+    rb.store(pack(invalid_rb), std::memory_order_release);
+  }
 }
 
 bool ue_bearer_manager_impl::set_five_qi(uint32_t eps_bearer_id, uint16_t five_qi)
 {
-  auto it = bearers.find(eps_bearer_id);
-  if (it == bearers.end()) {
+  radio_bearer_t rb = get_radio_bearer(eps_bearer_id);
+  if (not rb.is_valid()) {
     return false;
   }
-  it->second.five_qi = five_qi;
+  rb.five_qi = five_qi;
+  bearers[eps_bearer_id].store(pack(rb), std::memory_order_release);
   return true;
 }
 
@@ -105,7 +97,7 @@ void ue_bearer_manager::add_eps_bearer(uint8_t eps_bearer_id, srsran::srsran_rat
     logger.info(
         "Bearers: Registered EPS bearer ID %d for lcid=%d over %s-PDCP", eps_bearer_id, lcid, to_string(rat).c_str());
   } else {
-    logger.warning("Bearers: EPS bearer ID %d already registered", eps_bearer_id);
+    logger.warning("Bearers: EPS bearer ID %d already registered or invalid", eps_bearer_id);
   }
 }
 
@@ -130,44 +122,53 @@ void ue_bearer_manager::reset()
 
 namespace srsenb {
 
-enb_bearer_manager::enb_bearer_manager() : logger(srslog::fetch_basic_logger("STCK", false)) {}
+enb_bearer_manager::enb_bearer_manager() :
+  logger(srslog::fetch_basic_logger("STCK", false)),
+  rnti_to_user(new std::atomic<user_bearers_t*>[std::numeric_limits<uint16_t>::max() + 1])
+{
+  for (uint32_t rnti = 0; rnti <= std::numeric_limits<uint16_t>::max(); ++rnti) {
+    rnti_to_user[rnti].store(nullptr, std::memory_order_relaxed);
+  }
+}
 
 enb_bearer_manager::~enb_bearer_manager() {}
 
 void enb_bearer_manager::add_eps_bearer(uint16_t rnti, uint8_t eps_bearer_id, srsran::srsran_rat_t rat, uint32_t lcid)
 {
-  auto user_it = users_map.find(rnti);
-  if (user_it == users_map.end()) {
-    // add empty bearer map
-    // users_map.emplace( )   returns pair<iterator,bool>
-    auto p = users_map.emplace(rnti, srsran::detail::ue_bearer_manager_impl{});
-    if (!p.second) {
-      logger.error("Bearers: Unable to add a new bearer map for rnti=0x%x", rnti);
-      return;
+  std::lock_guard<std::mutex> lock(mutex);
+  user_bearers_t*             user = rnti_to_user[rnti].load(std::memory_order_relaxed);
+  if (user == nullptr) {
+    // add empty bearer table
+    if (free_users.empty()) {
+      users.emplace_back(new user_bearers_t{});
+      free_users.push_back(users.back().get());
     }
-    user_it = p.first;
+    user = free_users.back();
+    free_users.pop_back();
+    rnti_to_user[rnti].store(user, std::memory_order_release);
   }
 
-  if (user_it->second.add_eps_bearer(eps_bearer_id, rat, lcid)) {
+  if (user->bearers.add_eps_bearer(eps_bearer_id, rat, lcid)) {
     logger.info("Bearers: Registered eps-BearerID=%d for rnti=0x%x, lcid=%d over %s-PDCP",
                 eps_bearer_id,
                 rnti,
                 lcid,
                 to_string(rat).c_str());
   } else {
-    logger.warning("Bearers: EPS bearer ID %d for rnti=0x%x already registered", eps_bearer_id, rnti);
+    logger.warning("Bearers: EPS bearer ID %d for rnti=0x%x already registered or invalid", eps_bearer_id, rnti);
   }
 }
 
 void enb_bearer_manager::remove_eps_bearer(uint16_t rnti, uint8_t eps_bearer_id)
 {
-  auto user_it = users_map.find(rnti);
-  if (user_it == users_map.end()) {
+  std::lock_guard<std::mutex> lock(mutex);
+  user_bearers_t*             user = rnti_to_user[rnti].load(std::memory_order_relaxed);
+  if (user == nullptr) {
     logger.info("Bearers: No EPS bearer registered for rnti=0x%x", rnti);
     return;
   }
 
-  if (user_it->second.remove_eps_bearer(eps_bearer_id)) {
+  if (user->bearers.remove_eps_bearer(eps_bearer_id)) {
     logger.info("Bearers: Removed mapping for EPS bearer ID %d for rnti=0x%x", eps_bearer_id, rnti);
   } else {
     logger.info("Bearers: Can't remove EPS bearer ID %d, rnti=0x%x", eps_bearer_id, rnti);
@@ -176,50 +177,61 @@ void enb_bearer_manager::remove_eps_bearer(uint16_t rnti, uint8_t eps_bearer_id)
 
 void enb_bearer_manager::rem_user(uint16_t rnti)
 {
-  auto user_it = users_map.find(rnti);
-  if (user_it == users_map.end()) {
+  std::lock_guard<std::mutex> lock(mutex);
+  user_bearers_t*             user = rnti_to_user[rnti].load(std::memory_order_relaxed);
+  if (user == nullptr) {
     logger.info("Bearers: No EPS bearer registered for rnti=0x%x", rnti);
     return;
   }
 
   logger.info("Bearers: Removed rnti=0x%x from EPS bearer manager", rnti);
-  users_map.erase(user_it);
+  rnti_to_user[rnti].store(nullptr, std::memory_order_relaxed);
+  // The fence orders the new generation before the clearing of the table and the bearers of its next user
+  user->generation.fetch_add(1, std::memory_order_release);
+  std::atomic_thread_fence(std::memory_order_release);
+  user->bearers.reset();
+  free_users.push_back(user);
 }
 
-bool enb_bearer_manager::has_active_radio_bearer(uint16_t rnti, uint32_t eps_bearer_id)
+template <typename Lookup>
+enb_bearer_manager::radio_bearer_t enb_bearer_manager::find_bearer(uint16_t rnti, const Lookup& lookup) const
 {
-  auto user_it = users_map.find(rnti);
-  if (user_it == users_map.end()) {
-    return false;
+  const user_bearers_t* user = rnti_to_user[rnti].load(std::memory_order_acquire);
+  if (user == nullptr) {
+    return ue_bearers_t::invalid_rb;
+  }
+  // The table may have been released before its generation was read, in which case the user is gone
+  uint32_t generation = user->generation.load(std::memory_order_acquire);
+  if (rnti_to_user[rnti].load(std::memory_order_acquire) != user) {
+    return ue_bearers_t::invalid_rb;
   }
-  return user_it->second.has_active_radio_bearer(eps_bearer_id);
+  radio_bearer_t rb = lookup(user->bearers);
+  // If the lookup read anything written after a release of the table, the fence makes the new generation visible
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return user->generation.load(std::memory_order_relaxed) == generation ? rb : ue_bearers_t::invalid_rb;
+}
+
+bool enb_bearer_manager::has_active_radio_bearer(uint16_t rnti, uint32_t eps_bearer_id) const
+{
+  return get_radio_bearer(rnti, eps_bearer_id).is_valid();
 }
 
 enb_bearer_manager::radio_bearer_t enb_bearer_manager::get_lcid_bearer(uint16_t rnti, uint32_t lcid) const
 {
-  auto user_it = users_map.find(rnti);
-  if (user_it == users_map.end()) {
-    return srsran::detail::ue_bearer_manager_impl::invalid_rb;
-  }
-  return user_it->second.get_eps_bearer_id_for_lcid(lcid);
+  return find_bearer(rnti, [lcid](const ue_bearers_t& bearers) { return bearers.get_eps_bearer_id_for_lcid(lcid); });
 }
 
-enb_bearer_manager::radio_bearer_t enb_bearer_manager::get_radio_bearer(uint16_t rnti, uint32_t eps_bearer_id)
+enb_bearer_manager::radio_bearer_t enb_bearer_manager::get_radio_bearer(uint16_t rnti, uint32_t eps_bearer_id) const
 {
-  auto user_it = users_map.find(rnti);
-  if (user_it == users_map.end()) {
-    return srsran::detail::ue_bearer_manager_impl::invalid_rb;
-  }
-  return user_it->second.get_radio_bearer(eps_bearer_id);
+  return find_bearer(rnti,
+                     [eps_bearer_id](const ue_bearers_t& bearers) { return bearers.get_radio_bearer(eps_bearer_id); });
 }
 
 bool enb_bearer_manager::set_five_qi(uint16_t rnti, uint32_t eps_bearer_id, uint16_t five_qi)
 {
-  auto user_it = users_map.find(rnti);
-  if (user_it == users_map.end()) {
-    return false;
-  }
-  return user_it->second.set_five_qi(eps_bearer_id, five_qi);
+  std::lock_guard<std::mutex> lock(mutex);
+  user_bearers_t*             user = rnti_to_user[rnti].load(std::memory_order_relaxed);
+  return user != nullptr and user->bearers.set_five_qi(eps_bearer_id, five_qi);
 }
 
 } // namespace srsenb
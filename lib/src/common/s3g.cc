@@ -194,6 +194,39 @@ uint8_t s3g_mul_x_pow(uint8_t v, uint8_t i, uint8_t c)
     return s3g_mul_x(s3g_mul_x_pow(v, i - 1, c), c);
 }
 
+/*********************************************************************
+    Name: s3g_alpha_tables
+
+    Description: MUL_alpha and DIV_alpha only depend on the input byte.
+                 They are evaluated once for all 256 values instead of
+                 on every LFSR clock.
+
+    Document Reference: Specification of the 3GPP Confidentiality and
+                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
+                            Section 3.4.2 and Section 3.4.3
+*********************************************************************/
+struct s3g_alpha_tables_t {
+  uint32_t mul_alpha[256];
+  uint32_t div_alpha[256];
+
+  s3g_alpha_tables_t()
+  {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint8_t c    = (uint8_t)i;
+      mul_alpha[i] = ((((uint32_t)s3g_mul_x_pow(c, 23, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 245, 0xa9)) << 16) |
+                      (((uint32_t)s3g_mul_x_pow(c, 48, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 239, 0xa9))));
+      div_alpha[i] = ((((uint32_t)s3g_mul_x_pow(c, 16, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 39, 0xa9)) << 16) |
+                      (((uint32_t)s3g_mul_x_pow(c, 6, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 64, 0xa9))));
+    }
+  }
+};
+
+static const s3g_alpha_tables_t& s3g_alpha_tables()
+{
+  static const s3g_alpha_tables_t tables;
+  return tables;
+}
+
 /*********************************************************************
     Name: s3g_mul_alpha
 
@@ -205,8 +238,7 @@ uint8_t s3g_mul_x_pow(uint8_t v, uint8_t i, uint8_t c)
 *********************************************************************/
 uint32_t s3g_mul_alpha(uint8_t c)
 {
-  return ((((uint32_t)s3g_mul_x_pow(c, 23, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 245, 0xa9)) << 16) |
-          (((uint32_t)s3g_mul_x_pow(c, 48, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 239, 0xa9))));
+  return s3g_alpha_tables().mul_alpha[c];
 }
 
 /*********************************************************************
@@ -220,8 +252,7 @@ uint32_t s3g_mul_alpha(uint8_t c)
 *********************************************************************/
 uint32_t s3g_div_alpha(uint8_t c)
 {
-  return ((((uint32_t)s3g_mul_x_pow(c, 16, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 39, 0xa9)) << 16) |
-          (((uint32_t)s3g_mul_x_pow(c, 6, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 64, 0xa9))));
+  return s3g_alpha_tables().div_alpha[c];
 }
 
 /*********************************************************************
@@ -454,9 +485,11 @@ uint64_t s3g_MUL64(uint64_t V, uint64_t P, uint64_t c)
   uint64_t result = 0;
   int      i      = 0;
 
+  // V holds MUL64xPOW(V, i, c) in iteration i
   for (i = 0; i < 64; i++) {
     if ((P >> i) & 0x1)
-      result ^= s3g_MUL64xPOW(V, i, c);
+      result ^= V;
+    V = s3g_MUL64x(V, c);
   }
   return result;
 }
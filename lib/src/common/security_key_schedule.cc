@@ -0,0 +1,168 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security_key_schedule.h"
+#include "srsran/config.h"
+#include <algorithm>
+#include <string.h>
+
+namespace srsran {
+
+void security_key_schedule::set_aes_key(aes_key_t& aes_key, const uint8_t* key, bool cmac_subkeys)
+{
+  if (aes_key.valid && memcmp(aes_key.key, key, sizeof(aes_key.key)) == 0) {
+    return;
+  }
+  memcpy(aes_key.key, key, sizeof(aes_key.key));
+  aes_setkey_enc(&aes_key.ctx, aes_key.key, 128);
+  aes_key.valid = true;
+
+  if (not cmac_subkeys) {
+    return;
+  }
+
+  // CMAC subkeys K1 and K2 (RFC 4493, Section 2.3)
+  uint8_t const_zero[16] = {};
+  uint8_t L[16];
+  aes_crypt_ecb(&aes_key.ctx, AES_ENCRYPT, const_zero, L);
+  for (uint32_t i = 0; i < 15; i++) {
+    aes_key.k1[i] = (L[i] << 1) | ((L[i + 1] >> 7) & 0x01);
+  }
+  aes_key.k1[15] = L[15] << 1;
+  if (L[0] & 0x80) {
+    aes_key.k1[15] ^= 0x87;
+  }
+  for (uint32_t i = 0; i < 15; i++) {
+    aes_key.k2[i] = (aes_key.k1[i] << 1) | ((aes_key.k1[i + 1] >> 7) & 0x01);
+  }
+  aes_key.k2[15] = aes_key.k1[15] << 1;
+  if (aes_key.k1[0] & 0x80) {
+    aes_key.k2[15] ^= 0x87;
+  }
+}
+
+uint8_t security_key_schedule::integrity_generate(INTEGRITY_ALGORITHM_ID_ENUM algo,
+                                                  const uint8_t*              key,
+                                                  uint32_t                    count,
+                                                  uint32_t                    bearer,
+                                                  uint8_t                     direction,
+                                                  uint8_t*                    msg,
+                                                  uint32_t                    msg_len,
+                                                  uint8_t*                    mac)
+{
+  switch (algo) {
+    case INTEGRITY_ALGORITHM_ID_EIA0:
+      return SRSRAN_SUCCESS;
+    case INTEGRITY_ALGORITHM_ID_128_EIA1:
+      return security_128_eia1(key, count, bearer, direction, msg, msg_len, mac);
+    case INTEGRITY_ALGORITHM_ID_128_EIA2:
+      break;
+    case INTEGRITY_ALGORITHM_ID_128_EIA3:
+      return security_128_eia3(key, count, bearer, direction, msg, msg_len, mac);
+    default:
+      return SRSRAN_ERROR;
+  }
+  if (key == nullptr || msg == nullptr || mac == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  set_aes_key(int_key, key, true);
+
+  // AES-CMAC (33.401 Annex B.2.3) over COUNT | BEARER | DIRECTION | 0^26 | MESSAGE, without copying the message
+  uint8_t hdr[8] = {};
+  hdr[0]         = (count >> 24) & 0xFF;
+  hdr[1]         = (count >> 16) & 0xFF;
+  hdr[2]         = (count >> 8) & 0xFF;
+  hdr[3]         = count & 0xFF;
+  hdr[4]         = (bearer << 3) | (direction << 2);
+
+  uint32_t total_len = msg_len + sizeof(hdr);
+  uint32_t nof_blks  = (total_len + 15) / 16;
+  uint8_t  T[16]     = {};
+  for (uint32_t b = 0; b < nof_blks; b++) {
+    uint8_t  blk[16] = {};
+    uint32_t start   = b * 16;
+    uint32_t len     = std::min(16u, total_len - start);
+    for (uint32_t j = 0; j < len; j++) {
+      uint32_t idx = start + j;
+      blk[j]       = idx < sizeof(hdr) ? hdr[idx] : msg[idx - sizeof(hdr)];
+    }
+    if (b == nof_blks - 1) {
+      // Last block is xored with K1 if complete, otherwise padded with 10^i and xored with K2
+      const uint8_t* subkey = int_key.k1;
+      if (len < 16) {
+        blk[len] = 0x80;
+        subkey   = int_key.k2;
+      }
+      for (uint32_t j = 0; j < 16; j++) {
+        blk[j] ^= subkey[j];
+      }
+    }
+    for (uint32_t j = 0; j < 16; j++) {
+      blk[j] ^= T[j];
+    }
+    aes_crypt_ecb(&int_key.ctx, AES_ENCRYPT, blk, T);
+  }
+  memcpy(mac, T, 4);
+  return SRSRAN_SUCCESS;
+}
+
+uint8_t security_key_schedule::cipher(CIPHERING_ALGORITHM_ID_ENUM algo,
+                                      const uint8_t*              key,
+                                      uint32_t                    count,
+                                      uint8_t                     bearer,
+                                      uint8_t                     direction,
+                                      uint8_t*                    msg,
+                                      uint32_t                    msg_len,
+                                      uint8_t*                    msg_out)
+{
+  switch (algo) {
+    case CIPHERING_ALGORITHM_ID_EEA0:
+      return SRSRAN_SUCCESS;
+    case CIPHERING_ALGORITHM_ID_128_EEA1:
+      return security_128_eea1(const_cast<uint8_t*>(key), count, bearer, direction, msg, msg_len, msg_out);
+    case CIPHERING_ALGORITHM_ID_128_EEA2:
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA3:
+      return security_128_eea3(const_cast<uint8_t*>(key), count, bearer, direction, msg, msg_len, msg_out);
+    default:
+      return SRSRAN_ERROR;
+  }
+  if (key == nullptr || msg == nullptr || msg_out == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  set_aes_key(enc_key, key, false);
+
+  // AES-CTR (33.401 Annex B.1.3), works in place
+  uint8_t stream_blk[16] = {};
+  uint8_t nonce_cnt[16]  = {};
+  size_t  nc_off         = 0;
+  nonce_cnt[0]           = (count >> 24) & 0xFF;
+  nonce_cnt[1]           = (count >> 16) & 0xFF;
+  nonce_cnt[2]           = (count >> 8) & 0xFF;
+  nonce_cnt[3]           = count & 0xFF;
+  nonce_cnt[4]           = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+  if (aes_crypt_ctr(&enc_key.ctx, msg_len, &nc_off, nonce_cnt, stream_blk, msg, msg_out) != 0) {
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
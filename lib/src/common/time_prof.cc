@@ -21,9 +21,15 @@
 
 #include "srsran/common/time_prof.h"
 #include <algorithm>
+#include <cmath>
 #include <inttypes.h>
+#include <mutex>
 #include <numeric>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 using namespace srsran;
 using std::chrono::nanoseconds;
 
@@ -115,3 +121,202 @@ void sliding_window_stats<TUnit>::operator()(nanoseconds duration)
 
 template class srsran::sliding_window_stats<std::chrono::microseconds>;
 template class srsran::sliding_window_stats<std::chrono::milliseconds>;
+
+// histogram profiler
+
+namespace {
+
+/// Reference points of the tick calibration, taken when the library is loaded
+struct tprof_clock_ref {
+  uint64_t                              ticks = tprof_clock::now();
+  std::chrono::steady_clock::time_point t     = std::chrono::steady_clock::now();
+};
+const tprof_clock_ref clock_ref;
+
+/// Maximum number of profilers alive with per-thread histograms, the profilers beyond it share one histogram
+constexpr uint32_t tprof_max_thread_slots = 64;
+
+/// Histogram of the calling thread for the profiler in a slot, only valid if the generation matches
+struct tprof_thread_slot {
+  uint64_t         generation = 0;
+  tprof_histogram* hist       = nullptr;
+};
+thread_local std::array<tprof_thread_slot, tprof_max_thread_slots> thread_slots = {};
+
+/// Profilers alive and free thread slots, only accessed on creation, destruction and report
+struct tprof_registry {
+  tprof_registry()
+  {
+    for (uint32_t i = tprof_max_thread_slots; i > 0; i--) {
+      free_slots.push_back(i - 1);
+    }
+  }
+
+  std::mutex                     mutex;
+  std::vector<hist_tprof<true>*> list;
+  std::vector<uint32_t>          free_slots;
+  uint64_t                       next_generation = 1;
+};
+tprof_registry& get_tprof_registry()
+{
+  static tprof_registry registry;
+  return registry;
+}
+
+} // namespace
+
+uint64_t tprof_clock::now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+double tprof_clock::ns_per_tick()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  // The estimate is cached once the reference interval is long enough to make it accurate
+  static std::atomic<double> cached = {0.0};
+  double                     value  = cached.load(std::memory_order_relaxed);
+  if (value > 0.0) {
+    return value;
+  }
+
+  uint64_t ticks = tprof_clock::now() - clock_ref.ticks;
+  auto     ns    = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - clock_ref.t);
+  if (ticks == 0) {
+    return 1.0;
+  }
+  value = ns.count() / static_cast<double>(ticks);
+  if (ns > std::chrono::seconds(1)) {
+    cached.store(value, std::memory_order_relaxed);
+  }
+  return value;
+#else
+  return 1.0;
+#endif
+}
+
+template <bool Enabled>
+hist_tprof<Enabled>::hist_tprof(const char* name_) : name(name_)
+{
+  tprof_registry&             registry = get_tprof_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.list.push_back(this);
+  generation = registry.next_generation++;
+  slot       = tprof_max_thread_slots;
+  if (not registry.free_slots.empty()) {
+    slot = registry.free_slots.back();
+    registry.free_slots.pop_back();
+  }
+}
+
+template <bool Enabled>
+hist_tprof<Enabled>::~hist_tprof()
+{
+  {
+    tprof_registry&             registry = get_tprof_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.list.erase(std::remove(registry.list.begin(), registry.list.end(), this), registry.list.end());
+    if (slot < tprof_max_thread_slots) {
+      registry.free_slots.push_back(slot);
+    }
+  }
+
+  // Threads keep pointers to these histograms in the slot, but the next profiler in the slot has another generation
+  node_t* node = head.load(std::memory_order_acquire);
+  while (node != nullptr) {
+    node_t* next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+template <bool Enabled>
+void hist_tprof<Enabled>::add(uint64_t ticks)
+{
+  if (slot >= tprof_max_thread_slots) {
+    shared_node.hist.add_shared(ticks);
+    return;
+  }
+
+  tprof_thread_slot& s = thread_slots[slot];
+  if (s.generation != generation) {
+    s.hist       = &register_thread()->hist;
+    s.generation = generation;
+  }
+  s.hist->add(ticks);
+}
+
+template <bool Enabled>
+typename hist_tprof<Enabled>::node_t* hist_tprof<Enabled>::register_thread()
+{
+  // Push the thread histogram to the profiler list without locking
+  node_t* node = new node_t;
+  node->next   = head.load(std::memory_order_relaxed);
+  while (not head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+  return node;
+}
+
+template <bool Enabled>
+tprof_metrics_t hist_tprof<Enabled>::get_metrics() const
+{
+  std::array<uint64_t, tprof_histogram::nof_buckets> buckets = {};
+  uint64_t                                           count   = 0;
+  uint64_t                                           sum     = 0;
+  uint64_t                                           max     = 0;
+
+  shared_node.hist.merge_into(buckets, count, sum, max);
+  for (const node_t* node = head.load(std::memory_order_acquire); node != nullptr; node = node->next) {
+    node->hist.merge_into(buckets, count, sum, max);
+  }
+
+  tprof_metrics_t metrics = {};
+  metrics.name            = name;
+  metrics.count           = count;
+  if (count == 0) {
+    return metrics;
+  }
+
+  double us_per_tick = tprof_clock::ns_per_tick() / 1000.0;
+  metrics.mean_us    = static_cast<double>(sum) / static_cast<double>(count) * us_per_tick;
+  metrics.max_us     = static_cast<double>(max) * us_per_tick;
+
+  // Percentiles are reported as the middle of the bucket where they fall, without exceeding the maximum
+  auto percentile = [&](double p) {
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * static_cast<double>(count))));
+    uint64_t acc    = 0;
+    for (uint32_t i = 0; i < tprof_histogram::nof_buckets; i++) {
+      acc += buckets[i];
+      if (acc >= target) {
+        double mid = static_cast<double>(tprof_histogram::bucket_lower(i)) +
+                     static_cast<double>(tprof_histogram::bucket_width(i) - 1) / 2.0;
+        return std::min(mid, static_cast<double>(max)) * us_per_tick;
+      }
+    }
+    return metrics.max_us;
+  };
+  metrics.p50_us = percentile(0.50);
+  metrics.p90_us = percentile(0.90);
+  metrics.p99_us = percentile(0.99);
+
+  return metrics;
+}
+
+template class srsran::hist_tprof<true>;
+
+std::vector<tprof_metrics_t> srsran::get_tprof_metrics()
+{
+  tprof_registry&              registry = get_tprof_registry();
+  std::lock_guard<std::mutex>  lock(registry.mutex);
+  std::vector<tprof_metrics_t> metrics;
+  metrics.reserve(registry.list.size());
+  for (const hist_tprof<true>* prof : registry.list) {
+    metrics.push_back(prof->get_metrics());
+  }
+  return metrics;
+}
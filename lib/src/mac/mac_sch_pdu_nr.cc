@@ -23,6 +23,9 @@
 
 namespace srsran {
 
+// SubPDUs are created for every parsed or added element, so they reuse the logger of the PDU rather than fetching it
+mac_sch_subpdu_nr::mac_sch_subpdu_nr(mac_sch_pdu_nr* parent_) : logger(&parent_->logger), parent(parent_) {}
+
 mac_sch_subpdu_nr::nr_lcid_sch_t mac_sch_subpdu_nr::get_type()
 {
   if (lcid >= 32) {
@@ -206,9 +209,16 @@ uint32_t mac_sch_subpdu_nr::write_subpdu(const uint8_t* start_)
     logger->error("Error while packing PDU. Unsupported header length (%d)", header_length);
   }
 
-  // copy SDU payload
+  // copy SDU payload, it may have been written in place after a longer subheader than the one actually used
   if (sdu) {
-    memcpy(ptr, sdu.ptr(), sdu_length);
+    if (sdu.ptr() != ptr) {
+      memmove(ptr, sdu.ptr(), sdu_length);
+    }
+
+    // From now on the SDU is referenced where it was written in the PDU
+    if (not sdu.uses_internal_storage()) {
+      sdu.set_storage_to(ptr);
+    }
   } else {
     // clear memory
     memset(ptr, 0, sdu_length);
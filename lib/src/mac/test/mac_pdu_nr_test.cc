@@ -885,6 +885,35 @@ int mac_ul_sch_pdu_unpack_test7()
   return SRSRAN_SUCCESS;
 }
 
+int mac_ul_sch_pdu_pack_test8()
+{
+  // MAC PDU with an SDU generated in place after the long subheader, which is then packed with a short one
+  byte_buffer_t tx_buffer;
+
+  srsran::mac_sch_pdu_nr tx_pdu(true);
+  tx_pdu.init_tx(&tx_buffer, 16, true);
+
+  const uint32_t sdu_len = 10;
+  uint8_t*       sdu     = tx_pdu.get_next_sdu_ptr(3);
+  for (uint32_t i = 0; i < sdu_len; i++) {
+    sdu[i] = i + 1;
+  }
+  TESTASSERT(tx_pdu.add_sdu(4, sdu, sdu_len) == SRSRAN_SUCCESS);
+  tx_pdu.pack();
+
+  // The SDU follows the short subheader and the stored subPDU points to it
+  const uint8_t expected_pdu[] = {0x04, 0x0a, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a};
+  TESTASSERT(tx_buffer.N_bytes >= sizeof(expected_pdu));
+  TESTASSERT(memcmp(tx_buffer.msg, expected_pdu, sizeof(expected_pdu)) == 0);
+
+  const mac_sch_subpdu_nr& subpdu = tx_pdu.get_subpdu(0);
+  TESTASSERT(subpdu.get_sdu_length() == sdu_len);
+  TESTASSERT(subpdu.get_sdu() == tx_buffer.msg + 2);
+  TESTASSERT(memcmp(subpdu.get_sdu(), &expected_pdu[2], sdu_len) == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
 #if PCAP
@@ -993,6 +1022,11 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
+  if (mac_ul_sch_pdu_pack_test8()) {
+    fprintf(stderr, "mac_ul_sch_pdu_pack_test8() failed.\n");
+    return SRSRAN_ERROR;
+  }
+
   if (pcap_handle) {
     pcap_handle->close();
   }
@@ -97,6 +97,35 @@ void srsran_agc_set_gain(srsran_agc_t* q, float init_gain_value_db)
   q->gain_db = init_gain_value_db;
 }
 
+void srsran_agc_set_max_nof_samples(srsran_agc_t* q, uint32_t max_nof_samples)
+{
+  if (q) {
+    q->max_nof_samples = max_nof_samples;
+  }
+}
+
+/*
+ * Power estimators on every decimation-th sample, used when the frame exceeds the maximum number of measured samples
+ */
+static float agc_measure_energy_decimated(const cf_t* signal, uint32_t len, uint32_t decimation)
+{
+  float    acc   = 0.0f;
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < len; i += decimation, count++) {
+    acc += __real__ signal[i] * __real__ signal[i] + __imag__ signal[i] * __imag__ signal[i];
+  }
+  return sqrtf(acc / count);
+}
+
+static float agc_measure_peak_decimated(const cf_t* signal, uint32_t len, uint32_t decimation)
+{
+  float y = -INFINITY;
+  for (uint32_t i = 0; i < len; i += decimation) {
+    y = SRSRAN_MAX(y, SRSRAN_MAX(__real__ signal[i], __imag__ signal[i]));
+  }
+  return y;
+}
+
 /*
  * Transition functions
  */
@@ -141,16 +170,27 @@ static inline void agc_run_state_init(srsran_agc_t* q)
 
 static inline void agc_run_state_measure(srsran_agc_t* q, cf_t* signal, uint32_t len)
 {
+  // Measure a decimated frame if it is longer than the limit
+  uint32_t decimation = 1;
+  if (q->max_nof_samples > 0 && len > q->max_nof_samples) {
+    decimation = SRSRAN_CEIL(len, q->max_nof_samples);
+  }
+
   // Perform measurement of the frame
   float  y = 0;
   float* t;
   switch (q->mode) {
     case SRSRAN_AGC_MODE_ENERGY:
-      y = sqrtf(crealf(srsran_vec_dot_prod_conj_ccc(signal, signal, len)) / len);
+      y = (decimation > 1) ? agc_measure_energy_decimated(signal, len, decimation)
+                           : sqrtf(crealf(srsran_vec_dot_prod_conj_ccc(signal, signal, len)) / len);
       break;
     case SRSRAN_AGC_MODE_PEAK_AMPLITUDE:
-      t = (float*)signal;
-      y = t[srsran_vec_max_fi(t, 2 * len)]; // take only positive max to avoid abs() (should be similar)
+      if (decimation > 1) {
+        y = agc_measure_peak_decimated(signal, len, decimation);
+      } else {
+        t = (float*)signal;
+        y = t[srsran_vec_max_fi(t, 2 * len)]; // take only positive max to avoid abs() (should be similar)
+      }
       break;
     default:
       ERROR("Unsupported AGC mode");
@@ -22,10 +22,12 @@
 #include "srsran/phy/ch_estimation/csi_rs.h"
 #include "srsran/phy/common/sequence.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include <complex.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 /**
  * @brief Maximum number of subcarriers occupied by a CSI-RS resource as defined in TS 38.211 Table 7.4.1.5.3-1
@@ -393,6 +395,130 @@ static uint32_t csi_rs_rb_stride(const srsran_csi_rs_resource_mapping_t* m)
   return ret;
 }
 
+/**
+ * @brief CSI-RS resource element table, it contains the subcarriers within an OFDM symbol occupied by a CSI-RS resource
+ * CDM group. It only depends on the frequency domain mapping so it is shared by all the OFDM symbols of the resource
+ * and by any other resource with the same frequency domain mapping.
+ *
+ * Most mappings (i.e. TRS) occupy evenly spaced subcarriers, in which case the resource elements are accessed with a
+ * constant stride. Otherwise, the subcarrier index of every resource element is listed.
+ */
+typedef struct {
+  uint32_t nof_re;   ///< Number of resource elements per OFDM symbol
+  uint32_t seq_skip; ///< Number of sequence values to skip before the first resource element
+  uint32_t k_begin;  ///< Subcarrier index of the first resource element
+  uint32_t k_stride; ///< Subcarrier stride between resource elements, set to 0 if they are not evenly spaced
+  uint32_t k_list[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR]; ///< Subcarrier indexes, only used if k_stride is 0
+} csi_rs_re_table_t;
+
+static int csi_rs_re_table_init(const srsran_carrier_nr_t*              carrier,
+                                const srsran_csi_rs_resource_mapping_t* resource,
+                                uint32_t                                j,
+                                csi_rs_re_table_t*                      table)
+{
+  // Get subcarrier indexes within a PRB
+  uint32_t k_list[CSI_RS_MAX_SUBC_PRB];
+  int      nof_k = csi_rs_location_get_k_list(resource, j, k_list);
+  if (nof_k <= 0) {
+    return SRSRAN_ERROR;
+  }
+
+  // Calculate Resource Block boundaries
+  uint32_t rb_begin  = csi_rs_rb_begin(carrier, resource);
+  uint32_t rb_end    = csi_rs_rb_end(carrier, resource);
+  uint32_t rb_stride = csi_rs_rb_stride(resource);
+  uint32_t nof_rb    = (rb_end > rb_begin) ? SRSRAN_CEIL(rb_end - rb_begin, rb_stride) : 0;
+
+  table->nof_re   = nof_rb * (uint32_t)nof_k;
+  table->seq_skip = 2 * csi_rs_count(resource->density, rb_begin);
+  table->k_begin  = SRSRAN_NRE * rb_begin + k_list[0];
+
+  // Check whether the subcarriers are evenly spaced, including the wrap to the next allocated PRB
+  uint32_t k_period = SRSRAN_NRE * rb_stride;
+  table->k_stride   = (k_list[0] + k_period) - k_list[nof_k - 1];
+  for (uint32_t i = 1; i < (uint32_t)nof_k; i++) {
+    if (k_list[i] - k_list[i - 1] != table->k_stride) {
+      table->k_stride = 0;
+    }
+  }
+
+  // Expand the subcarrier indexes for every allocated PRB
+  if (table->k_stride == 0) {
+    uint32_t count = 0;
+    for (uint32_t n = rb_begin; n < rb_end; n += rb_stride) {
+      for (uint32_t k_idx = 0; k_idx < (uint32_t)nof_k; k_idx++) {
+        table->k_list[count++] = SRSRAN_NRE * n + k_list[k_idx];
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Checks whether two resource mappings occupy the same subcarriers, in other words, if they can share the same
+ * resource element table
+ */
+static bool csi_rs_re_table_match(const srsran_csi_rs_resource_mapping_t* a, const srsran_csi_rs_resource_mapping_t* b)
+{
+  return a->row == b->row && a->nof_ports == b->nof_ports && a->cdm == b->cdm && a->density == b->density &&
+         a->freq_band.start_rb == b->freq_band.start_rb && a->freq_band.nof_rb == b->freq_band.nof_rb &&
+         memcmp(a->frequency_domain_alloc, b->frequency_domain_alloc, sizeof(a->frequency_domain_alloc)) == 0;
+}
+
+static void csi_rs_re_table_get(const csi_rs_re_table_t* table, const cf_t* symbol, cf_t* re)
+{
+  if (table->k_stride != 0) {
+    const cf_t* ptr = &symbol[table->k_begin];
+    for (uint32_t i = 0; i < table->nof_re; i++) {
+      re[i] = ptr[i * table->k_stride];
+    }
+    return;
+  }
+
+  for (uint32_t i = 0; i < table->nof_re; i++) {
+    re[i] = symbol[table->k_list[i]];
+  }
+}
+
+static void csi_rs_re_table_put(const csi_rs_re_table_t* table, const cf_t* re, cf_t* symbol)
+{
+  if (table->k_stride != 0) {
+    cf_t* ptr = &symbol[table->k_begin];
+    for (uint32_t i = 0; i < table->nof_re; i++) {
+      ptr[i * table->k_stride] = re[i];
+    }
+    return;
+  }
+
+  for (uint32_t i = 0; i < table->nof_re; i++) {
+    symbol[table->k_list[i]] = re[i];
+  }
+}
+
+/**
+ * @brief Updates the resource element table for the given resource mapping, unless the table was already computed for
+ * a mapping occupying the same subcarriers
+ */
+static int csi_rs_re_table_update(const srsran_carrier_nr_t*               carrier,
+                                  const srsran_csi_rs_resource_mapping_t*  resource,
+                                  const srsran_csi_rs_resource_mapping_t** table_resource,
+                                  csi_rs_re_table_t*                       table)
+{
+  if (*table_resource != NULL && csi_rs_re_table_match(*table_resource, resource)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Force CDM group to 0
+  if (csi_rs_re_table_init(carrier, resource, 0, table) < SRSRAN_SUCCESS) {
+    *table_resource = NULL;
+    return SRSRAN_ERROR;
+  }
+
+  *table_resource = resource;
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_csi_rs_append_resource_to_pattern(const srsran_carrier_nr_t*              carrier,
                                              const srsran_csi_rs_resource_mapping_t* resource,
                                              srsran_re_pattern_list_t*               re_pattern_list)
@@ -465,9 +591,8 @@ int srsran_csi_rs_nzp_put_resource(const srsran_carrier_nr_t*          carrier,
   // Force CDM group to 0
   uint32_t j = 0;
 
-  uint32_t k_list[CSI_RS_MAX_SUBC_PRB];
-  int      nof_k = csi_rs_location_get_k_list(&resource->resource_mapping, j, k_list);
-  if (nof_k <= 0) {
+  csi_rs_re_table_t table;
+  if (csi_rs_re_table_init(carrier, &resource->resource_mapping, j, &table) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
@@ -477,11 +602,6 @@ int srsran_csi_rs_nzp_put_resource(const srsran_carrier_nr_t*          carrier,
     return SRSRAN_ERROR;
   }
 
-  // Calculate Resource Block boundaries
-  uint32_t rb_begin  = csi_rs_rb_begin(carrier, &resource->resource_mapping);
-  uint32_t rb_end    = csi_rs_rb_end(carrier, &resource->resource_mapping);
-  uint32_t rb_stride = csi_rs_rb_stride(&resource->resource_mapping);
-
   // Calculate power allocation
   float beta = srsran_convert_dB_to_amplitude((float)resource->power_control_offset);
   if (!isnormal(beta)) {
@@ -498,29 +618,14 @@ int srsran_csi_rs_nzp_put_resource(const srsran_carrier_nr_t*          carrier,
     srsran_sequence_state_init(&sequence_state, cinit);
 
     // Skip unallocated RB
-    srsran_sequence_state_advance(&sequence_state, 2 * csi_rs_count(resource->resource_mapping.density, rb_begin));
+    srsran_sequence_state_advance(&sequence_state, table.seq_skip);
 
-    // Temporal R sequence
-    cf_t     r[64];
-    uint32_t r_idx = 64;
+    // Generate the R sequence for the entire OFDM symbol
+    cf_t r[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
+    srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2 * beta, (float*)r, 2 * table.nof_re);
 
-    // Iterate over frequency domain
-    for (uint32_t n = rb_begin; n < rb_end; n += rb_stride) {
-      for (uint32_t k_idx = 0; k_idx < nof_k; k_idx++) {
-        // Calculate sub-carrier index k
-        uint32_t k = SRSRAN_NRE * n + k_list[k_idx];
-
-        // Do we need more r?
-        if (r_idx >= 64) {
-          // ... Generate a bunch of it!
-          srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2 * beta, (float*)r, 64 * 2);
-          r_idx = 0;
-        }
-
-        // Put CSI in grid
-        grid[l * SRSRAN_NRE * carrier->nof_prb + k] = r[r_idx++];
-      }
-    }
+    // Put CSI in grid
+    csi_rs_re_table_put(&table, r, &grid[l * SRSRAN_NRE * carrier->nof_prb]);
   }
 
   return SRSRAN_SUCCESS;
@@ -571,30 +676,13 @@ typedef struct {
 static int csi_rs_nzp_measure_resource(const srsran_carrier_nr_t*          carrier,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_csi_rs_nzp_resource_t* resource,
+                                       const csi_rs_re_table_t*            table,
                                        const cf_t*                         grid,
                                        csi_rs_nzp_resource_measure_t*      measure)
 {
   // Force CDM group to 0
   uint32_t j = 0;
 
-  // Get subcarrier indexes
-  uint32_t k_list[CSI_RS_MAX_SUBC_PRB];
-  int      nof_k = csi_rs_location_get_k_list(&resource->resource_mapping, j, k_list);
-  if (nof_k <= 0) {
-    return SRSRAN_ERROR;
-  }
-
-  // Calculate average CSI-RS RE stride
-  float avg_k_stride = (float)((k_list[0] + SRSRAN_NRE) - k_list[nof_k - 1]);
-  for (uint32_t i = 1; i < (uint32_t)nof_k; i++) {
-    avg_k_stride += (float)(k_list[i] - k_list[i - 1]);
-  }
-  avg_k_stride /= (float)nof_k;
-  if (!isnormal(avg_k_stride)) {
-    ERROR("Invalid avg_k_stride");
-    return SRSRAN_ERROR;
-  }
-
   // Get symbol indexes
   uint32_t l_list[CSI_RS_MAX_SYMBOLS_SLOT];
   int      nof_l = csi_rs_location_get_l_list(&resource->resource_mapping, j, l_list);
@@ -602,13 +690,12 @@ static int csi_rs_nzp_measure_resource(const srsran_carrier_nr_t*          carri
     return SRSRAN_ERROR;
   }
 
-  // Calculate Resource Block boundaries
-  uint32_t rb_begin  = csi_rs_rb_begin(carrier, &resource->resource_mapping);
-  uint32_t rb_end    = csi_rs_rb_end(carrier, &resource->resource_mapping);
-  uint32_t rb_stride = csi_rs_rb_stride(&resource->resource_mapping);
-
-  // Calculate ideal number of RE per symbol
-  uint32_t nof_re = csi_rs_count(resource->resource_mapping.density, rb_end - rb_begin);
+  // Number of RE per symbol
+  uint32_t nof_re = table->nof_re;
+  if (nof_re == 0) {
+    ERROR("No RE available for the CSI-RS resource");
+    return SRSRAN_ERROR;
+  }
 
   // Accumulators
   float epre_acc  = 0.0f;
@@ -629,45 +716,26 @@ static int csi_rs_nzp_measure_resource(const srsran_carrier_nr_t*          carri
     srsran_sequence_state_init(&sequence_state, cinit);
 
     // Skip unallocated RB
-    srsran_sequence_state_advance(&sequence_state, 2 * csi_rs_count(resource->resource_mapping.density, rb_begin));
-
-    // Temporal Least Square Estimates
-    cf_t     lse[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
-    uint32_t count_re = 0;
+    srsran_sequence_state_advance(&sequence_state, table->seq_skip);
 
     // Extract RE
-    for (uint32_t n = rb_begin; n < rb_end; n += rb_stride) {
-      for (uint32_t k_idx = 0; k_idx < nof_k; k_idx++) {
-        // Calculate sub-carrier index k
-        uint32_t k = SRSRAN_NRE * n + k_list[k_idx];
-
-        lse[count_re++] = grid[l * SRSRAN_NRE * carrier->nof_prb + k];
-      }
-    }
-
-    // Verify RE count matches the expected number of RE
-    if (count_re == 0 || count_re != nof_re) {
-      ERROR("Unmatched number of RE (%d != %d)", count_re, nof_re);
-      return SRSRAN_ERROR;
-    }
+    srsran_simd_aligned cf_t lse[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
+    csi_rs_re_table_get(table, &grid[l * SRSRAN_NRE * carrier->nof_prb], lse);
 
     // Compute LSE
-    cf_t r[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
-    srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2, (float*)r, 2 * count_re);
-    srsran_vec_prod_conj_ccc(lse, r, lse, count_re);
+    srsran_simd_aligned cf_t r[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
+    srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2, (float*)r, 2 * nof_re);
+    srsran_vec_prod_conj_ccc(lse, r, lse, nof_re);
 
     // Compute average delay
-    float delay = srsran_vec_estimate_frequency(lse, (int)count_re);
+    float delay = srsran_vec_estimate_frequency(lse, (int)nof_re);
     delay_acc += delay;
 
-    // Pre-compensate delay to avoid RSRP measurements get affected by average delay
-    srsran_vec_apply_cfo(lse, delay, lse, (int)count_re);
+    // Compute EPRE, it is not affected by the delay
+    epre_acc += srsran_vec_avg_power_cf(lse, nof_re);
 
-    // Compute EPRE
-    epre_acc += srsran_vec_avg_power_cf(lse, count_re);
-
-    // Compute correlation
-    corr_acc += srsran_vec_acc_cc(lse, count_re) / (float)count_re;
+    // Compute correlation, the delay is pre-compensated to avoid RSRP measurements get affected by average delay
+    corr_acc += srsran_vec_acc_cfo_cc(lse, delay, (int)nof_re) / (float)nof_re;
   }
 
   // Set measure fields
@@ -689,6 +757,10 @@ static int csi_rs_nzp_measure_set(const srsran_carrier_nr_t*     carrier,
 {
   uint32_t count = 0;
 
+  // Resource element table, shared by consecutive resources with the same frequency domain mapping
+  csi_rs_re_table_t                       table;
+  const srsran_csi_rs_resource_mapping_t* table_resource = NULL;
+
   // Iterate all resources in set
   for (uint32_t i = 0; i < set->count; i++) {
     // Skip resource
@@ -696,8 +768,15 @@ static int csi_rs_nzp_measure_set(const srsran_carrier_nr_t*     carrier,
       continue;
     }
 
+    // Update resource element table
+    if (csi_rs_re_table_update(carrier, &set->data[i].resource_mapping, &table_resource, &table) < SRSRAN_SUCCESS) {
+      ERROR("Error computing NZP-CSI-RS resource element table");
+      return SRSRAN_ERROR;
+    }
+
     // Perform measurement
-    if (csi_rs_nzp_measure_resource(carrier, slot_cfg, &set->data[i], grid, &measurements[count]) < SRSRAN_SUCCESS) {
+    if (csi_rs_nzp_measure_resource(carrier, slot_cfg, &set->data[i], &table, grid, &measurements[count]) <
+        SRSRAN_SUCCESS) {
       ERROR("Error measuring NZP-CSI-RS resource");
       return SRSRAN_ERROR;
     }
@@ -717,8 +796,15 @@ int srsran_csi_rs_nzp_measure(const srsran_carrier_nr_t*          carrier,
     return SRSRAN_ERROR;
   }
 
+  // Force CDM group to 0
+  csi_rs_re_table_t table;
+  if (csi_rs_re_table_init(carrier, &resource->resource_mapping, 0, &table) < SRSRAN_SUCCESS) {
+    ERROR("Error computing NZP-CSI-RS resource element table");
+    return SRSRAN_ERROR;
+  }
+
   csi_rs_nzp_resource_measure_t m = {};
-  if (csi_rs_nzp_measure_resource(carrier, slot_cfg, resource, grid, &m) < SRSRAN_SUCCESS) {
+  if (csi_rs_nzp_measure_resource(carrier, slot_cfg, resource, &table, grid, &m) < SRSRAN_SUCCESS) {
     ERROR("Error measuring NZP-CSI-RS resource");
     return SRSRAN_ERROR;
   }
@@ -920,32 +1006,14 @@ typedef struct {
 } csi_rs_zp_resource_measure_t;
 
 static int csi_rs_zp_measure_resource(const srsran_carrier_nr_t*         carrier,
-                                      const srsran_slot_cfg_t*           slot_cfg,
                                       const srsran_csi_rs_zp_resource_t* resource,
+                                      const csi_rs_re_table_t*           table,
                                       const cf_t*                        grid,
                                       csi_rs_zp_resource_measure_t*      measure)
 {
   // Force CDM group to 0
   uint32_t j = 0;
 
-  // Get subcarrier indexes
-  uint32_t k_list[CSI_RS_MAX_SUBC_PRB];
-  int      nof_k = csi_rs_location_get_k_list(&resource->resource_mapping, j, k_list);
-  if (nof_k <= 0) {
-    return SRSRAN_ERROR;
-  }
-
-  // Calculate average CSI-RS RE stride
-  float avg_k_stride = (float)((k_list[0] + SRSRAN_NRE) - k_list[nof_k - 1]);
-  for (uint32_t i = 1; i < (uint32_t)nof_k; i++) {
-    avg_k_stride += (float)(k_list[i] - k_list[i - 1]);
-  }
-  avg_k_stride /= (float)nof_k;
-  if (!isnormal(avg_k_stride)) {
-    ERROR("Invalid avg_k_stride");
-    return SRSRAN_ERROR;
-  }
-
   // Get symbol indexes
   uint32_t l_list[CSI_RS_MAX_SYMBOLS_SLOT];
   int      nof_l = csi_rs_location_get_l_list(&resource->resource_mapping, j, l_list);
@@ -953,13 +1021,12 @@ static int csi_rs_zp_measure_resource(const srsran_carrier_nr_t*         carrier
     return SRSRAN_ERROR;
   }
 
-  // Calculate Resource Block boundaries
-  uint32_t rb_begin  = csi_rs_rb_begin(carrier, &resource->resource_mapping);
-  uint32_t rb_end    = csi_rs_rb_end(carrier, &resource->resource_mapping);
-  uint32_t rb_stride = csi_rs_rb_stride(&resource->resource_mapping);
-
-  // Calculate ideal number of RE per symbol
-  uint32_t nof_re = csi_rs_count(resource->resource_mapping.density, rb_end - rb_begin);
+  // Number of RE per symbol
+  uint32_t nof_re = table->nof_re;
+  if (nof_re == 0) {
+    ERROR("No RE available for the CSI-RS resource");
+    return SRSRAN_ERROR;
+  }
 
   // Accumulators
   float epre_acc = 0.0f;
@@ -972,28 +1039,12 @@ static int csi_rs_zp_measure_resource(const srsran_carrier_nr_t*         carrier
     // Get symbol index
     uint32_t l = l_list[l_idx];
 
-    // Temporal Least Square Estimates
-    cf_t     temp[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
-    uint32_t count_re = 0;
-
     // Extract RE
-    for (uint32_t n = rb_begin; n < rb_end; n += rb_stride) {
-      for (uint32_t k_idx = 0; k_idx < nof_k; k_idx++) {
-        // Calculate sub-carrier index k
-        uint32_t k = SRSRAN_NRE * n + k_list[k_idx];
-
-        temp[count_re++] = grid[l * SRSRAN_NRE * carrier->nof_prb + k];
-      }
-    }
-
-    // Verify RE count matches the expected number of RE
-    if (count_re == 0 || count_re != nof_re) {
-      ERROR("Unmatched number of RE (%d != %d)", count_re, nof_re);
-      return SRSRAN_ERROR;
-    }
+    srsran_simd_aligned cf_t temp[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
+    csi_rs_re_table_get(table, &grid[l * SRSRAN_NRE * carrier->nof_prb], temp);
 
     // Compute EPRE
-    epre_acc += srsran_vec_avg_power_cf(temp, count_re);
+    epre_acc += srsran_vec_avg_power_cf(temp, nof_re);
   }
 
   // Set measure fields
@@ -1013,6 +1064,10 @@ static int csi_rs_zp_measure_set(const srsran_carrier_nr_t*    carrier,
 {
   uint32_t count = 0;
 
+  // Resource element table, shared by consecutive resources with the same frequency domain mapping
+  csi_rs_re_table_t                       table;
+  const srsran_csi_rs_resource_mapping_t* table_resource = NULL;
+
   // Iterate all resources in set
   for (uint32_t i = 0; i < set->count; i++) {
     // Skip resource
@@ -1020,8 +1075,14 @@ static int csi_rs_zp_measure_set(const srsran_carrier_nr_t*    carrier,
       continue;
     }
 
+    // Update resource element table
+    if (csi_rs_re_table_update(carrier, &set->data[i].resource_mapping, &table_resource, &table) < SRSRAN_SUCCESS) {
+      ERROR("Error computing ZP-CSI-RS resource element table");
+      return SRSRAN_ERROR;
+    }
+
     // Perform measurement
-    if (csi_rs_zp_measure_resource(carrier, slot_cfg, &set->data[i], grid, &measurements[count]) < SRSRAN_SUCCESS) {
+    if (csi_rs_zp_measure_resource(carrier, &set->data[i], &table, grid, &measurements[count]) < SRSRAN_SUCCESS) {
       ERROR("Error measuring NZP-CSI-RS resource");
       return SRSRAN_ERROR;
     }
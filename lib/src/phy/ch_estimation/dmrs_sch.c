@@ -22,6 +22,7 @@
 #include "srsran/phy/ch_estimation/dmrs_sch.h"
 #include "srsran/phy/ch_estimation/csi_rs.h"
 #include "srsran/phy/common/sequence.h"
+#include "srsran/phy/utils/simd.h"
 #include <complex.h>
 #include <srsran/phy/utils/debug.h>
 
@@ -68,38 +69,20 @@ int srsran_dmrs_sch_cfg_to_str(const srsran_dmrs_sch_cfg_t* cfg, char* msg, uint
       msg, max_len, 0, "type=%d, typeA_pos=%d, add_pos=%d, len=%s", type, typeA_pos, additional_pos, len);
 }
 
-static uint32_t
-srsran_dmrs_get_pilots_type1(uint32_t start_prb, uint32_t nof_prb, uint32_t delta, const cf_t* symbols, cf_t* pilots)
-{
-  uint32_t count   = 0;
-  uint32_t n_begin = start_prb * 3;
-  uint32_t n_enb   = n_begin + nof_prb * 3;
-
-  for (uint32_t n = n_begin; n < n_enb; n++) {
-    for (uint32_t k_prime = 0; k_prime < 2; k_prime++, count++) {
-      pilots[count] = symbols[4 * n + 2 * k_prime + delta];
-    }
-  }
-
-  return count;
-}
-
-static uint32_t
-srsran_dmrs_get_pilots_type2(uint32_t start_prb, uint32_t nof_prb, uint32_t delta, const cf_t* symbols, cf_t* pilots)
+/**
+ * @brief Computes the least square estimate of a single pilot, the DMRS sequence is QPSK so the conjugate product
+ * reduces to real multiplications by the signed sequence amplitude
+ */
+static inline cf_t dmrs_sch_lse(cf_t y, const float* seq)
 {
-  uint32_t count   = 0;
-  uint32_t n_begin = start_prb * 2;
-  uint32_t n_enb   = n_begin + nof_prb * 2;
-
-  for (uint32_t n = n_begin; n < n_enb; n++) {
-    for (uint32_t k_prime = 0; k_prime < 2; k_prime++, count++) {
-      pilots[count] = symbols[6 * n + k_prime + delta];
-    }
-  }
-
-  return count;
+  float re = __real__ y * seq[0] + __imag__ y * seq[1];
+  float im = __imag__ y * seq[0] - __real__ y * seq[1];
+  return re + I * im;
 }
 
+/**
+ * @brief Extracts the pilots of a group of contiguous PRB and computes their least square estimates in a single pass
+ */
 static uint32_t srsran_dmrs_get_lse(srsran_dmrs_sch_t*       q,
                                     srsran_sequence_state_t* sequence_state,
                                     srsran_dmrs_sch_type_t   dmrs_type,
@@ -110,25 +93,32 @@ static uint32_t srsran_dmrs_get_lse(srsran_dmrs_sch_t*       q,
                                     const cf_t*              symbols,
                                     cf_t*                    least_square_estimates)
 {
-  uint32_t count = 0;
+  uint32_t     count = 0;
+  const cf_t*  re    = &symbols[start_prb * SRSRAN_NRE + delta];
+  const float* seq   = (const float*)q->temp;
 
   switch (dmrs_type) {
     case srsran_dmrs_sch_type_1:
-      count = srsran_dmrs_get_pilots_type1(start_prb, nof_prb, delta, symbols, least_square_estimates);
+      // One pilot every 2 RE
+      count = nof_prb * SRSRAN_NRE / 2;
+      srsran_sequence_state_gen_f(sequence_state, amplitude, (float*)q->temp, count * 2);
+      for (uint32_t i = 0; i < count; i++) {
+        least_square_estimates[i] = dmrs_sch_lse(re[2 * i], &seq[2 * i]);
+      }
       break;
     case srsran_dmrs_sch_type_2:
-      count = srsran_dmrs_get_pilots_type2(start_prb, nof_prb, delta, symbols, least_square_estimates);
+      // Two consecutive pilots every 6 RE
+      count = nof_prb * SRSRAN_NRE / 3;
+      srsran_sequence_state_gen_f(sequence_state, amplitude, (float*)q->temp, count * 2);
+      for (uint32_t i = 0; i < count; i += 2) {
+        least_square_estimates[i]     = dmrs_sch_lse(re[3 * i], &seq[2 * i]);
+        least_square_estimates[i + 1] = dmrs_sch_lse(re[3 * i + 1], &seq[2 * i + 2]);
+      }
       break;
     default:
       ERROR("Unknown DMRS type.");
   }
 
-  // Generate sequence for the given pilots
-  srsran_sequence_state_gen_f(sequence_state, amplitude, (float*)q->temp, count * 2);
-
-  // Calculate least square estimates
-  srsran_vec_prod_conj_ccc(least_square_estimates, q->temp, least_square_estimates, count);
-
   return count;
 }
 
@@ -558,17 +548,6 @@ static int dmrs_sch_alloc(srsran_dmrs_sch_t* q, uint32_t max_nof_prb)
   }
 
   if (max_nof_prb_changed) {
-    // Resize interpolator only if the number of PRB has increased
-    srsran_interp_linear_free(&q->interpolator_type1);
-    srsran_interp_linear_free(&q->interpolator_type2);
-
-    if (srsran_interp_linear_init(&q->interpolator_type1, max_nof_prb * SRSRAN_NRE / 2, 2) != SRSRAN_SUCCESS) {
-      return SRSRAN_ERROR;
-    }
-    if (srsran_interp_linear_init(&q->interpolator_type2, max_nof_prb * SRSRAN_NRE / 3, 6) != SRSRAN_SUCCESS) {
-      return SRSRAN_ERROR;
-    }
-
     if (q->pilot_estimates) {
       free(q->pilot_estimates);
     }
@@ -619,8 +598,6 @@ void srsran_dmrs_sch_free(srsran_dmrs_sch_t* q)
     return;
   }
 
-  srsran_interp_linear_free(&q->interpolator_type1);
-  srsran_interp_linear_free(&q->interpolator_type2);
   if (q->pilot_estimates) {
     free(q->pilot_estimates);
   }
@@ -762,6 +739,120 @@ static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
   return pilot_count;
 }
 
+/**
+ * @brief Averages the pilot estimates of all DMRS symbols into the first symbol. Every symbol is weighted by a complex
+ * factor, so the CFO phase removal and the normalisation are applied in the same pass.
+ */
+static void dmrs_sch_average(cf_t* pilots, const cf_t* weights, uint32_t nof_symbols, uint32_t nof_pilots)
+{
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t w[SRSRAN_DMRS_SCH_MAX_SYMBOLS];
+  for (uint32_t s = 0; s < nof_symbols; s++) {
+    w[s] = srsran_simd_cf_set1(weights[s]);
+  }
+
+  for (; i + SRSRAN_SIMD_CF_SIZE <= nof_pilots; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_prod(srsran_simd_cfi_loadu(&pilots[i]), w[0]);
+    for (uint32_t s = 1; s < nof_symbols; s++) {
+      acc = srsran_simd_cf_add(acc, srsran_simd_cf_prod(srsran_simd_cfi_loadu(&pilots[nof_pilots * s + i]), w[s]));
+    }
+    srsran_simd_cfi_storeu(&pilots[i], acc);
+  }
+#endif // SRSRAN_SIMD_CF_SIZE
+
+  for (; i < nof_pilots; i++) {
+    cf_t acc = pilots[i] * weights[0];
+    for (uint32_t s = 1; s < nof_symbols; s++) {
+      acc += pilots[nof_pilots * s + i] * weights[s];
+    }
+    pilots[i] = acc;
+  }
+}
+
+#if DMRS_SCH_SMOOTH_FILTER_LEN
+/**
+ * @brief Gets the pilot k for the smoothing filter, the pilots out of range are extrapolated as srsran_conv_same_cf
+ * does
+ */
+static inline cf_t dmrs_sch_smooth_pilot(const cf_t* in, uint32_t len, int k)
+{
+  if (k < 0) {
+    return in[0] + (float)(2 - k) * (in[1] - in[0]);
+  }
+
+  if (k >= (int)len) {
+    int n = k - (int)len + DMRS_SCH_SMOOTH_FILTER_LEN - DMRS_SCH_SMOOTH_FILTER_LEN / 2;
+    return in[len - 1] + (float)n * (in[len - 1] - in[len - 2]);
+  }
+
+  return in[k];
+}
+
+static inline cf_t dmrs_sch_smooth_sample(const cf_t* in, const float* filter, uint32_t len, int i)
+{
+  cf_t y = 0.0f;
+  for (int k = 0; k < DMRS_SCH_SMOOTH_FILTER_LEN; k++) {
+    y += filter[k] * dmrs_sch_smooth_pilot(in, len, i - DMRS_SCH_SMOOTH_FILTER_LEN / 2 + k);
+  }
+  return y;
+}
+
+/**
+ * @brief Applies the smoothing filter over the pilot estimates, the input and output shall not overlap
+ */
+static void dmrs_sch_smooth(const cf_t* in, const float* filter, cf_t* out, uint32_t len)
+{
+  const uint32_t half = DMRS_SCH_SMOOTH_FILTER_LEN / 2;
+  uint32_t       i    = 0;
+
+  // Leading pilots require extrapolation
+  for (; i < SRSRAN_MIN(half, len); i++) {
+    out[i] = dmrs_sch_smooth_sample(in, filter, len, (int)i);
+  }
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_f_t h[DMRS_SCH_SMOOTH_FILTER_LEN];
+  for (uint32_t k = 0; k < DMRS_SCH_SMOOTH_FILTER_LEN; k++) {
+    h[k] = srsran_simd_f_set1(filter[k]);
+  }
+
+  for (; i + SRSRAN_SIMD_CF_SIZE + half <= len; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_zero();
+    for (uint32_t k = 0; k < DMRS_SCH_SMOOTH_FILTER_LEN; k++) {
+      acc = srsran_simd_cf_add(acc, srsran_simd_cf_mul(srsran_simd_cfi_loadu(&in[i - half + k]), h[k]));
+    }
+    srsran_simd_cfi_storeu(&out[i], acc);
+  }
+#endif // SRSRAN_SIMD_CF_SIZE
+
+  // Remainder and trailing pilots
+  for (; i < len; i++) {
+    out[i] = dmrs_sch_smooth_sample(in, filter, len, (int)i);
+  }
+}
+#endif // DMRS_SCH_SMOOTH_FILTER_LEN
+
+/**
+ * @brief Interpolates linearly in frequency domain pilots spaced stride RE apart, starting at the first RE. The RE
+ * after the last pilot are extrapolated from the last two pilots.
+ */
+static void dmrs_sch_interpolate(const cf_t* pilots, uint32_t nof_pilots, uint32_t stride, cf_t* ce)
+{
+  float step = 1.0f / (float)stride;
+
+  for (uint32_t i = 0; i < nof_pilots; i++) {
+    cf_t p    = pilots[i];
+    cf_t diff = (i + 1 < nof_pilots) ? pilots[i + 1] - p : p - pilots[i - 1];
+    diff *= step;
+
+    for (uint32_t j = 0; j < stride; j++) {
+      ce[stride * i + j] = p + (float)j * diff;
+    }
+  }
+}
+
 int srsran_dmrs_sch_estimate(srsran_dmrs_sch_t*           q,
                              const srsran_slot_cfg_t*     slot,
                              const srsran_sch_cfg_nr_t*   cfg,
@@ -895,15 +986,6 @@ int srsran_dmrs_sch_estimate(srsran_dmrs_sch_t*           q,
       float arg         = arg0 + 2.0f * M_PI * cfo_avg_hz * srsran_symbol_distance_s(0, l, q->carrier.scs);
       cfo_correction[l] = cexpf(I * arg);
     }
-
-    // Remove CFO phases
-    for (uint32_t i = 0; i < nof_symbols; i++) {
-      uint32_t l = symbols[i];
-      srsran_vec_sc_prod_ccc(&q->pilot_estimates[nof_pilots_x_symbol * i],
-                             conjf(cfo_correction[l]),
-                             &q->pilot_estimates[nof_pilots_x_symbol * i],
-                             nof_pilots_x_symbol);
-    }
   }
 #endif // DMRS_SCH_CFO_PRECOMPENSATE
 
@@ -913,44 +995,28 @@ int srsran_dmrs_sch_estimate(srsran_dmrs_sch_t*           q,
        cfo_avg_hz,
        chest_res->sync_error * 1e6);
 
-  // Average over time, only if more than one DMRS symbol
-  for (uint32_t i = 1; i < nof_symbols; i++) {
-    srsran_vec_sum_ccc(
-        q->pilot_estimates, &q->pilot_estimates[nof_pilots_x_symbol * i], q->pilot_estimates, nof_pilots_x_symbol);
-  }
-  if (nof_symbols > 0) {
-    srsran_vec_sc_prod_cfc(q->pilot_estimates, 1.0f / (float)nof_symbols, q->pilot_estimates, nof_pilots_x_symbol);
+  // Average over time, the CFO phase of every DMRS symbol is removed while averaging
+  cf_t avg_weights[SRSRAN_DMRS_SCH_MAX_SYMBOLS];
+  for (uint32_t i = 0; i < nof_symbols; i++) {
+#if DMRS_SCH_CFO_PRECOMPENSATE
+    avg_weights[i] = conjf(cfo_correction[symbols[i]]) / (float)nof_symbols;
+#else  // DMRS_SCH_CFO_PRECOMPENSATE
+    avg_weights[i] = 1.0f / (float)nof_symbols;
+#endif // DMRS_SCH_CFO_PRECOMPENSATE
   }
+  dmrs_sch_average(q->pilot_estimates, avg_weights, nof_symbols, nof_pilots_x_symbol);
+  cf_t* pilots = q->pilot_estimates;
 
 #if DMRS_SCH_SMOOTH_FILTER_LEN
-  // Apply smoothing filter
-  srsran_conv_same_cf(
-      q->pilot_estimates, q->filter, q->pilot_estimates, nof_pilots_x_symbol, DMRS_SCH_SMOOTH_FILTER_LEN);
+  // Apply smoothing filter, the result is stored after the averaged pilots
+  pilots = &q->pilot_estimates[nof_pilots_x_symbol];
+  dmrs_sch_smooth(q->pilot_estimates, q->filter, pilots, nof_pilots_x_symbol);
 #endif // DMRS_SCH_SMOOTH_FILTER_LEN
 
   // Frequency domain interpolate
-  uint32_t nof_re_x_symbol =
-      (dmrs_cfg->type == srsran_dmrs_sch_type_1) ? nof_pilots_x_symbol * 2 : nof_pilots_x_symbol * 3;
-  if (dmrs_cfg->type == srsran_dmrs_sch_type_1) {
-    // Prepare interpolator
-    if (srsran_interp_linear_resize(&q->interpolator_type1, nof_pilots_x_symbol, 2) < SRSRAN_SUCCESS) {
-      ERROR("Resizing interpolator nof_pilots_x_symbol=%d; M=%d;", nof_pilots_x_symbol, 2);
-      return SRSRAN_ERROR;
-    }
-
-    // Interpolate
-    srsran_interp_linear_offset(&q->interpolator_type1, q->pilot_estimates, ce, delta, 2 - delta);
-
-  } else {
-    // Prepare interpolator
-    if (srsran_interp_linear_resize(&q->interpolator_type2, nof_pilots_x_symbol, 3) < SRSRAN_SUCCESS) {
-      ERROR("Resizing interpolator nof_pilots_x_symbol=%d; M=%d;", nof_pilots_x_symbol, 3);
-      return SRSRAN_ERROR;
-    }
-
-    // Interpolate
-    srsran_interp_linear_offset(&q->interpolator_type2, q->pilot_estimates, ce, delta, 3 - delta);
-  }
+  uint32_t dmrs_re_stride  = (dmrs_cfg->type == srsran_dmrs_sch_type_1) ? 2 : 3;
+  uint32_t nof_re_x_symbol = nof_pilots_x_symbol * dmrs_re_stride;
+  dmrs_sch_interpolate(pilots, nof_pilots_x_symbol, dmrs_re_stride, ce);
 
 #if DMRS_SCH_SYNC_PRECOMPENSATE
   // Remove synchronization error pre-compensation
@@ -962,6 +1028,23 @@ int srsran_dmrs_sch_estimate(srsran_dmrs_sch_t*           q,
   // Time domain hold, extract resource elements estimates for PDSCH
   uint32_t count = 0;
   for (uint32_t l = grant->S; l < grant->S + grant->L; l++) {
+    // Check whether any RE is reserved in the symbol
+    bool has_rvd = (l < SRSRAN_NSYMB_PER_SLOT_NR) ? dmrs_pattern.symbol[l] : true;
+    for (uint32_t i = 0; i < cfg->rvd_re.count && !has_rvd; i++) {
+      has_rvd = cfg->rvd_re.data[i].symbol[l];
+    }
+
+    // Copy the whole symbol estimates if no RE is reserved
+    if (!has_rvd) {
+#if DMRS_SCH_CFO_PRECOMPENSATE
+      srsran_vec_sc_prod_ccc(ce, cfo_correction[l], &chest_res->ce[0][0][count], nof_re_x_symbol);
+#else  // DMRS_SCH_CFO_PRECOMPENSATE
+      srsran_vec_cf_copy(&chest_res->ce[0][0][count], ce, nof_re_x_symbol);
+#endif // DMRS_SCH_CFO_PRECOMPENSATE
+      count += nof_re_x_symbol;
+      continue;
+    }
+
     // Initialise reserved mask
     bool rvd_mask_wb[SRSRAN_NRE * SRSRAN_MAX_PRB_NR] = {};
 
@@ -241,6 +241,92 @@ static int run_test(srsran_dmrs_sch_t*           dmrs_pdsch,
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * Interpolates the smoothed pilots of a type 1 DMRS symbol as the estimator does, the RE after the last pilot are
+ * extrapolated from the last two pilots
+ */
+static void interpolate_type1(const cf_t* pilots, uint32_t nof_pilots, cf_t* ce)
+{
+  for (uint32_t i = 0; i < nof_pilots; i++) {
+    cf_t diff     = (i + 1 < nof_pilots) ? pilots[i + 1] - pilots[i] : pilots[i] - pilots[i - 1];
+    ce[2 * i]     = pilots[i];
+    ce[2 * i + 1] = pilots[i] + diff / 2.0f;
+  }
+}
+
+static float mean_error(const cf_t* a, const cf_t* b, uint32_t nof_re)
+{
+  float err = 0.0f;
+  for (uint32_t i = 0; i < nof_re; i++) {
+    err += cabsf(a[i] - b[i]);
+  }
+  return err / (float)nof_re;
+}
+
+/**
+ * Estimates a frequency selective channel and compares the result with a reference chain that applies the smoothing
+ * filter out of place. Filtering the pilots in place feeds the already smoothed pilots back into the filter, the test
+ * also checks that such an in place reference does not match.
+ */
+static int run_smoothing_test(srsran_dmrs_sch_t* dmrs_pdsch, cf_t* sf_symbols, srsran_chest_dl_res_t* chest_res)
+{
+  srsran_slot_cfg_t     slot_cfg  = {};
+  srsran_sch_cfg_nr_t   pdsch_cfg = {};
+  srsran_sch_grant_nr_t grant     = {};
+
+  pdsch_cfg.dmrs.type                    = srsran_dmrs_sch_type_1;
+  pdsch_cfg.dmrs.typeA_pos               = srsran_dmrs_sch_typeA_pos_2;
+  pdsch_cfg.dmrs.additional_pos          = srsran_dmrs_sch_add_pos_0;
+  pdsch_cfg.dmrs.length                  = srsran_dmrs_sch_len_1;
+  grant.nof_dmrs_cdm_groups_without_data = 1;
+  for (uint32_t i = 0; i < carrier.nof_prb; i++) {
+    grant.prb_idx[i] = true;
+  }
+  TESTASSERT(srsran_ra_dl_nr_time_default_A(0, pdsch_cfg.dmrs.typeA_pos, &grant) == SRSRAN_SUCCESS);
+
+  // Real and positive channel, so that neither synchronization error nor CFO is estimated
+  uint32_t nof_re_x_symbol = carrier.nof_prb * SRSRAN_NRE;
+  cf_t     channel[SRSRAN_NRE * SRSRAN_MAX_PRB_NR];
+  for (uint32_t k = 0; k < nof_re_x_symbol; k++) {
+    channel[k] = 1.0f + 0.5f * cosf(2.0f * (float)M_PI * (float)k / 16.0f);
+  }
+
+  srsran_vec_cf_zero(sf_symbols, nof_re_x_symbol * SRSRAN_NSYMB_PER_SLOT_NR);
+  TESTASSERT(srsran_dmrs_sch_put_sf(dmrs_pdsch, &slot_cfg, &pdsch_cfg, &grant, sf_symbols) == SRSRAN_SUCCESS);
+  for (uint32_t l = 0; l < SRSRAN_NSYMB_PER_SLOT_NR; l++) {
+    srsran_vec_prod_ccc(&sf_symbols[nof_re_x_symbol * l], channel, &sf_symbols[nof_re_x_symbol * l], nof_re_x_symbol);
+  }
+  TESTASSERT(srsran_dmrs_sch_estimate(dmrs_pdsch, &slot_cfg, &pdsch_cfg, &grant, sf_symbols, chest_res) ==
+             SRSRAN_SUCCESS);
+
+  // The last symbol of the grant carries no DMRS and is the last group of estimates
+  TESTASSERT(chest_res->nof_re >= nof_re_x_symbol);
+  const cf_t* ce = &chest_res->ce[0][0][chest_res->nof_re - nof_re_x_symbol];
+
+  // Type 1 DMRS pilots are in even subcarriers
+  uint32_t nof_pilots = nof_re_x_symbol / 2;
+  cf_t     pilots[SRSRAN_NRE * SRSRAN_MAX_PRB_NR / 2];
+  cf_t     smoothed[SRSRAN_NRE * SRSRAN_MAX_PRB_NR / 2];
+  cf_t     ref[SRSRAN_NRE * SRSRAN_MAX_PRB_NR];
+  float    filter[5];
+  for (uint32_t i = 0; i < nof_pilots; i++) {
+    pilots[i] = channel[2 * i];
+  }
+  srsran_chest_set_smooth_filter_gauss(filter, 4, 2);
+
+  // Out of place smoothing matches the estimator
+  srsran_conv_same_cf(pilots, filter, smoothed, nof_pilots, 5);
+  interpolate_type1(smoothed, nof_pilots, ref);
+  TESTASSERT(mean_error(ce, ref, nof_re_x_symbol) < 1e-4f);
+
+  // In place smoothing does not
+  srsran_conv_same_cf(pilots, filter, pilots, nof_pilots, 5);
+  interpolate_type1(pilots, nof_pilots, ref);
+  TESTASSERT(mean_error(ce, ref, nof_re_x_symbol) > 1e-2f);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   int ret = SRSRAN_ERROR;
@@ -275,6 +361,13 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  if (run_smoothing_test(&dmrs_pdsch, sf_symbols, &chest_dl_res) == SRSRAN_SUCCESS) {
+    test_passed++;
+  } else {
+    ERROR("Smoothing test failed.");
+  }
+  test_counter++;
+
   // For each DCI m param
   for (uint32_t m = 0; m < 16; m++) {
     srsran_dmrs_sch_type_t type_begin = srsran_dmrs_sch_type_1;
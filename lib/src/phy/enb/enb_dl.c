@@ -391,6 +391,24 @@ void srsran_enb_dl_put_phich(srsran_enb_dl_t* q, srsran_phich_grant_t* grant, bo
   srsran_phich_encode(&q->phich, &q->dl_sf, resource, ack, q->sf_symbols);
 }
 
+int srsran_enb_dl_put_phich_batch(srsran_enb_dl_t* q, srsran_phich_grant_t* grants, const bool* acks, uint32_t nof_acks)
+{
+  srsran_phich_ack_t phich_acks[SRSRAN_PHICH_MAX_NOF_ACKS];
+
+  // The encoding is additive, so repeated resources beyond the maximum are simply encoded in another batch
+  for (uint32_t i = 0; i < nof_acks; i += SRSRAN_PHICH_MAX_NOF_ACKS) {
+    uint32_t n = SRSRAN_MIN(nof_acks - i, SRSRAN_PHICH_MAX_NOF_ACKS);
+    for (uint32_t j = 0; j < n; j++) {
+      srsran_phich_calc(&q->phich, &grants[i + j], &phich_acks[j].resource);
+      phich_acks[j].ack = acks[i + j];
+    }
+    if (srsran_phich_encode_batch(&q->phich, &q->dl_sf, phich_acks, n, q->sf_symbols) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 bool srsran_enb_dl_location_is_common_ncce(srsran_enb_dl_t* q, const srsran_dci_location_t* loc)
 {
   if (SRSRAN_CFI_ISVALID(q->dl_sf.cfi)) {
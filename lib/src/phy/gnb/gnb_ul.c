@@ -205,6 +205,37 @@ int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
   return SRSRAN_SUCCESS;
 }
 
+static int gnb_ul_estimate_pucch(srsran_gnb_ul_t*                    q,
+                                 const srsran_slot_cfg_t*            slot_cfg,
+                                 const srsran_pucch_nr_common_cfg_t* cfg,
+                                 const srsran_pucch_nr_resource_t*   resource)
+{
+  switch (resource->format) {
+    case SRSRAN_PUCCH_NR_FORMAT_1:
+      if (srsran_dmrs_pucch_format1_estimate(&q->pucch, cfg, slot_cfg, resource, q->sf_symbols[0], &q->chest_pucch) <
+          SRSRAN_SUCCESS) {
+        ERROR("Error in PUCCH format 1 estimation");
+        return SRSRAN_ERROR;
+      }
+      break;
+    case SRSRAN_PUCCH_NR_FORMAT_2:
+      if (srsran_dmrs_pucch_format2_estimate(&q->pucch, cfg, slot_cfg, resource, q->sf_symbols[0], &q->chest_pucch) <
+          SRSRAN_SUCCESS) {
+        ERROR("Error in PUCCH format 2 estimation");
+        return SRSRAN_ERROR;
+      }
+      break;
+    case SRSRAN_PUCCH_NR_FORMAT_0:
+    case SRSRAN_PUCCH_NR_FORMAT_3:
+    case SRSRAN_PUCCH_NR_FORMAT_4:
+    case SRSRAN_PUCCH_NR_FORMAT_ERROR:
+      ERROR("Invalid or not implemented PUCCH-NR format %d", (int)resource->format);
+      return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 static int gnb_ul_decode_pucch_format1(srsran_gnb_ul_t*                    q,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_pucch_nr_common_cfg_t* cfg,
@@ -224,13 +255,6 @@ static int gnb_ul_decode_pucch_format1(srsran_gnb_ul_t*                    q,
     nof_bits = 1;
   }
 
-  // Channel estimation
-  if (srsran_dmrs_pucch_format1_estimate(&q->pucch, cfg, slot_cfg, resource, q->sf_symbols[0], &q->chest_pucch) <
-      SRSRAN_SUCCESS) {
-    ERROR("Error in PUCCH format 1 estimation");
-    return SRSRAN_ERROR;
-  }
-
   // Actual decode
   float norm_corr = 0.0f;
   if (srsran_pucch_nr_format1_decode(
@@ -263,12 +287,6 @@ static int gnb_ul_decode_pucch_format2(srsran_gnb_ul_t*                    q,
                                        const srsran_uci_cfg_nr_t*          uci_cfg,
                                        srsran_uci_value_nr_t*              uci_value)
 {
-  if (srsran_dmrs_pucch_format2_estimate(&q->pucch, cfg, slot_cfg, resource, q->sf_symbols[0], &q->chest_pucch) <
-      SRSRAN_SUCCESS) {
-    ERROR("Error in PUCCH format 2 estimation");
-    return SRSRAN_ERROR;
-  }
-
   if (srsran_pucch_nr_format_2_3_4_decode(
           &q->pucch, cfg, slot_cfg, resource, uci_cfg, &q->chest_pucch, q->sf_symbols[0], uci_value) < SRSRAN_SUCCESS) {
     ERROR("Error in PUCCH format 2 decoding");
@@ -278,19 +296,17 @@ static int gnb_ul_decode_pucch_format2(srsran_gnb_ul_t*                    q,
   return SRSRAN_SUCCESS;
 }
 
-int srsran_gnb_ul_get_pucch(srsran_gnb_ul_t*                    q,
-                            const srsran_slot_cfg_t*            slot_cfg,
-                            const srsran_pucch_nr_common_cfg_t* cfg,
-                            const srsran_pucch_nr_resource_t*   resource,
-                            const srsran_uci_cfg_nr_t*          uci_cfg,
-                            srsran_uci_value_nr_t*              uci_value,
-                            srsran_csi_trs_measurements_t*      meas)
+/**
+ * @brief Decodes a PUCCH transmission using the last channel estimate
+ */
+static int gnb_ul_decode_pucch(srsran_gnb_ul_t*                    q,
+                               const srsran_slot_cfg_t*            slot_cfg,
+                               const srsran_pucch_nr_common_cfg_t* cfg,
+                               const srsran_pucch_nr_resource_t*   resource,
+                               const srsran_uci_cfg_nr_t*          uci_cfg,
+                               srsran_uci_value_nr_t*              uci_value,
+                               srsran_csi_trs_measurements_t*      meas)
 {
-  if (q == NULL || slot_cfg == NULL || cfg == NULL || resource == NULL || uci_cfg == NULL || uci_value == NULL) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
-  // Estimate channel
   switch (resource->format) {
     case SRSRAN_PUCCH_NR_FORMAT_1:
       if (gnb_ul_decode_pucch_format1(q, slot_cfg, cfg, resource, uci_cfg, uci_value) < SRSRAN_SUCCESS) {
@@ -328,6 +344,102 @@ int srsran_gnb_ul_get_pucch(srsran_gnb_ul_t*                    q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_gnb_ul_get_pucch(srsran_gnb_ul_t*                    q,
+                            const srsran_slot_cfg_t*            slot_cfg,
+                            const srsran_pucch_nr_common_cfg_t* cfg,
+                            const srsran_pucch_nr_resource_t*   resource,
+                            const srsran_uci_cfg_nr_t*          uci_cfg,
+                            srsran_uci_value_nr_t*              uci_value,
+                            srsran_csi_trs_measurements_t*      meas)
+{
+  if (q == NULL || slot_cfg == NULL || cfg == NULL || resource == NULL || uci_cfg == NULL || uci_value == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Estimate channel
+  if (gnb_ul_estimate_pucch(q, slot_cfg, cfg, resource) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  return gnb_ul_decode_pucch(q, slot_cfg, cfg, resource, uci_cfg, uci_value, meas);
+}
+
+/**
+ * @brief Checks whether two PUCCH candidates carry the same DMRS, in other words, if they can share the channel estimate
+ */
+static bool gnb_ul_pucch_same_dmrs(const srsran_gnb_ul_pucch_candidate_t* a, const srsran_gnb_ul_pucch_candidate_t* b)
+{
+  const srsran_pucch_nr_common_cfg_t* cfg_a = a->cfg;
+  const srsran_pucch_nr_common_cfg_t* cfg_b = b->cfg;
+  const srsran_pucch_nr_resource_t*   res_a = a->resource;
+  const srsran_pucch_nr_resource_t*   res_b = b->resource;
+
+  // Common configuration parameters used for the DMRS sequence
+  if (cfg_a != cfg_b &&
+      (cfg_a->group_hopping != cfg_b->group_hopping || cfg_a->hopping_id_present != cfg_b->hopping_id_present ||
+       cfg_a->hopping_id != cfg_b->hopping_id || cfg_a->scrambling_id_present != cfg_b->scrambling_id_present ||
+       cfg_a->scambling_id != cfg_b->scambling_id)) {
+    return false;
+  }
+
+  // Resource allocation
+  return res_a == res_b ||
+         (res_a->format == res_b->format && res_a->starting_prb == res_b->starting_prb &&
+          res_a->intra_slot_hopping == res_b->intra_slot_hopping && res_a->second_hop_prb == res_b->second_hop_prb &&
+          res_a->nof_symbols == res_b->nof_symbols && res_a->start_symbol_idx == res_b->start_symbol_idx &&
+          res_a->initial_cyclic_shift == res_b->initial_cyclic_shift &&
+          res_a->time_domain_occ == res_b->time_domain_occ && res_a->nof_prb == res_b->nof_prb &&
+          res_a->occ_lenth == res_b->occ_lenth && res_a->occ_index == res_b->occ_index &&
+          res_a->additional_dmrs == res_b->additional_dmrs);
+}
+
+int srsran_gnb_ul_get_pucch_batch(srsran_gnb_ul_t*                 q,
+                                  const srsran_slot_cfg_t*         slot_cfg,
+                                  srsran_gnb_ul_pucch_candidate_t* candidates,
+                                  uint32_t                         nof_candidates)
+{
+  if (q == NULL || slot_cfg == NULL || (candidates == NULL && nof_candidates > 0)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < nof_candidates; i++) {
+    const srsran_gnb_ul_pucch_candidate_t* c = &candidates[i];
+    if (c->cfg == NULL || c->resource == NULL || c->uci_cfg == NULL || c->uci_value == NULL) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  for (uint32_t i = 0; i < nof_candidates; i++) {
+    // Skip candidate if it was already decoded along with a previous candidate carrying the same DMRS
+    bool decoded = false;
+    for (uint32_t j = 0; j < i && !decoded; j++) {
+      decoded = gnb_ul_pucch_same_dmrs(&candidates[j], &candidates[i]);
+    }
+    if (decoded) {
+      continue;
+    }
+
+    // Estimate channel once for all the candidates carrying the same DMRS
+    if (gnb_ul_estimate_pucch(q, slot_cfg, candidates[i].cfg, candidates[i].resource) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    // Decode this and the following candidates sharing the estimate
+    for (uint32_t j = i; j < nof_candidates; j++) {
+      srsran_gnb_ul_pucch_candidate_t* c = &candidates[j];
+      if (j != i && !gnb_ul_pucch_same_dmrs(&candidates[i], c)) {
+        continue;
+      }
+
+      if (gnb_ul_decode_pucch(q, slot_cfg, c->cfg, c->resource, c->uci_cfg, c->uci_value, c->meas) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 uint32_t srsran_gnb_ul_pucch_info(srsran_gnb_ul_t*                     q,
                                   const srsran_pucch_nr_resource_t*    resource,
                                   const srsran_uci_data_nr_t*          uci_data,
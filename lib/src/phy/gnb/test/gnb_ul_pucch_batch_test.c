@@ -0,0 +1,263 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/ch_estimation/dmrs_pucch.h"
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/gnb/gnb_ul.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+
+static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
+static float               snr_db  = 20.0f;
+static uint16_t            rnti    = 0x4601;
+
+#define NOF_CANDIDATES 8
+
+static int test_pucch_batch(srsran_gnb_ul_t* gnb_ul, srsran_pucch_nr_t* pucch_tx, srsran_channel_awgn_t* awgn)
+{
+  srsran_slot_cfg_t            slot       = {};
+  srsran_pucch_nr_common_cfg_t common_cfg = {};
+  cf_t*                        grid       = gnb_ul->sf_symbols[0];
+
+  // Two format 1 resources in the same PRB with different cyclic shift, so they only differ in the DMRS sequence
+  srsran_pucch_nr_resource_t f1_a = {};
+  f1_a.format                     = SRSRAN_PUCCH_NR_FORMAT_1;
+  f1_a.starting_prb               = 0;
+  f1_a.nof_symbols                = 14;
+  f1_a.start_symbol_idx           = 0;
+  f1_a.initial_cyclic_shift       = 0;
+  srsran_pucch_nr_resource_t f1_b = f1_a;
+  f1_b.initial_cyclic_shift       = 6;
+
+  // Format 1 resource with intra slot frequency hopping and time domain OCC
+  srsran_pucch_nr_resource_t f1_hop = {};
+  f1_hop.format                     = SRSRAN_PUCCH_NR_FORMAT_1;
+  f1_hop.starting_prb               = 5;
+  f1_hop.intra_slot_hopping         = true;
+  f1_hop.second_hop_prb             = 20;
+  f1_hop.nof_symbols                = 10;
+  f1_hop.start_symbol_idx           = 4;
+  f1_hop.initial_cyclic_shift       = 3;
+  f1_hop.time_domain_occ            = 1;
+
+  // Format 2 resource, and a copy of it in another object that shares the DMRS without sharing the pointer
+  srsran_pucch_nr_resource_t f2 = {};
+  f2.format                     = SRSRAN_PUCCH_NR_FORMAT_2;
+  f2.starting_prb               = 10;
+  f2.nof_prb                    = 2;
+  f2.nof_symbols                = 2;
+  f2.start_symbol_idx           = 12;
+  f2.max_code_rate              = 2;
+  srsran_pucch_nr_resource_t f2_copy = f2;
+
+  // UCI payload hypotheses, with and without SR
+  srsran_uci_cfg_nr_t ack1 = {};
+  ack1.ack.count           = 1;
+  ack1.pucch.rnti          = rnti;
+  srsran_uci_cfg_nr_t ack1_sr = ack1;
+  ack1_sr.o_sr                = 1;
+  ack1_sr.sr_positive_present = true;
+  srsran_uci_cfg_nr_t ack2    = ack1;
+  ack2.ack.count              = 2;
+  srsran_uci_cfg_nr_t ack4    = ack1;
+  ack4.ack.count              = 4;
+  srsran_uci_cfg_nr_t ack4_sr = ack4;
+  ack4_sr.o_sr                = 1;
+
+  // Transmit on the first format 1 resource, on the hopping resource and on the format 2 resource. Nothing is
+  // transmitted on the second format 1 resource.
+  srsran_vec_cf_zero(grid, SRSRAN_SLOT_LEN_RE_NR(carrier.nof_prb));
+  uint8_t b_a[1]   = {1};
+  uint8_t b_hop[2] = {1, 0};
+  TESTASSERT(srsran_pucch_nr_format1_encode(pucch_tx, &common_cfg, &slot, &f1_a, b_a, 1, grid) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_dmrs_pucch_format1_put(pucch_tx, &carrier, &common_cfg, &slot, &f1_a, grid) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_pucch_nr_format1_encode(pucch_tx, &common_cfg, &slot, &f1_hop, b_hop, 2, grid) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(srsran_dmrs_pucch_format1_put(pucch_tx, &carrier, &common_cfg, &slot, &f1_hop, grid) == SRSRAN_SUCCESS);
+
+  srsran_uci_value_nr_t f2_value = {};
+  for (uint32_t i = 0; i < ack4.ack.count; i++) {
+    f2_value.ack[i] = (uint8_t)(i % 3 == 0);
+  }
+  TESTASSERT(srsran_pucch_nr_format_2_3_4_encode(pucch_tx, &common_cfg, &slot, &f2, &ack4, &f2_value, grid) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(srsran_dmrs_pucch_format2_put(pucch_tx, &carrier, &common_cfg, &slot, &f2, grid) == SRSRAN_SUCCESS);
+
+  srsran_channel_awgn_run_c(awgn, grid, grid, SRSRAN_SLOT_LEN_RE_NR(carrier.nof_prb));
+
+  // Candidates are interleaved, so that the ones sharing the DMRS are not contiguous
+  const srsran_pucch_nr_resource_t* resources[NOF_CANDIDATES] = {
+      &f1_a, &f1_hop, &f2, &f1_a, &f1_b, &f2_copy, &f1_hop, &f1_b};
+  const srsran_uci_cfg_nr_t* uci_cfgs[NOF_CANDIDATES] = {
+      &ack1, &ack2, &ack4, &ack1_sr, &ack1, &ack4_sr, &ack1_sr, &ack1_sr};
+
+  srsran_gnb_ul_pucch_candidate_t candidates[NOF_CANDIDATES] = {};
+  srsran_uci_value_nr_t           batch_value[NOF_CANDIDATES] = {};
+  srsran_csi_trs_measurements_t   batch_meas[NOF_CANDIDATES]  = {};
+  for (uint32_t i = 0; i < NOF_CANDIDATES; i++) {
+    candidates[i].cfg       = &common_cfg;
+    candidates[i].resource  = resources[i];
+    candidates[i].uci_cfg   = uci_cfgs[i];
+    candidates[i].uci_value = &batch_value[i];
+    candidates[i].meas      = &batch_meas[i];
+  }
+  TESTASSERT(srsran_gnb_ul_get_pucch_batch(gnb_ul, &slot, candidates, NOF_CANDIDATES) == SRSRAN_SUCCESS);
+
+  // Every candidate must match the result of decoding it on its own
+  for (uint32_t i = 0; i < NOF_CANDIDATES; i++) {
+    srsran_uci_value_nr_t         value = {};
+    srsran_csi_trs_measurements_t meas  = {};
+    TESTASSERT(srsran_gnb_ul_get_pucch(gnb_ul, &slot, &common_cfg, resources[i], uci_cfgs[i], &value, &meas) ==
+               SRSRAN_SUCCESS);
+
+    INFO("candidate=%d; format=%d; valid=%c; rsrp=%+.2f; snr=%+.2f;",
+         i,
+         resources[i]->format,
+         value.valid ? 'y' : 'n',
+         meas.rsrp_dB,
+         meas.snr_dB);
+
+    TESTASSERT(batch_value[i].valid == value.valid);
+    TESTASSERT(batch_value[i].sr == value.sr);
+    for (uint32_t j = 0; j < uci_cfgs[i]->ack.count; j++) {
+      TESTASSERT(batch_value[i].ack[j] == value.ack[j]);
+    }
+    TESTASSERT(batch_meas[i].rsrp == meas.rsrp);
+    TESTASSERT(batch_meas[i].epre == meas.epre);
+    TESTASSERT(batch_meas[i].n0 == meas.n0);
+    TESTASSERT(batch_meas[i].snr_dB == meas.snr_dB);
+    TESTASSERT(batch_meas[i].cfo_hz == meas.cfo_hz);
+    TESTASSERT(batch_meas[i].delay_us == meas.delay_us);
+  }
+
+  // The transmitted payloads are decoded
+  TESTASSERT(batch_value[0].valid && batch_value[0].ack[0] == 1);
+  TESTASSERT(batch_value[1].valid && batch_value[1].ack[0] == 1 && batch_value[1].ack[1] == 0);
+  TESTASSERT(batch_value[2].valid);
+  for (uint32_t i = 0; i < ack4.ack.count; i++) {
+    TESTASSERT(batch_value[2].ack[i] == f2_value.ack[i]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [csv]\n", prog);
+  printf("\t-c cell id [Default %d]\n", carrier.pci);
+  printf("\t-s SNR in dB [Default %.2f]\n", snr_db);
+  printf("\t-v [set verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "csv")) != -1) {
+    switch (opt) {
+      case 'c':
+        carrier.pci = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int ret         = SRSRAN_ERROR;
+  carrier.nof_prb = 25;
+  parse_args(argc, argv);
+
+  srsran_gnb_ul_t       gnb_ul   = {};
+  srsran_pucch_nr_t     pucch_tx = {};
+  srsran_channel_awgn_t awgn     = {};
+  cf_t*                 buffer   = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB_NR(carrier.nof_prb));
+  if (buffer == NULL) {
+    ERROR("Alloc");
+    goto clean_exit;
+  }
+
+  srsran_gnb_ul_args_t gnb_ul_args = {};
+  gnb_ul_args.nof_max_prb          = carrier.nof_prb;
+  if (srsran_gnb_ul_init(&gnb_ul, buffer, &gnb_ul_args) < SRSRAN_SUCCESS) {
+    ERROR("gNb UL init");
+    goto clean_exit;
+  }
+
+  if (srsran_gnb_ul_set_carrier(&gnb_ul, &carrier) < SRSRAN_SUCCESS) {
+    ERROR("gNb UL set carrier");
+    goto clean_exit;
+  }
+
+  srsran_pucch_nr_args_t pucch_args = {};
+  if (srsran_pucch_nr_init(&pucch_tx, &pucch_args) < SRSRAN_SUCCESS) {
+    ERROR("PUCCH init");
+    goto clean_exit;
+  }
+
+  if (srsran_pucch_nr_set_carrier(&pucch_tx, &carrier) < SRSRAN_SUCCESS) {
+    ERROR("PUCCH set carrier");
+    goto clean_exit;
+  }
+
+  if (srsran_channel_awgn_init(&awgn, 1234) < SRSRAN_SUCCESS) {
+    ERROR("AWGN init");
+    goto clean_exit;
+  }
+
+  if (srsran_channel_awgn_set_n0(&awgn, -snr_db) < SRSRAN_SUCCESS) {
+    ERROR("AWGN set N0");
+    goto clean_exit;
+  }
+
+  if (test_pucch_batch(&gnb_ul, &pucch_tx, &awgn) < SRSRAN_SUCCESS) {
+    ERROR("Failed PUCCH batch");
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+clean_exit:
+  if (buffer) {
+    free(buffer);
+  }
+
+  srsran_gnb_ul_free(&gnb_ul);
+  srsran_pucch_nr_free(&pucch_tx);
+  srsran_channel_awgn_free(&awgn);
+
+  if (ret == SRSRAN_SUCCESS) {
+    printf("Test passed!\n");
+  } else {
+    printf("Test failed!\n");
+  }
+
+  return ret;
+}
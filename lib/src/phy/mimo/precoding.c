@@ -2794,23 +2794,57 @@ int srsran_precoding_pmi_select(cf_t*     h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
   return ret;
 }
 
-/* PMI Select for 1 layer */
-float srsran_precoding_2x2_cn_gen(cf_t* h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS], uint32_t nof_symbols)
+/* Number of channel matrices processed by every srsran_mat_cn_batch call */
+#define PRECODING_CN_BATCH_SZ 64
+
+/* Computes the condition number for a given number of antennas,
+ * stores in the parameter *cn the Condition Number in dB */
+int srsran_precoding_cn(cf_t*    h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                        uint32_t nof_tx_antennas,
+                        uint32_t nof_rx_antennas,
+                        uint32_t nof_symbols,
+                        float*   cn)
 {
+  if (nof_tx_antennas == 0 || nof_tx_antennas > SRSRAN_MAT_MAX_N || nof_rx_antennas == 0 ||
+      nof_rx_antennas > SRSRAN_MAT_MAX_N) {
+    ERROR("MIMO Condition Number calculation not implemented for %d×%d", nof_tx_antennas, nof_rx_antennas);
+    return SRSRAN_ERROR;
+  }
+
+  // Channel matrices of a batch, one row per receive antenna and one column per transmit antenna
+  cf_t  buffer[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N][PRECODING_CN_BATCH_SZ];
+  cf_t* batch[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N] = {};
+  float cn_batch[PRECODING_CN_BATCH_SZ];
+  for (uint32_t rx = 0; rx < nof_rx_antennas; rx++) {
+    for (uint32_t tx = 0; tx < nof_tx_antennas; tx++) {
+      batch[rx][tx] = buffer[rx][tx];
+    }
+  }
+
   uint32_t count  = 0;
   float    cn_avg = 0.0f;
+  uint32_t i      = 0;
+  while (i < nof_symbols) {
+    // Gather one every PMI_SEL_PRECISION resource elements
+    uint32_t len = 0;
+    for (; i < nof_symbols && len < PRECODING_CN_BATCH_SZ; i += PMI_SEL_PRECISION, len++) {
+      for (uint32_t rx = 0; rx < nof_rx_antennas; rx++) {
+        for (uint32_t tx = 0; tx < nof_tx_antennas; tx++) {
+          buffer[rx][tx][len] = h[tx][rx][i];
+        }
+      }
+    }
 
-  for (uint32_t i = 0; i < nof_symbols; i += PMI_SEL_PRECISION) {
-    /* 0. Load channel matrix */
-    cf_t h00 = h[0][0][i];
-    cf_t h01 = h[1][0][i];
-    cf_t h10 = h[0][1][i];
-    cf_t h11 = h[1][1][i];
+    if (srsran_mat_cn_batch(batch, nof_rx_antennas, nof_tx_antennas, len, cn_batch) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
 
-    float cn = 0.0f;
-    if (srsran_mat_2x2_cn(h00, h01, h10, h11, &cn) == SRSRAN_SUCCESS) {
-      cn_avg += cn;
-      count++;
+    // Make sure NAN or INF are not propagated
+    for (uint32_t k = 0; k < len; k++) {
+      if (isfinite(cn_batch[k])) {
+        cn_avg += cn_batch[k];
+        count++;
+      }
     }
   }
 
@@ -2818,22 +2852,9 @@ float srsran_precoding_2x2_cn_gen(cf_t* h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS], u
     cn_avg /= count;
   }
 
-  return cn_avg;
-}
-
-/* Computes the condition number for a given number of antennas,
- * stores in the parameter *cn the Condition Number in dB */
-int srsran_precoding_cn(cf_t*    h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
-                        uint32_t nof_tx_antennas,
-                        uint32_t nof_rx_antennas,
-                        uint32_t nof_symbols,
-                        float*   cn)
-{
-  if (nof_tx_antennas == 2 && nof_rx_antennas == 2) {
-    *cn = srsran_precoding_2x2_cn_gen(h, nof_symbols);
-    return SRSRAN_SUCCESS;
-  } else {
-    ERROR("MIMO Condition Number calculation not implemented for %d×%d", nof_tx_antennas, nof_rx_antennas);
-    return SRSRAN_ERROR;
+  if (cn != NULL) {
+    *cn = cn_avg;
   }
+
+  return SRSRAN_SUCCESS;
 }
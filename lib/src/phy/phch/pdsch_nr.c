@@ -451,6 +451,11 @@ static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*         q,
     srsran_vec_fprint_c(stdout, q->d[tb->cw_idx], tb->nof_re);
   }
 
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
   // Demodulation
   int8_t* llr = (int8_t*)q->b[tb->cw_idx];
   if (srsran_demod_soft_demodulate_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re)) {
@@ -474,12 +479,25 @@ static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*         q,
     srsran_vec_fprint_b(stdout, q->b[tb->cw_idx], tb->nof_bits);
   }
 
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_demod_us += (uint32_t)t[0].tv_usec;
+    t[1] = t[2];
+  }
+
   // Decode SCH
   if (srsran_dlsch_nr_decode(&q->sch, &cfg->sch_cfg, tb, llr, &res->tb[tb->cw_idx]) < SRSRAN_SUCCESS) {
     ERROR("Error in DL-SCH encoding");
     return SRSRAN_ERROR;
   }
 
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_sch_us += (uint32_t)t[0].tv_usec;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -544,6 +562,14 @@ int srsran_pdsch_nr_decode(srsran_pdsch_nr_t*           q,
     srsran_layerdemap_nr(q->d, nof_cw, q->x, grant->nof_layers, nof_re);
   }
 
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_eq_us    = (uint32_t)t[0].tv_usec;
+    q->meas_time_demod_us = 0;
+    q->meas_time_sch_us   = 0;
+  }
+
   // SCH decode
   for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
     if (pdsch_nr_decode_codeword(q, cfg, &grant->tb[tb], data, grant->rnti) < SRSRAN_SUCCESS) {
@@ -306,53 +306,38 @@ int srsran_phich_decode(srsran_phich_t*         q,
   return SRSRAN_SUCCESS;
 }
 
-/** Encodes ACK/NACK bits, modulates and inserts into resource.
- * The parameter ack is an array of srsran_phich_ngroups() pointers to buffers of nof_sequences uint8_ts
- */
-int srsran_phich_encode(srsran_phich_t*         q,
-                        srsran_dl_sf_cfg_t*     sf,
-                        srsran_phich_resource_t n_phich,
-                        uint8_t                 ack,
-                        cf_t*                   sf_symbols[SRSRAN_MAX_PORTS])
+/* Checks the PHICH resource is valid for the cell and the current REG configuration */
+static int phich_check_resource(srsran_phich_t* q, srsran_phich_resource_t n_phich)
 {
-  int i;
-
-  if (q == NULL || sf_symbols == NULL) {
+  uint32_t nof_sequences = SRSRAN_CP_ISEXT(q->cell.cp) ? SRSRAN_PHICH_EXT_NSEQUENCES : SRSRAN_PHICH_NORM_NSEQUENCES;
+  if (n_phich.nseq >= nof_sequences) {
+    ERROR("Invalid nseq %d", n_phich.nseq);
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
-
-  uint32_t sf_idx = sf->tti % 10;
-
-  if (SRSRAN_CP_ISEXT(q->cell.cp)) {
-    if (n_phich.nseq >= SRSRAN_PHICH_EXT_NSEQUENCES) {
-      ERROR("Invalid nseq %d", n_phich.nseq);
-      return SRSRAN_ERROR_INVALID_INPUTS;
-    }
-  } else {
-    if (n_phich.nseq >= SRSRAN_PHICH_NORM_NSEQUENCES) {
-      ERROR("Invalid nseq %d", n_phich.nseq);
-      return SRSRAN_ERROR_INVALID_INPUTS;
-    }
-  }
   if (n_phich.ngroup >= srsran_regs_phich_ngroups(q->regs)) {
     ERROR("Invalid ngroup %d", n_phich.ngroup);
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
+  return SRSRAN_SUCCESS;
+}
 
-  /* Set pointers for layermapping & precoding */
-  cf_t* x[SRSRAN_MAX_LAYERS];
-  cf_t* symbols_precoding[SRSRAN_MAX_PORTS];
-
-  /* number of layers equals number of ports */
-  for (i = 0; i < q->cell.nof_ports; i++) {
-    x[i] = q->x[i];
-  }
-  for (i = 0; i < SRSRAN_MAX_PORTS; i++) {
-    symbols_precoding[i] = q->sf_symbols[i];
+/* Encodes and modulates one ACK/NACK bit, spreads it with its orthogonal sequence and adds it to the accumulator of its
+ * mapping unit. With extended CP the two groups of a mapping unit use the lower and upper halves of the accumulator.
+ */
+static void phich_spread_add(srsran_phich_t* q, const srsran_phich_ack_t* ack)
+{
+  uint32_t ngroup = ack->resource.ngroup;
+  uint32_t nseq   = ack->resource.nseq;
+  uint32_t unit   = SRSRAN_CP_ISEXT(q->cell.cp) ? ngroup / 2 : ngroup;
+
+  if (!q->unit_active[unit]) {
+    srsran_vec_cf_zero(q->d_unit[unit], SRSRAN_PHICH_MAX_NSYMB);
+    q->unit_active[unit]                   = true;
+    q->active_units[q->nof_active_units++] = unit;
   }
 
   /* encode ACK/NACK bit */
-  srsran_phich_ack_encode(ack, q->data);
+  srsran_phich_ack_encode(ack->ack, q->data);
 
   srsran_mod_modulate(&q->mod, q->data, q->z, SRSRAN_PHICH_NBITS);
 
@@ -362,40 +347,52 @@ int srsran_phich_encode(srsran_phich_t*         q,
 
   /* Spread with w */
   if (SRSRAN_CP_ISEXT(q->cell.cp)) {
-    for (i = 0; i < SRSRAN_PHICH_EXT_MSYMB; i++) {
-      q->d[i] = w_ext[n_phich.nseq][i % SRSRAN_PHICH_EXT_NSF] * q->z[i / SRSRAN_PHICH_EXT_NSF];
+    cf_t* d = &q->d_unit[unit][(ngroup % 2) * SRSRAN_PHICH_EXT_MSYMB];
+    for (uint32_t i = 0; i < SRSRAN_PHICH_EXT_MSYMB; i++) {
+      d[i] += w_ext[nseq][i % SRSRAN_PHICH_EXT_NSF] * q->z[i / SRSRAN_PHICH_EXT_NSF];
     }
   } else {
-    for (i = 0; i < SRSRAN_PHICH_NORM_MSYMB; i++) {
-      q->d[i] = w_normal[n_phich.nseq][i % SRSRAN_PHICH_NORM_NSF] * q->z[i / SRSRAN_PHICH_NORM_NSF];
+    cf_t* d = q->d_unit[unit];
+    for (uint32_t i = 0; i < SRSRAN_PHICH_NORM_MSYMB; i++) {
+      d[i] += w_normal[nseq][i % SRSRAN_PHICH_NORM_NSF] * q->z[i / SRSRAN_PHICH_NORM_NSF];
     }
   }
+}
 
-  DEBUG("d: ");
-  if (SRSRAN_VERBOSE_ISDEBUG())
-    srsran_vec_fprint_c(stdout, q->d, SRSRAN_PHICH_EXT_MSYMB);
+/* Scrambles the combined sequences of a mapping unit, aligns them to the REGs, precodes them and adds them into the
+ * resource grid */
+static int phich_map_unit(srsran_phich_t* q, uint32_t sf_idx, uint32_t unit, cf_t* sf_symbols[SRSRAN_MAX_PORTS])
+{
+  int      i;
+  uint32_t ngroup = unit;
+  cf_t*    d      = q->d_unit[unit];
 
-  srsran_scrambling_c(&q->seq[sf_idx], q->d);
+  /* Set pointers for layermapping & precoding */
+  cf_t* x[SRSRAN_MAX_LAYERS];
+  cf_t* symbols_precoding[SRSRAN_MAX_PORTS];
+
+  /* number of layers equals number of ports */
+  for (i = 0; i < q->cell.nof_ports; i++) {
+    x[i] = q->x[i];
+  }
+  for (i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    symbols_precoding[i] = q->sf_symbols[i];
+  }
 
-  /* align to REG */
+  /* scramble and align to REG, the even group takes the first two REs of every REG and the odd group the last two */
   if (SRSRAN_CP_ISEXT(q->cell.cp)) {
-    if (n_phich.ngroup % 2) {
-      for (i = 0; i < SRSRAN_PHICH_EXT_MSYMB / 2; i++) {
-        q->d0[4 * i + 0] = 0;
-        q->d0[4 * i + 1] = 0;
-        q->d0[4 * i + 2] = q->d[2 * i];
-        q->d0[4 * i + 3] = q->d[2 * i + 1];
-      }
-    } else {
-      for (i = 0; i < SRSRAN_PHICH_EXT_MSYMB / 2; i++) {
-        q->d0[4 * i + 0] = q->d[2 * i];
-        q->d0[4 * i + 1] = q->d[2 * i + 1];
-        q->d0[4 * i + 2] = 0;
-        q->d0[4 * i + 3] = 0;
-      }
+    ngroup = 2 * unit;
+    srsran_scrambling_c_offset(&q->seq[sf_idx], d, 0, SRSRAN_PHICH_EXT_MSYMB);
+    srsran_scrambling_c_offset(&q->seq[sf_idx], &d[SRSRAN_PHICH_EXT_MSYMB], 0, SRSRAN_PHICH_EXT_MSYMB);
+    for (i = 0; i < SRSRAN_PHICH_EXT_MSYMB / 2; i++) {
+      q->d0[4 * i + 0] = d[2 * i];
+      q->d0[4 * i + 1] = d[2 * i + 1];
+      q->d0[4 * i + 2] = d[SRSRAN_PHICH_EXT_MSYMB + 2 * i];
+      q->d0[4 * i + 3] = d[SRSRAN_PHICH_EXT_MSYMB + 2 * i + 1];
     }
   } else {
-    memcpy(q->d0, q->d, SRSRAN_PHICH_MAX_NSYMB * sizeof(cf_t));
+    srsran_scrambling_c_offset(&q->seq[sf_idx], d, 0, SRSRAN_PHICH_NORM_MSYMB);
+    memcpy(q->d0, d, SRSRAN_PHICH_MAX_NSYMB * sizeof(cf_t));
   }
 
   DEBUG("d0: ");
@@ -414,7 +411,7 @@ int srsran_phich_encode(srsran_phich_t*         q,
 
   /* mapping to resource elements */
   for (i = 0; i < q->cell.nof_ports; i++) {
-    if (srsran_regs_phich_add(q->regs, q->sf_symbols[i], n_phich.ngroup, sf_symbols[i]) < 0) {
+    if (srsran_regs_phich_add(q->regs, q->sf_symbols[i], ngroup, sf_symbols[i]) < 0) {
       ERROR("Error putting PCHICH resource elements");
       return SRSRAN_ERROR;
     }
@@ -422,3 +419,50 @@ int srsran_phich_encode(srsran_phich_t*         q,
 
   return SRSRAN_SUCCESS;
 }
+
+int srsran_phich_encode_batch(srsran_phich_t*           q,
+                              srsran_dl_sf_cfg_t*       sf,
+                              const srsran_phich_ack_t* acks,
+                              uint32_t                  nof_acks,
+                              cf_t*                     sf_symbols[SRSRAN_MAX_PORTS])
+{
+  if (q == NULL || sf == NULL || (acks == NULL && nof_acks > 0) || sf_symbols == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < nof_acks; i++) {
+    if (phich_check_resource(q, acks[i].resource) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  uint32_t sf_idx = sf->tti % 10;
+
+  /* combine the sequences in the symbol domain, the scrambling and precoding are linear */
+  q->nof_active_units = 0;
+  for (uint32_t i = 0; i < nof_acks; i++) {
+    phich_spread_add(q, &acks[i]);
+  }
+
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < q->nof_active_units; i++) {
+    uint32_t unit = q->active_units[i];
+    if (ret == SRSRAN_SUCCESS && phich_map_unit(q, sf_idx, unit, sf_symbols) < SRSRAN_SUCCESS) {
+      ret = SRSRAN_ERROR;
+    }
+    q->unit_active[unit] = false;
+  }
+
+  return ret;
+}
+
+/** Encodes one ACK/NACK bit, modulates and adds it into its resource */
+int srsran_phich_encode(srsran_phich_t*         q,
+                        srsran_dl_sf_cfg_t*     sf,
+                        srsran_phich_resource_t n_phich,
+                        uint8_t                 ack,
+                        cf_t*                   sf_symbols[SRSRAN_MAX_PORTS])
+{
+  srsran_phich_ack_t phich_ack = {.resource = n_phich, .ack = ack};
+  return srsran_phich_encode_batch(q, sf, &phich_ack, 1, sf_symbols);
+}
@@ -82,15 +82,18 @@ int srsran_pucch_nr_alpha_idx(const srsran_carrier_nr_t*          carrier,
   // Compute number of slot
   uint32_t n_slot = SRSRAN_SLOT_NR_MOD(carrier->scs, slot->idx);
 
-  // Generate pseudo-random sequence
-  uint32_t cinit = cfg->hopping_id_present ? cfg->hopping_id : carrier->pci;
-  uint8_t  cs[SRSRAN_NSYMB_PER_SLOT_NR * SRSRAN_NSLOTS_PER_FRAME_NR(SRSRAN_NR_MAX_NUMEROLOGY) * 8U] = {};
-  srsran_sequence_apply_bit(cs, cs, SRSRAN_NSYMB_PER_SLOT_NR * SRSRAN_NSLOTS_PER_FRAME_NR(carrier->scs) * 8, cinit);
+  // Generate only the 8 pseudo-random bits used by this symbol, skipping the ones of the previous symbols in the frame
+  uint32_t                cinit          = cfg->hopping_id_present ? cfg->hopping_id : carrier->pci;
+  srsran_sequence_state_t sequence_state = {};
+  srsran_sequence_state_init(&sequence_state, cinit);
+  srsran_sequence_state_advance(&sequence_state, (SRSRAN_NSYMB_PER_SLOT_NR * n_slot + (l + l_prime)) * 8U);
+  uint8_t cs[8] = {};
+  srsran_sequence_state_apply_bit(&sequence_state, cs, cs, 8);
 
   // Create n_cs parameter
   uint32_t n_cs = 0;
   for (uint32_t m = 0; m < 8; m++) {
-    n_cs += cs[(SRSRAN_NSYMB_PER_SLOT_NR * n_slot + (l + l_prime)) * 8 + m] << m;
+    n_cs += cs[m] << m;
   }
 
   *alpha_idx = (m0 + m_cs + n_cs) % SRSRAN_NRE;
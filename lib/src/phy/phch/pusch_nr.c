@@ -840,6 +840,11 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
     return SRSRAN_ERROR;
   }
 
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
   // Demodulation
   int8_t* llr = (int8_t*)q->b[tb->cw_idx];
   if (srsran_demod_soft_demodulate_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re)) {
@@ -859,6 +864,13 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
     srsran_vec_fprint_bs(stdout, llr, nof_bits);
   }
 
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_demod_us += (uint32_t)t[0].tv_usec;
+    t[1] = t[2];
+  }
+
   // Demultiplex UCI only if necessary
   if (q->uci_mux) {
     // As it can be HARQ-ACK takes LLRs from ULSCH, demultiplex HARQ-ACK first
@@ -924,6 +936,12 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
     }
   }
 
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_sch_us += (uint32_t)t[0].tv_usec;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -999,6 +1017,14 @@ int srsran_pusch_nr_decode(srsran_pusch_nr_t*           q,
     srsran_layerdemap_nr(q->d, nof_cw, q->x, grant->nof_layers, nof_re);
   }
 
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_eq_us    = (uint32_t)t[0].tv_usec;
+    q->meas_time_demod_us = 0;
+    q->meas_time_sch_us   = 0;
+  }
+
   // SCH decode
   for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
     if (pusch_nr_decode_codeword(q, cfg, &grant->tb[tb], data, grant->rnti) < SRSRAN_SUCCESS) {
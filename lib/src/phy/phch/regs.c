@@ -27,17 +27,11 @@
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/phch/regs.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
 
 #define REG_IDX(r, i, n) r->k[i] + r->l* n* SRSRAN_NRE
 
 srsran_regs_reg_t* regs_find_reg(srsran_regs_t* h, uint32_t k, uint32_t l);
-int                regs_put_reg(srsran_regs_reg_t* reg, cf_t* reg_data, cf_t* slot_symbols, uint32_t nof_prb);
-
-int regs_add_reg(srsran_regs_reg_t* reg, cf_t* reg_data, cf_t* slot_symbols, uint32_t nof_prb);
-
-int regs_get_reg(srsran_regs_reg_t* reg, cf_t* slot_symbols, cf_t* reg_data, uint32_t nof_prb);
-
-int regs_reset_reg(srsran_regs_reg_t* reg, cf_t* slot_symbols, uint32_t nof_prb);
 
 /***************************************************************
  *
@@ -181,13 +175,9 @@ int srsran_regs_pdcch_put_offset(srsran_regs_t* h,
     return SRSRAN_ERROR;
   }
   if (start_reg + nof_regs <= h->pdcch[cfi - 1].nof_regs) {
-    uint32_t i, k;
-    k = 0;
-    for (i = start_reg; i < start_reg + nof_regs; i++) {
-      regs_put_reg(h->pdcch[cfi - 1].regs[i], &d[k], slot_symbols, h->cell.nof_prb);
-      k += 4;
-    }
-    return k;
+    uint32_t nof_re = nof_regs * REGS_RE_X_REG;
+    srsran_vec_scatter_c(d, &h->pdcch_re_idx[cfi - 1][start_reg * REGS_RE_X_REG], slot_symbols, nof_re);
+    return nof_re;
   } else {
     ERROR("Out of range: start_reg + nof_reg must be lower than %d", h->pdcch[cfi - 1].nof_regs);
     return SRSRAN_ERROR;
@@ -215,13 +205,9 @@ int srsran_regs_pdcch_get_offset(srsran_regs_t* h,
     return SRSRAN_ERROR;
   }
   if (start_reg + nof_regs <= h->pdcch[cfi - 1].nof_regs) {
-    uint32_t i, k;
-    k = 0;
-    for (i = start_reg; i < start_reg + nof_regs; i++) {
-      regs_get_reg(h->pdcch[cfi - 1].regs[i], slot_symbols, &d[k], h->cell.nof_prb);
-      k += 4;
-    }
-    return k;
+    uint32_t nof_re = nof_regs * REGS_RE_X_REG;
+    srsran_vec_gather_c(slot_symbols, &h->pdcch_re_idx[cfi - 1][start_reg * REGS_RE_X_REG], d, nof_re);
+    return nof_re;
   } else {
     ERROR("Out of range: start_reg + nof_reg must be lower than %d", h->pdcch[cfi - 1].nof_regs);
     return SRSRAN_ERROR;
@@ -401,6 +387,12 @@ uint32_t srsran_regs_phich_nregs(srsran_regs_t* h)
   return n;
 }
 
+/* Number of PHICH mapping units. With extended CP two groups share each mapping unit */
+static uint32_t regs_phich_nof_units(srsran_regs_t* h)
+{
+  return SRSRAN_CP_ISEXT(h->cell.cp) ? h->ngroups_phich / 2 : h->ngroups_phich;
+}
+
 uint32_t srsran_regs_phich_ngroups(srsran_regs_t* h)
 {
   return h->ngroups_phich;
@@ -420,7 +412,6 @@ uint32_t srsran_regs_phich_ngroups_m1(srsran_regs_t* h)
  */
 int srsran_regs_phich_add(srsran_regs_t* h, cf_t symbols[REGS_PHICH_NSYM], uint32_t ngroup, cf_t* slot_symbols)
 {
-  uint32_t i;
   if (ngroup >= h->ngroups_phich) {
     ERROR("Error invalid ngroup %d", ngroup);
     return SRSRAN_ERROR_INVALID_INPUTS;
@@ -428,11 +419,8 @@ int srsran_regs_phich_add(srsran_regs_t* h, cf_t symbols[REGS_PHICH_NSYM], uint3
   if (SRSRAN_CP_ISEXT(h->cell.cp)) {
     ngroup /= 2;
   }
-  srsran_regs_ch_t* rch = &h->phich[ngroup];
-  for (i = 0; i < rch->nof_regs && i * REGS_RE_X_REG < REGS_PHICH_NSYM; i++) {
-    regs_add_reg(rch->regs[i], &symbols[i * REGS_RE_X_REG], slot_symbols, h->cell.nof_prb);
-  }
-  return i * REGS_RE_X_REG;
+  srsran_vec_scatter_sum_c(symbols, &h->phich_re_idx[ngroup * REGS_PHICH_NSYM], slot_symbols, REGS_PHICH_NSYM);
+  return REGS_PHICH_NSYM;
 }
 
 /**
@@ -442,18 +430,10 @@ int srsran_regs_phich_add(srsran_regs_t* h, cf_t symbols[REGS_PHICH_NSYM], uint3
  */
 int srsran_regs_phich_reset(srsran_regs_t* h, cf_t* slot_symbols)
 {
-  uint32_t i;
-  uint32_t ngroup, ng;
-  for (ngroup = 0; ngroup < h->ngroups_phich; SRSRAN_CP_ISEXT(h->cell.cp) ? ngroup += 2 : ngroup++) {
-    if (SRSRAN_CP_ISEXT(h->cell.cp)) {
-      ng = ngroup / 2;
-    } else {
-      ng = ngroup;
-    }
-    srsran_regs_ch_t* rch = &h->phich[ng];
-    for (i = 0; i < rch->nof_regs && i * REGS_RE_X_REG < REGS_PHICH_NSYM; i++) {
-      regs_reset_reg(rch->regs[i], slot_symbols, h->cell.nof_prb);
-    }
+  // The table holds all the mapping units back to back
+  uint32_t nof_re = regs_phich_nof_units(h) * REGS_PHICH_NSYM;
+  for (uint32_t i = 0; i < nof_re; i++) {
+    slot_symbols[h->phich_re_idx[i]] = 0;
   }
   return SRSRAN_SUCCESS;
 }
@@ -465,7 +445,6 @@ int srsran_regs_phich_reset(srsran_regs_t* h, cf_t* slot_symbols)
  */
 int srsran_regs_phich_get(srsran_regs_t* h, cf_t* slot_symbols, cf_t symbols[REGS_PHICH_NSYM], uint32_t ngroup)
 {
-  uint32_t i;
   if (ngroup >= h->ngroups_phich) {
     ERROR("Error invalid ngroup %d", ngroup);
     return SRSRAN_ERROR_INVALID_INPUTS;
@@ -473,11 +452,8 @@ int srsran_regs_phich_get(srsran_regs_t* h, cf_t* slot_symbols, cf_t symbols[REG
   if (SRSRAN_CP_ISEXT(h->cell.cp)) {
     ngroup /= 2;
   }
-  srsran_regs_ch_t* rch = &h->phich[ngroup];
-  for (i = 0; i < rch->nof_regs && i * REGS_RE_X_REG < REGS_PHICH_NSYM; i++) {
-    regs_get_reg(rch->regs[i], slot_symbols, &symbols[i * REGS_RE_X_REG], h->cell.nof_prb);
-  }
-  return i * REGS_RE_X_REG;
+  srsran_vec_gather_c(slot_symbols, &h->phich_re_idx[ngroup * REGS_PHICH_NSYM], symbols, REGS_PHICH_NSYM);
+  return REGS_PHICH_NSYM;
 }
 
 /***************************************************************
@@ -542,13 +518,8 @@ uint32_t srsran_regs_pcfich_nregs(srsran_regs_t* h)
  */
 int srsran_regs_pcfich_put(srsran_regs_t* h, cf_t symbols[REGS_PCFICH_NSYM], cf_t* slot_symbols)
 {
-  srsran_regs_ch_t* rch = &h->pcfich;
-
-  uint32_t i;
-  for (i = 0; i < rch->nof_regs && i * REGS_RE_X_REG < REGS_PCFICH_NSYM; i++) {
-    regs_put_reg(rch->regs[i], &symbols[i * REGS_RE_X_REG], slot_symbols, h->cell.nof_prb);
-  }
-  return i * REGS_RE_X_REG;
+  srsran_vec_scatter_c(symbols, h->pcfich_re_idx, slot_symbols, REGS_PCFICH_NSYM);
+  return REGS_PCFICH_NSYM;
 }
 
 /**
@@ -558,12 +529,8 @@ int srsran_regs_pcfich_put(srsran_regs_t* h, cf_t symbols[REGS_PCFICH_NSYM], cf_
  */
 int srsran_regs_pcfich_get(srsran_regs_t* h, cf_t* slot_symbols, cf_t ch_data[REGS_PCFICH_NSYM])
 {
-  srsran_regs_ch_t* rch = &h->pcfich;
-  uint32_t          i;
-  for (i = 0; i < rch->nof_regs && i * REGS_RE_X_REG < REGS_PCFICH_NSYM; i++) {
-    regs_get_reg(rch->regs[i], slot_symbols, &ch_data[i * REGS_RE_X_REG], h->cell.nof_prb);
-  }
-  return i * REGS_RE_X_REG;
+  srsran_vec_gather_c(slot_symbols, h->pcfich_re_idx, ch_data, REGS_PCFICH_NSYM);
+  return REGS_PCFICH_NSYM;
 }
 
 /***************************************************************
@@ -668,11 +635,68 @@ int regs_reg_init(srsran_regs_reg_t* reg, uint32_t symbol, uint32_t nreg, uint32
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * Flattens the REGs of every channel into resource element indexes in the subframe grid
+ */
+static int regs_re_idx_init(srsran_regs_t* h)
+{
+  uint32_t nof_prb = h->cell.nof_prb;
+
+  for (uint32_t i = 0; i < REGS_PCFICH_NREGS; i++) {
+    for (uint32_t j = 0; j < REGS_RE_X_REG; j++) {
+      h->pcfich_re_idx[i * REGS_RE_X_REG + j] = REG_IDX(h->pcfich.regs[i], j, nof_prb);
+    }
+  }
+
+  uint32_t nof_units = regs_phich_nof_units(h);
+  if (nof_units > 0) {
+    h->phich_re_idx = srsran_vec_u32_malloc(nof_units * REGS_PHICH_NSYM);
+    if (!h->phich_re_idx) {
+      return SRSRAN_ERROR;
+    }
+    for (uint32_t m = 0; m < nof_units; m++) {
+      for (uint32_t i = 0; i < REGS_PHICH_REGS_X_GROUP; i++) {
+        for (uint32_t j = 0; j < REGS_RE_X_REG; j++) {
+          h->phich_re_idx[(m * REGS_PHICH_REGS_X_GROUP + i) * REGS_RE_X_REG + j] =
+              REG_IDX(h->phich[m].regs[i], j, nof_prb);
+        }
+      }
+    }
+  }
+
+  for (uint32_t cfi = 0; cfi < 3; cfi++) {
+    h->pdcch_re_idx[cfi] = srsran_vec_u32_malloc(SRSRAN_MAX(1, h->pdcch[cfi].nof_regs * REGS_RE_X_REG));
+    if (!h->pdcch_re_idx[cfi]) {
+      return SRSRAN_ERROR;
+    }
+    for (uint32_t i = 0; i < h->pdcch[cfi].nof_regs; i++) {
+      for (uint32_t j = 0; j < REGS_RE_X_REG; j++) {
+        h->pdcch_re_idx[cfi][i * REGS_RE_X_REG + j] = REG_IDX(h->pdcch[cfi].regs[i], j, nof_prb);
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void regs_re_idx_free(srsran_regs_t* h)
+{
+  if (h->phich_re_idx) {
+    free(h->phich_re_idx);
+  }
+  for (uint32_t cfi = 0; cfi < 3; cfi++) {
+    if (h->pdcch_re_idx[cfi]) {
+      free(h->pdcch_re_idx[cfi]);
+    }
+  }
+}
+
 void srsran_regs_free(srsran_regs_t* h)
 {
   if (h->regs) {
     free(h->regs);
   }
+  regs_re_idx_free(h);
   regs_pcfich_free(h);
   regs_phich_free(h);
   regs_pdcch_free(h);
@@ -769,6 +793,10 @@ int srsran_regs_init_opts(srsran_regs_t* h, srsran_cell_t cell, uint32_t phich_m
       ERROR("Error initializing PDCCH REGs");
       goto clean_and_exit;
     }
+    if (regs_re_idx_init(h)) {
+      ERROR("Error initializing REG resource element indexes");
+      goto clean_and_exit;
+    }
 
     ret = SRSRAN_SUCCESS;
   }
@@ -780,52 +808,3 @@ clean_and_exit:
   }
   return ret;
 }
-
-/**
- * Puts one REG data (4 symbols) in the slot symbols array
- */
-int regs_put_reg(srsran_regs_reg_t* reg, cf_t* reg_data, cf_t* slot_symbols, uint32_t nof_prb)
-{
-  uint32_t i;
-  for (i = 0; i < REGS_RE_X_REG; i++) {
-    slot_symbols[REG_IDX(reg, i, nof_prb)] = reg_data[i];
-  }
-  return REGS_RE_X_REG;
-}
-
-/**
- * Adds one REG data (4 symbols) in the slot symbols array
- * Used by PHICH
- */
-int regs_add_reg(srsran_regs_reg_t* reg, cf_t* reg_data, cf_t* slot_symbols, uint32_t nof_prb)
-{
-  uint32_t i;
-  for (i = 0; i < REGS_RE_X_REG; i++) {
-    slot_symbols[REG_IDX(reg, i, nof_prb)] += reg_data[i];
-  }
-  return REGS_RE_X_REG;
-}
-
-/**
- * Reset REG data (4 symbols) in the slot symbols array
- */
-int regs_reset_reg(srsran_regs_reg_t* reg, cf_t* slot_symbols, uint32_t nof_prb)
-{
-  uint32_t i;
-  for (i = 0; i < REGS_RE_X_REG; i++) {
-    slot_symbols[REG_IDX(reg, i, nof_prb)] = 0;
-  }
-  return REGS_RE_X_REG;
-}
-
-/**
- * Gets one REG data (4 symbols) from the slot symbols array
- */
-int regs_get_reg(srsran_regs_reg_t* reg, cf_t* slot_symbols, cf_t* reg_data, uint32_t nof_prb)
-{
-  uint32_t i;
-  for (i = 0; i < REGS_RE_X_REG; i++) {
-    reg_data[i] = slot_symbols[REG_IDX(reg, i, nof_prb)];
-  }
-  return REGS_RE_X_REG;
-}
@@ -164,8 +164,10 @@ int main(int argc, char** argv)
       srsran_phich_reset(&phich, slot_symbols);
 
       srsran_phich_resource_t resource;
+      srsran_phich_ack_t      acks[SRSRAN_PHICH_MAX_NOF_ACKS];
+      uint32_t                nof_acks = 0;
 
-      /* Transmit all PHICH groups and sequence numbers */
+      /* Transmit all PHICH groups and sequence numbers, odd subframes encode all of them at once */
       for (ngroup = 0; ngroup < srsran_phich_ngroups(&phich); ngroup++) {
         for (nseq = 0; nseq < max_nseq; nseq++) {
           resource.ngroup = ngroup;
@@ -173,9 +175,19 @@ int main(int argc, char** argv)
 
           ack[ngroup][nseq] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
 
-          srsran_phich_encode(&phich, &dl_sf, resource, ack[ngroup][nseq], slot_symbols);
+          if (nsf % 2) {
+            acks[nof_acks].resource = resource;
+            acks[nof_acks].ack      = ack[ngroup][nseq];
+            nof_acks++;
+          } else {
+            srsran_phich_encode(&phich, &dl_sf, resource, ack[ngroup][nseq], slot_symbols);
+          }
         }
       }
+      if (srsran_phich_encode_batch(&phich, &dl_sf, acks, nof_acks, slot_symbols) < SRSRAN_SUCCESS) {
+        ERROR("Error encoding PHICH batch");
+        exit(-1);
+      }
       /* combine outputs */
       for (i = 1; i < cell.nof_ports; i++) {
         for (j = 0; j < nof_re; j++) {
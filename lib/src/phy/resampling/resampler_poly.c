@@ -0,0 +1,301 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/resampler_poly.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+/**
+ * Filter cut-off frequency relative to the lowest of the input and output sampling rates. It leaves the occupied
+ * bandwidth of LTE and NR carriers (up to 60% of the sampling rate) in the pass band.
+ */
+#define RESAMPLER_POLY_BW 0.8
+
+/**
+ * Maximum number of input samples processed in a single filter pass
+ */
+#define RESAMPLER_POLY_WINDOW_SZ 4096
+
+static uint64_t resampler_poly_gcd(uint64_t a, uint64_t b)
+{
+  while (b != 0) {
+    uint64_t t = a % b;
+    a          = b;
+    b          = t;
+  }
+  return a;
+}
+
+static int resampler_poly_design(srsran_resampler_poly_t* q)
+{
+  uint32_t nof_taps = q->nof_taps;
+  uint32_t len      = nof_taps * q->up;
+  double   fc       = RESAMPLER_POLY_BW / (2.0 * (double)SRSRAN_MAX(q->up, q->down));
+  double   center   = (double)(len - 1) / 2.0;
+
+  float* branch = srsran_vec_f_malloc(nof_taps);
+  if (branch == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t p = 0; p < q->up; p++) {
+    // Compute windowed sinc prototype coefficients of the branch, the taps of a branch are spaced up samples apart
+    double sum = 0.0;
+    for (uint32_t k = 0; k < nof_taps; k++) {
+      uint32_t n = k * q->up + p;
+      double   t = (double)n - center;
+      double   h = 2.0 * fc;
+      if (isnormal(t)) {
+        h = sin(2.0 * M_PI * fc * t) / (M_PI * t);
+      }
+
+      // Blackman window
+      double w = 0.42 - 0.5 * cos(2.0 * M_PI * (double)n / (double)(len - 1)) +
+                 0.08 * cos(4.0 * M_PI * (double)n / (double)(len - 1));
+
+      branch[k] = (float)(h * w);
+      sum += h * w;
+    }
+
+    // Normalise every branch to unitary DC gain and store the coefficients in reversed order, so the branch is applied
+    // with a plain dot product over the input history. Each coefficient is duplicated for the real and imaginary parts.
+    float* h = &q->filter[2 * nof_taps * p];
+    for (uint32_t k = 0; k < nof_taps; k++) {
+      float c                       = (float)(branch[k] / sum);
+      h[2 * (nof_taps - 1 - k)]     = c;
+      h[2 * (nof_taps - 1 - k) + 1] = c;
+    }
+  }
+
+  free(branch);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t up, uint32_t down)
+{
+  if (q == NULL || up == 0 || down == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Reduce ratio
+  uint32_t gcd = (uint32_t)resampler_poly_gcd(up, down);
+  up /= gcd;
+  down /= gcd;
+
+  if (up > SRSRAN_RESAMPLER_POLY_MAX_PHASES) {
+    ERROR("Polyphase resampler interpolation factor (%d) exceeds the maximum (%d)",
+          up,
+          SRSRAN_RESAMPLER_POLY_MAX_PHASES);
+    return SRSRAN_ERROR_OUT_OF_BOUNDS;
+  }
+
+  // Skip initialisation if the configuration does not change
+  if (q->up == up && q->down == down && q->filter != NULL) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Make sure the resampler is freed
+  srsran_resampler_poly_free(q);
+
+  q->up        = up;
+  q->down      = down;
+  q->nof_taps  = SRSRAN_RESAMPLER_POLY_NOF_TAPS * SRSRAN_CEIL(down, up);
+  q->window_sz = RESAMPLER_POLY_WINDOW_SZ;
+
+  q->filter = srsran_vec_f_malloc(2 * q->nof_taps * up);
+  if (q->filter == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  q->buffer = srsran_vec_cf_malloc(q->nof_taps - 1 + q->window_sz);
+  if (q->buffer == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (resampler_poly_design(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_resampler_poly_reset_state(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_resampler_poly_init_srate(srsran_resampler_poly_t* q, double input_srate_hz, double output_srate_hz)
+{
+  if (q == NULL || !isnormal(input_srate_hz) || !isnormal(output_srate_hz)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint64_t in  = (uint64_t)round(input_srate_hz);
+  uint64_t out = (uint64_t)round(output_srate_hz);
+  uint64_t gcd = resampler_poly_gcd(in, out);
+
+  return srsran_resampler_poly_init(q, (uint32_t)(out / gcd), (uint32_t)(in / gcd));
+}
+
+void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->buffer == NULL) {
+    return;
+  }
+
+  q->phase  = 0;
+  q->offset = 0;
+  srsran_vec_cf_zero(q->buffer, q->nof_taps - 1);
+}
+
+uint32_t srsran_resampler_poly_get_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output)
+{
+  if (q == NULL || q->up == 0 || nof_output == 0) {
+    return 0;
+  }
+
+  // The last output sample requires the input sample at index offset + floor((phase + (nof_output - 1) * down) / up)
+  uint64_t last = ((uint64_t)q->phase + (uint64_t)(nof_output - 1) * (uint64_t)q->down) / (uint64_t)q->up;
+
+  return (uint32_t)(q->offset + last + 1);
+}
+
+uint32_t srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->down == 0) {
+    return 0;
+  }
+
+  return ((q->nof_taps * q->up - 1) / 2) / q->down;
+}
+
+/**
+ * Applies a filter branch over nof_taps complex samples. The coefficients are duplicated for the real and imaginary
+ * parts so the product is carried over the interleaved samples as a real dot product.
+ */
+static inline cf_t resampler_poly_dot_prod(const cf_t* x, const float* h, uint32_t nof_taps)
+{
+  const float* x_ptr = (const float*)x;
+  uint32_t     len   = 2 * nof_taps;
+  uint32_t     i     = 0;
+  float        re    = 0.0f;
+  float        im    = 0.0f;
+
+#if SRSRAN_SIMD_F_SIZE
+  simd_f_t acc0 = srsran_simd_f_zero();
+  simd_f_t acc1 = srsran_simd_f_zero();
+  for (; i + 2 * SRSRAN_SIMD_F_SIZE <= len; i += 2 * SRSRAN_SIMD_F_SIZE) {
+    simd_f_t x0 = srsran_simd_f_loadu(&x_ptr[i]);
+    simd_f_t x1 = srsran_simd_f_loadu(&x_ptr[i + SRSRAN_SIMD_F_SIZE]);
+    simd_f_t h0 = srsran_simd_f_load(&h[i]);
+    simd_f_t h1 = srsran_simd_f_load(&h[i + SRSRAN_SIMD_F_SIZE]);
+
+    acc0 = srsran_simd_f_add(acc0, srsran_simd_f_mul(x0, h0));
+    acc1 = srsran_simd_f_add(acc1, srsran_simd_f_mul(x1, h1));
+  }
+
+  __attribute__((aligned(64))) float acc[SRSRAN_SIMD_F_SIZE];
+  srsran_simd_f_store(acc, srsran_simd_f_add(acc0, acc1));
+  for (uint32_t j = 0; j < SRSRAN_SIMD_F_SIZE; j += 2) {
+    re += acc[j];
+    im += acc[j + 1];
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+
+  for (; i < len; i += 2) {
+    re += x_ptr[i] * h[i];
+    im += x_ptr[i + 1] * h[i + 1];
+  }
+
+  return re + _Complex_I * im;
+}
+
+uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q, const cf_t* input, cf_t* output, uint32_t nsamples)
+{
+  if (q == NULL || q->filter == NULL || q->buffer == NULL) {
+    return 0;
+  }
+
+  uint32_t history    = q->nof_taps - 1;
+  uint32_t step_int   = q->down / q->up;
+  uint32_t step_frac  = q->down % q->up;
+  uint32_t branch_sz  = 2 * q->nof_taps;
+  uint32_t count      = 0;
+  uint32_t nof_output = 0;
+  cf_t*    window     = &q->buffer[history];
+
+  while (count < nsamples) {
+    uint32_t n = SRSRAN_MIN(q->window_sz, nsamples - count);
+
+    // Append input samples to the filter history
+    if (input) {
+      srsran_vec_cf_copy(window, &input[count], n);
+    } else {
+      srsran_vec_cf_zero(window, n);
+    }
+
+    // Produce every output sample whose newest input sample is in the current window
+    while (q->offset < n) {
+      cf_t y = resampler_poly_dot_prod(&q->buffer[q->offset], &q->filter[branch_sz * q->phase], q->nof_taps);
+      if (output) {
+        output[nof_output] = y;
+      }
+      nof_output++;
+
+      // Advance down/up input samples
+      q->offset += step_int;
+      q->phase += step_frac;
+      if (q->phase >= q->up) {
+        q->phase -= q->up;
+        q->offset++;
+      }
+    }
+    q->offset -= n;
+
+    // Keep the newest samples as history for the next window
+    memmove(q->buffer, &q->buffer[n], history * sizeof(cf_t));
+
+    count += n;
+  }
+
+  return nof_output;
+}
+
+void srsran_resampler_poly_free(srsran_resampler_poly_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->filter) {
+    free(q->filter);
+  }
+
+  if (q->buffer) {
+    free(q->buffer);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_resampler_poly_t, 1);
+}
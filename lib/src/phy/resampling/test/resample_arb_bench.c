@@ -27,9 +27,22 @@
 #include <unistd.h>
 
 #include "srsran/phy/resampling/resample_arb.h"
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/resampling/resampler_poly.h"
 #include "srsran/srsran.h"
 
 #define ITERATIONS 10000
+
+static void print_result(const char* name, clock_t diff, int N)
+{
+  diff       = diff / ITERATIONS;
+  int   msec = diff * 1000 / CLOCKS_PER_SEC;
+  float thru = (CLOCKS_PER_SEC / (float)diff) * (N / 1e6);
+  printf("%s:\n", name);
+  printf("  Time taken %d seconds %d milliseconds\n", msec / 1000, msec % 1000);
+  printf("  Rate = %f MS/sec\n", thru);
+}
+
 int main(int argc, char** argv)
 {
   int   N    = 9000;
@@ -40,6 +53,7 @@ int main(int argc, char** argv)
   for (int i = 0; i < N; i++)
     in[i] = sin(i * 2 * M_PI / 100);
 
+  // Arbitrary rate resampler, one sample at a time
   srsran_resample_arb_t r;
   srsran_resample_arb_init(&r, rate, 0);
 
@@ -48,13 +62,50 @@ int main(int argc, char** argv)
     srsran_resample_arb_compute(&r, in, out, N);
   }
   diff = clock() - start;
+  print_result("Arbitrary rate resampler 24/25", diff, N);
 
-  diff       = diff / ITERATIONS;
-  int   msec = diff * 1000 / CLOCKS_PER_SEC;
-  float thru = (CLOCKS_PER_SEC / (float)diff) * (N / 1e6);
-  printf("Time taken %d seconds %d milliseconds\n", msec / 1000, msec % 1000);
-  printf("Rate = %f MS/sec\n", thru);
+  // Rational polyphase resampler with the same rate
+  srsran_resampler_poly_t poly = {};
+  if (srsran_resampler_poly_init(&poly, 24, 25) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising polyphase resampler");
+    exit(-1);
+  }
+
+  start = clock();
+  for (int xx = 0; xx < ITERATIONS; xx++) {
+    srsran_resampler_poly_run(&poly, in, out, N);
+  }
+  diff = clock() - start;
+  print_result("Polyphase resampler 24/25", diff, N);
+
+  // Integer decimation, FFT based resampler against polyphase resampler
+  srsran_resampler_fft_t fft = {};
+  if (srsran_resampler_fft_init(&fft, SRSRAN_RESAMPLER_MODE_DECIMATE, 2) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising FFT resampler");
+    exit(-1);
+  }
+
+  start = clock();
+  for (int xx = 0; xx < ITERATIONS; xx++) {
+    srsran_resampler_fft_run(&fft, in, out, N);
+  }
+  diff = clock() - start;
+  print_result("FFT resampler 1/2", diff, N);
+
+  if (srsran_resampler_poly_init(&poly, 1, 2) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising polyphase resampler");
+    exit(-1);
+  }
+
+  start = clock();
+  for (int xx = 0; xx < ITERATIONS; xx++) {
+    srsran_resampler_poly_run(&poly, in, out, N);
+  }
+  diff = clock() - start;
+  print_result("Polyphase resampler 1/2", diff, N);
 
+  srsran_resampler_fft_free(&fft);
+  srsran_resampler_poly_free(&poly);
   free(in);
   free(out);
   printf("Done\n");
@@ -0,0 +1,162 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/resampler_poly.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static uint32_t buffer_size = 1920;
+static uint32_t up          = 3;
+static uint32_t down        = 8;
+static uint32_t repetitions = 20;
+static float    freq        = 0.1f; ///< Tone frequency relative to the lowest sampling rate
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [sudrfv]\n", prog);
+  printf("\t-s Input buffer size [Default %d]\n", buffer_size);
+  printf("\t-u Interpolation factor [Default %d]\n", up);
+  printf("\t-d Decimation factor [Default %d]\n", down);
+  printf("\t-r Number of repetitions [Default %d]\n", repetitions);
+  printf("\t-f Tone frequency relative to the lowest sampling rate [Default %.2f]\n", freq);
+  printf("\t-v increase verbosity\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "sudrfv")) != -1) {
+    switch (opt) {
+      case 's':
+        buffer_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'u':
+        up = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        down = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        freq = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  struct timeval          t[3] = {};
+  srsran_resampler_poly_t q    = {};
+
+  parse_args(argc, argv);
+
+  if (srsran_resampler_poly_init(&q, up, down) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising polyphase resampler");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t total_in  = buffer_size * repetitions;
+  uint32_t max_out   = SRSRAN_CEIL(buffer_size * q.up, q.down);
+  cf_t*    src       = srsran_vec_cf_malloc(total_in);
+  cf_t*    resampled = srsran_vec_cf_malloc(max_out * repetitions);
+  if (src == NULL || resampled == NULL) {
+    ERROR("Error allocating buffers");
+    return SRSRAN_ERROR;
+  }
+
+  // Generate tone, the frequency is relative to the lowest rate so it stays in the pass band
+  double f_in = freq * (double)SRSRAN_MIN(q.up, q.down) / (double)q.down;
+  for (uint32_t i = 0; i < total_in; i++) {
+    src[i] = cexp(_Complex_I * 2.0 * M_PI * f_in * (double)i);
+  }
+
+  // Run resampler in blocks of buffer_size input samples
+  uint32_t nof_out = 0;
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    nof_out += srsran_resampler_poly_run(&q, &src[r * buffer_size], &resampled[nof_out], buffer_size);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t duration_us = (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+
+  // Check the number of output samples matches the expected
+  uint32_t expected_nof_out = SRSRAN_CEIL(total_in * q.up, q.down);
+  if (nof_out != expected_nof_out) {
+    ERROR("Number of output samples (%d) does not match the expected (%d)", nof_out, expected_nof_out);
+    return SRSRAN_ERROR;
+  }
+
+  // Check the number of input samples for a given number of outputs is consistent with the run, it is exact only when
+  // decimating
+  if (q.up <= q.down) {
+    srsran_resampler_poly_reset_state(&q);
+    uint32_t nof_in = srsran_resampler_poly_get_nof_input(&q, buffer_size);
+    if (srsran_resampler_poly_run(&q, src, NULL, nof_in) != buffer_size) {
+      ERROR("Number of input samples (%d) does not produce %d output samples", nof_in, buffer_size);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Compare with the ideal tone at the output rate, skipping the filter transient
+  double   delay = (double)(q.nof_taps * q.up - 1) / 2.0;
+  uint32_t skip  = 2 * srsran_resampler_poly_get_delay(&q) + 1;
+  double   err   = 0.0;
+  for (uint32_t n = skip; n < nof_out; n++) {
+    double t_in = ((double)n * (double)q.down - delay) / (double)q.up;
+    cf_t   ref  = cexp(_Complex_I * 2.0 * M_PI * f_in * t_in);
+    err += pow(cabsf(resampled[n] - ref), 2.0);
+  }
+  float mse = (float)sqrt(err / (double)(nof_out - skip));
+
+  if (get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    printf("resampled=");
+    srsran_vec_fprint_c(stdout, resampled, nof_out);
+  }
+
+  printf("Done %.1f Msps; up=%d; down=%d; taps=%d; MSE: %.6f\n",
+         total_in / (double)duration_us,
+         q.up,
+         q.down,
+         q.nof_taps,
+         mse);
+
+  srsran_resampler_poly_free(&q);
+  free(src);
+  free(resampled);
+
+  return (mse < 0.01f) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
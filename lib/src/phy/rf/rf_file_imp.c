@@ -435,8 +435,12 @@ int rf_file_set_rx_gain(void* h, double gain)
   double ret = 0.0;
   if (h) {
     rf_file_handler_t* handler = (rf_file_handler_t*)h;
-    handler->rx_gain           = gain;
-    ret                        = gain;
+    // Like hardware devices, the gain is clamped to the advertised range
+    gain = SRSRAN_MIN(SRSRAN_MAX(gain, FILE_MIN_GAIN_DB), FILE_MAX_GAIN_DB);
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    handler->rx_gain = gain;
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+    ret = gain;
   }
   return ret;
 }
@@ -461,7 +465,9 @@ double rf_file_get_rx_gain(void* h)
   double ret = 0.0;
   if (h) {
     rf_file_handler_t* handler = (rf_file_handler_t*)h;
-    ret                        = handler->rx_gain;
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    ret = handler->rx_gain;
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
   }
   return ret;
 }
@@ -28,6 +28,7 @@
 #include <srsran/phy/common/phy_common.h>
 #include <srsran/phy/utils/vector.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 #define PRINT_SAMPLES 0
 #define COMPARE_BITS 0
@@ -37,6 +38,8 @@
 #define SF_LEN (1920)
 #define RF_BUFFER_SIZE (SF_LEN * NUM_SF)
 #define TX_OFFSET_MS (4)
+#define NOF_GAIN_REQUESTS (1000)
+#define GAIN_TIMEOUT_MS (1000)
 
 static cf_t ue_rx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
 static cf_t enb_tx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
@@ -231,6 +234,79 @@ int param_test(const char* args_param, const int num_channels)
   return SRSRAN_SUCCESS;
 }
 
+// Waits until the gain thread has applied the given gain to the device and published it as the current gain
+static int wait_rx_gain(srsran_rf_t* rf, double gain)
+{
+  for (uint32_t i = 0; i < GAIN_TIMEOUT_MS; i++) {
+    double cur_rx_gain = 0.0;
+    __atomic_load(&rf->cur_rx_gain, &cur_rx_gain, __ATOMIC_ACQUIRE);
+    if (cur_rx_gain == gain && srsran_rf_get_rx_gain(rf) == gain) {
+      return SRSRAN_SUCCESS;
+    }
+    usleep(1000);
+  }
+  return SRSRAN_ERROR;
+}
+
+int gain_thread_test(const char* args_param)
+{
+  char rf_args[RF_PARAM_LEN] = {};
+  strncpy(rf_args, (char*)args_param, RF_PARAM_LEN - 1);
+  rf_args[RF_PARAM_LEN - 1] = 0;
+
+  if (srsran_rf_open_devname(&enb_radio, "file", rf_args, 1)) {
+    fprintf(stderr, "Error opening rf\n");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_rf_start_gain_thread(&enb_radio, false)) {
+    fprintf(stderr, "Error starting gain thread\n");
+    srsran_rf_close(&enb_radio);
+    return SRSRAN_ERROR;
+  }
+
+  // Burst of requests as the AGC would issue them from the receive path, only the last one needs to be applied
+  for (uint32_t i = 0; i < NOF_GAIN_REQUESTS; i++) {
+    srsran_rf_set_rx_gain_th(&enb_radio, (i % 2) ? 30.0 : 0.0);
+  }
+  double gain = 15.0;
+  srsran_rf_set_rx_gain_th(&enb_radio, gain);
+
+  int ret = wait_rx_gain(&enb_radio, gain);
+  if (ret != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Rx gain %.1f dB was not applied (current %.1f dB)\n", gain, srsran_rf_get_rx_gain(&enb_radio));
+  }
+
+  // Requests within the hysteresis are ignored
+  if (ret == SRSRAN_SUCCESS) {
+    srsran_rf_set_rx_gain_th(&enb_radio, gain + 1.0);
+    usleep(10000);
+    if (srsran_rf_get_rx_gain(&enb_radio) != gain) {
+      fprintf(stderr, "Rx gain changed within the hysteresis\n");
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  // The device clamps the gain to its maximum. Repeating the same request applies it again, here after the device gain
+  // was changed without the gain thread
+  if (ret == SRSRAN_SUCCESS) {
+    srsran_rf_set_rx_gain_th(&enb_radio, 40.0);
+    ret = wait_rx_gain(&enb_radio, 30.0);
+  }
+  if (ret == SRSRAN_SUCCESS) {
+    srsran_rf_set_rx_gain(&enb_radio, gain);
+    srsran_rf_set_rx_gain_th(&enb_radio, 40.0);
+    ret = wait_rx_gain(&enb_radio, 30.0);
+    if (ret != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Repeated Rx gain request was not applied (current %.1f dB)\n", srsran_rf_get_rx_gain(&enb_radio));
+    }
+  }
+
+  srsran_rf_close(&enb_radio);
+
+  return ret;
+}
+
 void create_file(const char* filename)
 {
   FILE* f = fopen(filename, "w");
@@ -288,6 +364,12 @@ int main()
     return SRSRAN_ERROR;
   }
 
+  // gain requests are applied asynchronously by the gain thread
+  if (gain_thread_test("rx_file=rx_file0")) {
+    fprintf(stderr, "Gain thread test failed!\n");
+    return SRSRAN_ERROR;
+  }
+
 #if NOF_RX_ANT == 1
   // single tx, single rx with continuous transmissions (no decimation, no timed tx)
   if (run_test("rx_file=tx_file0,base_srate=1.92e6", "tx_file=tx_file0,base_srate=1.92e6", false) != SRSRAN_SUCCESS) {
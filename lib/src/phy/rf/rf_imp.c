@@ -39,12 +39,18 @@ int rf_get_available_devices(char** devnames, int max_strlen)
 
 int srsran_rf_set_rx_gain_th(srsran_rf_t* rf, double gain)
 {
-  pthread_mutex_lock(&rf->mutex);
-  if (gain > rf->cur_rx_gain + 2 || gain < rf->cur_rx_gain - 2) {
-    rf->new_rx_gain = gain;
-    pthread_cond_signal(&rf->cond);
+  if (!__atomic_load_n(&rf->thread_gain_run, __ATOMIC_ACQUIRE)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  double cur_rx_gain = 0.0;
+  __atomic_load(&rf->cur_rx_gain, &cur_rx_gain, __ATOMIC_ACQUIRE);
+  if (gain > cur_rx_gain + 2 || gain < cur_rx_gain - 2) {
+    // Overwrite any pending request. The gain thread is woken up even if the same gain was requested before, since the
+    // device may have clamped or rounded it and the applied gain is still outside the hysteresis
+    __atomic_store(&rf->new_rx_gain, &gain, __ATOMIC_RELEASE);
+    sem_post(&rf->gain_sem);
   }
-  pthread_mutex_unlock(&rf->mutex);
   return SRSRAN_SUCCESS;
 }
 
@@ -53,44 +59,53 @@ void srsran_rf_set_tx_rx_gain_offset(srsran_rf_t* rf, double offset)
   rf->tx_rx_gain_offset = offset;
 }
 
-/* This thread listens for set_rx_gain commands to the USRP */
+/* This thread applies the set_rx_gain requests to the device, which may block for several milliseconds */
 static void* thread_gain_fcn(void* h)
 {
   srsran_rf_t* rf = (srsran_rf_t*)h;
 
-  while (rf->thread_gain_run) {
-    pthread_mutex_lock(&rf->mutex);
-    while (rf->cur_rx_gain == rf->new_rx_gain && rf->thread_gain_run) {
-      pthread_cond_wait(&rf->cond, &rf->mutex);
+  while (true) {
+    if (sem_wait(&rf->gain_sem) != 0) {
+      // Interrupted by a signal
+      continue;
     }
-    if (rf->new_rx_gain != rf->cur_rx_gain) {
-      srsran_rf_set_rx_gain(h, rf->new_rx_gain);
-      rf->cur_rx_gain = srsran_rf_get_rx_gain(h);
-      rf->new_rx_gain = rf->cur_rx_gain;
+    // Requests posted while the device was busy are all served by reading the latest one
+    while (sem_trywait(&rf->gain_sem) == 0) {
     }
-    if (rf->tx_gain_same_rx) {
-      srsran_rf_set_tx_gain(h, rf->cur_rx_gain + rf->tx_rx_gain_offset);
+    if (!__atomic_load_n(&rf->thread_gain_run, __ATOMIC_ACQUIRE)) {
+      break;
+    }
+
+    double new_rx_gain = 0.0;
+    double cur_rx_gain = 0.0;
+    __atomic_load(&rf->new_rx_gain, &new_rx_gain, __ATOMIC_ACQUIRE);
+    __atomic_load(&rf->cur_rx_gain, &cur_rx_gain, __ATOMIC_RELAXED);
+    if (new_rx_gain != cur_rx_gain) {
+      srsran_rf_set_rx_gain(rf, new_rx_gain);
+      cur_rx_gain = srsran_rf_get_rx_gain(rf);
+      __atomic_store(&rf->cur_rx_gain, &cur_rx_gain, __ATOMIC_RELEASE);
+      if (rf->tx_gain_same_rx) {
+        srsran_rf_set_tx_gain(rf, cur_rx_gain + rf->tx_rx_gain_offset);
+      }
     }
-    pthread_mutex_unlock(&rf->mutex);
   }
   return NULL;
 }
 
-/* Create auxiliary thread and mutexes for AGC */
+/* Create auxiliary thread and semaphore for AGC */
 int srsran_rf_start_gain_thread(srsran_rf_t* rf, bool tx_gain_same_rx)
 {
   rf->tx_gain_same_rx   = tx_gain_same_rx;
   rf->tx_rx_gain_offset = 0.0;
-  if (pthread_mutex_init(&rf->mutex, NULL)) {
-    return -1;
-  }
-  if (pthread_cond_init(&rf->cond, NULL)) {
+  rf->new_rx_gain       = rf->cur_rx_gain;
+  if (sem_init(&rf->gain_sem, 0, 0)) {
     return -1;
   }
-  rf->thread_gain_run = true;
+  __atomic_store_n(&rf->thread_gain_run, true, __ATOMIC_RELEASE);
   if (pthread_create(&rf->thread_gain, NULL, thread_gain_fcn, rf)) {
     perror("pthread_create");
-    rf->thread_gain_run = false;
+    __atomic_store_n(&rf->thread_gain_run, false, __ATOMIC_RELEASE);
+    sem_destroy(&rf->gain_sem);
     return -1;
   }
   return 0;
@@ -154,7 +169,8 @@ int srsran_rf_open_devname(srsran_rf_t* rf, const char* devname, char* args, uin
 
 int srsran_rf_open_file(srsran_rf_t* rf, FILE** rx_files, FILE** tx_files, uint32_t nof_channels, uint32_t base_srate)
 {
-  rf->dev = &srsran_rf_dev_file;
+  rf->dev             = &srsran_rf_dev_file;
+  rf->thread_gain_run = false;
 
   // file abstraction has custom "open" function with file-related args
   return rf_file_open_file(&rf->handler, rx_files, tx_files, nof_channels, base_srate);
@@ -213,14 +229,10 @@ int srsran_rf_open_multi(srsran_rf_t* h, char* args, uint32_t nof_channels)
 int srsran_rf_close(srsran_rf_t* rf)
 {
   // Stop gain thread
-  pthread_mutex_lock(&rf->mutex);
-  if (rf->thread_gain_run) {
-    rf->thread_gain_run = false;
-  }
-  pthread_mutex_unlock(&rf->mutex);
-  pthread_cond_signal(&rf->cond);
-  if (rf->thread_gain) {
+  if (__atomic_exchange_n(&rf->thread_gain_run, false, __ATOMIC_ACQ_REL)) {
+    sem_post(&rf->gain_sem);
     pthread_join(rf->thread_gain, NULL);
+    sem_destroy(&rf->gain_sem);
   }
 
   return ((rf_dev_t*)rf->dev)->srsran_rf_close(rf->handler);
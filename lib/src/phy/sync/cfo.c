@@ -25,52 +25,18 @@
 #include <strings.h>
 
 #include "srsran/phy/sync/cfo.h"
-#include "srsran/phy/utils/cexptab.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
-/* Set next macro to 1 for using table generated CFO compensation */
-#define SRSRAN_CFO_USE_EXP_TABLE 0
-
 int srsran_cfo_init(srsran_cfo_t* h, uint32_t nsamples)
 {
-#if SRSRAN_CFO_USE_EXP_TABLE
-  int ret = SRSRAN_ERROR;
   bzero(h, sizeof(srsran_cfo_t));
-
-  if (srsran_cexptab_init(&h->tab, SRSRAN_CFO_CEXPTAB_SIZE)) {
-    goto clean;
-  }
-  h->cur_cexp = srsran_vec_cf_malloc(nsamples);
-  if (!h->cur_cexp) {
-    goto clean;
-  }
-  h->tol         = 0;
-  h->last_freq   = 0;
-  h->nsamples    = nsamples;
-  h->max_samples = nsamples;
-  srsran_cexptab_gen(&h->tab, h->cur_cexp, h->last_freq, h->nsamples);
-
-  ret = SRSRAN_SUCCESS;
-clean:
-  if (ret == SRSRAN_ERROR) {
-    srsran_cfo_free(h);
-  }
-  return ret;
-#else  /* SRSRAN_CFO_USE_EXP_TABLE */
   h->nsamples = nsamples;
   return SRSRAN_SUCCESS;
-#endif /* SRSRAN_CFO_USE_EXP_TABLE */
 }
 
 void srsran_cfo_free(srsran_cfo_t* h)
 {
-#if SRSRAN_CFO_USE_EXP_TABLE
-  srsran_cexptab_free(&h->tab);
-  if (h->cur_cexp) {
-    free(h->cur_cexp);
-  }
-#endif /* SRSRAN_CFO_USE_EXP_TABLE */
   bzero(h, sizeof(srsran_cfo_t));
 }
 
@@ -81,36 +47,18 @@ void srsran_cfo_set_tol(srsran_cfo_t* h, float tol)
 
 int srsran_cfo_resize(srsran_cfo_t* h, uint32_t samples)
 {
-#if SRSRAN_CFO_USE_EXP_TABLE
-  if (samples <= h->max_samples) {
-    srsran_cexptab_gen(&h->tab, h->cur_cexp, h->last_freq, samples);
-    h->nsamples = samples;
-  } else {
-    ERROR("Error in cfo_resize(): nof_samples must be lower than initialized");
-    return SRSRAN_ERROR;
-  }
-#endif /* SRSRAN_CFO_USE_EXP_TABLE */
+  h->nsamples = samples;
   return SRSRAN_SUCCESS;
 }
 
 void srsran_cfo_correct(srsran_cfo_t* h, const cf_t* input, cf_t* output, float freq)
 {
-#if SRSRAN_CFO_USE_EXP_TABLE
-  if (fabs(h->last_freq - freq) > h->tol) {
-    h->last_freq = freq;
-    srsran_cexptab_gen(&h->tab, h->cur_cexp, h->last_freq, h->nsamples);
-    DEBUG("CFO generating new table for frequency %.4fe-6", freq * 1e6);
-  }
-  srsran_vec_prod_ccc(h->cur_cexp, input, output, h->nsamples);
-#else  /* SRSRAN_CFO_USE_EXP_TABLE */
-  srsran_vec_apply_cfo(input, freq, output, h->nsamples);
-#endif /* SRSRAN_CFO_USE_EXP_TABLE */
+  h->last_freq = freq;
+  srsran_vec_apply_cfo_phase(input, freq, 0.0, output, h->nsamples);
 }
 
-/* CFO correction which allows to specify the offset within the correction
- * table to allow phase-continuity across multi-subframe transmissions (NB-IoT)
- * Note that when correction table needs to be regenerated, the regeneration
- * takes place for the maximum number of samples
+/* CFO correction which allows to specify the sample offset within the subframe to allow phase-continuity across
+ * multi-subframe transmissions (NB-IoT)
  */
 void srsran_cfo_correct_offset(srsran_cfo_t* h,
                                const cf_t*   input,
@@ -119,12 +67,31 @@ void srsran_cfo_correct_offset(srsran_cfo_t* h,
                                int           cexp_offset,
                                int           nsamples)
 {
-  if (fabs(h->last_freq - freq) > h->tol) {
-    h->last_freq = freq;
-    srsran_cexptab_gen(&h->tab, h->cur_cexp, h->last_freq, h->nsamples);
-    DEBUG("CFO generating new table for frequency %.4fe-6", freq * 1e6);
+  h->last_freq = freq;
+  srsran_vec_apply_cfo_phase(input, freq, (double)freq * (double)cexp_offset, output, nsamples);
+}
+
+void srsran_cfo_correct_continuous(srsran_cfo_t* h,
+                                   cf_t* const*  input,
+                                   cf_t* const*  output,
+                                   uint32_t      nof_channels,
+                                   float         freq)
+{
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    if (input[i] != NULL) {
+      srsran_vec_apply_cfo_phase(input[i], freq, h->phase, output[i], h->nsamples);
+    }
   }
-  srsran_vec_prod_ccc(&h->cur_cexp[cexp_offset], input, output, nsamples);
+
+  // Advance the oscillator phase, wrapped to [0, 1) cycles
+  h->phase += (double)freq * (double)h->nsamples;
+  h->phase -= floor(h->phase);
+  h->last_freq = freq;
+}
+
+void srsran_cfo_reset_phase(srsran_cfo_t* h)
+{
+  h->phase = 0.0;
 }
 
 float srsran_cfo_est_corr_cp(cf_t* input_buffer, uint32_t nof_prb)
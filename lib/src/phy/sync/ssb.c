@@ -43,6 +43,12 @@
  */
 #define SSB_CORR_SZ(SYMB_SZ) SRSRAN_MIN(1U << (uint32_t)ceil(log2((double)(SYMB_SZ)) + 3.0), 1U << 13U)
 
+/*
+ * Number of subcarriers added at each side of the PSS in the narrowband correlation. They keep the spectral leakage of
+ * the correlation window and the PSS offset from the SSB center.
+ */
+#define SSB_CORR_NB_GUARD_SC 4
+
 /*
  * Default NR-PBCH DMRS normalised correlation (RSRP/EPRE) threshold
  */
@@ -58,8 +64,9 @@ static int ssb_init_corr(srsran_ssb_t* q)
   // For each PSS sequence allocate
   for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
     // Allocate sequences
-    q->pss_seq[N_id_2] = srsran_vec_cf_malloc(q->max_corr_sz);
-    if (q->pss_seq[N_id_2] == NULL) {
+    q->pss_seq[N_id_2]    = srsran_vec_cf_malloc(q->max_corr_sz);
+    q->pss_seq_nb[N_id_2] = srsran_vec_cf_malloc(q->max_corr_sz);
+    if (q->pss_seq[N_id_2] == NULL || q->pss_seq_nb[N_id_2] == NULL) {
       ERROR("Malloc");
       return SRSRAN_ERROR;
     }
@@ -159,6 +166,9 @@ void srsran_ssb_free(srsran_ssb_t* q)
     if (q->pss_seq[N_id_2] != NULL) {
       free(q->pss_seq[N_id_2]);
     }
+    if (q->pss_seq_nb[N_id_2] != NULL) {
+      free(q->pss_seq_nb[N_id_2]);
+    }
   }
 
   if (q->sf_buffer != NULL) {
@@ -169,6 +179,7 @@ void srsran_ssb_free(srsran_ssb_t* q)
   srsran_dft_plan_free(&q->fft);
   srsran_dft_plan_free(&q->fft_corr);
   srsran_dft_plan_free(&q->ifft_corr);
+  srsran_dft_plan_free(&q->ifft_corr_nb);
   srsran_pbch_nr_free(&q->pbch);
 
   SRSRAN_MEM_ZERO(q, srsran_ssb_t, 1);
@@ -348,11 +359,10 @@ static int ssb_setup_corr(srsran_ssb_t* q)
   // Compute new correlation size
   uint32_t corr_sz = SSB_CORR_SZ(q->symbol_sz);
 
-  // Skip if the symbol size is unchanged
-  if (q->corr_sz == corr_sz) {
+  // Skip if the symbol size and the SSB frequency offset are unchanged
+  if (q->corr_sz == corr_sz && q->corr_f_offset == q->f_offset) {
     return SRSRAN_SUCCESS;
   }
-  q->corr_sz = corr_sz;
 
   // Select correlation window, return error if the correlation window is smaller than a symbol
   if (corr_sz < 2 * q->symbol_sz) {
@@ -361,21 +371,48 @@ static int ssb_setup_corr(srsran_ssb_t* q)
   }
   q->corr_window = corr_sz - q->symbol_sz;
 
-  // Free correlation
-  srsran_dft_plan_free(&q->fft_corr);
-  srsran_dft_plan_free(&q->ifft_corr);
-
-  // Prepare correlation FFT
-  if (srsran_dft_plan_guru_c(&q->fft_corr, (int)corr_sz, SRSRAN_DFT_FORWARD, q->tmp_time, q->tmp_freq, 1, 1, 1, 1, 1) <
-      SRSRAN_SUCCESS) {
-    ERROR("Error planning correlation DFT");
-    return SRSRAN_ERROR;
+  // Select the narrowband correlation size, the smallest power of two that covers the PSS and the guards
+  double   corr_bins_per_sc = (double)corr_sz / (double)q->symbol_sz;
+  uint32_t corr_nb_sz       = 1;
+  while (corr_nb_sz < corr_sz &&
+         corr_nb_sz < (uint32_t)ceil((SRSRAN_PSS_NR_LEN + 2 * SSB_CORR_NB_GUARD_SC) * corr_bins_per_sc)) {
+    corr_nb_sz *= 2;
   }
-  if (srsran_dft_plan_guru_c(
-          &q->ifft_corr, (int)corr_sz, SRSRAN_DFT_BACKWARD, q->tmp_corr, q->tmp_time, 1, 1, 1, 1, 1) < SRSRAN_SUCCESS) {
-    ERROR("Error planning correlation DFT");
-    return SRSRAN_ERROR;
+
+  // Replan the DFTs only if the correlation size changed
+  if (q->corr_sz != corr_sz) {
+    q->corr_sz    = corr_sz;
+    q->corr_nb_sz = corr_nb_sz;
+
+    // Free correlation
+    srsran_dft_plan_free(&q->fft_corr);
+    srsran_dft_plan_free(&q->ifft_corr);
+    srsran_dft_plan_free(&q->ifft_corr_nb);
+
+    // Prepare correlation FFT
+    if (srsran_dft_plan_guru_c(
+            &q->fft_corr, (int)corr_sz, SRSRAN_DFT_FORWARD, q->tmp_time, q->tmp_freq, 1, 1, 1, 1, 1) < SRSRAN_SUCCESS) {
+      ERROR("Error planning correlation DFT");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_dft_plan_guru_c(
+            &q->ifft_corr, (int)corr_sz, SRSRAN_DFT_BACKWARD, q->tmp_corr, q->tmp_time, 1, 1, 1, 1, 1) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error planning correlation DFT");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_dft_plan_guru_c(
+            &q->ifft_corr_nb, (int)corr_nb_sz, SRSRAN_DFT_BACKWARD, q->tmp_corr, q->tmp_time, 1, 1, 1, 1, 1) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error planning correlation DFT");
+      return SRSRAN_ERROR;
+    }
   }
+  q->corr_f_offset = q->f_offset;
+
+  // The narrowband correlation is centered in the PSS of the configured SSB
+  int32_t corr_nb_start = (int32_t)round(q->f_offset * corr_bins_per_sc) - (int32_t)corr_nb_sz / 2;
+  q->corr_nb_start      = (uint32_t)((corr_nb_start % (int32_t)corr_sz + (int32_t)corr_sz) % (int32_t)corr_sz);
 
   // Zero the time domain signal last samples
   srsran_vec_cf_zero(&q->tmp_time[q->symbol_sz], q->corr_window);
@@ -399,6 +436,11 @@ static int ssb_setup_corr(srsran_ssb_t* q)
 
     // Copy frequency domain sequence
     srsran_vec_cf_copy(q->pss_seq[N_id_2], q->tmp_freq, q->corr_sz);
+
+    // Copy the narrowband bins, they may wrap around the end of the sequence
+    uint32_t n = SRSRAN_MIN(q->corr_nb_sz, q->corr_sz - q->corr_nb_start);
+    srsran_vec_cf_copy(q->pss_seq_nb[N_id_2], &q->pss_seq[N_id_2][q->corr_nb_start], n);
+    srsran_vec_cf_copy(&q->pss_seq_nb[N_id_2][n], q->pss_seq[N_id_2], q->corr_nb_sz - n);
   }
 
   return SRSRAN_SUCCESS;
@@ -674,6 +716,7 @@ int srsran_ssb_add(srsran_ssb_t* q, uint32_t N_id, const srsran_pbch_msg_nr_t* m
 static int ssb_demodulate(srsran_ssb_t* q,
                           const cf_t*   in,
                           uint32_t      t_offset,
+                          int32_t       f_offset,
                           float         coarse_cfo_hz,
                           cf_t          ssb_grid[SRSRAN_SSB_NOF_RE])
 {
@@ -705,16 +748,15 @@ static int ssb_demodulate(srsran_ssb_t* q,
     cf_t* ptr = &ssb_grid[l * SRSRAN_SSB_BW_SUBC];
 
     // Map frequency domain symbol into the SSB grid
-    if (q->f_offset >= SRSRAN_SSB_BW_SUBC / 2) {
-      srsran_vec_cf_copy(ptr, &q->tmp_freq[q->f_offset - SRSRAN_SSB_BW_SUBC / 2], SRSRAN_SSB_BW_SUBC);
-    } else if (q->f_offset <= -SRSRAN_SSB_BW_SUBC / 2) {
-      srsran_vec_cf_copy(ptr, &q->tmp_freq[q->symbol_sz + q->f_offset - SRSRAN_SSB_BW_SUBC / 2], SRSRAN_SSB_BW_SUBC);
+    if (f_offset >= SRSRAN_SSB_BW_SUBC / 2) {
+      srsran_vec_cf_copy(ptr, &q->tmp_freq[f_offset - SRSRAN_SSB_BW_SUBC / 2], SRSRAN_SSB_BW_SUBC);
+    } else if (f_offset <= -SRSRAN_SSB_BW_SUBC / 2) {
+      srsran_vec_cf_copy(ptr, &q->tmp_freq[q->symbol_sz + f_offset - SRSRAN_SSB_BW_SUBC / 2], SRSRAN_SSB_BW_SUBC);
     } else {
-      srsran_vec_cf_copy(
-          &ptr[SRSRAN_SSB_BW_SUBC / 2 - q->f_offset], &q->tmp_freq[0], SRSRAN_SSB_BW_SUBC / 2 + q->f_offset);
+      srsran_vec_cf_copy(&ptr[SRSRAN_SSB_BW_SUBC / 2 - f_offset], &q->tmp_freq[0], SRSRAN_SSB_BW_SUBC / 2 + f_offset);
       srsran_vec_cf_copy(&ptr[0],
-                         &q->tmp_freq[q->symbol_sz - SRSRAN_SSB_BW_SUBC / 2 + q->f_offset],
-                         SRSRAN_SSB_BW_SUBC / 2 - q->f_offset);
+                         &q->tmp_freq[q->symbol_sz - SRSRAN_SSB_BW_SUBC / 2 + f_offset],
+                         SRSRAN_SSB_BW_SUBC / 2 - f_offset);
     }
 
     // Normalize
@@ -850,12 +892,79 @@ static void ssb_vec_prod_conj_circ_shift(const cf_t* a, const cf_t* b, cf_t* c,
   srsran_vec_prod_conj_ccc(a, b, c, n);
 }
 
-static int ssb_pss_search(srsran_ssb_t* q,
-                          const cf_t*   in,
-                          uint32_t      nof_samples,
-                          uint32_t*     found_N_id_2,
-                          uint32_t*     found_delay,
-                          float*        coarse_cfo_hz)
+/*
+ * Narrowband version of ssb_vec_prod_conj_circ_shift(), it only computes the corr_nb_sz products of the bins the
+ * narrowband PSS sequences were taken from
+ */
+static void ssb_vec_prod_conj_circ_shift_nb(const srsran_ssb_t* q, const cf_t* a, const cf_t* b_nb, cf_t* c, int shift)
+{
+  int32_t  n       = (int32_t)q->corr_sz;
+  uint32_t a_start = (uint32_t)((((int32_t)q->corr_nb_start - shift) % n + n) % n);
+
+  // The shifted input may wrap around the end of the correlation buffer
+  uint32_t first = SRSRAN_MIN(q->corr_nb_sz, q->corr_sz - a_start);
+  srsran_vec_prod_conj_ccc(&a[a_start], b_nb, c, first);
+  srsran_vec_prod_conj_ccc(&a[0], &b_nb[first], &c[first], q->corr_nb_sz - first);
+}
+
+/*
+ * PSS search state for an SSB center frequency candidate
+ */
+typedef struct {
+  int32_t  f_offset;    ///< SSB integer frequency offset (multiple of SCS) between DC and the SSB center
+  double   corr_offset; ///< Frequency offset with respect to the configured SSB in correlation bins
+  int      shift_base;  ///< Integer correlation shift that compensates the frequency offset
+  float    best_corr;   ///< Best normalised correlation
+  uint32_t best_delay;  ///< Time offset of the best correlation
+  uint32_t best_N_id_2; ///< PSS sequence of the best correlation
+  int      best_shift;  ///< Correlation shift of the best correlation
+} ssb_pss_candidate_t;
+
+static void ssb_pss_candidate_init(const srsran_ssb_t* q, ssb_pss_candidate_t* c, int32_t f_offset)
+{
+  SRSRAN_MEM_ZERO(c, ssb_pss_candidate_t, 1);
+  c->f_offset = f_offset;
+
+  // A frequency offset of one subcarrier is equivalent to corr_sz / symbol_sz correlation bins. The correlation shift
+  // is opposite to the offset
+  c->corr_offset = -(double)(f_offset - q->f_offset) * (double)q->corr_sz / (double)q->symbol_sz;
+  c->shift_base  = (int)round(c->corr_offset);
+}
+
+// Copies the correlation window starting at t_offset into the correlation buffer and converts it to frequency domain
+static void ssb_pss_corr_fft(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, uint32_t t_offset)
+{
+  // Number of samples taken in this iteration
+  uint32_t n = q->corr_sz;
+
+  // Detect if the correlation input exceeds the input length, take the maximum amount of samples
+  if (t_offset + q->corr_sz > nof_samples) {
+    n = nof_samples - t_offset;
+  }
+
+  // Copy the amount of samples
+  srsran_vec_cf_copy(q->tmp_time, &in[t_offset], n);
+
+  // Append zeros if there is space left
+  if (n < q->corr_sz) {
+    srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
+  }
+
+  // Convert to frequency domain
+  srsran_dft_run_guru_c(&q->fft_corr);
+}
+
+/*
+ * Searches the PSS for all the given SSB center frequency candidates. Every correlation window is converted to
+ * frequency domain once and it is correlated with every candidate and PSS sequence by shifting the input in frequency
+ * domain. The coarse search only transforms the PSS bandwidth back to time domain, which decimates the correlation, so
+ * the delay of every candidate is refined afterwards with a full size correlation around the coarse peak.
+ */
+static int ssb_pss_search_multi(srsran_ssb_t*        q,
+                                const cf_t*          in,
+                                uint32_t             nof_samples,
+                                ssb_pss_candidate_t* candidates,
+                                uint32_t             nof_candidates)
 {
   // verify it is initialised
   if (q->corr_sz == 0) {
@@ -871,63 +980,51 @@ static int ssb_pss_search(srsran_ssb_t* q,
   // Calculate the coarse shift increment for half of the subcarrier spacing
   int shift_coarse_inc = shift_range / 2;
 
-  // Correlation best sequence
-  float    best_corr   = 0;
-  uint32_t best_delay  = 0;
-  uint32_t best_N_id_2 = 0;
-  int      best_shift  = 0;
+  // Decimation of the narrowband correlation and number of decimated samples in the correlation window
+  uint32_t decimation    = q->corr_sz / q->corr_nb_sz;
+  uint32_t corr_window_d = SRSRAN_CEIL(q->corr_window, decimation);
 
   // Delay in correlation window
   uint32_t t_offset = 0;
   while ((t_offset + q->symbol_sz) < nof_samples) {
-    // Number of samples taken in this iteration
-    uint32_t n = q->corr_sz;
-
-    // Detect if the correlation input exceeds the input length, take the maximum amount of samples
-    if (t_offset + q->corr_sz > nof_samples) {
-      n = nof_samples - t_offset;
-    }
-
-    // Copy the amount of samples
-    srsran_vec_cf_copy(q->tmp_time, &in[t_offset], n);
-
-    // Append zeros if there is space left
-    if (n < q->corr_sz) {
-      srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
-    }
-
-    // Convert to frequency domain
-    srsran_dft_run_guru_c(&q->fft_corr);
-
-    // Try each N_id_2 sequence
-    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
-      // Steer coarse frequency offset
-      for (int shift = -shift_range; shift <= shift_range; shift += shift_coarse_inc) {
-        // Actual correlation in frequency domain
-        ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[N_id_2], q->tmp_corr, q->corr_sz, shift);
-
-        // Convert to time domain
-        srsran_dft_run_guru_c(&q->ifft_corr);
-
-        // Find maximum
-        uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, q->corr_window);
-
-        // Average power, take total power of the frequency domain signal after filtering, skip correlation window if
-        // value is invalid (0.0, nan or inf)
-        float avg_pwr_corr = srsran_vec_avg_power_cf(q->tmp_corr, q->corr_sz);
-        if (!isnormal(avg_pwr_corr)) {
-          continue;
-        }
-
-        // Normalise correlation
-        float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
-
-        // Update if the correlation is better than the current best
-        if (best_corr < corr) {
-          best_corr   = corr;
-          best_delay  = peak_idx + t_offset;
-          best_N_id_2 = N_id_2;
-          best_shift  = shift;
+    // Convert to frequency domain, shared by all candidates
+    ssb_pss_corr_fft(q, in, nof_samples, t_offset);
+
+    // Try each candidate
+    for (uint32_t i = 0; i < nof_candidates; i++) {
+      ssb_pss_candidate_t* c = &candidates[i];
+
+      // Try each N_id_2 sequence
+      for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
+        // Steer coarse frequency offset
+        for (int shift = -shift_range; shift <= shift_range; shift += shift_coarse_inc) {
+          // Actual correlation in frequency domain, only in the PSS bandwidth
+          ssb_vec_prod_conj_circ_shift_nb(q, q->tmp_freq, q->pss_seq_nb[N_id_2], q->tmp_corr, c->shift_base + shift);
+
+          // Convert to time domain
+          srsran_dft_run_guru_c(&q->ifft_corr_nb);
+
+          // Find maximum
+          uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, corr_window_d);
+
+          // Average power, take total power of the frequency domain signal after filtering, skip correlation window if
+          // value is invalid (0.0, nan or inf). The bins outside the PSS bandwidth are considered null
+          float avg_pwr_corr =
+              srsran_vec_avg_power_cf(q->tmp_corr, q->corr_nb_sz) * (float)q->corr_nb_sz / (float)q->corr_sz;
+          if (!isnormal(avg_pwr_corr)) {
+            continue;
+          }
+
+          // Normalise correlation
+          float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
+
+          // Update if the correlation is better than the current best
+          if (c->best_corr < corr) {
+            c->best_corr   = corr;
+            c->best_delay  = peak_idx * decimation + t_offset;
+            c->best_N_id_2 = N_id_2;
+            c->best_shift  = c->shift_base + shift;
+          }
         }
       }
     }
@@ -936,49 +1033,65 @@ static int ssb_pss_search(srsran_ssb_t* q,
     t_offset += q->corr_window;
   }
 
-  // From the best sequence correlate in frequency domain
-  {
-    // Reset best correlation
-    best_corr = 0.0f;
-
-    // Number of samples taken in this iteration
-    uint32_t n = q->corr_sz;
+  // Refine the delay of each candidate around the decimated peak with a full size correlation
+  for (uint32_t i = 0; i < nof_candidates && decimation > 1; i++) {
+    ssb_pss_candidate_t* c = &candidates[i];
 
-    // Detect if the correlation input exceeds the input length, take the maximum amount of samples
-    if (best_delay + q->corr_sz > nof_samples) {
-      n = nof_samples - best_delay;
-    }
+    // The peak is within one decimation step of the coarse delay
+    uint32_t t_start = (c->best_delay > decimation) ? (c->best_delay - decimation) : 0;
+    ssb_pss_corr_fft(q, in, nof_samples, t_start);
+    ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[c->best_N_id_2], q->tmp_corr, q->corr_sz, c->best_shift);
+    srsran_dft_run_guru_c(&q->ifft_corr);
+    c->best_delay = t_start + srsran_vec_max_abs_ci(q->tmp_time, SRSRAN_MIN(2 * decimation + 1, q->corr_window));
+  }
 
-    // Copy the amount of samples
-    srsran_vec_cf_copy(q->tmp_time, &in[best_delay], n);
+  // From the best sequence of each candidate correlate in frequency domain
+  for (uint32_t i = 0; i < nof_candidates; i++) {
+    ssb_pss_candidate_t* c = &candidates[i];
 
-    // Append zeros if there is space left
-    if (n < q->corr_sz) {
-      srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
-    }
+    // Reset best correlation
+    float best_corr = 0.0f;
 
-    // Convert to frequency domain
-    srsran_dft_run_guru_c(&q->fft_corr);
+    // Convert to frequency domain, the time domain buffer is overwritten by the correlation IFFT
+    ssb_pss_corr_fft(q, in, nof_samples, c->best_delay);
 
     for (int shift = -shift_range; shift <= shift_range; shift++) {
       // Actual correlation in frequency domain
-      ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[best_N_id_2], q->tmp_corr, q->corr_sz, shift);
+      ssb_vec_prod_conj_circ_shift(
+          q->tmp_freq, q->pss_seq[c->best_N_id_2], q->tmp_corr, q->corr_sz, c->shift_base + shift);
 
       // Calculate correlation assuming the peak is in the first sample
       float corr = SRSRAN_CSQABS(srsran_vec_acc_cc(q->tmp_corr, q->corr_sz));
 
       // Update if the correlation is better than the current best
       if (best_corr < corr) {
-        best_corr  = corr;
-        best_shift = shift;
+        best_corr     = corr;
+        c->best_shift = c->shift_base + shift;
       }
     }
   }
 
+  return SRSRAN_SUCCESS;
+}
+
+static int ssb_pss_search(srsran_ssb_t* q,
+                          const cf_t*   in,
+                          uint32_t      nof_samples,
+                          uint32_t*     found_N_id_2,
+                          uint32_t*     found_delay,
+                          float*        coarse_cfo_hz)
+{
+  // Search only for the configured SSB center frequency
+  ssb_pss_candidate_t candidate = {};
+  ssb_pss_candidate_init(q, &candidate, q->f_offset);
+  if (ssb_pss_search_multi(q, in, nof_samples, &candidate, 1) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Save findings
-  *found_delay   = best_delay;
-  *found_N_id_2  = best_N_id_2;
-  *coarse_cfo_hz = -(float)best_shift * coarse_cfo_ref_hz;
+  *found_delay   = candidate.best_delay;
+  *found_N_id_2  = candidate.best_N_id_2;
+  *coarse_cfo_hz = -(float)candidate.best_shift * (q->cfg.srate_hz / q->corr_sz);
 
   return SRSRAN_SUCCESS;
 }
@@ -1029,7 +1142,7 @@ int srsran_ssb_csi_search(srsran_ssb_t*                  q,
 
   // Demodulate
   cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
-  if (ssb_demodulate(q, in, t_offset, coarse_cfo_hz, ssb_grid) < SRSRAN_SUCCESS) {
+  if (ssb_demodulate(q, in, t_offset, q->f_offset, coarse_cfo_hz, ssb_grid) < SRSRAN_SUCCESS) {
     ERROR("Error demodulating");
     return SRSRAN_ERROR;
   }
@@ -1082,7 +1195,7 @@ int srsran_ssb_csi_measure(srsran_ssb_t*                  q,
 
   // Demodulate
   cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
-  if (ssb_demodulate(q, in, (uint32_t)t_offset, 0.0f, ssb_grid) < SRSRAN_SUCCESS) {
+  if (ssb_demodulate(q, in, (uint32_t)t_offset, q->f_offset, 0.0f, ssb_grid) < SRSRAN_SUCCESS) {
     ERROR("Error demodulating");
     return SRSRAN_ERROR;
   }
@@ -1253,7 +1366,7 @@ int srsran_ssb_decode_pbch(srsran_ssb_t*         q,
 
   // Demodulate
   cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
-  if (ssb_demodulate(q, in, (uint32_t)t_offset, 0.0f, ssb_grid) < SRSRAN_SUCCESS) {
+  if (ssb_demodulate(q, in, (uint32_t)t_offset, q->f_offset, 0.0f, ssb_grid) < SRSRAN_SUCCESS) {
     ERROR("Error demodulating");
     return SRSRAN_ERROR;
   }
@@ -1267,32 +1380,17 @@ int srsran_ssb_decode_pbch(srsran_ssb_t*         q,
   return SRSRAN_SUCCESS;
 }
 
-int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res)
+// Demodulates the SSB found by the PSS search, finds N_id_1 and decodes the PBCH. The result is written in res only if
+// the PBCH is decoded successfully
+static int ssb_search_decode(srsran_ssb_t*            q,
+                             const cf_t*              in,
+                             uint32_t                 nof_samples,
+                             uint32_t                 N_id_2,
+                             uint32_t                 t_offset,
+                             int32_t                  f_offset,
+                             float                    coarse_cfo_hz,
+                             srsran_ssb_search_res_t* res)
 {
-  // Verify inputs
-  if (q == NULL || in == NULL || res == NULL || !isnormal(q->scs_hz)) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
-  if (!q->args.enable_search || !q->args.enable_decode) {
-    ERROR("SSB is not configured to search (%c) and decode (%c)",
-          q->args.enable_search ? 'y' : 'n',
-          q->args.enable_decode ? 'y' : 'n');
-    return SRSRAN_ERROR;
-  }
-
-  // Set the SSB search result with default value with PBCH CRC unmatched, meaning no cell is found
-  SRSRAN_MEM_ZERO(res, srsran_ssb_search_res_t, 1);
-
-  // Search for PSS in time domain
-  uint32_t N_id_2        = 0;
-  uint32_t t_offset      = 0;
-  float    coarse_cfo_hz = 0.0f;
-  if (ssb_pss_search(q, in, nof_samples, &N_id_2, &t_offset, &coarse_cfo_hz) < SRSRAN_SUCCESS) {
-    ERROR("Error searching for N_id_2");
-    return SRSRAN_ERROR;
-  }
-
   // Remove CP offset prior demodulation
   if (t_offset >= q->cp_sz) {
     t_offset -= q->cp_sz;
@@ -1307,7 +1405,7 @@ int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srs
 
   // Demodulate
   cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
-  if (ssb_demodulate(q, in, t_offset, coarse_cfo_hz, ssb_grid) < SRSRAN_SUCCESS) {
+  if (ssb_demodulate(q, in, t_offset, f_offset, coarse_cfo_hz, ssb_grid) < SRSRAN_SUCCESS) {
     ERROR("Error demodulating");
     return SRSRAN_ERROR;
   }
@@ -1366,6 +1464,98 @@ int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srs
   return SRSRAN_SUCCESS;
 }
 
+int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res)
+{
+  // Verify inputs
+  if (q == NULL || in == NULL || res == NULL || !isnormal(q->scs_hz)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->args.enable_search || !q->args.enable_decode) {
+    ERROR("SSB is not configured to search (%c) and decode (%c)",
+          q->args.enable_search ? 'y' : 'n',
+          q->args.enable_decode ? 'y' : 'n');
+    return SRSRAN_ERROR;
+  }
+
+  // Set the SSB search result with default value with PBCH CRC unmatched, meaning no cell is found
+  SRSRAN_MEM_ZERO(res, srsran_ssb_search_res_t, 1);
+
+  // Search for PSS in time domain
+  uint32_t N_id_2        = 0;
+  uint32_t t_offset      = 0;
+  float    coarse_cfo_hz = 0.0f;
+  if (ssb_pss_search(q, in, nof_samples, &N_id_2, &t_offset, &coarse_cfo_hz) < SRSRAN_SUCCESS) {
+    ERROR("Error searching for N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  return ssb_search_decode(q, in, nof_samples, N_id_2, t_offset, q->f_offset, coarse_cfo_hz, res);
+}
+
+int srsran_ssb_search_multi(srsran_ssb_t*            q,
+                            const cf_t*              in,
+                            uint32_t                 nof_samples,
+                            const double*            ssb_freq_hz,
+                            uint32_t                 nof_freqs,
+                            srsran_ssb_search_res_t* res)
+{
+  // Verify inputs
+  if (q == NULL || in == NULL || ssb_freq_hz == NULL || res == NULL || !isnormal(q->scs_hz) ||
+      nof_freqs > SRSRAN_SSB_MAX_SEARCH_FREQS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->args.enable_search || !q->args.enable_decode) {
+    ERROR("SSB is not configured to search (%c) and decode (%c)",
+          q->args.enable_search ? 'y' : 'n',
+          q->args.enable_decode ? 'y' : 'n');
+    return SRSRAN_ERROR;
+  }
+
+  // Prepare the candidates
+  ssb_pss_candidate_t candidates[SRSRAN_SSB_MAX_SEARCH_FREQS];
+  for (uint32_t i = 0; i < nof_freqs; i++) {
+    // Calculate SSB integer frequency offset and check
+    double  freq_offset_hz = ssb_freq_hz[i] - q->cfg.center_freq_hz;
+    int32_t f_offset       = (int32_t)round(freq_offset_hz / q->scs_hz);
+    if (fabs(((double)f_offset * q->scs_hz) - freq_offset_hz) > SSB_FREQ_OFFSET_MAX_ERROR_HZ) {
+      ERROR("SSB Offset (%.1f kHz) error exceeds maximum allowed", freq_offset_hz / 1e3);
+      return SRSRAN_ERROR;
+    }
+
+    // The whole SSB must fit in the base-band
+    if ((uint32_t)abs(f_offset) + SRSRAN_SSB_BW_SUBC / 2 > q->symbol_sz / 2) {
+      ERROR("SSB Offset (%.1f kHz) exceeds the base-band bandwidth", freq_offset_hz / 1e3);
+      return SRSRAN_ERROR;
+    }
+
+    ssb_pss_candidate_init(q, &candidates[i], f_offset);
+  }
+
+  // Search for PSS in time domain for all candidates at once
+  if (ssb_pss_search_multi(q, in, nof_samples, candidates, nof_freqs) < SRSRAN_SUCCESS) {
+    ERROR("Error searching for N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  // Demodulate and decode each candidate at its own frequency offset
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < nof_freqs && ret == SRSRAN_SUCCESS; i++) {
+    const ssb_pss_candidate_t* c = &candidates[i];
+
+    // Set the SSB search result with default value with PBCH CRC unmatched, meaning no cell is found
+    SRSRAN_MEM_ZERO(&res[i], srsran_ssb_search_res_t, 1);
+
+    // Compensate the residual of the frequency offset rounding in the coarse CFO
+    float coarse_cfo_hz = -(float)((c->best_shift - c->corr_offset) * (q->cfg.srate_hz / q->corr_sz));
+
+    ret = ssb_search_decode(q, in, nof_samples, c->best_N_id_2, c->best_delay, c->f_offset, coarse_cfo_hz, &res[i]);
+  }
+
+  return ret;
+}
+
 static int ssb_pss_find(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, uint32_t N_id_2, uint32_t* found_delay)
 {
   // verify it is initialised
@@ -1481,7 +1671,7 @@ int srsran_ssb_find(srsran_ssb_t*                  q,
 
   // Demodulate
   cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
-  if (ssb_demodulate(q, q->sf_buffer, t_offset, 0.0f, ssb_grid) < SRSRAN_SUCCESS) {
+  if (ssb_demodulate(q, q->sf_buffer, t_offset, q->f_offset, 0.0f, ssb_grid) < SRSRAN_SUCCESS) {
     ERROR("Error demodulating");
     return SRSRAN_ERROR;
   }
@@ -1547,7 +1737,7 @@ int srsran_ssb_track(srsran_ssb_t*                  q,
 
   // Demodulate
   cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
-  if (ssb_demodulate(q, sf_buffer, t_offset, 0.0f, ssb_grid) < SRSRAN_SUCCESS) {
+  if (ssb_demodulate(q, sf_buffer, t_offset, q->f_offset, 0.0f, ssb_grid) < SRSRAN_SUCCESS) {
     ERROR("Error demodulating");
     return SRSRAN_ERROR;
   }
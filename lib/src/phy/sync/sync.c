@@ -847,4 +847,5 @@ void srsran_sync_reset(srsran_sync_t* q)
   q->M_ext_avg  = 0;
   q->M_norm_avg = 0;
   srsran_pss_reset(&q->pss);
+  srsran_cfo_reset_phase(&q->cfo_corr_frame);
 }
@@ -27,6 +27,7 @@
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/sync/cfo.h"
 #include "srsran/phy/sync/sync_nbiot.h"
+#include "srsran/phy/utils/cexptab.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
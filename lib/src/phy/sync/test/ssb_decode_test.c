@@ -31,6 +31,7 @@
 
 #define SSB_DECODE_TEST_PCI_STRIDE 53
 #define SSB_DECODE_TEST_SSB_STRIDE 3
+#define SSB_DECODE_TEST_NOF_FREQS 3
 
 // NR parameters
 static uint32_t                    carrier_nof_prb = 52;
@@ -224,6 +225,93 @@ static int test_case_true(srsran_ssb_t* ssb)
   return SRSRAN_SUCCESS;
 }
 
+static int test_case_multi(srsran_ssb_t* ssb)
+{
+  // For benchmarking purposes
+  uint64_t t_search_usec = 0;
+
+  // SSB center frequency candidates, centered at -960, 0 and 960 kHz from the center frequency, one of them is the
+  // transmitted SSB
+  double   ssb_freqs_hz[SSB_DECODE_TEST_NOF_FREQS] = {};
+  uint32_t ssb_freq_idx                            = SSB_DECODE_TEST_NOF_FREQS;
+  for (uint32_t i = 0; i < SSB_DECODE_TEST_NOF_FREQS; i++) {
+    ssb_freqs_hz[i] = carrier_freq_hz + 960e3 * ((double)i - 1.0);
+    if (fabs(ssb_freqs_hz[i] - ssb_freq_hz) < 1.0) {
+      ssb_freq_idx = i;
+    }
+  }
+
+  // SSB configuration
+  srsran_ssb_cfg_t ssb_cfg = {};
+  ssb_cfg.srate_hz         = srate_hz;
+  ssb_cfg.center_freq_hz   = carrier_freq_hz;
+  ssb_cfg.ssb_freq_hz      = ssb_freq_hz;
+  ssb_cfg.scs              = ssb_scs;
+  ssb_cfg.pattern          = ssb_pattern;
+
+  TESTASSERT(srsran_ssb_set_cfg(ssb, &ssb_cfg) == SRSRAN_SUCCESS);
+
+  // For each PCI...
+  uint64_t count = 0;
+  for (uint32_t pci = 0; pci < SRSRAN_NOF_NID_NR; pci += SSB_DECODE_TEST_PCI_STRIDE, count++) {
+    struct timeval t[3] = {};
+
+    // Build PBCH message
+    srsran_pbch_msg_nr_t pbch_msg_tx = {};
+    gen_pbch_msg(&pbch_msg_tx, 0);
+
+    // Initialise baseband
+    srsran_vec_cf_zero(buffer, hf_len);
+
+    // Add the SSB base-band
+    TESTASSERT(srsran_ssb_add(ssb, pci, &pbch_msg_tx, buffer, buffer) == SRSRAN_SUCCESS);
+
+    // Run channel
+    run_channel();
+
+    // Search all candidates
+    srsran_ssb_search_res_t res[SSB_DECODE_TEST_NOF_FREQS] = {};
+    gettimeofday(&t[1], NULL);
+    TESTASSERT(srsran_ssb_search_multi(ssb, buffer, hf_len, ssb_freqs_hz, SSB_DECODE_TEST_NOF_FREQS, res) ==
+               SRSRAN_SUCCESS);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_search_usec += t[0].tv_usec + t[0].tv_sec * 1000000UL;
+
+    for (uint32_t i = 0; i < SSB_DECODE_TEST_NOF_FREQS; i++) {
+      // Print decoded PBCH message
+      char str[512] = {};
+      srsran_pbch_msg_info(&res[i].pbch_msg, str, sizeof(str));
+      INFO("test_case_multi - found   pci=%d ssb_freq=%.3f MHz %s crc=%s",
+           res[i].N_id,
+           ssb_freqs_hz[i] / 1e6,
+           str,
+           res[i].pbch_msg.crc ? "OK" : "KO");
+
+      // Only the transmitted SSB center frequency shall be found
+      if (i == ssb_freq_idx) {
+        TESTASSERT(res[i].pbch_msg.crc);
+        TESTASSERT(res[i].N_id == pci);
+        TESTASSERT(memcmp(&res[i].pbch_msg, &pbch_msg_tx, sizeof(srsran_pbch_msg_nr_t)) == 0);
+      } else {
+        TESTASSERT(!res[i].pbch_msg.crc);
+      }
+    }
+  }
+
+  // The configured SSB center frequency shall be kept
+  TESTASSERT(ssb->cfg.ssb_freq_hz == ssb_freq_hz);
+
+  if (!count) {
+    ERROR("Error in test case multi: undefined division");
+    return SRSRAN_ERROR;
+  }
+
+  INFO("test_case_multi - %.1f usec/search;", (double)t_search_usec / (double)(count));
+
+  return SRSRAN_SUCCESS;
+}
+
 static int test_case_false(srsran_ssb_t* ssb)
 {
   // For benchmarking purposes
@@ -336,6 +424,11 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  if (test_case_multi(&ssb) != SRSRAN_SUCCESS) {
+    ERROR("test case failed");
+    goto clean_exit;
+  }
+
   if (test_case_false(&ssb) != SRSRAN_SUCCESS) {
     ERROR("test case failed");
     goto clean_exit;
@@ -152,6 +152,7 @@ int srsran_ue_sync_start_agc(srsran_ue_sync_t* q,
   if (q->do_agc) {
     srsran_agc_set_gain_range(&q->agc, min_gain_db, max_gain_db);
     srsran_agc_set_gain(&q->agc, init_gain_value_db);
+    srsran_agc_set_max_nof_samples(&q->agc, SRSRAN_AGC_DEFAULT_MAX_NOF_SAMPLES);
     srsran_ue_sync_set_agc_period(q, 4);
   }
   return n;
@@ -807,14 +808,14 @@ int srsran_ue_sync_zerocopy(srsran_ue_sync_t* q,
             q->frame_number = (q->frame_number + 1) % 1024;
           }
 
-          // Correct CFO before PSS/SSS tracking using the sync object corrector (initialized for 1 ms)
+          // Correct CFO before PSS/SSS tracking using the sync object corrector (initialized for 1 ms). The phase is
+          // continuous between subframes while tracking
           if (q->cfo_correct_enable_track) {
-            for (int i = 0; i < q->nof_rx_antennas; i++) {
-              if (input_buffer[i]) {
-                srsran_cfo_correct(
-                    &q->strack.cfo_corr_frame, input_buffer[i], input_buffer[i], -q->cfo_current_value / q->fft_size);
-              }
-            }
+            srsran_cfo_correct_continuous(&q->strack.cfo_corr_frame,
+                                          input_buffer,
+                                          input_buffer,
+                                          (uint32_t)q->nof_rx_antennas,
+                                          -q->cfo_current_value / q->fft_size);
           }
 
           if (q->mode == SYNC_MODE_PSS) {
@@ -52,6 +52,22 @@ void srsran_bit_interleaver_init(srsran_bit_interleaver_t* q, uint16_t* interlea
     q->byte_idx[i]    = (uint16_t)(interleaver[i] / 8);
     q->bit_mask[i]    = (uint8_t)(mask[i_px % 8]);
   }
+
+#ifdef LV_HAVE_AVX2
+  // Gather tables: every input bit is read from a 32-bit little-endian word. The word offset is clipped so the word
+  // never exceeds the input buffer, the shift takes into account the position of the byte within the word.
+  uint32_t nof_bytes = SRSRAN_CEIL(nof_bits, 8);
+  if (nof_bytes >= 4) {
+    q->word_idx   = srsran_vec_i32_malloc(nof_bits);
+    q->word_shift = srsran_vec_i32_malloc(nof_bits);
+    for (int i = 0; i < nof_bits; i++) {
+      uint16_t i_px    = interleaver[i];
+      int32_t  idx     = (int32_t)SRSRAN_MIN(i_px / 8, nof_bytes - 4);
+      q->word_idx[i]   = idx;
+      q->word_shift[i] = 24 - 8 * (i_px / 8 - idx) + i_px % 8;
+    }
+  }
+#endif /* LV_HAVE_AVX2 */
 }
 
 void srsran_bit_interleaver_free(srsran_bit_interleaver_t* q)
@@ -68,6 +84,14 @@ void srsran_bit_interleaver_free(srsran_bit_interleaver_t* q)
     free(q->bit_mask);
   }
 
+  if (q->word_idx) {
+    free(q->word_idx);
+  }
+
+  if (q->word_shift) {
+    free(q->word_shift);
+  }
+
   bzero(q, sizeof(srsran_bit_interleaver_t));
 }
 
@@ -99,6 +123,51 @@ void srsran_bit_interleaver_run(srsran_bit_interleaver_t* q, uint8_t* input, uin
   bit_mask += i - w_offset_p;
   output_ptr += st;
 
+#ifdef LV_HAVE_AVX2
+  // Gather based kernels, each lane reads the 32-bit word containing its input bit and moves the bit to the MSB. The
+  // lanes are reversed before extracting the MSBs as the first bit goes to the MSB of the output byte.
+  if (q->word_idx != NULL) {
+    const int32_t* word_idx   = q->word_idx + (i - w_offset_p);
+    const int32_t* word_shift = q->word_shift + (i - w_offset_p);
+
+#ifdef LV_HAVE_AVX512
+    const __m512i reverse512 = _mm512_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    for (; i < (int)q->nof_bits - 15; i += 16) {
+      __m512i idx512   = _mm512_loadu_si512((const void*)word_idx);
+      __m512i shift512 = _mm512_loadu_si512((const void*)word_shift);
+      __m512i word512  = _mm512_i32gather_epi32(idx512, (const void*)input, 1);
+
+      word512 = _mm512_permutexvar_epi32(reverse512, _mm512_sllv_epi32(word512, shift512));
+
+      *((uint16_t*)(output_ptr)) = (uint16_t)_mm512_movepi32_mask(word512);
+
+      word_idx += 16;
+      word_shift += 16;
+      byte_idx += 16;
+      bit_mask += 16;
+      output_ptr += 2;
+    }
+#endif /* LV_HAVE_AVX512 */
+
+    const __m256i reverse256 = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    for (; i < (int)q->nof_bits - 7; i += 8) {
+      __m256i idx256   = _mm256_loadu_si256((const __m256i*)word_idx);
+      __m256i shift256 = _mm256_loadu_si256((const __m256i*)word_shift);
+      __m256i word256  = _mm256_i32gather_epi32((const int*)input, idx256, 1);
+
+      word256 = _mm256_permutevar8x32_epi32(_mm256_sllv_epi32(word256, shift256), reverse256);
+
+      *output_ptr = (uint8_t)_mm256_movemask_ps(_mm256_castsi256_ps(word256));
+
+      word_idx += 8;
+      word_shift += 8;
+      byte_idx += 8;
+      bit_mask += 8;
+      output_ptr++;
+    }
+  }
+#endif /* LV_HAVE_AVX2 */
+
 #ifdef LV_HAVE_SSE
   for (; i < (int)q->nof_bits - 15; i += 16) {
     __m128i in128 = _mm_setzero_si128();
@@ -699,9 +768,42 @@ void srsran_bit_copy(uint8_t* dst, uint32_t dst_offset, uint8_t* src, uint32_t s
 
 void srsran_bit_unpack_vector(const uint8_t* packed, uint8_t* unpacked, int nof_bits)
 {
-  uint32_t i, nbytes;
-  nbytes = nof_bits / 8;
-  for (i = 0; i < nbytes; i++) {
+  uint32_t i = 0, nbytes;
+  nbytes     = nof_bits / 8;
+
+#ifdef LV_HAVE_AVX512
+  // Every 128-bit lane expands two packed bytes, each output byte selects its bit with a mask
+  const __m512i shuffle512 = _mm512_set_epi64(0x0707070707070707,
+                                              0x0606060606060606,
+                                              0x0505050505050505,
+                                              0x0404040404040404,
+                                              0x0303030303030303,
+                                              0x0202020202020202,
+                                              0x0101010101010101,
+                                              0x0000000000000000);
+  const __m512i bitmask512 = _mm512_set1_epi64(0x0102040810204080);
+  for (; i + 8 <= nbytes; i += 8) {
+    __m512i   in512 = _mm512_shuffle_epi8(_mm512_set1_epi64(*((int64_t*)&packed[i])), shuffle512);
+    __mmask64 bits  = _mm512_test_epi8_mask(in512, bitmask512);
+    _mm512_storeu_si512((void*)unpacked, _mm512_maskz_set1_epi8(bits, 1));
+    unpacked += 64;
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  // Every 128-bit lane expands two packed bytes, each output byte selects its bit with a mask
+  const __m256i shuffle256 =
+      _mm256_set_epi64x(0x0303030303030303, 0x0202020202020202, 0x0101010101010101, 0x0000000000000000);
+  const __m256i bitmask256 = _mm256_set1_epi64x(0x0102040810204080);
+  for (; i + 4 <= nbytes; i += 4) {
+    __m256i in256 = _mm256_shuffle_epi8(_mm256_set1_epi32(*((int32_t*)&packed[i])), shuffle256);
+    __m256i bits  = _mm256_cmpeq_epi8(_mm256_and_si256(in256, bitmask256), bitmask256);
+    _mm256_storeu_si256((__m256i*)unpacked, _mm256_and_si256(bits, _mm256_set1_epi8(1)));
+    unpacked += 32;
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < nbytes; i++) {
     srsran_bit_unpack(packed[i], &unpacked, 8);
   }
   if (nof_bits % 8) {
@@ -754,11 +856,41 @@ void srsran_bit_unpack_lsb(uint32_t value, uint8_t** bits, int nof_bits)
 
 void srsran_bit_pack_vector(uint8_t* unpacked, uint8_t* packed, int nof_bits)
 {
-  uint32_t i, nbytes;
-  nbytes = nof_bits / 8;
+  uint32_t i = 0, nbytes;
+  nbytes     = nof_bits / 8;
+
+#ifdef LV_HAVE_AVX512
+  // Reverse every group of 8 bits, so the first bit is the MSB, and extract the comparison mask
+  const __m512i reverse512 = _mm512_set_epi64(0x08090a0b0c0d0e0f,
+                                              0x0001020304050607,
+                                              0x08090a0b0c0d0e0f,
+                                              0x0001020304050607,
+                                              0x08090a0b0c0d0e0f,
+                                              0x0001020304050607,
+                                              0x08090a0b0c0d0e0f,
+                                              0x0001020304050607);
+  for (; i + 8 <= nbytes; i += 8) {
+    __m512i in512 = _mm512_shuffle_epi8(_mm512_loadu_si512((void*)unpacked), reverse512);
+
+    *((uint64_t*)&packed[i]) = (uint64_t)_mm512_cmpgt_epi8_mask(in512, _mm512_setzero_si512());
+    unpacked += 64;
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  // Reverse every group of 8 bits, so the first bit is the MSB, and extract the comparison mask
+  const __m256i reverse256 =
+      _mm256_set_epi64x(0x08090a0b0c0d0e0f, 0x0001020304050607, 0x08090a0b0c0d0e0f, 0x0001020304050607);
+  for (; i + 4 <= nbytes; i += 4) {
+    __m256i in256 = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)unpacked), reverse256);
+
+    *((uint32_t*)&packed[i]) = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(in256, _mm256_setzero_si256()));
+    unpacked += 32;
+  }
+#endif /* LV_HAVE_AVX2 */
 
 #ifdef LV_HAVE_SSE
-  for (i = 0; i < nbytes; i++) {
+  for (; i < nbytes; i++) {
     // Get 8 Bit
     __m64 mask = _mm_cmpgt_pi8(*((__m64*)unpacked), _mm_set1_pi8(0));
     unpacked += 8;
@@ -770,7 +902,7 @@ void srsran_bit_pack_vector(uint8_t* unpacked, uint8_t* packed, int nof_bits)
     packed[i] = (uint8_t)_mm_movemask_pi8(mask);
   }
 #else  /* LV_HAVE_SSE */
-  for (i = 0; i < nbytes; i++) {
+  for (; i < nbytes; i++) {
     packed[i] = srsran_bit_pack(&unpacked, 8);
   }
 #endif /* LV_HAVE_SSE */
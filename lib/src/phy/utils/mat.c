@@ -364,6 +364,552 @@ inline void srsran_mat_2x2_mmse_avx(__m256  y0,
 
 #endif /* LV_HAVE_AVX */
 
+/*
+ * Batched small matrix functions
+ */
+
+/* Smallest Cholesky pivot, it keeps the decomposition finite for singular matrices */
+#define MAT_MIN_PIVOT (1e-12f)
+
+/* Eigenvalue bounds for the condition number, the same as in srsran_mat_2x2_cn */
+#define MAT_CN_MIN_EIG (1e-9f)
+#define MAT_CN_MAX_EIG (1e+9f)
+
+/* Number of power iterations for estimating the extreme eigenvalues of matrices larger than 2x2 */
+#define MAT_CN_NOF_ITERATIONS 8
+
+/* Power iteration start vector, it is arbitrary and unlikely to be orthogonal to the dominant eigenvector */
+static const cf_t mat_power_start[SRSRAN_MAT_MAX_N] = {0.5f, 0.3f + 0.4f * I, -0.1f + 0.6f * I, 0.2f - 0.3f * I};
+
+static inline float mat_cabs2(cf_t x)
+{
+  return __real__ x * __real__ x + __imag__ x * __imag__ x;
+}
+
+static inline void mat_cholesky_gen(cf_t a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                    cf_t l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                    uint32_t N)
+{
+  for (uint32_t j = 0; j < N; j++) {
+    float d = __real__ a[j][j];
+    for (uint32_t k = 0; k < j; k++) {
+      d -= mat_cabs2(l[j][k]);
+    }
+    d           = sqrtf(SRSRAN_MAX(d, MAT_MIN_PIVOT));
+    float d_rcp = 1.0f / d;
+    l[j][j]     = d;
+
+    for (uint32_t i = j + 1; i < N; i++) {
+      cf_t acc = a[i][j];
+      for (uint32_t k = 0; k < j; k++) {
+        acc -= l[i][k] * conjf(l[j][k]);
+      }
+      l[i][j] = acc * d_rcp;
+    }
+
+    for (uint32_t i = 0; i < j; i++) {
+      l[i][j] = 0.0f;
+    }
+  }
+}
+
+/* Computes inv(A) = inv(L)' x inv(L) from the Cholesky decomposition of A */
+static inline void mat_cholesky_inv_gen(cf_t l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                        cf_t r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                        uint32_t N)
+{
+  cf_t m[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N] = {};
+
+  // Invert lower triangular matrix
+  for (uint32_t i = 0; i < N; i++) {
+    m[i][i] = 1.0f / __real__ l[i][i];
+  }
+  for (uint32_t j = 0; j < N; j++) {
+    for (uint32_t i = j + 1; i < N; i++) {
+      cf_t acc = 0.0f;
+      for (uint32_t k = j; k < i; k++) {
+        acc += l[i][k] * m[k][j];
+      }
+      m[i][j] = -acc * m[i][i];
+    }
+  }
+
+  // Multiply by its conjugate transpose, the result is Hermitian
+  for (uint32_t i = 0; i < N; i++) {
+    for (uint32_t j = i; j < N; j++) {
+      cf_t acc = 0.0f;
+      for (uint32_t k = j; k < N; k++) {
+        acc += conjf(m[k][i]) * m[k][j];
+      }
+      r[i][j] = acc;
+      r[j][i] = conjf(acc);
+    }
+  }
+}
+
+/* Computes the Gram matrix of H with the smallest dimension, returns its dimension */
+static inline uint32_t mat_gram_gen(cf_t h[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                    cf_t g[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                    uint32_t nof_rows,
+                                    uint32_t nof_cols)
+{
+  bool     by_cols = nof_rows >= nof_cols;
+  uint32_t n       = by_cols ? nof_cols : nof_rows;
+  uint32_t m       = by_cols ? nof_rows : nof_cols;
+
+  for (uint32_t i = 0; i < n; i++) {
+    for (uint32_t j = 0; j <= i; j++) {
+      cf_t acc = 0.0f;
+      for (uint32_t k = 0; k < m; k++) {
+        acc += by_cols ? conjf(h[k][i]) * h[k][j] : h[i][k] * conjf(h[j][k]);
+      }
+      g[i][j] = acc;
+    }
+  }
+
+  return n;
+}
+
+/* Estimates the largest eigenvalue of a N x N Hermitian matrix with the Rayleigh quotient of power iterations */
+static inline float mat_power_gen(cf_t a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N], uint32_t N)
+{
+  cf_t  v[SRSRAN_MAT_MAX_N];
+  float lambda = 0.0f;
+
+  for (uint32_t i = 0; i < N; i++) {
+    v[i] = mat_power_start[i];
+  }
+
+  for (uint32_t it = 0; it < MAT_CN_NOF_ITERATIONS; it++) {
+    cf_t  x[SRSRAN_MAT_MAX_N];
+    float norm = 0.0f;
+    float vv   = 0.0f;
+    lambda     = 0.0f;
+    for (uint32_t i = 0; i < N; i++) {
+      x[i] = 0.0f;
+      for (uint32_t j = 0; j < N; j++) {
+        x[i] += a[i][j] * v[j];
+      }
+      lambda += __real__(conjf(v[i]) * x[i]);
+      vv += mat_cabs2(v[i]);
+      norm += mat_cabs2(x[i]);
+    }
+    lambda /= vv;
+
+    float norm_rcp = 1.0f / sqrtf(SRSRAN_MAX(norm, MAT_MIN_PIVOT));
+    for (uint32_t i = 0; i < N; i++) {
+      v[i] = x[i] * norm_rcp;
+    }
+  }
+
+  return lambda;
+}
+
+static inline float mat_cn_gen(cf_t h[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N], uint32_t nof_rows, uint32_t nof_cols)
+{
+  cf_t     g[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+  uint32_t n    = mat_gram_gen(h, g, nof_rows, nof_cols);
+  float    xmax = 1.0f;
+  float    xmin = 1.0f;
+
+  if (n == 2) {
+    // Closed form, |G - λI| = 0 -> λ² - bλ + c = 0
+    float b   = __real__ g[0][0] + __real__ g[1][1];
+    float c   = __real__ g[0][0] * __real__ g[1][1] - mat_cabs2(g[1][0]);
+    float sqr = sqrtf(SRSRAN_MAX(b * b - 4.0f * c, 0.0f));
+    xmax      = b + sqr;
+    xmin      = b - sqr;
+  } else if (n > 2) {
+    cf_t l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    cf_t r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    mat_cholesky_gen(g, l, n);
+    mat_cholesky_inv_gen(l, r, n);
+
+    // Complete the upper triangle of the Gram matrix
+    for (uint32_t i = 0; i < n; i++) {
+      for (uint32_t j = i + 1; j < n; j++) {
+        g[i][j] = conjf(g[j][i]);
+      }
+    }
+
+    // The smallest eigenvalue is the reciprocal of the largest eigenvalue of the inverse
+    xmax = mat_power_gen(g, n);
+    xmin = 1.0f / mat_power_gen(r, n);
+  }
+
+  xmin = SRSRAN_MAX(xmin, MAT_CN_MIN_EIG);
+  xmax = SRSRAN_MIN(xmax, MAT_CN_MAX_EIG);
+
+  return 10.0f * log10f(xmax / xmin);
+}
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+
+static inline simd_cf_t mat_simd_cf_from_re(simd_f_t re)
+{
+  simd_cf_t ret;
+#if HAVE_NEON
+  ret.val[0] = re;
+  ret.val[1] = srsran_simd_f_zero();
+#else  /* HAVE_NEON */
+  ret.re = re;
+  ret.im = srsran_simd_f_zero();
+#endif /* HAVE_NEON */
+  return ret;
+}
+
+/* Scales by a real vector, srsran_simd_cf_mul expects the real factors interleaved as in memory */
+static inline simd_cf_t mat_simd_cf_mul_re(simd_cf_t a, simd_f_t b)
+{
+  simd_cf_t ret;
+#if HAVE_NEON
+  ret.val[0] = srsran_simd_f_mul(a.val[0], b);
+  ret.val[1] = srsran_simd_f_mul(a.val[1], b);
+#else  /* HAVE_NEON */
+  ret.re = srsran_simd_f_mul(a.re, b);
+  ret.im = srsran_simd_f_mul(a.im, b);
+#endif /* HAVE_NEON */
+  return ret;
+}
+
+static inline simd_f_t mat_simd_cf_abs2(simd_cf_t x)
+{
+  return srsran_simd_cf_re(srsran_simd_cf_conjprod(x, x));
+}
+
+/* Reciprocal refined with a Newton-Raphson step, the SIMD estimate alone is not accurate enough for decompositions */
+static inline simd_f_t mat_simd_f_rcp(simd_f_t a)
+{
+  simd_f_t r = srsran_simd_f_rcp(a);
+  return srsran_simd_f_mul(r, srsran_simd_f_sub(srsran_simd_f_set1(2.0f), srsran_simd_f_mul(a, r)));
+}
+
+static inline simd_f_t mat_simd_f_bound(simd_f_t a, float min, float max)
+{
+  simd_f_t _min = srsran_simd_f_set1(min);
+  simd_f_t _max = srsran_simd_f_set1(max);
+  a             = srsran_simd_f_select(a, _min, srsran_simd_f_min(a, _min));
+  return srsran_simd_f_select(a, _max, srsran_simd_f_max(a, _max));
+}
+
+static inline void mat_cholesky_simd(simd_cf_t a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                     simd_cf_t l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                     uint32_t  N)
+{
+  for (uint32_t j = 0; j < N; j++) {
+    simd_f_t d = srsran_simd_cf_re(a[j][j]);
+    for (uint32_t k = 0; k < j; k++) {
+      d = srsran_simd_f_sub(d, mat_simd_cf_abs2(l[j][k]));
+    }
+    d              = srsran_simd_f_sqrt(mat_simd_f_bound(d, MAT_MIN_PIVOT, INFINITY));
+    simd_f_t d_rcp = mat_simd_f_rcp(d);
+    l[j][j]        = mat_simd_cf_from_re(d);
+
+    for (uint32_t i = j + 1; i < N; i++) {
+      simd_cf_t acc = a[i][j];
+      for (uint32_t k = 0; k < j; k++) {
+        acc = srsran_simd_cf_sub(acc, srsran_simd_cf_conjprod(l[i][k], l[j][k]));
+      }
+      l[i][j] = mat_simd_cf_mul_re(acc, d_rcp);
+    }
+
+    for (uint32_t i = 0; i < j; i++) {
+      l[i][j] = srsran_simd_cf_zero();
+    }
+  }
+}
+
+static inline void mat_cholesky_inv_simd(simd_cf_t l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                         simd_cf_t r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                         uint32_t  N)
+{
+  simd_cf_t m[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+  simd_f_t  d_rcp[SRSRAN_MAT_MAX_N];
+
+  // Invert lower triangular matrix
+  for (uint32_t i = 0; i < N; i++) {
+    d_rcp[i] = mat_simd_f_rcp(srsran_simd_cf_re(l[i][i]));
+    m[i][i]  = mat_simd_cf_from_re(d_rcp[i]);
+  }
+  for (uint32_t j = 0; j < N; j++) {
+    for (uint32_t i = j + 1; i < N; i++) {
+      simd_cf_t acc = srsran_simd_cf_zero();
+      for (uint32_t k = j; k < i; k++) {
+        acc = srsran_simd_cf_add(acc, srsran_simd_cf_prod(l[i][k], m[k][j]));
+      }
+      m[i][j] = mat_simd_cf_mul_re(srsran_simd_cf_neg(acc), d_rcp[i]);
+    }
+  }
+
+  // Multiply by its conjugate transpose, the result is Hermitian
+  for (uint32_t i = 0; i < N; i++) {
+    for (uint32_t j = i; j < N; j++) {
+      simd_cf_t acc = srsran_simd_cf_zero();
+      for (uint32_t k = j; k < N; k++) {
+        acc = srsran_simd_cf_add(acc, srsran_simd_cf_conjprod(m[k][j], m[k][i]));
+      }
+      r[i][j] = acc;
+      r[j][i] = srsran_simd_cf_conj(acc);
+    }
+  }
+}
+
+static inline uint32_t mat_gram_simd(simd_cf_t h[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                     simd_cf_t g[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                     uint32_t  nof_rows,
+                                     uint32_t  nof_cols)
+{
+  bool     by_cols = nof_rows >= nof_cols;
+  uint32_t n       = by_cols ? nof_cols : nof_rows;
+  uint32_t m       = by_cols ? nof_rows : nof_cols;
+
+  for (uint32_t i = 0; i < n; i++) {
+    for (uint32_t j = 0; j <= i; j++) {
+      simd_cf_t acc = srsran_simd_cf_zero();
+      for (uint32_t k = 0; k < m; k++) {
+        acc = srsran_simd_cf_add(acc,
+                                 by_cols ? srsran_simd_cf_conjprod(h[k][j], h[k][i])
+                                         : srsran_simd_cf_conjprod(h[i][k], h[j][k]));
+      }
+      g[i][j] = acc;
+    }
+  }
+
+  return n;
+}
+
+static inline simd_f_t mat_power_simd(simd_cf_t a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N], uint32_t N)
+{
+  simd_cf_t v[SRSRAN_MAT_MAX_N];
+  simd_f_t  lambda = srsran_simd_f_zero();
+
+  for (uint32_t i = 0; i < N; i++) {
+    v[i] = srsran_simd_cf_set1(mat_power_start[i]);
+  }
+
+  for (uint32_t it = 0; it < MAT_CN_NOF_ITERATIONS; it++) {
+    simd_cf_t x[SRSRAN_MAT_MAX_N];
+    simd_f_t  norm = srsran_simd_f_zero();
+    simd_f_t  vv   = srsran_simd_f_zero();
+    lambda         = srsran_simd_f_zero();
+    for (uint32_t i = 0; i < N; i++) {
+      x[i] = srsran_simd_cf_zero();
+      for (uint32_t j = 0; j < N; j++) {
+        x[i] = srsran_simd_cf_add(x[i], srsran_simd_cf_prod(a[i][j], v[j]));
+      }
+      lambda = srsran_simd_f_add(lambda, srsran_simd_cf_re(srsran_simd_cf_conjprod(x[i], v[i])));
+      vv     = srsran_simd_f_add(vv, mat_simd_cf_abs2(v[i]));
+      norm   = srsran_simd_f_add(norm, mat_simd_cf_abs2(x[i]));
+    }
+    lambda = srsran_simd_f_mul(lambda, mat_simd_f_rcp(vv));
+
+    simd_f_t norm_rcp = mat_simd_f_rcp(srsran_simd_f_sqrt(mat_simd_f_bound(norm, MAT_MIN_PIVOT, INFINITY)));
+    for (uint32_t i = 0; i < N; i++) {
+      v[i] = mat_simd_cf_mul_re(x[i], norm_rcp);
+    }
+  }
+
+  return lambda;
+}
+
+/* Computes the ratio between the largest and the smallest eigenvalues, the logarithm is left to the caller */
+static inline simd_f_t
+mat_cn_simd(simd_cf_t h[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N], uint32_t nof_rows, uint32_t nof_cols)
+{
+  simd_cf_t g[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+  uint32_t  n    = mat_gram_simd(h, g, nof_rows, nof_cols);
+  simd_f_t  xmax = srsran_simd_f_set1(1.0f);
+  simd_f_t  xmin = srsran_simd_f_set1(1.0f);
+
+  if (n == 2) {
+    // Closed form, |G - λI| = 0 -> λ² - bλ + c = 0
+    simd_f_t g00 = srsran_simd_cf_re(g[0][0]);
+    simd_f_t g11 = srsran_simd_cf_re(g[1][1]);
+    simd_f_t b   = srsran_simd_f_add(g00, g11);
+    simd_f_t c   = srsran_simd_f_sub(srsran_simd_f_mul(g00, g11), mat_simd_cf_abs2(g[1][0]));
+    simd_f_t dis = srsran_simd_f_sub(srsran_simd_f_mul(b, b), srsran_simd_f_mul(srsran_simd_f_set1(4.0f), c));
+    simd_f_t sqr = srsran_simd_f_sqrt(mat_simd_f_bound(dis, 0.0f, INFINITY));
+    xmax         = srsran_simd_f_add(b, sqr);
+    xmin         = srsran_simd_f_sub(b, sqr);
+  } else if (n > 2) {
+    simd_cf_t l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    simd_cf_t r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    mat_cholesky_simd(g, l, n);
+    mat_cholesky_inv_simd(l, r, n);
+
+    // Complete the upper triangle of the Gram matrix
+    for (uint32_t i = 0; i < n; i++) {
+      for (uint32_t j = i + 1; j < n; j++) {
+        g[i][j] = srsran_simd_cf_conj(g[j][i]);
+      }
+    }
+
+    // The smallest eigenvalue is the reciprocal of the largest eigenvalue of the inverse
+    xmax = mat_power_simd(g, n);
+    xmin = mat_simd_f_rcp(mat_power_simd(r, n));
+  }
+
+  xmin = mat_simd_f_bound(xmin, MAT_CN_MIN_EIG, INFINITY);
+  xmax = mat_simd_f_bound(xmax, 0.0f, MAT_CN_MAX_EIG);
+
+  return srsran_simd_f_mul(xmax, mat_simd_f_rcp(xmin));
+}
+
+#endif /* SRSRAN_SIMD_CF_SIZE != 0 */
+
+int srsran_mat_cholesky_batch(cf_t*    a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                              cf_t*    l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                              uint32_t N,
+                              uint32_t len)
+{
+  if (a == NULL || l == NULL || N == 0 || N > SRSRAN_MAT_MAX_N) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t k = 0;
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+  for (; k + SRSRAN_SIMD_CF_SIZE <= len; k += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t _a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    simd_cf_t _l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j <= i; j++) {
+        _a[i][j] = srsran_simd_cfi_loadu(&a[i][j][k]);
+      }
+    }
+
+    mat_cholesky_simd(_a, _l, N);
+
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        srsran_simd_cfi_storeu(&l[i][j][k], _l[i][j]);
+      }
+    }
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE != 0 */
+
+  for (; k < len; k++) {
+    cf_t _a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    cf_t _l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j <= i; j++) {
+        _a[i][j] = a[i][j][k];
+      }
+    }
+
+    mat_cholesky_gen(_a, _l, N);
+
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        l[i][j][k] = _l[i][j];
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_mat_hermitian_inv_batch(cf_t*    a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                   cf_t*    r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                   uint32_t N,
+                                   uint32_t len)
+{
+  if (a == NULL || r == NULL || N == 0 || N > SRSRAN_MAT_MAX_N) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t k = 0;
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+  for (; k + SRSRAN_SIMD_CF_SIZE <= len; k += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t _a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    simd_cf_t _l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    simd_cf_t _r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j <= i; j++) {
+        _a[i][j] = srsran_simd_cfi_loadu(&a[i][j][k]);
+      }
+    }
+
+    mat_cholesky_simd(_a, _l, N);
+    mat_cholesky_inv_simd(_l, _r, N);
+
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        srsran_simd_cfi_storeu(&r[i][j][k], _r[i][j]);
+      }
+    }
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE != 0 */
+
+  for (; k < len; k++) {
+    cf_t _a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    cf_t _l[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    cf_t _r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j <= i; j++) {
+        _a[i][j] = a[i][j][k];
+      }
+    }
+
+    mat_cholesky_gen(_a, _l, N);
+    mat_cholesky_inv_gen(_l, _r, N);
+
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        r[i][j][k] = _r[i][j];
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_mat_cn_batch(cf_t*    h[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                        uint32_t nof_rows,
+                        uint32_t nof_cols,
+                        uint32_t len,
+                        float*   cn)
+{
+  if (h == NULL || cn == NULL || nof_rows == 0 || nof_rows > SRSRAN_MAT_MAX_N || nof_cols == 0 ||
+      nof_cols > SRSRAN_MAT_MAX_N) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t k = 0;
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+  for (; k + SRSRAN_SIMD_CF_SIZE <= len; k += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t _h[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    for (uint32_t i = 0; i < nof_rows; i++) {
+      for (uint32_t j = 0; j < nof_cols; j++) {
+        _h[i][j] = srsran_simd_cfi_loadu(&h[i][j][k]);
+      }
+    }
+
+    srsran_simd_f_storeu(&cn[k], mat_cn_simd(_h, nof_rows, nof_cols));
+
+    // Convert eigenvalue ratios to dB
+    for (uint32_t i = 0; i < SRSRAN_SIMD_CF_SIZE; i++) {
+      cn[k + i] = 10.0f * log10f(cn[k + i]);
+    }
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE != 0 */
+
+  for (; k < len; k++) {
+    cf_t _h[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    for (uint32_t i = 0; i < nof_rows; i++) {
+      for (uint32_t j = 0; j < nof_cols; j++) {
+        _h[i][j] = h[i][j][k];
+      }
+    }
+
+    cn[k] = mat_cn_gen(_h, nof_rows, nof_cols);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_matrix_NxN_inv_init(srsran_matrix_NxN_inv_t* q, uint32_t N)
 {
   int ret = SRSRAN_SUCCESS;
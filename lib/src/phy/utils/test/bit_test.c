@@ -0,0 +1,219 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <sys/time.h>
+
+static uint32_t nof_repetitions = 100;
+
+/**
+ * Typical code block (turbo and LDPC) and transport block sizes in bits
+ */
+static const uint32_t block_sizes[] = {40, 1024, 3200, 6144, 8448, 25344, 75376, 149776};
+
+/**
+ * Turbo coder and rate matching interleaver sizes in bits, limited by the 16-bit interleaver indexes
+ */
+static const uint32_t interleaver_sizes[] = {40, 1024, 3200, 6144, 18432, 18444};
+
+static srsran_random_t random_gen = NULL;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [rv]\n", prog);
+  printf("\t-r Number of repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-v increase verbosity\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "rv")) != -1) {
+    switch (opt) {
+      case 'r':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
+{
+  return ((double)ts_end->tv_sec - (double)ts_start->tv_sec) * 1e6 +
+         ((double)ts_end->tv_usec - (double)ts_start->tv_usec);
+}
+
+static uint8_t get_bit(const uint8_t* packed, uint32_t idx)
+{
+  return (uint8_t)((packed[idx / 8] >> (7 - idx % 8)) & 1U);
+}
+
+static int test_pack_unpack(uint32_t nof_bits)
+{
+  struct timeval t[2];
+  uint32_t       nof_bytes = SRSRAN_CEIL(nof_bits, 8);
+  uint8_t*       bits      = srsran_vec_u8_malloc(nof_bits);
+  uint8_t*       bits_rx   = srsran_vec_u8_malloc(nof_bits);
+  uint8_t*       packed    = srsran_vec_u8_malloc(nof_bytes);
+  if (bits == NULL || bits_rx == NULL || packed == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_random_bit_vector(random_gen, bits, nof_bits);
+  srsran_vec_u8_zero(packed, nof_bytes);
+
+  // Pack and compare with the bit by bit packing
+  gettimeofday(&t[0], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_bit_pack_vector(bits, packed, nof_bits);
+  }
+  gettimeofday(&t[1], NULL);
+  double pack_us = elapsed_us(&t[0], &t[1]);
+
+  for (uint32_t i = 0; i < nof_bits; i++) {
+    if (get_bit(packed, i) != bits[i]) {
+      ERROR("Packing %d bits failed at bit %d", nof_bits, i);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Unpack and compare with the original bits
+  gettimeofday(&t[0], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_bit_unpack_vector(packed, bits_rx, nof_bits);
+  }
+  gettimeofday(&t[1], NULL);
+  double unpack_us = elapsed_us(&t[0], &t[1]);
+
+  if (srsran_bit_diff(bits, bits_rx, nof_bits) != 0) {
+    ERROR("Unpacking %d bits failed", nof_bits);
+    return SRSRAN_ERROR;
+  }
+
+  printf("%32s (%6d) ... pack %7.1f Mbps ... unpack %7.1f Mbps\n",
+         "srsran_bit_pack_vector",
+         nof_bits,
+         (double)nof_bits * nof_repetitions / pack_us,
+         (double)nof_bits * nof_repetitions / unpack_us);
+
+  free(bits);
+  free(bits_rx);
+  free(packed);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_interleaver(uint32_t nof_bits, uint16_t w_offset)
+{
+  struct timeval           t[2];
+  srsran_bit_interleaver_t q         = {};
+  uint32_t                 nof_bytes = SRSRAN_CEIL(nof_bits + w_offset, 8);
+  uint16_t*                table     = srsran_vec_u16_malloc(nof_bits);
+  uint8_t*                 input     = srsran_vec_u8_malloc(nof_bytes);
+  uint8_t*                 output    = srsran_vec_u8_malloc(nof_bytes);
+  if (table == NULL || input == NULL || output == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  // Random permutation
+  for (uint32_t i = 0; i < nof_bits; i++) {
+    table[i] = (uint16_t)i;
+  }
+  for (uint32_t i = nof_bits - 1; i > 0; i--) {
+    uint32_t j = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, (int)i);
+    uint16_t t = table[i];
+    table[i]   = table[j];
+    table[j]   = t;
+  }
+
+  for (uint32_t i = 0; i < nof_bytes; i++) {
+    input[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 255);
+  }
+  srsran_vec_u8_zero(output, nof_bytes);
+
+  srsran_bit_interleaver_init(&q, table, nof_bits);
+
+  gettimeofday(&t[0], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_bit_interleaver_run(&q, input, output, w_offset);
+  }
+  gettimeofday(&t[1], NULL);
+  double run_us = elapsed_us(&t[0], &t[1]);
+
+  // Every output bit after the write offset is the input bit pointed by the interleaver
+  for (uint32_t i = 0; i < nof_bits; i++) {
+    if (get_bit(output, i + w_offset) != get_bit(input, table[i])) {
+      ERROR("Interleaving %d bits with offset %d failed at bit %d", nof_bits, w_offset, i);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  printf("%32s (%6d) ... %7.1f Mbps\n", "srsran_bit_interleaver_run", nof_bits, nof_bits * nof_repetitions / run_us);
+
+  srsran_bit_interleaver_free(&q);
+  free(table);
+  free(input);
+  free(output);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  random_gen = srsran_random_init(0x1234);
+
+  for (uint32_t i = 0; i < sizeof(block_sizes) / sizeof(block_sizes[0]); i++) {
+    for (uint32_t delta = 0; delta < 8; delta += 3) {
+      if (test_pack_unpack(block_sizes[i] + delta) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < sizeof(interleaver_sizes) / sizeof(interleaver_sizes[0]); i++) {
+    // Non-zero write offsets are only used with byte aligned sizes
+    if (test_interleaver(interleaver_sizes[i], 0) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    if (interleaver_sizes[i] % 8 == 0 && test_interleaver(interleaver_sizes[i], 4) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  srsran_random_free(random_gen);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
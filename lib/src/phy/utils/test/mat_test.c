@@ -20,6 +20,7 @@
  */
 
 #include <complex.h>
+#include <math.h>
 #include <srsran/phy/utils/random.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -33,6 +34,8 @@
 static bool            inverter    = false;
 static bool            zf_solver   = false;
 static bool            mmse_solver = false;
+static bool            batch       = false;
+static bool            benchmark   = false;
 static bool            verbose     = false;
 static srsran_random_t random_gen  = NULL;
 
@@ -72,9 +75,11 @@ double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 
 void usage(char* prog)
 {
-  printf("Usage: %s [mzvh]\n", prog);
+  printf("Usage: %s [mzbpvh]\n", prog);
   printf("\t-m Test Minimum Mean Squared Error (MMSE) solver\n");
   printf("\t-z Test Zero Forcing (ZF) solver\n");
+  printf("\t-b Test batched Cholesky, Hermitian inversion and condition number\n");
+  printf("\t-p Measure the throughput of the batched functions\n");
   printf("\t-v Verbose\n");
   printf("\t-h Show this message\n");
 }
@@ -82,7 +87,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "imzvh")) != -1) {
+  while ((opt = getopt(argc, argv, "imzbpvh")) != -1) {
     switch (opt) {
       case 'i':
         inverter = true;
@@ -93,6 +98,12 @@ void parse_args(int argc, char** argv)
       case 'z':
         zf_solver = true;
         break;
+      case 'b':
+        batch = true;
+        break;
+      case 'p':
+        benchmark = true;
+        break;
       case 'v':
         verbose = true;
         break;
@@ -270,6 +281,307 @@ static bool test_vec_dot_prod_ccc(void)
   return (cabsf(res - gold) < MAXIMUM_ERROR);
 }
 
+#define BATCH_LEN (SRSRAN_SIMD_CF_SIZE * 8 + 3)
+#define BATCH_MAXIMUM_ERROR (1e-4f)
+
+typedef struct {
+  cf_t  buffer[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N][BATCH_LEN];
+  cf_t* m[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+} batch_t;
+
+static void batch_init(batch_t* b)
+{
+  for (uint32_t i = 0; i < SRSRAN_MAT_MAX_N; i++) {
+    for (uint32_t j = 0; j < SRSRAN_MAT_MAX_N; j++) {
+      b->m[i][j] = b->buffer[i][j];
+    }
+  }
+}
+
+/* Fills the batch with random Hermitian positive definite matrices A = B x B' + I */
+static void batch_random_hpd(batch_t* a, uint32_t N)
+{
+  for (uint32_t k = 0; k < BATCH_LEN; k++) {
+    cf_t b[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        b[i][j] = RANDOM_CF();
+      }
+    }
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        cf_t acc = (i == j) ? 1.0f : 0.0f;
+        for (uint32_t n = 0; n < N; n++) {
+          acc += b[i][n] * conjf(b[j][n]);
+        }
+        a->buffer[i][j][k] = acc;
+      }
+    }
+  }
+}
+
+/* Fills u with a random unitary matrix, orthonormalising random columns */
+static void random_unitary(cf_t u[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N], uint32_t N)
+{
+  for (uint32_t j = 0; j < N; j++) {
+    for (uint32_t i = 0; i < N; i++) {
+      u[i][j] = RANDOM_CF();
+    }
+    for (uint32_t p = 0; p < j; p++) {
+      cf_t dot = 0.0f;
+      for (uint32_t i = 0; i < N; i++) {
+        dot += conjf(u[i][p]) * u[i][j];
+      }
+      for (uint32_t i = 0; i < N; i++) {
+        u[i][j] -= dot * u[i][p];
+      }
+    }
+    float norm = 0.0f;
+    for (uint32_t i = 0; i < N; i++) {
+      norm += crealf(u[i][j] * conjf(u[i][j]));
+    }
+    for (uint32_t i = 0; i < N; i++) {
+      u[i][j] /= sqrtf(norm);
+    }
+  }
+}
+
+static bool test_cholesky_batch(uint32_t N)
+{
+  static batch_t a, l;
+  batch_init(&a);
+  batch_init(&l);
+  batch_random_hpd(&a, N);
+
+  if (srsran_mat_cholesky_batch(a.m, l.m, N, BATCH_LEN) < SRSRAN_SUCCESS) {
+    return false;
+  }
+
+  // Check L x L' = A
+  float error = 0.0f;
+  for (uint32_t k = 0; k < BATCH_LEN; k++) {
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        cf_t acc = 0.0f;
+        for (uint32_t n = 0; n < N; n++) {
+          acc += l.buffer[i][n][k] * conjf(l.buffer[j][n][k]);
+        }
+        error = SRSRAN_MAX(error, cabsf(acc - a.buffer[i][j][k]) / cabsf(a.buffer[i][i][k]));
+      }
+    }
+  }
+
+  return (error < BATCH_MAXIMUM_ERROR);
+}
+
+static bool test_hermitian_inv_batch(uint32_t N)
+{
+  static batch_t a, r;
+  batch_init(&a);
+  batch_init(&r);
+  batch_random_hpd(&a, N);
+
+  if (srsran_mat_hermitian_inv_batch(a.m, r.m, N, BATCH_LEN) < SRSRAN_SUCCESS) {
+    return false;
+  }
+
+  // Check A x inv(A) = I
+  float error = 0.0f;
+  for (uint32_t k = 0; k < BATCH_LEN; k++) {
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        cf_t acc = 0.0f;
+        for (uint32_t n = 0; n < N; n++) {
+          acc += a.buffer[i][n][k] * r.buffer[n][j][k];
+        }
+        error = SRSRAN_MAX(error, cabsf(acc - ((i == j) ? 1.0f : 0.0f)));
+      }
+    }
+  }
+
+  return (error < BATCH_MAXIMUM_ERROR);
+}
+
+static bool test_cn_batch(uint32_t nof_rows, uint32_t nof_cols)
+{
+  static batch_t h;
+  float          cn[BATCH_LEN];
+  float          cn_gold[BATCH_LEN];
+  uint32_t       n = SRSRAN_MIN(nof_rows, nof_cols);
+  batch_init(&h);
+
+  // H = U x S x V' with well separated singular values, so the condition number is known
+  for (uint32_t k = 0; k < BATCH_LEN; k++) {
+    cf_t  u[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    cf_t  v[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+    float s[SRSRAN_MAT_MAX_N];
+    random_unitary(u, nof_rows);
+    random_unitary(v, nof_cols);
+    s[0] = srsran_random_uniform_real_dist(random_gen, 1.0f, 4.0f);
+    for (uint32_t i = 1; i < n; i++) {
+      s[i] = s[i - 1] * srsran_random_uniform_real_dist(random_gen, 0.1f, 0.5f);
+    }
+    cn_gold[k] = 20.0f * log10f(s[0] / s[n - 1]);
+
+    for (uint32_t i = 0; i < nof_rows; i++) {
+      for (uint32_t j = 0; j < nof_cols; j++) {
+        cf_t acc = 0.0f;
+        for (uint32_t p = 0; p < n; p++) {
+          acc += u[i][p] * s[p] * conjf(v[j][p]);
+        }
+        h.buffer[i][j][k] = acc;
+      }
+    }
+  }
+
+  if (srsran_mat_cn_batch(h.m, nof_rows, nof_cols, BATCH_LEN, cn) < SRSRAN_SUCCESS) {
+    return false;
+  }
+
+  float error = 0.0f;
+  for (uint32_t k = 0; k < BATCH_LEN; k++) {
+    error = SRSRAN_MAX(error, fabsf(cn[k] - cn_gold[k]));
+  }
+
+  // Condition numbers are given in dB
+  return (error < 0.1f);
+}
+
+static bool test_cholesky_batch_2x2(void)
+{
+  return test_cholesky_batch(2);
+}
+
+static bool test_cholesky_batch_4x4(void)
+{
+  return test_cholesky_batch(4);
+}
+
+static bool test_hermitian_inv_batch_2x2(void)
+{
+  return test_hermitian_inv_batch(2);
+}
+
+static bool test_hermitian_inv_batch_3x3(void)
+{
+  return test_hermitian_inv_batch(3);
+}
+
+static bool test_hermitian_inv_batch_4x4(void)
+{
+  return test_hermitian_inv_batch(4);
+}
+
+static bool test_cn_batch_2x2(void)
+{
+  return test_cn_batch(2, 2);
+}
+
+static bool test_cn_batch_4x2(void)
+{
+  return test_cn_batch(4, 2);
+}
+
+static bool test_cn_batch_3x4(void)
+{
+  return test_cn_batch(3, 4);
+}
+
+static bool test_cn_batch_4x4(void)
+{
+  return test_cn_batch(4, 4);
+}
+
+#define BENCHMARK_LEN 1200 /* Resource elements in a 100 PRB OFDM symbol */
+#define BENCHMARK_NOF_REPETITIONS 200
+
+typedef int (*batch_function_t)(cf_t*    a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                cf_t*    r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                                uint32_t N,
+                                uint32_t len);
+
+/* Condition number of N x N matrices, the results are written in the first output buffer */
+static int cn_batch_square(cf_t*    a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                           cf_t*    r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                           uint32_t N,
+                           uint32_t len)
+{
+  return srsran_mat_cn_batch(a, N, N, len, (float*)r[0][0]);
+}
+
+/* Returns the throughput in millions of matrices per second, processing stride matrices per call */
+static double benchmark_batch(batch_function_t function,
+                              cf_t*            a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                              cf_t*            r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N],
+                              uint32_t         N,
+                              uint32_t         stride)
+{
+  cf_t* a_k[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+  cf_t* r_k[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+  for (uint32_t n = 0; n < BENCHMARK_NOF_REPETITIONS; n++) {
+    for (uint32_t k = 0; k < BENCHMARK_LEN; k += stride) {
+      for (uint32_t i = 0; i < SRSRAN_MAT_MAX_N; i++) {
+        for (uint32_t j = 0; j < SRSRAN_MAT_MAX_N; j++) {
+          a_k[i][j] = &a[i][j][k];
+          r_k[i][j] = &r[i][j][k];
+        }
+      }
+      function(a_k, r_k, N, stride);
+    }
+  }
+  gettimeofday(&end, NULL);
+
+  return (double)BENCHMARK_LEN * BENCHMARK_NOF_REPETITIONS / elapsed_us(&start, &end);
+}
+
+/* Compares processing one matrix per call, which takes the scalar path, with processing a whole OFDM symbol per call */
+static void benchmark_batch_functions(void)
+{
+  cf_t* buffer = srsran_vec_cf_malloc(2 * SRSRAN_MAT_MAX_N * SRSRAN_MAT_MAX_N * BENCHMARK_LEN);
+  cf_t* a[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+  cf_t* r[SRSRAN_MAT_MAX_N][SRSRAN_MAT_MAX_N];
+  if (buffer == NULL) {
+    return;
+  }
+
+  // Diagonally dominant Hermitian matrices, also valid as channel matrices for the condition number
+  for (uint32_t i = 0; i < SRSRAN_MAT_MAX_N; i++) {
+    for (uint32_t j = 0; j < SRSRAN_MAT_MAX_N; j++) {
+      a[i][j] = &buffer[(SRSRAN_MAT_MAX_N * i + j) * BENCHMARK_LEN];
+      r[i][j] = &buffer[(SRSRAN_MAT_MAX_N * (SRSRAN_MAT_MAX_N + i) + j) * BENCHMARK_LEN];
+    }
+  }
+  for (uint32_t k = 0; k < BENCHMARK_LEN; k++) {
+    for (uint32_t i = 0; i < SRSRAN_MAT_MAX_N; i++) {
+      for (uint32_t j = 0; j <= i; j++) {
+        a[i][j][k] = (i == j) ? (float)SRSRAN_MAT_MAX_N + RANDOM_F() : RANDOM_CF();
+        a[j][i][k] = conjf(a[i][j][k]);
+      }
+    }
+  }
+
+  const struct {
+    const char*      name;
+    batch_function_t function;
+  } functions[] = {{"cholesky", srsran_mat_cholesky_batch},
+                   {"hermitian_inv", srsran_mat_hermitian_inv_batch},
+                   {"cn", cn_batch_square}};
+
+  printf("%16s %4s %14s %14s\n", "function", "N", "single Mmat/s", "batch Mmat/s");
+  for (uint32_t f = 0; f < sizeof(functions) / sizeof(functions[0]); f++) {
+    for (uint32_t N = 2; N <= SRSRAN_MAT_MAX_N; N++) {
+      double single  = benchmark_batch(functions[f].function, a, r, N, 1);
+      double batched = benchmark_batch(functions[f].function, a, r, N, BENCHMARK_LEN);
+      printf("%16s %4d %14.2f %14.2f\n", functions[f].name, N, single, batched);
+    }
+  }
+
+  free(buffer);
+}
+
 bool test_matrix_inv(void)
 {
   const uint32_t                     N = 64;
@@ -322,6 +634,22 @@ int main(int argc, char** argv)
     RUN_TEST(test_matrix_inv);
   }
 
+  if (batch) {
+    RUN_TEST(test_cholesky_batch_2x2);
+    RUN_TEST(test_cholesky_batch_4x4);
+    RUN_TEST(test_hermitian_inv_batch_2x2);
+    RUN_TEST(test_hermitian_inv_batch_3x3);
+    RUN_TEST(test_hermitian_inv_batch_4x4);
+    RUN_TEST(test_cn_batch_2x2);
+    RUN_TEST(test_cn_batch_4x2);
+    RUN_TEST(test_cn_batch_3x4);
+    RUN_TEST(test_cn_batch_4x4);
+  }
+
+  if (benchmark) {
+    benchmark_batch_functions();
+  }
+
   RUN_TEST(test_vec_dot_prod_ccc);
 
   printf("%s!\n", (passed) ? "Ok" : "Failed");
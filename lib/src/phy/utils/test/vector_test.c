@@ -776,6 +776,56 @@ TEST(
     free(x);
     free(z);)
 
+TEST(
+    srsran_vec_acc_cfo_cc, MALLOC(cf_t, x); cf_t z = 0.0f;
+
+    const float cfo  = 0.1f;
+    cf_t        gold = 0.0f;
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_CF(); }
+
+    TEST_CALL(z = srsran_vec_acc_cfo_cc(x, cfo, block_size))
+
+        for (int i = 0; i < block_size; i++) { gold += x[i] * cexp(_Complex_I * 2.0 * M_PI * i * cfo); }
+
+    mse += cabsf(gold - z) / cabsf(gold);
+
+    free(x);)
+
+// Odd strides are permutations of the power of two block sizes
+TEST(
+    srsran_vec_gather_c, MALLOC(cf_t, x); MALLOC(uint32_t, idx); MALLOC(cf_t, z);
+
+    for (int i = 0; i < block_size; i++) {
+      x[i]   = RANDOM_CF();
+      idx[i] = (i * 7) % block_size;
+    }
+
+    TEST_CALL(srsran_vec_gather_c(x, idx, z, block_size))
+
+        for (int i = 0; i < block_size; i++) { mse += cabsf(x[idx[i]] - z[i]); }
+
+    free(x);
+    free(idx);
+    free(z);)
+
+TEST(
+    srsran_vec_scatter_sum_c, MALLOC(cf_t, x); MALLOC(uint32_t, idx); MALLOC(cf_t, y); MALLOC(cf_t, z);
+
+    for (int i = 0; i < block_size; i++) {
+      x[i]   = RANDOM_CF();
+      y[i]   = RANDOM_CF();
+      idx[i] = (i * 7) % block_size;
+    }
+
+    TEST_CALL(srsran_vec_scatter_c(y, idx, z, block_size); srsran_vec_scatter_sum_c(x, idx, z, block_size))
+
+        for (int i = 0; i < block_size; i++) { mse += cabsf(x[i] + y[i] - z[idx[i]]); }
+
+    free(x);
+    free(idx);
+    free(y);
+    free(z);)
+
 TEST(
     srsran_vec_gen_sine, MALLOC(cf_t, z);
 
@@ -845,6 +895,95 @@ TEST(
     free(z);
     srsran_cfo_free(&srsran_cfo);)
 
+TEST(
+    srsran_vec_apply_cfo_phase, MALLOC(cf_t, x); MALLOC(cf_t, z);
+
+    const float  cfo   = 0.1f;
+    const double phase = 0.25;
+    cf_t         gold;
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_CF(); }
+
+    TEST_CALL(srsran_vec_apply_cfo_phase(x, cfo, phase, z, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          gold = x[i] * cexp(_Complex_I * 2.0 * M_PI * (phase + (double)i * cfo));
+          mse += cabsf(gold - z[i]) / cabsf(gold);
+        } mse /= block_size;
+
+    free(x);
+    free(z);)
+
+TEST(
+    srsran_cfo_correct_continuous, srsran_cfo_t srsran_cfo; bzero(&srsran_cfo, sizeof(srsran_cfo)); MALLOC(cf_t, x);
+    MALLOC(cf_t, z);
+    MALLOC(cf_t, w);
+
+    // The frequency changes between the two halves of the block, the phase shall be continuous. The second channel
+    // takes the same input, so it shall have the same output
+    const float cfo1 = 0.1f;
+    const float cfo2 = -0.05f;
+    uint32_t    n1   = block_size / 2;
+    uint32_t    n2   = block_size - n1;
+    cf_t        gold;
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_CF(); }
+
+    cf_t* in1[2];
+    cf_t* out1[2];
+    cf_t* in2[2];
+    cf_t* out2[2];
+    in1[0]  = x;
+    in1[1]  = x;
+    out1[0] = z;
+    out1[1] = w;
+    in2[0]  = &x[n1];
+    in2[1]  = &x[n1];
+    out2[0] = &z[n1];
+    out2[1] = &w[n1];
+
+    srsran_cfo_init(&srsran_cfo, block_size);
+
+    TEST_CALL(srsran_cfo_reset_phase(&srsran_cfo); srsran_cfo_resize(&srsran_cfo, n1);
+              srsran_cfo_correct_continuous(&srsran_cfo, in1, out1, 2, cfo1);
+              srsran_cfo_resize(&srsran_cfo, n2);
+              srsran_cfo_correct_continuous(&srsran_cfo, in2, out2, 2, cfo2))
+
+        for (int i = 0; i < block_size; i++) {
+          double phase = (i < n1) ? (double)i * cfo1 : (double)n1 * cfo1 + (double)(i - n1) * cfo2;
+          gold         = x[i] * cexp(_Complex_I * 2.0 * M_PI * phase);
+          mse += cabsf(gold - z[i]) / cabsf(gold);
+          mse += cabsf(w[i] - z[i]);
+        } mse /= block_size;
+
+    free(x);
+    free(z);
+    free(w);
+    srsran_cfo_free(&srsran_cfo);)
+
+// Table based CFO correction, the table is generated on every call as the frequency changes. It is the reference for
+// the throughput of the table-less CFO correction
+TEST(
+    srsran_cexptab_gen_prod, srsran_cexptab_t tab; bzero(&tab, sizeof(tab)); MALLOC(cf_t, x); MALLOC(cf_t, t);
+    MALLOC(cf_t, z);
+
+    float cfo = 0.1f;
+    cf_t  gold;
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_CF(); }
+
+    srsran_cexptab_init(&tab, 4096);
+
+    TEST_CALL(cfo = (i % 2) ? 0.1 : -0.1; srsran_cexptab_gen(&tab, t, cfo, block_size);
+              srsran_vec_prod_ccc(t, x, z, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          gold = x[i] * cexpf(_Complex_I * 2.0f * (float)M_PI * i * cfo);
+          mse += cabsf(gold - z[i]) / cabsf(gold);
+        } mse /= block_size;
+
+    free(x);
+    free(t);
+    free(z);
+    srsran_cexptab_free(&tab);)
+
 // This test compares the clipping method used for the CFR module in its default configuration to the original CFR
 // algorithm. The original algorithm can still be used by defining CFR_PEAK_EXTRACTION in the CFR module.
 TEST(
@@ -1039,6 +1178,18 @@ int main(int argc, char** argv)
         test_srsran_vec_apply_cfo(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_acc_cfo_cc(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srsran_vec_gather_c(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srsran_vec_scatter_sum_c(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_gen_sine(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
@@ -1055,6 +1206,18 @@ int main(int argc, char** argv)
         test_srsran_cfo_correct_change(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_apply_cfo_phase(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srsran_cfo_correct_continuous(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srsran_cexptab_gen_prod(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_gen_clip_env(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
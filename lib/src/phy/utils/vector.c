@@ -151,6 +151,21 @@ void srsran_vec_lut_sis(const short* x, const unsigned int* lut, short* y, const
   }
 }
 
+void srsran_vec_gather_c(const cf_t* x, const uint32_t* idx, cf_t* y, const uint32_t len)
+{
+  srsran_vec_gather_c_simd(x, idx, y, len);
+}
+
+void srsran_vec_scatter_c(const cf_t* x, const uint32_t* idx, cf_t* y, const uint32_t len)
+{
+  srsran_vec_scatter_c_simd(x, idx, y, len);
+}
+
+void srsran_vec_scatter_sum_c(const cf_t* x, const uint32_t* idx, cf_t* y, const uint32_t len)
+{
+  srsran_vec_scatter_sum_c_simd(x, idx, y, len);
+}
+
 void* srsran_vec_malloc(uint32_t size)
 {
   void* ptr;
@@ -857,6 +872,16 @@ void srsran_vec_apply_cfo(const cf_t* x, float cfo, cf_t* z, int len)
   srsran_vec_apply_cfo_simd(x, cfo, z, len);
 }
 
+void srsran_vec_apply_cfo_phase(const cf_t* x, float cfo, double phase, cf_t* z, int len)
+{
+  srsran_vec_apply_cfo_phase_simd(x, cfo, phase, z, len);
+}
+
+cf_t srsran_vec_acc_cfo_cc(const cf_t* x, float cfo, int len)
+{
+  return srsran_vec_acc_cfo_cc_simd(x, cfo, len);
+}
+
 float srsran_vec_estimate_frequency(const cf_t* x, int len)
 {
   return srsran_vec_estimate_frequency_simd(x, len);
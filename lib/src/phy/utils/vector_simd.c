@@ -402,6 +402,78 @@ void srsran_vec_lut_bbb_simd(const int8_t* x, const unsigned short* lut, int8_t*
   }
 }
 
+void srsran_vec_gather_c_simd(const cf_t* x, const uint32_t* idx, cf_t* y, const int len)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  for (; i < len - 7; i += 8) {
+    __m256i idx_v = _mm256_loadu_si256((__m256i*)&idx[i]);
+    __m512d v     = _mm512_i32gather_pd(idx_v, (const double*)x, sizeof(cf_t));
+    _mm512_storeu_pd((double*)&y[i], v);
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  for (; i < len - 3; i += 4) {
+    __m128i idx_v = _mm_loadu_si128((__m128i*)&idx[i]);
+    __m256d v     = _mm256_i32gather_pd((const double*)x, idx_v, sizeof(cf_t));
+    _mm256_storeu_pd((double*)&y[i], v);
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < len; i++) {
+    y[i] = x[idx[i]];
+  }
+}
+
+void srsran_vec_scatter_c_simd(const cf_t* x, const uint32_t* idx, cf_t* y, const int len)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  for (; i < len - 7; i += 8) {
+    __m256i idx_v = _mm256_loadu_si256((__m256i*)&idx[i]);
+    __m512d v     = _mm512_loadu_pd((const double*)&x[i]);
+    _mm512_i32scatter_pd((double*)y, idx_v, v, sizeof(cf_t));
+  }
+#endif /* LV_HAVE_AVX512 */
+
+  for (; i < len; i++) {
+    y[idx[i]] = x[i];
+  }
+}
+
+void srsran_vec_scatter_sum_c_simd(const cf_t* x, const uint32_t* idx, cf_t* y, const int len)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  for (; i < len - 7; i += 8) {
+    __m256i idx_v = _mm256_loadu_si256((__m256i*)&idx[i]);
+    __m512  a     = _mm512_loadu_ps((const float*)&x[i]);
+    __m512  b     = _mm512_castpd_ps(_mm512_i32gather_pd(idx_v, (const double*)y, sizeof(cf_t)));
+    _mm512_i32scatter_pd((double*)y, idx_v, _mm512_castps_pd(_mm512_add_ps(a, b)), sizeof(cf_t));
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  for (; i < len - 3; i += 4) {
+    __m128i idx_v = _mm_loadu_si128((__m128i*)&idx[i]);
+    __m256  a     = _mm256_loadu_ps((const float*)&x[i]);
+    __m256  b     = _mm256_castpd_ps(_mm256_i32gather_pd((const double*)y, idx_v, sizeof(cf_t)));
+    __m256d r     = _mm256_castps_pd(_mm256_add_ps(a, b));
+    __m128d lo    = _mm256_castpd256_pd128(r);
+    __m128d hi    = _mm256_extractf128_pd(r, 1);
+    _mm_storel_pd((double*)&y[idx[i]], lo);
+    _mm_storeh_pd((double*)&y[idx[i + 1]], lo);
+    _mm_storel_pd((double*)&y[idx[i + 2]], hi);
+    _mm_storeh_pd((double*)&y[idx[i + 3]], hi);
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < len; i++) {
+    y[idx[i]] += x[i];
+  }
+}
+
 void srsran_vec_convert_if_simd(const int16_t* x, float* z, const float scale, const int len)
 {
   int         i    = 0;
@@ -1720,21 +1792,21 @@ cf_t srsran_vec_gen_sine_simd(cf_t amplitude, float freq, cf_t* z, int len)
   return phase;
 }
 
-void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int len)
+// Multiplies x by a complex oscillator with initial phase and per sample rotation osc
+static void vec_apply_osc_simd(const cf_t* x, cf_t osc, cf_t phase, cf_t* z, int len)
 {
-  const float TWOPI = 2.0f * (float)M_PI;
-  int         i     = 0;
-  cf_t        osc   = cexpf(_Complex_I * TWOPI * cfo);
-  cf_t        phase = 1.0f;
+  int i = 0;
 
 #if SRSRAN_SIMD_CF_SIZE
   // Load initial phases and oscillator
   srsran_simd_aligned cf_t _phase[SRSRAN_SIMD_CF_SIZE];
-  _phase[0] = phase;
+  cf_t                     osc_n = osc;
+  _phase[0]                      = phase;
   for (int k = 1; k < SRSRAN_SIMD_CF_SIZE; k++) {
     _phase[k] = _phase[k - 1] * osc;
+    osc_n *= osc;
   }
-  simd_cf_t _simd_osc   = srsran_simd_cf_set1(_phase[SRSRAN_SIMD_CF_SIZE - 1] * osc);
+  simd_cf_t _simd_osc   = srsran_simd_cf_set1(osc_n);
   simd_cf_t _simd_phase = srsran_simd_cfi_load(_phase);
 
   if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
@@ -1773,6 +1845,95 @@ void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int len)
   }
 }
 
+void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int len)
+{
+  const float TWOPI = 2.0f * (float)M_PI;
+
+  vec_apply_osc_simd(x, cexpf(_Complex_I * TWOPI * cfo), 1.0f, z, len);
+}
+
+/*
+ * Number of samples between oscillator phase recalculations in srsran_vec_apply_cfo_phase_simd(). It bounds the error
+ * accumulated by the recursive phase rotation
+ */
+#define VEC_CFO_ANCHOR_LEN 4096
+
+void srsran_vec_apply_cfo_phase_simd(const cf_t* x, float cfo, double phase, cf_t* z, int len)
+{
+  const double TWOPI = 2.0 * M_PI;
+  cf_t         osc   = cexpf(_Complex_I * (float)TWOPI * cfo);
+
+  for (int i = 0; i < len; i += VEC_CFO_ANCHOR_LEN) {
+    // Calculate the phase at the beginning of the chunk from the accumulated phase, wrapped to [0, 1) cycles to keep the
+    // precision regardless of the offset
+    double chunk_phase = phase + (double)cfo * (double)i;
+    chunk_phase -= floor(chunk_phase);
+
+    int n = (len - i < VEC_CFO_ANCHOR_LEN) ? (len - i) : VEC_CFO_ANCHOR_LEN;
+    vec_apply_osc_simd(&x[i], osc, (cf_t)cexp(_Complex_I * TWOPI * chunk_phase), &z[i], n);
+  }
+}
+
+cf_t srsran_vec_acc_cfo_cc_simd(const cf_t* x, float cfo, int len)
+{
+  const float TWOPI = 2.0f * (float)M_PI;
+  int         i     = 0;
+  cf_t        osc   = cexpf(_Complex_I * TWOPI * cfo);
+  cf_t        phase = 1.0f;
+  cf_t        acc   = 0.0f;
+
+#if SRSRAN_SIMD_CF_SIZE
+  // Load initial phases and oscillator
+  srsran_simd_aligned cf_t _phase[SRSRAN_SIMD_CF_SIZE];
+  _phase[0] = phase;
+  for (int k = 1; k < SRSRAN_SIMD_CF_SIZE; k++) {
+    _phase[k] = _phase[k - 1] * osc;
+  }
+  simd_cf_t _simd_osc   = srsran_simd_cf_set1(_phase[SRSRAN_SIMD_CF_SIZE - 1] * osc);
+  simd_cf_t _simd_phase = srsran_simd_cfi_load(_phase);
+  simd_cf_t _simd_acc   = srsran_simd_cf_zero();
+
+  if (SRSRAN_IS_ALIGNED(x)) {
+    // For aligned memory
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t a = srsran_simd_cfi_load(&x[i]);
+
+      _simd_acc = srsran_simd_cf_add(_simd_acc, srsran_simd_cf_prod(a, _simd_phase));
+
+      _simd_phase = srsran_simd_cf_prod(_simd_phase, _simd_osc);
+    }
+  } else {
+    // For unaligned memory
+    for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t a = srsran_simd_cfi_loadu(&x[i]);
+
+      _simd_acc = srsran_simd_cf_add(_simd_acc, srsran_simd_cf_prod(a, _simd_phase));
+
+      _simd_phase = srsran_simd_cf_prod(_simd_phase, _simd_osc);
+    }
+  }
+
+  // Accumulate all lanes
+  srsran_simd_aligned cf_t _acc[SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_cfi_store(_acc, _simd_acc);
+  for (int k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+    acc += _acc[k];
+  }
+
+  // Stores the next phase
+  srsran_simd_cfi_store(_phase, _simd_phase);
+  phase = _phase[0];
+#endif
+
+  for (; i < len; i++) {
+    acc += x[i] * phase;
+
+    phase *= osc;
+  }
+
+  return acc;
+}
+
 float srsran_vec_estimate_frequency_simd(const cf_t* x, int len)
 {
   cf_t sum = 0.0f;
@@ -47,6 +47,14 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resampler_poly_t& q : poly_interpolators) {
+    srsran_resampler_poly_free(&q);
+  }
+
+  for (srsran_resampler_poly_t& q : poly_decimators) {
+    srsran_resampler_poly_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -76,6 +84,15 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
   nof_carriers = args.nof_carriers;
   fix_srate_hz = args.srate_hz;
 
+  // Select the resampler for fixed sampling rate
+  if (args.resampler == "fft") {
+    resampler_mode = RESAMPLER_FFT;
+  } else if (args.resampler == "polyphase") {
+    resampler_mode = RESAMPLER_POLYPHASE;
+  } else {
+    resampler_mode = RESAMPLER_AUTO;
+  }
+
   cur_tx_freqs.resize(nof_carriers);
   cur_rx_freqs.resize(nof_carriers);
 
@@ -296,24 +313,32 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // Extract decimation ratio. As the decimation may take some time to set a new ratio, deactivate the decimation and
   // keep receiving samples to avoid stalling the RX stream
   uint32_t ratio = 1; // No decimation by default
+  bool     poly  = false;
   if (decimator_busy) {
     lock.unlock();
   } else if (decimators[0].ratio > 1) {
     ratio = decimators[0].ratio;
+  } else if (poly_decimators[0].up > 0) {
+    poly = true;
   }
+  bool decimate = (ratio > 1 || poly);
 
-  // Calculate number of samples, considering the decimation ratio
+  // Calculate number of samples, considering the decimation ratio. The polyphase decimator requires a variable number
+  // of samples depending on its phase
   uint32_t nof_samples = buffer.get_nof_samples() * ratio;
+  if (poly) {
+    nof_samples = srsran_resampler_poly_get_nof_input(&poly_decimators[0], buffer.get_nof_samples());
+  }
 
   // Check decimation buffer protection
-  if (ratio > 1 && nof_samples > rx_buffer[0].size()) {
+  if (decimate && nof_samples > rx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Rx number of samples ({}/{}) exceeds buffer size ({})",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_samples,
                    rx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
@@ -327,7 +352,7 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // If the interpolator have been set, interpolate
   for (uint32_t ch = 0; ch < nof_channels; ch++) {
     // Use rx buffer if decimator is required
-    buffer_rx.set(ch, ratio > 1 ? rx_buffer[ch].data() : buffer.get(ch));
+    buffer_rx.set(ch, decimate ? rx_buffer[ch].data() : buffer.get(ch));
   }
 
   if (not radio_is_streaming) {
@@ -355,6 +380,12 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
         srsran_resampler_fft_run(&decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
       }
     }
+  } else if (poly) {
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      if (buffer.get(ch) and buffer_rx.get(ch)) {
+        srsran_resampler_poly_run(&poly_decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
+      }
+    }
   }
 
   return ret;
@@ -422,6 +453,7 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
   bool                         ret = true;
   std::unique_lock<std::mutex> lock(tx_mutex);
   uint32_t                     ratio = interpolators[0].ratio;
+  srsran_resampler_poly_t&     poly  = poly_interpolators[0];
 
   // Get number of samples at the low rate
   uint32_t nof_samples = buffer.get_nof_samples();
@@ -442,6 +474,14 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
     nof_samples = tx_buffer[0].size() / ratio;
   }
 
+  // Same protection for the polyphase interpolator, the number of interpolated samples is up to ceil(N * up / down)
+  if (poly.up > 0 && SRSRAN_CEIL((size_t)nof_samples * poly.up, poly.down) > tx_buffer[0].size()) {
+    logger.info("Tx number of samples (%d) exceeds buffer size (%zd)", nof_samples, tx_buffer[0].size());
+
+    // Limit number of samples to transmit
+    nof_samples = (uint32_t)(((size_t)tx_buffer[0].size() * poly.down) / poly.up);
+  }
+
   // If the interpolator have been set, interpolate
   if (interpolators[0].ratio > 1) {
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
@@ -454,6 +494,19 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
 
     // Set buffer size after applying the interpolation
     buffer.set_nof_samples(nof_samples * ratio);
+  } else if (poly.up > 0) {
+    uint32_t nof_interpolated = 0;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      // Perform actual interpolation, all channels produce the same number of samples
+      nof_interpolated =
+          srsran_resampler_poly_run(&poly_interpolators[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+
+      // Set the buffer pointer
+      buffer.set(ch, tx_buffer[ch].data());
+    }
+
+    // Set buffer size after applying the interpolation
+    buffer.set_nof_samples(nof_interpolated);
   }
 
   for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
@@ -746,17 +799,33 @@ void radio::set_rx_srate(const double& srate)
       }
     }
 
+    // Select the polyphase decimator for non-integer ratios unless the FFT resampler is forced
+    bool is_integer = ((uint32_t)cur_rx_srate % (uint32_t)srate) == 0;
+    bool use_poly   = resampler_mode == RESAMPLER_POLYPHASE || (resampler_mode == RESAMPLER_AUTO && not is_integer);
+
     // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_rx_srate % (uint32_t)srate) == 0,
+    srsran_assert(use_poly || is_integer,
                   "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
                   cur_rx_srate / 1e6,
                   srate / 1e6,
                   cur_rx_srate / srate);
 
-    // Update decimators
-    uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+    if (use_poly) {
+      // Update polyphase decimators and make sure the FFT decimators are not used
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_free(&decimators[ch]);
+        if (srsran_resampler_poly_init_srate(&poly_decimators[ch], cur_rx_srate, srate) < SRSRAN_SUCCESS) {
+          logger.error("Error initialising polyphase decimator %.2f MHz / %.2f MHz", cur_rx_srate / 1e6, srate / 1e6);
+        }
+        srsran_resampler_poly_reset_state(&poly_decimators[ch]);
+      }
+    } else {
+      // Update decimators
+      uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_poly_free(&poly_decimators[ch]);
+        srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+      }
     }
 
     decimator_busy = false;
@@ -1002,17 +1071,34 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
+    // Select the polyphase interpolator for non-integer ratios unless the FFT resampler is forced
+    bool is_integer = ((uint32_t)cur_tx_srate % (uint32_t)srate) == 0;
+    bool use_poly   = resampler_mode == RESAMPLER_POLYPHASE || (resampler_mode == RESAMPLER_AUTO && not is_integer);
+
     // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
+    srsran_assert(use_poly || is_integer,
                   "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
                   cur_rx_srate / 1e6,
                   srate / 1e6,
                   cur_rx_srate / srate);
 
-    // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+    if (use_poly) {
+      // Update polyphase interpolators and make sure the FFT interpolators are not used
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_free(&interpolators[ch]);
+        if (srsran_resampler_poly_init_srate(&poly_interpolators[ch], srate, cur_tx_srate) < SRSRAN_SUCCESS) {
+          logger.error(
+              "Error initialising polyphase interpolator %.2f MHz / %.2f MHz", cur_tx_srate / 1e6, srate / 1e6);
+        }
+        srsran_resampler_poly_reset_state(&poly_interpolators[ch]);
+      }
+    } else {
+      // Update interpolators
+      uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_poly_free(&poly_interpolators[ch]);
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -0,0 +1,126 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/system/sys_metrics_parsers.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+using namespace srsran;
+
+/// Returns a pointer to the given field of a space separated line, or nullptr if the line is shorter. The first field
+/// has index zero.
+static const char* skip_fields(const char* str, uint32_t nof_fields)
+{
+  for (uint32_t i = 0; i < nof_fields && str != nullptr; ++i) {
+    str = std::strpbrk(str, " \n");
+    if (str == nullptr || *str == '\n') {
+      return nullptr;
+    }
+    str += std::strspn(str, " ");
+  }
+  return str;
+}
+
+/// Parses the unsigned decimal number at the start of the given string. Returns false if there is none.
+static bool parse_number(const char* str, uint64_t& value)
+{
+  if (str == nullptr || *str < '0' || *str > '9') {
+    return false;
+  }
+  value = std::strtoull(str, nullptr, 10);
+  return true;
+}
+
+bool srsran::parse_proc_stat(const char* buffer, proc_stat_fields& fields)
+{
+  // The name is enclosed in parenthesis and may contain spaces and parenthesis itself, so it ends at the last one.
+  const char* name_begin = std::strchr(buffer, '(');
+  const char* name_end   = std::strrchr(buffer, ')');
+  if (name_begin == nullptr || name_end == nullptr || name_end < name_begin || name_end[1] != ' ') {
+    return false;
+  }
+  size_t name_len = std::min<size_t>(name_end - name_begin - 1, fields.name.size() - 1);
+  std::copy(name_begin + 1, name_begin + 1 + name_len, fields.name.begin());
+  fields.name[name_len] = '\0';
+
+  // Fields 14, 15, 20 and 22, counted from the state that follows the name, which is the third one.
+  const char* str         = name_end + 2;
+  const char* utime       = skip_fields(str, 14 - 3);
+  const char* stime       = skip_fields(utime, 1);
+  const char* num_threads = skip_fields(stime, 5);
+  const char* start_time  = skip_fields(num_threads, 2);
+
+  uint64_t nof_threads = 0;
+  if (!parse_number(utime, fields.utime) || !parse_number(stime, fields.stime) ||
+      !parse_number(num_threads, nof_threads) || !parse_number(start_time, fields.start_time)) {
+    return false;
+  }
+  fields.num_threads = static_cast<int32_t>(nof_threads);
+  return true;
+}
+
+uint32_t srsran::parse_memory_value(const char* buffer, const char* label)
+{
+  const char* str = std::strstr(buffer, label);
+  if (str == nullptr) {
+    return 0;
+  }
+
+  // NOTE: negative values are clamped to 0.
+  long value = std::strtol(str + std::strlen(label), nullptr, 10);
+  return static_cast<uint32_t>(std::max(value, 0L));
+}
+
+bool srsran::parse_meminfo(const char* buffer, meminfo_fields& fields)
+{
+  // Labels other than the first one are preceded by a new line, so that e.g. "SwapCached:" is not taken as "Cached:".
+  fields.total_kB   = parse_memory_value(buffer, "MemTotal:");
+  fields.free_kB    = parse_memory_value(buffer, "\nMemFree:");
+  fields.buffers_kB = parse_memory_value(buffer, "\nBuffers:");
+  fields.cached_kB  = parse_memory_value(buffer, "\nCached:");
+  fields.slab_kB    = parse_memory_value(buffer, "\nSlab:");
+  return fields.total_kB != 0;
+}
+
+uint32_t srsran::parse_cpu_idle_times(const char* buffer, uint64_t* idle_ticks, uint32_t max_nof_cpus)
+{
+  // First line is the CPU field that contains all the cores and thread. For now, we skip this one.
+  const char* line  = std::strchr(buffer, '\n');
+  uint32_t    index = 0;
+  while (line != nullptr && index < max_nof_cpus) {
+    line += 1;
+
+    // Parse all the cpus, the idle time is the fourth value.
+    if (std::strncmp(line, "cpu", 3) != 0 || !parse_number(skip_fields(line, 4), idle_ticks[index])) {
+      break;
+    }
+
+    ++index;
+    line = std::strchr(line, '\n');
+  }
+  return index;
+}
+
+bool srsran::parse_schedstat_runtime(const char* buffer, uint64_t& runtime_ns)
+{
+  return parse_number(buffer, runtime_ns);
+}
@@ -18,11 +18,14 @@
  * and at http://www.gnu.org/licenses/.
  *
  */
-
 #include "srsran/system/sys_metrics_processor.h"
-#include <fstream>
-#include <sstream>
-#include <sys/sysinfo.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 using namespace srsran;
@@ -30,32 +33,83 @@ using namespace srsran;
 static const uint32_t cpu_count        = ::sysconf(_SC_NPROCESSORS_CONF);
 static const float    ticks_per_second = ::sysconf(_SC_CLK_TCK);
 
-sys_metrics_processor::sys_metrics_processor(srslog::basic_logger& logger) : logger(logger)
+sys_metrics_processor::proc_file::proc_file(int dir_fd, const char* path) :
+  fd(::openat(dir_fd, path, O_RDONLY | O_CLOEXEC))
+{}
+
+sys_metrics_processor::proc_file::~proc_file()
 {
-  if (cpu_count > metrics_max_supported_cpu) {
-    logger.warning("Number of cpu is greater than supported. CPU metrics will be disabled.");
+  if (fd >= 0) {
+    ::close(fd);
   }
 }
 
-sys_metrics_processor::proc_stats_info::proc_stats_info()
+sys_metrics_processor::proc_file::proc_file(proc_file&& other) noexcept : fd(other.fd)
+{
+  other.fd = -1;
+}
+
+sys_metrics_processor::proc_file& sys_metrics_processor::proc_file::operator=(proc_file&& other) noexcept
+{
+  std::swap(fd, other.fd);
+  return *this;
+}
+
+int sys_metrics_processor::proc_file::read(char* buffer, size_t size) const
 {
-  std::string line;
-  {
-    std::ifstream file("/proc/self/stat");
-    if (!file) {
-      return;
+  if (fd < 0 || size == 0) {
+    return -1;
+  }
+
+  // Reading from offset zero makes the kernel regenerate the file contents.
+  size_t nof_bytes = 0;
+  while (nof_bytes < size - 1) {
+    ssize_t n = ::pread(fd, buffer + nof_bytes, size - 1 - nof_bytes, nof_bytes);
+    if (n < 0) {
+      return -1;
     }
+    if (n == 0) {
+      break;
+    }
+    nof_bytes += n;
+  }
+  buffer[nof_bytes] = '\0';
+
+  return static_cast<int>(nof_bytes);
+}
+
+sys_metrics_processor::sys_metrics_processor(srslog::basic_logger& logger) :
+  logger(logger),
+  self_stat(AT_FDCWD, "/proc/self/stat"),
+  self_status(AT_FDCWD, "/proc/self/status"),
+  stat(AT_FDCWD, "/proc/stat"),
+  meminfo(AT_FDCWD, "/proc/meminfo"),
+  task_dir_fd(::open("/proc/self/task", O_RDONLY | O_DIRECTORY | O_CLOEXEC))
+{
+  if (cpu_count > metrics_max_supported_cpu) {
+    logger.warning("Number of cpu is greater than supported. CPU metrics will be disabled.");
+  }
+  if (!self_stat.is_open() || !self_status.is_open() || !stat.is_open() || !meminfo.is_open() || task_dir_fd < 0) {
+    logger.warning("Some files of the /proc/ system could not be opened. The related metrics will be disabled.");
+  }
+
+  threads.reserve(metrics_max_supported_threads);
+  read_proc_stats(last_query);
+}
 
-    std::getline(file, line);
+sys_metrics_processor::~sys_metrics_processor()
+{
+  if (task_dir_fd >= 0) {
+    ::close(task_dir_fd);
   }
+}
 
-  std::istringstream reader(line);
-  reader >> pid >> comm >> state >> ppid >> pgrp >> session >> tty_nr >> tpgid >> flags >> minflt >> cminflt >>
-      majflt >> cmajflt >> utime >> stime >> cutime >> cstime >> priority >> nice >> num_threads >> itrealvalue >>
-      starttime >> vsize >> rss >> rsslim >> startcode >> endcode >> startstack >> kstkeip >> signal >> blocked >>
-      sigignore >> sigcatch >> wchan >> nswap >> cnswap >> exit_signal >> processor >> rt_priority >> policy >>
-      delaycct_blkio_ticks >> guest_time >> cguest_time >> start_data >> end_data >> start_brk >> arg_start >>
-      arg_end >> env_start >> env_end >> exit_code;
+bool sys_metrics_processor::read_proc_stats(proc_stat_fields& info)
+{
+  if (self_stat.read(buffer.data(), buffer.size()) <= 0) {
+    return false;
+  }
+  return parse_proc_stat(buffer.data(), info);
 }
 
 /// Returns a null sys_metrics_t with the cpu count field filled.
@@ -92,20 +146,25 @@ sys_metrics_t sys_metrics_processor::get_metrics()
   // Calculate cpu metrics.
   calculate_cpu_metrics(metrics, measure_interval_ms / 1000.f);
 
+  // Calculate the cpu usage of every thread.
+  calculate_thread_metrics(metrics, measure_interval_ms / 1000.f);
+
   // Get the stats from the proc.
-  proc_stats_info current_query;
-  metrics.thread_count      = current_query.num_threads;
-  metrics.process_cpu_usage = calculate_cpu_usage(current_query, measure_interval_ms / 1000.f);
+  proc_stat_fields current_query;
+  if (read_proc_stats(current_query)) {
+    metrics.thread_count      = current_query.num_threads;
+    metrics.process_cpu_usage = calculate_cpu_usage(current_query, measure_interval_ms / 1000.f);
+    last_query                = current_query;
+  }
 
   // Update the last values.
   last_query_time = current_time;
-  last_query      = std::move(current_query);
 
   return metrics;
 }
 
-float sys_metrics_processor::calculate_cpu_usage(const proc_stats_info& current_query,
-                                                 float                  delta_time_in_seconds) const
+float sys_metrics_processor::calculate_cpu_usage(const proc_stat_fields& current_query,
+                                                 float                   delta_time_in_seconds) const
 {
   // Error current value has to be greater than last value.
   if (current_query.stime < last_query.stime || current_query.utime < last_query.utime) {
@@ -121,16 +180,6 @@ float sys_metrics_processor::calculate_cpu_usage(const proc_stats_info& current_
          (cpu_count * ticks_per_second * delta_time_in_seconds);
 }
 
-sys_metrics_processor::cpu_metrics_t sys_metrics_processor::read_cpu_idle_from_line(const std::string& line) const
-{
-  std::istringstream reader(line);
-  cpu_metrics_t      m;
-
-  reader >> m.name >> m.user >> m.nice >> m.system >> m.idle >> m.iowait >> m.irq >> m.softirq;
-
-  return m;
-}
-
 void sys_metrics_processor::calculate_cpu_metrics(sys_metrics_t& metrics, float delta_time_in_seconds)
 {
   // When the number of cpu is higher than system_metrics_t supports, skip the cpu metrics.
@@ -140,35 +189,121 @@ void sys_metrics_processor::calculate_cpu_metrics(sys_metrics_t& metrics, float
 
   metrics.cpu_count = cpu_count;
 
-  std::ifstream file("/proc/stat");
-  std::string   line;
-
-  if (!file) {
+  if (stat.read(buffer.data(), buffer.size()) <= 0) {
     return;
   }
 
-  int count = -1;
-  while (std::getline(file, line)) {
-    // First line is the CPU field that contains all the cores and thread. For now, we skip this one.
-    if (count < 0) {
-      ++count;
-      continue;
+  std::array<uint64_t, metrics_max_supported_cpu> idle_ticks;
+  uint32_t nof_cpus = parse_cpu_idle_times(buffer.data(), idle_ticks.data(), metrics_max_supported_cpu);
+  for (uint32_t index = 0; index != nof_cpus; ++index) {
+    uint64_t idle = idle_ticks[index];
+    if (idle < last_cpu_idle[index]) {
+      metrics.cpu_load[index] = 0.f;
+    } else {
+      metrics.cpu_load[index] =
+          std::max((1.f - (idle - last_cpu_idle[index]) / (ticks_per_second * delta_time_in_seconds)) * 100.f, 0.f);
+      last_cpu_idle[index] = idle;
     }
+  }
+}
+
+void sys_metrics_processor::calculate_thread_metrics(sys_metrics_t& metrics, float delta_time_in_seconds)
+{
+  if (task_dir_fd < 0) {
+    return;
+  }
+
+  for (auto& thread : threads) {
+    thread.alive = false;
+  }
+
+  // List the thread identifiers of the process from the already opened task directory.
+  struct linux_dirent64 {
+    uint64_t       d_ino;
+    int64_t        d_off;
+    unsigned short d_reclen;
+    unsigned char  d_type;
+    char           d_name[];
+  };
+  alignas(linux_dirent64) char dirents[4096];
+
+  ::lseek(task_dir_fd, 0, SEEK_SET);
+  long nof_bytes;
+  while ((nof_bytes = ::syscall(SYS_getdents64, task_dir_fd, dirents, sizeof(dirents))) > 0) {
+    for (long offset = 0; offset < nof_bytes;) {
+      const auto* entry = reinterpret_cast<const linux_dirent64*>(dirents + offset);
+      offset += entry->d_reclen;
 
-    // Parse all the cpus.
-    if (line.find("cpu") != std::string::npos) {
-      auto tmp   = read_cpu_idle_from_line(line);
-      auto index = count++;
-      if (tmp.idle < last_cpu_thread[index].idle) {
-        metrics.cpu_load[index] = 0.f;
+      if (entry->d_name[0] < '0' || entry->d_name[0] > '9') {
         continue;
       }
+      uint32_t tid = std::strtoul(entry->d_name, nullptr, 10);
 
-      metrics.cpu_load[index] = std::max(
-          (1.f - (tmp.idle - last_cpu_thread[index].idle) / (ticks_per_second * delta_time_in_seconds)) * 100.f, 0.f);
+      auto same_tid = [tid](const thread_info_t& thread) { return thread.tid == tid; };
+      auto it       = std::find_if(threads.begin(), threads.end(), same_tid);
+      if (it != threads.end()) {
+        it->alive = true;
+        continue;
+      }
+
+      if (threads.size() == metrics_max_supported_threads) {
+        continue;
+      }
+
+      thread_info_t thread;
+      thread.tid   = tid;
+      thread.alive = true;
+      threads.push_back(std::move(thread));
+    }
+  }
+
+  // Forget the threads that have finished.
+  auto finished = [](const thread_info_t& thread) { return !thread.alive; };
+  threads.erase(std::remove_if(threads.begin(), threads.end(), finished), threads.end());
+
+  for (auto& thread : threads) {
+    // A thread that reuses the identifier of a finished one has another start time. It is tracked as a new thread,
+    // whose usage is reported from the next measure.
+    proc_stat_fields fields;
+    if (thread.stat.read(buffer.data(), buffer.size()) <= 0 || !parse_proc_stat(buffer.data(), fields) ||
+        fields.start_time != thread.start_time) {
+      open_thread(thread);
+      continue;
+    }
 
-      last_cpu_thread[index] = std::move(tmp);
+    // The first field of the scheduler stats is the time spent on CPU in nanoseconds.
+    uint64_t runtime_ns = 0;
+    if (thread.schedstat.read(buffer.data(), buffer.size()) <= 0 ||
+        !parse_schedstat_runtime(buffer.data(), runtime_ns)) {
+      continue;
     }
+
+    sys_thread_metrics_t& m = metrics.thread_metrics[metrics.nof_thread_metrics++];
+    m.tid                   = thread.tid;
+    m.name                  = thread.name;
+    m.cpu_usage = (runtime_ns > thread.runtime_ns) ? (runtime_ns - thread.runtime_ns) * 1e-7f / delta_time_in_seconds
+                                                   : 0.f;
+    thread.runtime_ns = runtime_ns;
+  }
+}
+
+void sys_metrics_processor::open_thread(thread_info_t& thread)
+{
+  char path[32];
+  std::snprintf(path, sizeof(path), "%" PRIu32 "/stat", thread.tid);
+  thread.stat = proc_file(task_dir_fd, path);
+  std::snprintf(path, sizeof(path), "%" PRIu32 "/schedstat", thread.tid);
+  thread.schedstat = proc_file(task_dir_fd, path);
+
+  proc_stat_fields fields;
+  if (thread.stat.read(buffer.data(), buffer.size()) <= 0 || !parse_proc_stat(buffer.data(), fields)) {
+    return;
+  }
+  thread.name       = fields.name;
+  thread.start_time = fields.start_time;
+  thread.runtime_ns = 0;
+  if (thread.schedstat.read(buffer.data(), buffer.size()) > 0) {
+    parse_schedstat_runtime(buffer.data(), thread.runtime_ns);
   }
 }
 
@@ -181,91 +316,31 @@ static void set_mem_to_zero(sys_metrics_t& metrics)
   metrics.system_mem            = 0;
 }
 
-/// Extracts and returns the memory size from the given line.
-static int32_t read_memory_value_from_line(const std::string& line)
-{
-  std::istringstream reader(line);
-  std::string        label, unit;
-  int32_t            value;
-
-  reader >> label >> value >> unit;
-
-  return value;
-}
-
-static void calculate_percentage_memory(sys_metrics_t& metrics)
+void sys_metrics_processor::calculate_mem_usage(sys_metrics_t& metrics)
 {
-  std::ifstream file("/proc/meminfo");
-  std::string   line;
-
-  if (!file) {
+  if (self_status.read(buffer.data(), buffer.size()) <= 0) {
     set_mem_to_zero(metrics);
     return;
   }
 
-  struct meminfo_t {
-    uint32_t total_kB   = 0;
-    uint32_t free_kB    = 0;
-    uint32_t buffers_kB = 0;
-    uint32_t cached_kB  = 0;
-    uint32_t slab_kB    = 0;
-  };
-
-  // Retrieve the data
-  meminfo_t m_info;
-  while (std::getline(file, line)) {
-    // Looks for Virtual memory.
-    if (line.find("MemTotal:") != std::string::npos) {
-      m_info.total_kB = std::max(read_memory_value_from_line(line), 0);
-    }
-    if (line.find("MemFree:") != std::string::npos) {
-      m_info.free_kB = std::max(read_memory_value_from_line(line), 0);
-    }
-    if (line.find("Buffers:") != std::string::npos) {
-      m_info.buffers_kB = std::max(read_memory_value_from_line(line), 0);
-    }
-    if (line.find("Cached:") != std::string::npos) {
-      m_info.cached_kB = std::max(read_memory_value_from_line(line), 0);
-    }
-    if (line.find("Slab:") != std::string::npos) {
-      m_info.slab_kB = std::max(read_memory_value_from_line(line), 0);
-    }
-  }
-
-  // Calculate the metrics.
-  metrics.process_realmem = (metrics.process_realmem_kB <= m_info.total_kB)
-                                ? 100.f * (float(metrics.process_realmem_kB) / m_info.total_kB)
-                                : 0;
-  metrics.system_mem =
-      (1.f - float(m_info.buffers_kB + m_info.cached_kB + m_info.free_kB + m_info.slab_kB) / float(m_info.total_kB)) *
-      100.f;
-}
+  // Virtual and physical memory.
+  metrics.process_virtualmem_kB = parse_memory_value(buffer.data(), "\nVmSize:");
+  metrics.process_realmem_kB    = parse_memory_value(buffer.data(), "\nVmRSS:");
 
-void sys_metrics_processor::calculate_mem_usage(sys_metrics_t& metrics) const
-{
-  std::ifstream file("/proc/self/status");
-  std::string   line;
-
-  if (!file) {
+  // Now calculate the memory usage in percentage.
+  if (meminfo.read(buffer.data(), buffer.size()) <= 0) {
     set_mem_to_zero(metrics);
     return;
   }
 
-  while (std::getline(file, line)) {
-    // Looks for Virtual memory.
-    if (line.find("VmSize:") != std::string::npos) {
-      // NOTE: std::max will clamp negative values to 0.
-      metrics.process_virtualmem_kB = std::max(read_memory_value_from_line(line), 0);
-      continue;
-    }
-    // Looks for physical memory.
-    if (line.find("VmRSS:") != std::string::npos) {
-      // NOTE: std::max will clamp negative values to 0.
-      metrics.process_realmem_kB = std::max(read_memory_value_from_line(line), 0);
-      continue;
-    }
+  meminfo_fields mem;
+  if (!parse_meminfo(buffer.data(), mem)) {
+    set_mem_to_zero(metrics);
+    return;
   }
 
-  // Now calculate the memory usage in percentage.
-  calculate_percentage_memory(metrics);
+  metrics.process_realmem =
+      (metrics.process_realmem_kB <= mem.total_kB) ? 100.f * (float(metrics.process_realmem_kB) / mem.total_kB) : 0;
+  metrics.system_mem =
+      (1.f - float(mem.buffers_kB + mem.cached_kB + mem.free_kB + mem.slab_kB) / float(mem.total_kB)) * 100.f;
 }
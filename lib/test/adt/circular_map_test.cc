@@ -52,10 +52,12 @@ void test_id_map()
   }
 
   // TEST: const iteration
-  count = 0;
-  for (const std::pair<uint32_t, std::string>& obj : myobj) {
+  count                                                      = 0;
+  const static_circular_map<uint32_t, std::string, 16>& cobj = myobj;
+  for (const std::pair<uint32_t, std::string>& obj : cobj) {
     TESTASSERT(obj.second == "obj" + std::to_string(count++));
   }
+  TESTASSERT(cobj.find(1)->second == "obj1");
 
   TESTASSERT(myobj.erase(0));
   TESTASSERT(myobj.erase(1));
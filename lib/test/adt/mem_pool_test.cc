@@ -19,10 +19,13 @@
  *
  */
 
+#include "srsran/adt/pool/batch_mem_pool.h"
+#include "srsran/adt/pool/circular_stack_pool.h"
 #include "srsran/adt/pool/fixed_size_pool.h"
 #include "srsran/adt/pool/mem_pool.h"
 #include "srsran/adt/pool/obj_pool.h"
 #include "srsran/common/test_common.h"
+#include <chrono>
 
 class C
 {
@@ -181,6 +184,102 @@ void test_background_pool()
   TESTASSERT(C::dtor_counter == C::default_ctor_counter);
 }
 
+/// Each thread allocates and deallocates a burst of nodes, checking that no node is handed out twice
+void test_background_mem_pool_concurrent()
+{
+  const size_t nof_threads = 4, nof_rounds = 2000, burst_size = 16;
+  for (size_t i = 0; i < 2; ++i) {
+    srsran::background_mem_pool pool(4, sizeof(size_t) * 4, 8);
+    std::vector<std::thread>    workers;
+    for (size_t t = 0; t < nof_threads; ++t) {
+      workers.emplace_back([&pool, t]() {
+        std::array<size_t*, burst_size> nodes;
+        for (size_t r = 0; r < nof_rounds; ++r) {
+          for (size_t n = 0; n < burst_size; ++n) {
+            nodes[n]    = static_cast<size_t*>(pool.allocate_node(sizeof(size_t) * 4));
+            nodes[n][3] = t * burst_size + n;
+          }
+          for (size_t n = 0; n < burst_size; ++n) {
+            TESTASSERT(nodes[n][3] == t * burst_size + n);
+            pool.deallocate_node(nodes[n]);
+          }
+        }
+      });
+    }
+    // one thread allocates, and the other deallocates
+    srsran::dyn_blocking_queue<void*> queue(64);
+    std::thread                       producer([&pool, &queue]() {
+      for (size_t r = 0; r < nof_rounds * burst_size; ++r) {
+        queue.push_blocking(pool.allocate_node(sizeof(size_t)));
+      }
+    });
+    for (size_t r = 0; r < nof_rounds * burst_size; ++r) {
+      pool.deallocate_node(queue.pop_blocking());
+    }
+    producer.join();
+    for (std::thread& w : workers) {
+      w.join();
+    }
+    // the caches of the finished threads were given back to the pool
+    TESTASSERT(pool.cache_size() >= nof_threads * burst_size);
+  }
+}
+
+void test_circular_stack_pool_concurrent()
+{
+  const size_t                    nof_threads = 4, nof_rounds = 2000;
+  srsran::circular_stack_pool<16> pool(4, 256, 4);
+  std::vector<std::thread>        workers;
+  for (size_t t = 0; t < nof_threads; ++t) {
+    workers.emplace_back([&pool, t]() {
+      for (size_t r = 0; r < nof_rounds; ++r) {
+        size_t  key = t * 4 + r % 4;
+        size_t* a   = static_cast<size_t*>(pool.allocate(key, sizeof(size_t), alignof(size_t)));
+        size_t* b   = static_cast<size_t*>(pool.allocate(key, sizeof(size_t), alignof(size_t)));
+        TESTASSERT(a != nullptr and b != nullptr and a != b);
+        *a = key;
+        *b = r;
+        TESTASSERT(*a == key and *b == r);
+        pool.deallocate(key, b);
+        pool.deallocate(key, a);
+      }
+    });
+  }
+  for (std::thread& w : workers) {
+    w.join();
+  }
+}
+
+void benchmark_background_mem_pool()
+{
+  const size_t nof_ops = 200000, burst_size = 8;
+  for (size_t nof_threads : {1, 2, 4}) {
+    srsran::background_mem_pool pool(16, 512, 32);
+    std::vector<std::thread>    workers;
+    auto                        tp = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < nof_threads; ++t) {
+      workers.emplace_back([&pool]() {
+        std::array<void*, burst_size> nodes;
+        for (size_t r = 0; r < nof_ops / burst_size; ++r) {
+          for (void*& n : nodes) {
+            n = pool.allocate_node(512);
+          }
+          for (void* n : nodes) {
+            pool.deallocate_node(n);
+          }
+        }
+      });
+    }
+    for (std::thread& w : workers) {
+      w.join();
+    }
+    auto tdiff = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+    printf("background_mem_pool: %zd threads, %.1f nsec per allocation+deallocation\n",
+           nof_threads,
+           tdiff.count() / (double)nof_ops);
+  }
+}
+
 int main(int argc, char** argv)
 {
   srsran::test_init(argc, argv);
@@ -188,6 +287,9 @@ int main(int argc, char** argv)
   test_nontrivial_obj_pool();
   test_fixedsize_pool();
   test_background_pool();
+  test_background_mem_pool_concurrent();
+  test_circular_stack_pool_concurrent();
+  benchmark_background_mem_pool();
 
   printf("Success\n");
   return 0;
@@ -0,0 +1,161 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/bearer_manager.h"
+#include "srsran/support/srsran_test.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using srsran::srsran_rat_t;
+
+void test_enb_bearer_manager()
+{
+  srsenb::enb_bearer_manager bearers;
+
+  bearers.add_eps_bearer(0x46, 5, srsran_rat_t::lte, 3);
+  bearers.add_eps_bearer(0x46, 6, srsran_rat_t::lte, 4);
+  bearers.add_eps_bearer(0xfff0, 1, srsran_rat_t::nr, 4);
+  TESTASSERT(bearers.set_five_qi(0xfff0, 1, 9));
+
+  srsenb::enb_bearer_manager::radio_bearer_t rb = bearers.get_radio_bearer(0x46, 6);
+  TESTASSERT(rb.is_valid() and rb.rat == srsran_rat_t::lte and rb.lcid == 4 and rb.eps_bearer_id == 6);
+  rb = bearers.get_lcid_bearer(0xfff0, 4);
+  TESTASSERT(rb.is_valid() and rb.rat == srsran_rat_t::nr and rb.eps_bearer_id == 1 and rb.five_qi == 9);
+  TESTASSERT(bearers.has_active_radio_bearer(0x46, 5));
+  TESTASSERT(not bearers.has_active_radio_bearer(0x46, 7));
+  TESTASSERT(not bearers.has_active_radio_bearer(0x47, 5));
+
+  // Duplicated and out of range IDs are rejected
+  bearers.add_eps_bearer(0x46, 5, srsran_rat_t::nr, 7);
+  TESTASSERT(bearers.get_radio_bearer(0x46, 5).rat == srsran_rat_t::lte);
+  TESTASSERT(not bearers.get_lcid_bearer(0x46, 7).is_valid());
+  bearers.add_eps_bearer(0x46, 200, srsran_rat_t::lte, 5);
+  bearers.add_eps_bearer(0x46, 7, srsran_rat_t::lte, srsran::INVALID_LCID);
+  TESTASSERT(not bearers.has_active_radio_bearer(0x46, 7));
+  TESTASSERT(not bearers.get_radio_bearer(0x46, srsran::INVALID_EPS_BEARER_ID).is_valid());
+  TESTASSERT(not bearers.get_lcid_bearer(0x46, srsran::INVALID_LCID).is_valid());
+
+  bearers.remove_eps_bearer(0x46, 5);
+  TESTASSERT(not bearers.has_active_radio_bearer(0x46, 5));
+  TESTASSERT(not bearers.get_lcid_bearer(0x46, 3).is_valid());
+  TESTASSERT(bearers.get_lcid_bearer(0x46, 4).eps_bearer_id == 6);
+
+  // The bearer table of a removed user is cleared before it is reused
+  bearers.rem_user(0x46);
+  TESTASSERT(not bearers.get_lcid_bearer(0x46, 4).is_valid());
+  bearers.add_eps_bearer(0x47, 5, srsran_rat_t::lte, 3);
+  TESTASSERT(not bearers.has_active_radio_bearer(0x47, 6));
+  TESTASSERT(bearers.get_lcid_bearer(0x47, 3).eps_bearer_id == 5);
+  TESTASSERT(bearers.get_radio_bearer(0xfff0, 1).five_qi == 9);
+}
+
+void test_enb_bearer_manager_concurrent_readers()
+{
+  const uint32_t nof_readers = 3;
+  const uint16_t nof_users   = 512;
+
+  srsenb::enb_bearer_manager bearers;
+  std::atomic<bool>          running{true};
+  std::atomic<uint32_t>      nof_errors{0};
+
+  // The EPS bearer IDs of a user depend on the parity of its RNTI. Removed tables are reused by users of the other
+  // parity, so a lookup that returned the bearers of another user would be noticed
+  auto eps_bearer_id_of = [](uint16_t rnti, uint32_t lcid) { return lcid + 2 + 2 * (rnti % 2); };
+
+  // Bearers of a user are either all present or all absent, with a consistent LCID to EPS bearer ID mapping
+  std::vector<std::thread> readers;
+  for (uint32_t t = 0; t < nof_readers; t++) {
+    readers.emplace_back([&]() {
+      while (running) {
+        for (uint16_t rnti = 0x46; rnti < 0x46 + nof_users; ++rnti) {
+          for (uint32_t lcid = 3; lcid <= 4; ++lcid) {
+            srsenb::enb_bearer_manager::radio_bearer_t rb = bearers.get_lcid_bearer(rnti, lcid);
+            if (rb.is_valid() and (rb.lcid != lcid or rb.eps_bearer_id != eps_bearer_id_of(rnti, lcid))) {
+              nof_errors++;
+            }
+            rb = bearers.get_radio_bearer(rnti, eps_bearer_id_of(rnti ^ 1U, lcid));
+            if (rb.is_valid()) {
+              nof_errors++;
+            }
+          }
+        }
+      }
+    });
+  }
+
+  for (uint32_t round = 0; round < 20; ++round) {
+    for (uint16_t rnti = 0x46; rnti < 0x46 + nof_users; ++rnti) {
+      bearers.add_eps_bearer(rnti, eps_bearer_id_of(rnti, 3), srsran_rat_t::lte, 3);
+      bearers.add_eps_bearer(rnti, eps_bearer_id_of(rnti, 4), srsran_rat_t::lte, 4);
+    }
+    for (uint16_t rnti = 0x46; rnti < 0x46 + nof_users; ++rnti) {
+      bearers.rem_user(rnti);
+    }
+  }
+  running = false;
+  for (auto& t : readers) {
+    t.join();
+  }
+  TESTASSERT(nof_errors == 0);
+}
+
+/// Measures the LCID and EPS bearer lookups done per packet by the GTPU/PDCP adapter
+void benchmark_enb_bearer_manager()
+{
+  const uint32_t nof_users   = 1000;
+  const uint32_t nof_lookups = 4000000;
+
+  srsenb::enb_bearer_manager bearers;
+  std::vector<uint16_t>      rntis(nof_users);
+  for (uint32_t i = 0; i < nof_users; ++i) {
+    rntis[i] = 0x46 + i * 37;
+    for (uint32_t eps_bearer_id = 5; eps_bearer_id <= 8; ++eps_bearer_id) {
+      bearers.add_eps_bearer(rntis[i], eps_bearer_id, srsran_rat_t::lte, eps_bearer_id - 2);
+    }
+  }
+
+  uint32_t found = 0;
+  auto     tic   = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_lookups; ++i) {
+    uint16_t rnti = rntis[i % nof_users];
+    found += bearers.get_lcid_bearer(rnti, 3 + i % 4).is_valid();
+    found += bearers.get_radio_bearer(rnti, 5 + i % 4).is_valid();
+  }
+  auto toc = std::chrono::steady_clock::now();
+  TESTASSERT(found == 2 * nof_lookups);
+
+  printf("Bearer lookups for %d users: %.1f ns/lookup\n",
+         nof_users,
+         std::chrono::duration_cast<std::chrono::nanoseconds>(toc - tic).count() / (2.0 * nof_lookups));
+}
+
+int main()
+{
+  srslog::fetch_basic_logger("STCK", false).set_level(srslog::basic_levels::none);
+  srslog::init();
+  test_enb_bearer_manager();
+  test_enb_bearer_manager_concurrent_readers();
+  benchmark_enb_bearer_manager();
+  srslog::flush();
+  printf("Success\n");
+  return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/system/sys_metrics_parsers.h"
+#include <cstring>
+
+using namespace srsran;
+
+int test_task_stat()
+{
+  // The thread name contains spaces and parenthesis.
+  const char* task_stat =
+      "1234 (PHY (worker) 1) S 1200 1200 1000 34816 1200 4194368 330 0 0 0 1520 310 0 0 -2 0 42 0 98765 1234567 2345 "
+      "18446744073709551615 1 1 0 0 0 0 0 4096 0 0 0 0 -1 3 99 1 0 0 0 0 0 0 0 0 0\n";
+
+  proc_stat_fields fields;
+  TESTASSERT(parse_proc_stat(task_stat, fields));
+  TESTASSERT(std::strcmp(fields.name.data(), "PHY (worker) 1") == 0);
+  TESTASSERT(fields.utime == 1520);
+  TESTASSERT(fields.stime == 310);
+  TESTASSERT(fields.num_threads == 42);
+  TESTASSERT(fields.start_time == 98765);
+
+  // Names longer than the kernel limit are truncated.
+  const char* long_name = "77 (a very long thread name) R 1 1 1 0 -1 0 0 0 0 0 7 8 0 0 20 0 1 0 555 0 0\n";
+  TESTASSERT(parse_proc_stat(long_name, fields));
+  TESTASSERT(std::strcmp(fields.name.data(), "a very long thr") == 0);
+  TESTASSERT(fields.utime == 7 and fields.stime == 8 and fields.num_threads == 1 and fields.start_time == 555);
+
+  // Truncated and malformed contents are rejected.
+  TESTASSERT(not parse_proc_stat("1234 (srsenb) S 1200 1200 1000 34816 1200 4194368 330 0 0 0 1520\n", fields));
+  TESTASSERT(not parse_proc_stat("1234 srsenb S 1200\n", fields));
+  TESTASSERT(not parse_proc_stat("", fields));
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_meminfo()
+{
+  const char* meminfo = "MemTotal:       16283952 kB\n"
+                        "MemFree:         1702284 kB\n"
+                        "MemAvailable:    9581044 kB\n"
+                        "Buffers:          612904 kB\n"
+                        "Cached:          7012340 kB\n"
+                        "SwapCached:         1024 kB\n"
+                        "Active:          8409252 kB\n"
+                        "Inactive:        4851752 kB\n"
+                        "Slab:             734160 kB\n"
+                        "SReclaimable:     552276 kB\n";
+
+  meminfo_fields fields;
+  TESTASSERT(parse_meminfo(meminfo, fields));
+  TESTASSERT(fields.total_kB == 16283952);
+  TESTASSERT(fields.free_kB == 1702284);
+  TESTASSERT(fields.buffers_kB == 612904);
+  TESTASSERT(fields.cached_kB == 7012340);
+  TESTASSERT(fields.slab_kB == 734160);
+
+  TESTASSERT(not parse_meminfo("MemFree:         1702284 kB\n", fields));
+
+  const char* status = "Name:\tsrsenb\n"
+                       "VmPeak:\t 2345680 kB\n"
+                       "VmSize:\t 2345600 kB\n"
+                       "VmRSS:\t  412340 kB\n"
+                       "Threads:\t42\n";
+  TESTASSERT(parse_memory_value(status, "\nVmSize:") == 2345600);
+  TESTASSERT(parse_memory_value(status, "\nVmRSS:") == 412340);
+  TESTASSERT(parse_memory_value(status, "\nVmSwap:") == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_cpu_idle_times()
+{
+  const char* stat = "cpu  1190546 3522 262718 29853380 44207 0 17032 0 0 0\n"
+                     "cpu0 148212 431 33120 3729452 5602 0 8417 0 0 0\n"
+                     "cpu1 149887 449 32612 3731086 5464 0 2151 0 0 0\n"
+                     "cpu2 148617 442 32984 3732510 5526 0 1311 0 0 0\n"
+                     "intr 73626592 0 9 0 0 0 0 0 0 0 0\n"
+                     "ctxt 150212043\n";
+
+  uint64_t idle[4] = {};
+  TESTASSERT(parse_cpu_idle_times(stat, idle, 4) == 3);
+  TESTASSERT(idle[0] == 3729452);
+  TESTASSERT(idle[1] == 3731086);
+  TESTASSERT(idle[2] == 3732510);
+
+  // The number of CPUs is limited to the given one.
+  TESTASSERT(parse_cpu_idle_times(stat, idle, 2) == 2);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_schedstat()
+{
+  uint64_t runtime_ns = 0;
+  TESTASSERT(parse_schedstat_runtime("12345678901 2345678 9012\n", runtime_ns));
+  TESTASSERT(runtime_ns == 12345678901);
+  TESTASSERT(not parse_schedstat_runtime("\n", runtime_ns));
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_task_stat() == SRSRAN_SUCCESS);
+  TESTASSERT(test_meminfo() == SRSRAN_SUCCESS);
+  TESTASSERT(test_cpu_idle_times() == SRSRAN_SUCCESS);
+  TESTASSERT(test_schedstat() == SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
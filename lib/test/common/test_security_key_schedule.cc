@@ -0,0 +1,123 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security_key_schedule.h"
+#include "srsran/common/test_common.h"
+#include <random>
+#include <string.h>
+
+using namespace srsran;
+
+/*
+ * Document Reference: 33.401 V13.1.0 Annex C.2, 128-EIA2 test set 2
+ */
+int test_eia2_test_set_2()
+{
+  uint8_t  key[]     = {0xd3, 0xc5, 0xd5, 0x92, 0x32, 0x7f, 0xb1, 0x1c, 0x40, 0x35, 0xc6, 0x68, 0x0a, 0xf8, 0xc6, 0xd1};
+  uint32_t count     = 0x398a59b4;
+  uint8_t  bearer    = 0x1a;
+  uint8_t  direction = 1;
+  uint8_t  msg[]     = {0x48, 0x45, 0x83, 0xd5, 0xaf, 0xe0, 0x82, 0xae};
+  uint8_t  mac[4]    = {};
+  uint8_t  exp_mac[] = {0xb9, 0x37, 0x87, 0xe6};
+
+  security_key_schedule sched;
+  TESTASSERT(sched.integrity_generate(
+                 INTEGRITY_ALGORITHM_ID_128_EIA2, key, count, bearer, direction, msg, sizeof(msg), mac) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(memcmp(mac, exp_mac, sizeof(mac)) == 0);
+
+  // Second message with the same key reuses the cached schedule
+  memset(mac, 0, sizeof(mac));
+  TESTASSERT(sched.integrity_generate(
+                 INTEGRITY_ALGORITHM_ID_128_EIA2, key, count, bearer, direction, msg, sizeof(msg), mac) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(memcmp(mac, exp_mac, sizeof(mac)) == 0);
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The cached schedules must give the same result as the regular implementation for all algorithms, message sizes and
+ * when the key changes between messages.
+ */
+int test_against_reference()
+{
+  std::mt19937                    rgen(1234);
+  std::uniform_int_distribution<> byte_dist(0, 255);
+  security_key_schedule           sched;
+
+  uint8_t int_key[16], enc_key[16];
+  uint8_t msg[256], ref_out[256], out[256];
+
+  for (uint32_t i = 0; i < 400; i++) {
+    // change keys every few messages
+    if (i % 7 == 0) {
+      for (uint32_t j = 0; j < 16; j++) {
+        int_key[j] = byte_dist(rgen);
+        enc_key[j] = byte_dist(rgen);
+      }
+    }
+    uint32_t count     = rgen();
+    uint8_t  bearer    = rgen() % 32;
+    uint8_t  direction = rgen() % 2;
+    uint32_t len       = 1 + rgen() % (sizeof(msg) - 1);
+    for (uint32_t j = 0; j < len; j++) {
+      msg[j] = byte_dist(rgen);
+    }
+
+    // Integrity
+    uint8_t ref_mac[4], mac[4];
+    security_128_eia1(int_key, count, bearer, direction, msg, len, ref_mac);
+    sched.integrity_generate(INTEGRITY_ALGORITHM_ID_128_EIA1, int_key, count, bearer, direction, msg, len, mac);
+    TESTASSERT(memcmp(ref_mac, mac, sizeof(mac)) == 0);
+    security_128_eia2(int_key, count, bearer, direction, msg, len, ref_mac);
+    sched.integrity_generate(INTEGRITY_ALGORITHM_ID_128_EIA2, int_key, count, bearer, direction, msg, len, mac);
+    TESTASSERT(memcmp(ref_mac, mac, sizeof(mac)) == 0);
+    security_128_eia3(int_key, count, bearer, direction, msg, len, ref_mac);
+    sched.integrity_generate(INTEGRITY_ALGORITHM_ID_128_EIA3, int_key, count, bearer, direction, msg, len, mac);
+    TESTASSERT(memcmp(ref_mac, mac, sizeof(mac)) == 0);
+
+    // Ciphering, both out of place and in place
+    security_128_eea1(enc_key, count, bearer, direction, msg, len, ref_out);
+    sched.cipher(CIPHERING_ALGORITHM_ID_128_EEA1, enc_key, count, bearer, direction, msg, len, out);
+    TESTASSERT(memcmp(ref_out, out, len) == 0);
+    sched.cipher(CIPHERING_ALGORITHM_ID_128_EEA1, enc_key, count, bearer, direction, out, len, out);
+    TESTASSERT(memcmp(msg, out, len) == 0);
+    security_128_eea2(enc_key, count, bearer, direction, msg, len, ref_out);
+    sched.cipher(CIPHERING_ALGORITHM_ID_128_EEA2, enc_key, count, bearer, direction, msg, len, out);
+    TESTASSERT(memcmp(ref_out, out, len) == 0);
+    sched.cipher(CIPHERING_ALGORITHM_ID_128_EEA2, enc_key, count, bearer, direction, out, len, out);
+    TESTASSERT(memcmp(msg, out, len) == 0);
+    security_128_eea3(enc_key, count, bearer, direction, msg, len, ref_out);
+    sched.cipher(CIPHERING_ALGORITHM_ID_128_EEA3, enc_key, count, bearer, direction, msg, len, out);
+    TESTASSERT(memcmp(ref_out, out, len) == 0);
+    sched.cipher(CIPHERING_ALGORITHM_ID_128_EEA3, enc_key, count, bearer, direction, out, len, out);
+    TESTASSERT(memcmp(msg, out, len) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  TESTASSERT(test_eia2_test_set_2() == SRSRAN_SUCCESS);
+  TESTASSERT(test_against_reference() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
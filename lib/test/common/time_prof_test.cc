@@ -0,0 +1,139 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/time_prof.h"
+#include "srsran/support/srsran_test.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using srsran::tprof_histogram;
+
+void test_histogram_buckets()
+{
+  // Every value falls in a bucket whose range contains it
+  for (uint64_t v : {0UL, 1UL, 7UL, 8UL, 15UL, 16UL, 17UL, 1000UL, 123456789UL, UINT64_MAX}) {
+    uint32_t idx = tprof_histogram::bucket_idx(v);
+    TESTASSERT(idx < tprof_histogram::nof_buckets);
+    TESTASSERT(tprof_histogram::bucket_lower(idx) <= v);
+    TESTASSERT(v - tprof_histogram::bucket_lower(idx) < tprof_histogram::bucket_width(idx));
+  }
+
+  // Buckets are contiguous and the relative error is bounded
+  for (uint32_t idx = 1; idx < tprof_histogram::nof_buckets; idx++) {
+    uint64_t lower = tprof_histogram::bucket_lower(idx);
+    TESTASSERT(lower == tprof_histogram::bucket_lower(idx - 1) + tprof_histogram::bucket_width(idx - 1));
+    TESTASSERT(tprof_histogram::bucket_width(idx) * tprof_histogram::nof_sub <= std::max<uint64_t>(lower, 8));
+  }
+}
+
+void test_hist_tprof_threads()
+{
+  const uint32_t nof_threads = 4;
+  const uint32_t nof_samples = 10000;
+
+  srsran::hist_tprof<true> prof("test_tprof");
+
+  // Each thread records the same uniform distribution of ticks
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < nof_threads; t++) {
+    threads.emplace_back([&prof]() {
+      for (uint32_t i = 1; i <= nof_samples; i++) {
+        prof.add(i);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // A measure started in one thread can be stopped in another
+  auto meas = prof.start();
+  std::thread([meas]() mutable { meas.stop(); }).join();
+
+  srsran::tprof_metrics_t metrics = prof.get_metrics();
+  TESTASSERT(metrics.name == "test_tprof");
+  TESTASSERT(metrics.count == nof_threads * nof_samples + 1);
+
+  // Percentiles are within the histogram resolution
+  double us_per_tick = srsran::tprof_clock::ns_per_tick() / 1000.0;
+  double tolerance   = 1.0 / tprof_histogram::nof_sub;
+  TESTASSERT(std::abs(metrics.p50_us / us_per_tick - 0.50 * nof_samples) < tolerance * 0.50 * nof_samples);
+  TESTASSERT(std::abs(metrics.p90_us / us_per_tick - 0.90 * nof_samples) < tolerance * 0.90 * nof_samples);
+  TESTASSERT(metrics.p50_us <= metrics.p90_us and metrics.p90_us <= metrics.p99_us);
+  TESTASSERT(metrics.p99_us <= metrics.max_us);
+
+  // The profiler is reported while it is alive
+  std::vector<srsran::tprof_metrics_t> all = srsran::get_tprof_metrics();
+  TESTASSERT(std::count_if(all.begin(), all.end(), [](const srsran::tprof_metrics_t& m) {
+               return m.name == "test_tprof";
+             }) == 1);
+}
+
+void test_hist_tprof_slot_recycling()
+{
+  // Profilers created after many others were destroyed reuse their slots without seeing their histograms
+  for (uint32_t i = 0; i < 1000; i++) {
+    srsran::hist_tprof<true> prof("recycled_tprof");
+    for (uint32_t n = 0; n <= i % 3; n++) {
+      prof.add(100);
+    }
+    std::thread([&prof]() { prof.add(100); }).join();
+    TESTASSERT(prof.get_metrics().count == i % 3 + 2);
+  }
+
+  // Profilers beyond the number of slots share a histogram
+  std::vector<std::unique_ptr<srsran::hist_tprof<true> > > profs;
+  for (uint32_t i = 0; i < 100; i++) {
+    profs.emplace_back(new srsran::hist_tprof<true>("many_tprof"));
+  }
+  for (uint32_t i = 0; i < profs.size(); i++) {
+    for (uint32_t n = 0; n <= i; n++) {
+      profs[i]->add(n + 1);
+    }
+  }
+  for (uint32_t i = 0; i < profs.size(); i++) {
+    TESTASSERT(profs[i]->get_metrics().count == i + 1);
+  }
+}
+
+void test_hist_tprof_disabled()
+{
+  // Disabled profilers are not registered
+  srsran::hist_tprof<false> prof("disabled_tprof");
+  auto                      meas = prof.start();
+  TESTASSERT(meas.stop().count() == 0);
+  TESTASSERT(prof.get_metrics().count == 0);
+  TESTASSERT(srsran::get_tprof_metrics().empty());
+}
+
+int main()
+{
+  srslog::init();
+  test_histogram_buckets();
+  test_hist_tprof_threads();
+  test_hist_tprof_slot_recycling();
+  test_hist_tprof_disabled();
+  TESTASSERT(srsran::get_tprof_metrics().empty());
+  return 0;
+}
@@ -279,6 +279,31 @@ static bool when_logging_with_context_and_message_then_filled_in_log_entry_is_pu
   return true;
 }
 
+static bool when_logging_formatted_entry_then_it_is_written_as_is()
+{
+  backend_spy              backend;
+  test_dummies::sink_dummy s;
+
+  log_channel log("id", s, backend);
+
+  std::string str = "{\n  \"type\": \"metrics\"\n}\n";
+  log.write_formatted(str);
+
+  ASSERT_EQ(backend.push_invocation_count(), 1);
+
+  const detail::log_entry& entry = backend.last_entry();
+  ASSERT_EQ(&s, entry.s);
+  ASSERT_NE(entry.format_func, nullptr);
+  ASSERT_EQ(entry.metadata.fmtstring, nullptr);
+
+  fmt::memory_buffer         buffer;
+  detail::log_entry_metadata metadata = entry.metadata;
+  entry.format_func(std::move(metadata), buffer);
+  ASSERT_EQ(fmt::to_string(buffer), str);
+
+  return true;
+}
+
 int main()
 {
   TEST_FUNCTION(when_log_channel_is_created_then_id_matches_expected_value);
@@ -291,6 +316,7 @@ int main()
   TEST_FUNCTION(when_hex_array_length_is_less_than_hex_log_max_size_then_array_length_is_used);
   TEST_FUNCTION(when_logging_with_context_then_filled_in_log_entry_is_pushed_into_the_backend);
   TEST_FUNCTION(when_logging_with_context_and_message_then_filled_in_log_entry_is_pushed_into_the_backend);
+  TEST_FUNCTION(when_logging_formatted_entry_then_it_is_written_as_is);
 
   return 0;
 }
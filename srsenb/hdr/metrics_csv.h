@@ -48,7 +48,7 @@ public:
   void stop();
 
 private:
-  std::string float_to_string(float f, int digits, bool add_semicolon = true);
+  void write_float(float f, int digits, bool add_semicolon = true);
 
   float                  metrics_report_period;
   std::ofstream          file;
@@ -28,7 +28,9 @@
 #define SRSENB_METRICS_JSON_H
 
 #include "srsran/interfaces/enb_metrics_interface.h"
+#include "srsran/srslog/bundled/fmt/format.h"
 #include "srsran/srslog/log_channel.h"
+#include <vector>
 
 namespace srsenb {
 
@@ -41,8 +43,17 @@ public:
   void stop() override {}
 
 private:
+  /// Fills cell_ues with the indexes of the UEs with valid metrics, sorted by cell.
+  void group_ues_by_cell(const enb_metrics_t& m);
+
   srslog::log_channel&   log_c;
   enb_metrics_interface* enb;
+
+  // Buffers reused across reports.
+  fmt::memory_buffer    buffer;
+  std::vector<unsigned> cell_ues;
+  /// UEs of cell cc_idx are in cell_ues[cell_ue_offsets[cc_idx], cell_ue_offsets[cc_idx + 1]).
+  std::vector<unsigned> cell_ue_offsets;
 };
 
 } // namespace srsenb
@@ -0,0 +1,36 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_MAC_TPROF_H
+#define SRSENB_MAC_TPROF_H
+
+#include "srsran/common/time_prof.h"
+
+namespace srsenb {
+
+/// Latency profilers of the MAC procedures reported in the eNB metrics. Unlike the other profilers, they are enabled
+/// in every build, so that their histograms are available in production.
+extern srsran::hist_tprof<true> mac_rach_tprof;
+extern srsran::hist_tprof<true> mac_nr_rach_tprof;
+
+} // namespace srsenb
+
+#endif // SRSENB_MAC_TPROF_H
@@ -186,9 +186,9 @@ private:
   std::unique_ptr<enb_cell_common_list> cell_common_list;
 
   // state
-  std::unique_ptr<freq_res_common_list>    cell_res_list;
-  std::map<uint16_t, unique_rnti_ptr<ue> > users; // NOTE: has to have fixed addr
-  std::unique_ptr<paging_manager>          pending_paging;
+  std::unique_ptr<freq_res_common_list> cell_res_list;
+  rnti_map_t<unique_rnti_ptr<ue> >      users; // NOTE: has to have fixed addr
+  std::unique_ptr<paging_manager>       pending_paging;
 
   void     process_release_complete(uint16_t rnti);
   void     rem_user(uint16_t rnti);
@@ -22,7 +22,9 @@
 #ifndef SRSRAN_RRC_BEARER_CFG_H
 #define SRSRAN_RRC_BEARER_CFG_H
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/stack/rrc/rrc_config.h"
+#include "srsran/adt/circular_map.h"
 #include "srsran/asn1/s1ap.h"
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/interfaces/enb_interfaces.h"
@@ -96,6 +98,9 @@ public:
     uint32_t                                    teid_in  = 0;
     std::vector<gtpu_tunnel>                    tunnels;
   };
+  /// E-RABs are stored in a fixed-size table directly indexed by E-RAB ID
+  template <typename T>
+  using erab_map_t = srsran::static_circular_map<uint8_t, T, MAX_NOF_ERABS>;
 
   bearer_cfg_handler(uint16_t rnti_, const rrc_cfg_t& cfg_, gtpu_interface_rrc* gtpu_);
 
@@ -125,11 +130,11 @@ public:
   void                       fill_pending_nas_info(asn1::rrc::rrc_conn_recfg_r8_ies_s* msg);
   void                       clear_pending_nas_info();
 
-  const std::map<uint8_t, erab_t>&        get_erabs() const { return erabs; }
+  const erab_map_t<erab_t>&               get_erabs() const { return erabs; }
   const asn1::rrc::drb_to_add_mod_list_l& get_established_drbs() const { return current_drbs; }
 
-  std::map<uint8_t, std::vector<uint8_t> > erab_info_list;
-  std::map<uint8_t, erab_t>                erabs;
+  erab_map_t<std::vector<uint8_t> > erab_info_list;
+  erab_map_t<erab_t>                erabs;
 
 private:
   srslog::basic_logger* logger;
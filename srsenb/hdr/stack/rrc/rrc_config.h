@@ -39,6 +39,9 @@ struct rrc_cfg_sr_t {
   uint32_t                                                   nof_subframes;
 };
 
+/// QCI values range [0, 255] in TS 36.413
+const uint32_t MAX_NOF_QCI = 256;
+
 struct rrc_cfg_qci_t {
   bool                                          configured            = false;
   int                                           enb_dl_max_retx_thres = -1;
@@ -76,7 +79,7 @@ struct rrc_cfg_t {
   asn1::rrc::pdsch_cfg_ded_s::p_a_e_                                                      pdsch_cfg;
   rrc_cfg_sr_t                                                                            sr_cfg;
   rrc_cfg_cqi_t                                                                           cqi_cfg;
-  std::map<uint32_t, rrc_cfg_qci_t>                                                       qci_cfg;
+  std::array<rrc_cfg_qci_t, MAX_NOF_QCI>                                                  qci_cfg;
   bool                                                                                    enable_mbsfn;
   uint16_t                                                                                mbms_mcs;
   uint32_t                                                                                inactivity_timeout_ms;
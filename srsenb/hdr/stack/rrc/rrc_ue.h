@@ -126,7 +126,7 @@ public:
   void set_bitrates(const asn1::s1ap::ue_aggregate_maximum_bitrate_s& rates);
 
   /// Helper to check UE ERABs
-  bool has_erab(uint32_t erab_id) const { return bearer_list.get_erabs().count(erab_id) > 0; }
+  bool has_erab(uint32_t erab_id) const { return bearer_list.get_erabs().contains(erab_id); }
   int  get_erab_addr_in(uint16_t erab_id, transp_addr_t& addr_in, uint32_t& teid_in) const;
 
   bool release_erabs();
@@ -60,6 +60,9 @@ class s1ap : public s1ap_interface_rrc
 {
   using s1ap_proc_id_t = asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts::options;
 
+  // Gives the unit tests access to the user list
+  friend class s1ap_test_access;
+
 public:
   using erab_id_list   = srsran::bounded_vector<uint16_t, ASN1_S1AP_MAXNOOF_ERABS>;
   using erab_item_list = srsran::bounded_vector<asn1::s1ap::erab_item_s, ASN1_S1AP_MAXNOOF_ERABS>;
@@ -320,6 +323,8 @@ private:
     ue*            find_ue_mmeid(uint32_t mmeid);
     ue*            add_user(value_type user);
     void           erase(ue* ue_ptr);
+    bool           set_rnti(ue* ue_ptr, uint16_t rnti);
+    bool           set_mmeid(ue* ue_ptr, uint32_t mmeid);
     iterator       begin() { return users.begin(); }
     iterator       end() { return users.end(); }
     const_iterator cbegin() const { return users.begin(); }
@@ -328,6 +333,9 @@ private:
 
   private:
     std::unordered_map<uint32_t, std::unique_ptr<ue> > users; // maps ENB_S1AP_ID to user
+    // Secondary indices. Users must only change their RNTI and MME_UE_S1AP_ID via set_rnti() and set_mmeid()
+    std::unordered_map<uint16_t, ue*> rnti_index;  // maps RNTI to user
+    std::unordered_map<uint32_t, ue*> mmeid_index; // maps MME_UE_S1AP_ID to user
   };
   user_list users;
 
@@ -239,6 +239,7 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   m->running = true;
   m->sys     = sys_proc.get_metrics();
+  m->tprof   = srsran::get_tprof_metrics();
   return true;
 }
 
@@ -771,6 +771,10 @@ int field_qci::parse(libconfig::Setting& root)
     libconfig::Setting& q = root[i];
 
     uint32_t qci = q["qci"];
+    if (qci >= MAX_NOF_QCI) {
+      fprintf(stderr, "Invalid qci=%d. Valid range is [0, %d]\n", qci, MAX_NOF_QCI - 1);
+      return SRSRAN_ERROR;
+    }
 
     // Parse PDCP section
     if (!q.exists("pdcp_config")) {
@@ -926,7 +930,9 @@ int field_qci::parse(libconfig::Setting& root)
       qcicfg.enb_dl_max_retx_thres = (int)q["enb_specific"]["dl_max_retx_thresh"];
     }
 
-    cfg.insert(std::make_pair(qci, qcicfg));
+    if (not cfg[qci].configured) {
+      cfg[qci] = qcicfg;
+    }
   }
 
   return 0;
@@ -261,13 +261,13 @@ private:
 class field_qci final : public parser::field_itf
 {
 public:
-  explicit field_qci(std::map<uint32_t, rrc_cfg_qci_t>& cfg_) : cfg(cfg_) {}
+  explicit field_qci(std::array<rrc_cfg_qci_t, MAX_NOF_QCI>& cfg_) : cfg(cfg_) {}
   const char* get_name() override { return "field_qci"; }
 
   int parse(Setting& root) override;
 
 private:
-  std::map<uint32_t, rrc_cfg_qci_t>& cfg;
+  std::array<rrc_cfg_qci_t, MAX_NOF_QCI>& cfg;
 };
 
 class field_5g_srb final : public parser::field_itf
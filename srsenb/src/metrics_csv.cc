@@ -26,7 +26,6 @@
 #include <iomanip>
 #include <iostream>
 #include <math.h>
-#include <sstream>
 #include <stdlib.h>
 #include <unistd.h>
 
@@ -65,7 +64,7 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
 
       // Add the cpus
       for (uint32_t i = 0, e = metrics.sys.cpu_count; i != e; ++i) {
-        file << ";cpu_" << std::to_string(i);
+        file << ";cpu_" << i;
       }
 
       // Add the new line.
@@ -87,30 +86,30 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
 
     // DL rate
     if (dl_rate_sum > 0) {
-      file << float_to_string(SRSRAN_MAX(0.1, (float)dl_rate_sum), 2);
+      write_float(SRSRAN_MAX(0.1, (float)dl_rate_sum), 2);
     } else {
-      file << float_to_string(0, 2);
+      write_float(0, 2);
     }
 
     // UL rate
     if (ul_rate_sum > 0) {
-      file << float_to_string(SRSRAN_MAX(0.1, (float)ul_rate_sum), 2);
+      write_float(SRSRAN_MAX(0.1, (float)ul_rate_sum), 2);
     } else {
-      file << float_to_string(0, 2);
+      write_float(0, 2);
     }
 
     // Write system metrics.
     const srsran::sys_metrics_t& m = metrics.sys;
-    file << float_to_string(m.process_realmem, 2);
-    file << std::to_string(m.process_realmem_kB) << ";";
-    file << std::to_string(m.process_virtualmem_kB) << ";";
-    file << float_to_string(m.system_mem, 2);
-    file << float_to_string(m.process_cpu_usage, 2);
-    file << std::to_string(m.thread_count) << ";";
+    write_float(m.process_realmem, 2);
+    file << m.process_realmem_kB << ";";
+    file << m.process_virtualmem_kB << ";";
+    write_float(m.system_mem, 2);
+    write_float(m.process_cpu_usage, 2);
+    file << m.thread_count << ";";
 
     // Write the cpu metrics.
     for (uint32_t i = 0, e = m.cpu_count, last_cpu_index = e - 1; i != e; ++i) {
-      file << float_to_string(m.cpu_load[i], 2, (i != last_cpu_index));
+      write_float(m.cpu_load[i], 2, (i != last_cpu_index));
     }
 
     file << "\n";
@@ -121,14 +120,19 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
   }
 }
 
-std::string metrics_csv::float_to_string(float f, int digits, bool add_semicolon)
+void metrics_csv::write_float(float f, int digits, bool add_semicolon)
 {
-  std::ostringstream os;
-  const int          precision = (f == 0.0) ? digits - 1 : digits - log10f(fabs(f)) - 2 * DBL_EPSILON;
-  os << std::fixed << std::setprecision(precision) << f;
-  if (add_semicolon)
-    os << ';';
-  return os.str();
+  const int precision = (f == 0.0) ? digits - 1 : digits - log10f(fabs(f)) - 2 * DBL_EPSILON;
+
+  // Written straight into the file, restoring its default float format afterwards
+  std::ios_base::fmtflags flags          = file.flags();
+  std::streamsize         prev_precision = file.precision();
+  file << std::fixed << std::setprecision(precision) << f;
+  file.flags(flags);
+  file.precision(prev_precision);
+  if (add_semicolon) {
+    file << ';';
+  }
 }
 
 } // namespace srsenb
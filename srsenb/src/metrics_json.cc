@@ -20,158 +20,205 @@
  */
 
 #include "srsenb/hdr/metrics_json.h"
-#include "srsran/srslog/context.h"
 
 using namespace srsenb;
 
 namespace {
 
-/// Bearer container metrics.
-DECLARE_METRIC("bearer_id", metric_bearer_id, uint32_t, "");
-DECLARE_METRIC("qci", metric_qci, uint32_t, "");
-DECLARE_METRIC("dl_total_bytes", metric_dl_total_bytes, uint64_t, "");
-DECLARE_METRIC("ul_total_bytes", metric_ul_total_bytes, uint64_t, "");
-DECLARE_METRIC("dl_latency", metric_dl_latency, float, "");
-DECLARE_METRIC("ul_latency", metric_ul_latency, float, "");
-DECLARE_METRIC("dl_buffered_bytes", metric_dl_buffered_bytes, uint32_t, "");
-DECLARE_METRIC("ul_buffered_bytes", metric_ul_buffered_bytes, uint32_t, "");
-DECLARE_METRIC_SET("bearer_container",
-                   mset_bearer_container,
-                   metric_bearer_id,
-                   metric_qci,
-                   metric_dl_total_bytes,
-                   metric_ul_total_bytes,
-                   metric_dl_latency,
-                   metric_ul_latency,
-                   metric_dl_buffered_bytes,
-                   metric_ul_buffered_bytes);
-
-/// UE container metrics.
-DECLARE_METRIC("ue_rnti", metric_ue_rnti, uint32_t, "");
-DECLARE_METRIC("dl_cqi", metric_dl_cqi, float, "");
-DECLARE_METRIC("dl_mcs", metric_dl_mcs, float, "");
-DECLARE_METRIC("dl_bitrate", metric_dl_bitrate, float, "");
-DECLARE_METRIC("dl_bler", metric_dl_bler, float, "");
-DECLARE_METRIC("ul_snr", metric_ul_snr, float, "");
-DECLARE_METRIC("ul_mcs", metric_ul_mcs, float, "");
-DECLARE_METRIC("ul_pusch_rssi", metric_ul_pusch_rssi, float, "");
-DECLARE_METRIC("ul_pucch_rssi", metric_ul_pucch_rssi, float, "");
-DECLARE_METRIC("ul_pucch_ni", metric_ul_pucch_ni, float, "");
-DECLARE_METRIC("ul_pusch_tpc", metric_ul_pusch_tpc, int64_t, "");
-DECLARE_METRIC("ul_pucch_tpc", metric_ul_pucch_tpc, int64_t, "");
-DECLARE_METRIC("dl_cqi_offset", metric_dl_cqi_offset, float, "");
-DECLARE_METRIC("ul_snr_offset", metric_ul_snr_offset, float, "");
-DECLARE_METRIC("ul_bitrate", metric_ul_bitrate, float, "");
-DECLARE_METRIC("ul_bler", metric_ul_bler, float, "");
-DECLARE_METRIC("ul_phr", metric_ul_phr, float, "");
-DECLARE_METRIC("ul_bsr", metric_bsr, uint32_t, "");
-DECLARE_METRIC_LIST("bearer_list", mlist_bearers, std::vector<mset_bearer_container>);
-DECLARE_METRIC_SET("ue_container",
-                   mset_ue_container,
-                   metric_ue_rnti,
-                   metric_dl_cqi,
-                   metric_dl_mcs,
-                   metric_ul_pusch_rssi,
-                   metric_ul_pucch_rssi,
-                   metric_ul_pucch_ni,
-                   metric_ul_pusch_tpc,
-                   metric_ul_pucch_tpc,
-                   metric_dl_cqi_offset,
-                   metric_ul_snr_offset,
-                   metric_dl_bitrate,
-                   metric_dl_bler,
-                   metric_ul_snr,
-                   metric_ul_mcs,
-                   metric_ul_bitrate,
-                   metric_ul_bler,
-                   metric_ul_phr,
-                   metric_bsr,
-                   mlist_bearers);
-
-/// Cell container metrics.
-DECLARE_METRIC("carrier_id", metric_carrier_id, uint32_t, "");
-DECLARE_METRIC("pci", metric_pci, uint32_t, "");
-DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
-DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
-DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
-
-/// Metrics root object.
-DECLARE_METRIC("type", metric_type_tag, std::string, "");
-DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
-DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
-
-/// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+/// Streams metrics as JSON directly into a buffer, producing the same layout as the srslog JSON formatter does for a
+/// metrics context. As in the formatter, the number of elements of every object and list has to be known when it is
+/// opened, so that separating commas can be placed without look-ahead.
+class json_writer
+{
+public:
+  explicit json_writer(fmt::memory_buffer& buffer_) : buffer(buffer_) {}
 
-} // namespace
+  void begin_context(unsigned size)
+  {
+    put("{\n");
+    push_scope(size, false);
+    level = 1;
+  }
 
-/// Fill the metrics for the i'th UE in the enb metrics struct.
-static void fill_ue_metrics(mset_ue_container& ue, const enb_metrics_t& m, unsigned i)
-{
-  ue.write<metric_ue_rnti>(m.stack.mac.ues[i].rnti);
-  ue.write<metric_dl_cqi>(std::max(0.1f, m.stack.mac.ues[i].dl_cqi));
-  if (!std::isnan(m.phy[i].dl.mcs)) {
-    ue.write<metric_dl_mcs>(m.phy[i].dl.mcs);
+  void end_context()
+  {
+    pop_scope();
+    put("}\n");
   }
-  if (m.stack.mac.ues[i].tx_brate > 0 && m.stack.mac.ues[i].nof_tti > 0) {
-    ue.write<metric_dl_bitrate>(
-        std::max(0.1f, (float)m.stack.mac.ues[i].tx_brate / (m.stack.mac.ues[i].nof_tti * 0.001f)));
+
+  /// Opens a named object. Inside lists, objects are wrapped in an additional anonymous object.
+  void begin_set(fmt::string_view name, unsigned size)
+  {
+    if (in_list_scope()) {
+      put_indent();
+      put("{\n");
+      ++nest_level;
+    }
+    consume_element();
+    put_indent();
+    put_name(name);
+    put("{\n");
+    push_scope(size, false);
+    ++level;
   }
-  if (m.stack.mac.ues[i].tx_pkts > 0 && m.stack.mac.ues[i].tx_errors > 0) {
-    ue.write<metric_dl_bler>((float)100 * m.stack.mac.ues[i].tx_errors / m.stack.mac.ues[i].tx_pkts);
+
+  void end_set()
+  {
+    --level;
+    pop_scope();
+    put_indent();
+    put(needs_comma() && !in_list_scope() ? "},\n" : "}\n");
+    if (in_list_scope()) {
+      --nest_level;
+      put_indent();
+      put(needs_comma() ? "},\n" : "}\n");
+    }
   }
-  if (!std::isnan(m.phy[i].ul.pusch_sinr)) {
-    ue.write<metric_ul_snr>(m.phy[i].ul.pusch_sinr);
+
+  void begin_list(fmt::string_view name, unsigned size)
+  {
+    consume_element();
+    put_indent();
+    put_name(name);
+    put("[\n");
+    push_scope(size, true);
+    ++level;
   }
-  if (!std::isnan(m.phy[i].ul.pusch_rssi)) {
-    ue.write<metric_ul_pusch_rssi>(m.phy[i].ul.pusch_rssi);
+
+  void end_list()
+  {
+    --level;
+    pop_scope();
+    put_indent();
+    put(needs_comma() ? "],\n" : "]\n");
   }
-  if (!std::isnan(m.phy[i].ul.pucch_rssi)) {
-    ue.write<metric_ul_pucch_rssi>(m.phy[i].ul.pucch_rssi);
+
+  /// Writes a numeric metric. T is the type the value is formatted as.
+  template <typename T>
+  void write(fmt::string_view name, T value)
+  {
+    consume_element();
+    put_indent();
+    put_name(name);
+    put_value(value);
+    put(needs_comma() ? ",\n" : "\n");
   }
-  if (!std::isnan(m.phy[i].ul.pucch_ni)) {
-    ue.write<metric_ul_pucch_ni>(m.phy[i].ul.pucch_ni);
+
+  void write_string(fmt::string_view name, fmt::string_view value)
+  {
+    consume_element();
+    put_indent();
+    put_name(name);
+    put("\"");
+    put(value);
+    put(needs_comma() ? "\",\n" : "\"\n");
   }
-  ue.write<metric_ul_pusch_tpc>(m.phy[i].ul.pusch_tpc);
-  ue.write<metric_ul_pucch_tpc>(m.phy[i].dl.pucch_tpc);
-  if (!std::isnan(m.stack.mac.ues[i].dl_cqi_offset)) {
-    ue.write<metric_dl_cqi_offset>(m.stack.mac.ues[i].dl_cqi_offset);
+
+private:
+  struct scope {
+    unsigned size;
+    bool     inside_list;
+  };
+
+  void push_scope(unsigned size, bool inside_list)
+  {
+    srsran_assert(nof_scopes < scopes.size(), "Maximum JSON nesting depth exceeded");
+    scopes[nof_scopes++] = {size, inside_list};
   }
-  if (!std::isnan(m.stack.mac.ues[i].ul_snr_offset)) {
-    ue.write<metric_ul_snr_offset>(m.stack.mac.ues[i].ul_snr_offset);
+  void     pop_scope() { --nof_scopes; }
+  void     consume_element() { --scopes[nof_scopes - 1].size; }
+  bool     needs_comma() const { return scopes[nof_scopes - 1].size > 0; }
+  bool     in_list_scope() const { return scopes[nof_scopes - 1].inside_list; }
+  unsigned indents() const { return (nest_level + level) * 2; }
+
+  void put(fmt::string_view str) { buffer.append(str.data(), str.data() + str.size()); }
+  void put_indent()
+  {
+    static const char spaces[] = "                                ";
+    srsran_assert(indents() < sizeof(spaces), "Maximum JSON nesting depth exceeded");
+    buffer.append(spaces, spaces + indents());
   }
-  if (!std::isnan(m.phy[i].ul.mcs)) {
-    ue.write<metric_ul_mcs>(m.phy[i].ul.mcs);
+  void put_name(fmt::string_view name)
+  {
+    put("\"");
+    put(name);
+    put("\": ");
   }
-  if (m.stack.mac.ues[i].rx_brate > 0 && m.stack.mac.ues[i].nof_tti > 0) {
-    ue.write<metric_ul_bitrate>((float)m.stack.mac.ues[i].rx_brate / (m.stack.mac.ues[i].nof_tti * 0.001f));
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value>::type put_value(T value)
+  {
+    put(fmt::format_int(value).str());
   }
-  if (m.stack.mac.ues[i].rx_pkts > 0 && m.stack.mac.ues[i].rx_errors > 0) {
-    ue.write<metric_ul_bler>(std::max(0.1f, (float)100 * m.stack.mac.ues[i].rx_errors / m.stack.mac.ues[i].rx_pkts));
+  template <typename T>
+  typename std::enable_if<std::is_floating_point<T>::value>::type put_value(T value)
+  {
+    fmt::format_to(buffer, "{}", value);
   }
-  ue.write<metric_ul_phr>(m.stack.mac.ues[i].phr);
-  ue.write<metric_bsr>(m.stack.mac.ues[i].ul_buffer);
+
+  fmt::memory_buffer&   buffer;
+  std::array<scope, 16> scopes;
+  unsigned              nof_scopes = 0;
+  unsigned              level      = 0;
+  unsigned              nest_level = 0;
+};
+
+} // namespace
+
+/// Number of metrics in a UE container, including the bearer list.
+static const unsigned nof_ue_metrics = 19;
+
+/// Writes the metrics for the i'th UE in the enb metrics struct. Metrics without a valid value are written as 0.
+static void write_ue_metrics(json_writer& w, const enb_metrics_t& m, unsigned i)
+{
+  const mac_ue_metrics_t& mac = m.stack.mac.ues[i];
+  const phy_metrics_t&    phy = m.phy[i];
+
+  w.begin_set("ue_container", nof_ue_metrics);
+  w.write<uint32_t>("ue_rnti", mac.rnti);
+  w.write<float>("dl_cqi", std::max(0.1f, mac.dl_cqi));
+  w.write<float>("dl_mcs", !std::isnan(phy.dl.mcs) ? phy.dl.mcs : 0);
+  w.write<float>("ul_pusch_rssi", !std::isnan(phy.ul.pusch_rssi) ? phy.ul.pusch_rssi : 0);
+  w.write<float>("ul_pucch_rssi", !std::isnan(phy.ul.pucch_rssi) ? phy.ul.pucch_rssi : 0);
+  w.write<float>("ul_pucch_ni", !std::isnan(phy.ul.pucch_ni) ? phy.ul.pucch_ni : 0);
+  w.write<int64_t>("ul_pusch_tpc", phy.ul.pusch_tpc);
+  w.write<int64_t>("ul_pucch_tpc", phy.dl.pucch_tpc);
+  w.write<float>("dl_cqi_offset", !std::isnan(mac.dl_cqi_offset) ? mac.dl_cqi_offset : 0);
+  w.write<float>("ul_snr_offset", !std::isnan(mac.ul_snr_offset) ? mac.ul_snr_offset : 0);
+  w.write<float>("dl_bitrate",
+                 (mac.tx_brate > 0 && mac.nof_tti > 0) ? std::max(0.1f, (float)mac.tx_brate / (mac.nof_tti * 0.001f))
+                                                       : 0);
+  w.write<float>("dl_bler", (mac.tx_pkts > 0 && mac.tx_errors > 0) ? (float)100 * mac.tx_errors / mac.tx_pkts : 0);
+  w.write<float>("ul_snr", !std::isnan(phy.ul.pusch_sinr) ? phy.ul.pusch_sinr : 0);
+  w.write<float>("ul_mcs", !std::isnan(phy.ul.mcs) ? phy.ul.mcs : 0);
+  w.write<float>("ul_bitrate",
+                 (mac.rx_brate > 0 && mac.nof_tti > 0) ? (float)mac.rx_brate / (mac.nof_tti * 0.001f) : 0);
+  w.write<float>("ul_bler",
+                 (mac.rx_pkts > 0 && mac.rx_errors > 0) ? std::max(0.1f, (float)100 * mac.rx_errors / mac.rx_pkts)
+                                                        : 0);
+  w.write<float>("ul_phr", mac.phr);
+  w.write<uint32_t>("ul_bsr", mac.ul_buffer);
 
   // For each data bearer of this UE...
-  auto& bearer_list = ue.get<mlist_bearers>();
-  for (const auto& drb : m.stack.rrc.ues[i].drb_qci_map) {
-    bearer_list.emplace_back();
-    auto& bearer_container = bearer_list.back();
-    bearer_container.write<metric_bearer_id>(drb.first);
-    bearer_container.write<metric_qci>(drb.second);
+  const auto& drb_qci_map = m.stack.rrc.ues[i].drb_qci_map;
+  const auto& rlc_bearer  = m.stack.rlc.ues[i].bearer;
+  const auto& pdcp_bearer = m.stack.pdcp.ues[i].bearer;
+  w.begin_list("bearer_list", drb_qci_map.size());
+  for (const auto& drb : drb_qci_map) {
+    w.begin_set("bearer_container", 8);
+    w.write<uint32_t>("bearer_id", drb.first);
+    w.write<uint32_t>("qci", drb.second);
     // RLC bearer metrics.
-    if (drb.first >= SRSRAN_N_RADIO_BEARERS) {
-      continue;
-    }
-    const auto& rlc_bearer  = m.stack.rlc.ues[i].bearer;
-    const auto& pdcp_bearer = m.stack.pdcp.ues[i].bearer;
-    bearer_container.write<metric_dl_total_bytes>(pdcp_bearer[drb.first].num_tx_acked_bytes);
-    bearer_container.write<metric_ul_total_bytes>(pdcp_bearer[drb.first].num_rx_pdu_bytes);
-    bearer_container.write<metric_dl_latency>(pdcp_bearer[drb.first].tx_notification_latency_ms / 1e3);
-    bearer_container.write<metric_ul_latency>(rlc_bearer[drb.first].rx_latency_ms / 1e3);
-    bearer_container.write<metric_dl_buffered_bytes>(pdcp_bearer[drb.first].num_tx_buffered_pdus_bytes);
-    bearer_container.write<metric_ul_buffered_bytes>(rlc_bearer[drb.first].rx_buffered_bytes);
+    bool valid = drb.first < SRSRAN_N_RADIO_BEARERS;
+    w.write<uint64_t>("dl_total_bytes", valid ? pdcp_bearer[drb.first].num_tx_acked_bytes : 0);
+    w.write<uint64_t>("ul_total_bytes", valid ? pdcp_bearer[drb.first].num_rx_pdu_bytes : 0);
+    w.write<float>("dl_latency", valid ? pdcp_bearer[drb.first].tx_notification_latency_ms / 1e3 : 0);
+    w.write<float>("ul_latency", valid ? rlc_bearer[drb.first].rx_latency_ms / 1e3 : 0);
+    w.write<uint32_t>("dl_buffered_bytes", valid ? pdcp_bearer[drb.first].num_tx_buffered_pdus_bytes : 0);
+    w.write<uint32_t>("ul_buffered_bytes", valid ? rlc_bearer[drb.first].rx_buffered_bytes : 0);
+    w.end_set();
   }
+  w.end_list();
+  w.end_set();
 }
 
 /// Returns the current time in seconds with ms precision since UNIX epoch.
@@ -200,6 +247,32 @@ static bool has_valid_metric_ranges(const enb_metrics_t& m, unsigned index)
   return true;
 }
 
+void metrics_json::group_ues_by_cell(const enb_metrics_t& m)
+{
+  // Counting sort of the valid UE indexes by cell, keeping their relative order.
+  unsigned nof_cells = m.stack.mac.cc_info.size();
+  cell_ue_offsets.assign(nof_cells + 1, 0);
+  for (unsigned i = 0, e = m.stack.rrc.ues.size(); i != e; ++i) {
+    if (has_valid_metric_ranges(m, i) and m.stack.mac.ues[i].cc_idx < nof_cells) {
+      cell_ue_offsets[m.stack.mac.ues[i].cc_idx + 1]++;
+    }
+  }
+  for (unsigned cc_idx = 0; cc_idx != nof_cells; ++cc_idx) {
+    cell_ue_offsets[cc_idx + 1] += cell_ue_offsets[cc_idx];
+  }
+  cell_ues.resize(cell_ue_offsets[nof_cells]);
+  for (unsigned i = 0, e = m.stack.rrc.ues.size(); i != e; ++i) {
+    if (has_valid_metric_ranges(m, i) and m.stack.mac.ues[i].cc_idx < nof_cells) {
+      cell_ues[cell_ue_offsets[m.stack.mac.ues[i].cc_idx]++] = i;
+    }
+  }
+  // The fill pass moved each offset to the start of the next cell.
+  for (unsigned cc_idx = nof_cells; cc_idx != 0; --cc_idx) {
+    cell_ue_offsets[cc_idx] = cell_ue_offsets[cc_idx - 1];
+  }
+  cell_ue_offsets[0] = 0;
+}
+
 void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_usec)
 {
   if (!enb) {
@@ -209,36 +282,60 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     return;
   }
 
-  metric_context_t ctx("JSON Metrics");
+  group_ues_by_cell(m);
+
+  buffer.clear();
+  json_writer w(buffer);
 
   // Fill root object.
-  ctx.write<metric_type_tag>("metrics");
-  auto& cell_list = ctx.get<mlist_cell>();
-  cell_list.resize(m.stack.mac.cc_info.size());
+  w.begin_context(5);
+  w.write_string("type", "metrics");
+  w.write<double>("timestamp", get_time_stamp());
 
   // For each cell...
-  for (unsigned cc_idx = 0, e = cell_list.size(); cc_idx != e; ++cc_idx) {
-    auto& cell = cell_list[cc_idx];
-    cell.write<metric_carrier_id>(cc_idx);
-    cell.write<metric_nof_rach>(m.stack.mac.cc_info[cc_idx].cc_rach_counter);
-    cell.write<metric_pci>(m.stack.mac.cc_info[cc_idx].pci);
+  w.begin_list("cell_list", m.stack.mac.cc_info.size());
+  for (unsigned cc_idx = 0, e = m.stack.mac.cc_info.size(); cc_idx != e; ++cc_idx) {
+    w.begin_set("cell_container", 4);
+    w.write<uint32_t>("carrier_id", cc_idx);
+    w.write<uint32_t>("pci", m.stack.mac.cc_info[cc_idx].pci);
+    w.write<uint32_t>("nof_rach", m.stack.mac.cc_info[cc_idx].cc_rach_counter);
 
     // For each UE in this cell...
-    for (unsigned i = 0; i != m.stack.rrc.ues.size(); ++i) {
-      if (!has_valid_metric_ranges(m, i)) {
-        continue;
-      }
-
-      // Only record UEs that belong to this cell.
-      if (m.stack.mac.ues[i].cc_idx != cc_idx) {
-        continue;
-      }
-      cell.get<mlist_ues>().emplace_back();
-      fill_ue_metrics(cell.get<mlist_ues>().back(), m, i);
+    w.begin_list("ue_list", cell_ue_offsets[cc_idx + 1] - cell_ue_offsets[cc_idx]);
+    for (unsigned k = cell_ue_offsets[cc_idx]; k != cell_ue_offsets[cc_idx + 1]; ++k) {
+      write_ue_metrics(w, m, cell_ues[k]);
     }
+    w.end_list();
+    w.end_set();
+  }
+  w.end_list();
+
+  // For each time profiler...
+  w.begin_list("tprof_list", m.tprof.size());
+  for (const auto& prof : m.tprof) {
+    w.begin_set("tprof_container", 7);
+    w.write_string("name", prof.name);
+    w.write<uint64_t>("count", prof.count);
+    w.write<double>("mean", prof.mean_us);
+    w.write<double>("p50", prof.p50_us);
+    w.write<double>("p90", prof.p90_us);
+    w.write<double>("p99", prof.p99_us);
+    w.write<double>("max", prof.max_us);
+    w.end_set();
+  }
+  w.end_list();
+
+  // For each thread of the process...
+  w.begin_list("thread_list", m.sys.nof_thread_metrics);
+  for (unsigned i = 0; i != m.sys.nof_thread_metrics; ++i) {
+    const srsran::sys_thread_metrics_t& thread = m.sys.thread_metrics[i];
+    w.begin_set("thread_container", 2);
+    w.write_string("thread_name", thread.name.data());
+    w.write<float>("thread_cpu_usage", thread.cpu_usage);
+    w.end_set();
   }
+  w.end_list();
+  w.end_context();
 
-  // Log the context.
-  ctx.write<metric_timestamp_tag>(get_time_stamp());
-  log_c(ctx);
+  log_c.write_formatted(std::string(buffer.data(), buffer.size()));
 }
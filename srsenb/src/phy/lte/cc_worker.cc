@@ -476,9 +476,16 @@ int cc_worker::decode_pucch()
 
 int cc_worker::encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks)
 {
-  for (uint32_t i = 0; i < nof_acks; i++) {
+  // Gather the ACKs of the subframe so every PHICH group is precoded and mapped once
+  std::array<srsran_phich_grant_t, stack_interface_phy_lte::MAX_GRANTS> grants;
+  std::array<bool, stack_interface_phy_lte::MAX_GRANTS>                 values;
+  uint32_t                                                              nof_values = 0;
+
+  for (uint32_t i = 0; i < nof_acks && nof_values < values.size(); i++) {
     if (acks[i].rnti && ue_db.count(acks[i].rnti)) {
-      srsran_enb_dl_put_phich(&enb_dl, &ue_db[acks[i].rnti]->phich_grant, acks[i].ack);
+      grants[nof_values] = ue_db[acks[i].rnti]->phich_grant;
+      values[nof_values] = acks[i].ack;
+      nof_values++;
 
       Info("PHICH: rnti=0x%x, hi=%d, I_lowest=%d, n_dmrs=%d, tti_tx_dl=%d",
            acks[i].rnti,
@@ -488,7 +495,8 @@ int cc_worker::encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint3
            tti_tx_dl);
     }
   }
-  return SRSRAN_SUCCESS;
+
+  return srsran_enb_dl_put_phich_batch(&enb_dl, grants.data(), values.data(), nof_values);
 }
 
 int cc_worker::encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants)
@@ -183,27 +183,42 @@ bool slot_worker::work_ul()
     return false;
   }
 
-  // For each PUCCH...
-  for (stack_interface_phy_nr::pucch_t& pucch : ul_sched->pucch) {
-    srsran::bounded_vector<stack_interface_phy_nr::pucch_info_t, stack_interface_phy_nr::MAX_PUCCH_CANDIDATES>
-        pucch_info(pucch.candidates.size());
+  // Gather all PUCCH candidates of the slot, so the candidates sharing the same resource are estimated once
+  using pucch_info_list_t =
+      srsran::bounded_vector<stack_interface_phy_nr::pucch_info_t, stack_interface_phy_nr::MAX_PUCCH_CANDIDATES>;
+  const static uint32_t max_pucch_candidates =
+      stack_interface_phy_nr::MAX_GRANTS * stack_interface_phy_nr::MAX_PUCCH_CANDIDATES;
+  std::array<pucch_info_list_t, stack_interface_phy_nr::MAX_GRANTS> pucch_infos;
+  std::array<srsran_gnb_ul_pucch_candidate_t, max_pucch_candidates> pucch_candidates     = {};
+  uint32_t                                                          nof_pucch_candidates = 0;
+  for (uint32_t p = 0; p < (uint32_t)ul_sched->pucch.size(); p++) {
+    stack_interface_phy_nr::pucch_t& pucch = ul_sched->pucch[p];
+    pucch_infos[p].resize(pucch.candidates.size());
 
-    // For each candidate decode PUCCH
     for (uint32_t i = 0; i < (uint32_t)pucch.candidates.size(); i++) {
-      pucch_info[i].uci_data.cfg = pucch.candidates[i].uci_cfg;
-
-      // Decode PUCCH
-      if (srsran_gnb_ul_get_pucch(&gnb_ul,
-                                  &ul_slot_cfg,
-                                  &pucch.pucch_cfg,
-                                  &pucch.candidates[i].resource,
-                                  &pucch_info[i].uci_data.cfg,
-                                  &pucch_info[i].uci_data.value,
-                                  &pucch_info[i].csi) < SRSRAN_SUCCESS) {
-        logger.error("Error getting PUCCH");
-        return false;
-      }
+      stack_interface_phy_nr::pucch_info_t& pucch_info = pucch_infos[p][i];
+      pucch_info.uci_data.cfg                          = pucch.candidates[i].uci_cfg;
+
+      srsran_gnb_ul_pucch_candidate_t& candidate = pucch_candidates[nof_pucch_candidates++];
+      candidate.cfg                              = &pucch.pucch_cfg;
+      candidate.resource                         = &pucch.candidates[i].resource;
+      candidate.uci_cfg                          = &pucch_info.uci_data.cfg;
+      candidate.uci_value                        = &pucch_info.uci_data.value;
+      candidate.meas                             = &pucch_info.csi;
     }
+  }
+
+  // Decode all PUCCH candidates
+  if (srsran_gnb_ul_get_pucch_batch(&gnb_ul, &ul_slot_cfg, pucch_candidates.data(), nof_pucch_candidates) <
+      SRSRAN_SUCCESS) {
+    logger.error("Error getting PUCCH");
+    return false;
+  }
+
+  // For each PUCCH...
+  for (uint32_t p = 0; p < (uint32_t)ul_sched->pucch.size(); p++) {
+    stack_interface_phy_nr::pucch_t& pucch      = ul_sched->pucch[p];
+    pucch_info_list_t&               pucch_info = pucch_infos[p];
 
     // Find most suitable PUCCH candidate
     uint32_t best_candidate = 0;
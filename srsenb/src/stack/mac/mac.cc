@@ -22,6 +22,7 @@
 #include <pthread.h>
 #include <string.h>
 
+#include "srsenb/hdr/stack/mac/common/mac_tprof.h"
 #include "srsenb/hdr/stack/mac/mac.h"
 #include "srsran/adt/pool/obj_pool.h"
 #include "srsran/common/rwlock_guard.h"
@@ -559,9 +560,8 @@ uint16_t mac::reserve_new_crnti(const sched_interface::ue_cfg_t& uecfg)
 
 void mac::rach_detected(uint32_t tti, uint32_t enb_cc_idx, uint32_t preamble_idx, uint32_t time_adv)
 {
-  static srsran::mutexed_tprof<srsran::avg_time_stats> rach_tprof("rach_tprof", "MAC", 1);
   logger.set_context(tti);
-  auto rach_tprof_meas = rach_tprof.start();
+  auto rach_tprof_meas = mac_rach_tprof.start();
 
   stack_task_queue.push([this, tti, enb_cc_idx, preamble_idx, time_adv, rach_tprof_meas]() mutable {
     uint16_t rnti = 0;
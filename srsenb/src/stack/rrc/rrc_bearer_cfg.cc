@@ -228,7 +228,7 @@ int bearer_cfg_handler::addmod_erab(uint8_t
                                     srsran::const_span<uint8_t>                        nas_pdu,
                                     asn1::s1ap::cause_c&                               cause)
 {
-  if (erab_id < 5) {
+  if (not srsran::is_eps_bearer_id(erab_id)) {
     logger->error("ERAB id=%d is invalid", erab_id);
     cause.set_radio_network().value = asn1::s1ap::cause_radio_network_opts::unknown_erab_id;
     return SRSRAN_ERROR;
@@ -254,8 +254,7 @@ int bearer_cfg_handler::addmod_erab(uint8_t
     return SRSRAN_ERROR;
   }
 
-  auto qci_it = cfg->qci_cfg.find(qos.qci);
-  if (qci_it == cfg->qci_cfg.end() or not qci_it->second.configured) {
+  if (qos.qci >= cfg->qci_cfg.size() or not cfg->qci_cfg[qos.qci].configured) {
     logger->error("QCI=%d not configured", qos.qci);
     cause.set_radio_network().value = asn1::s1ap::cause_radio_network_opts::not_supported_qci_value;
     return SRSRAN_ERROR;
@@ -265,7 +264,7 @@ int bearer_cfg_handler::addmod_erab(uint8_t
     cause.set_radio_network().value = asn1::s1ap::cause_radio_network_opts::unknown_erab_id;
     return SRSRAN_ERROR;
   }
-  const rrc_cfg_qci_t& qci_cfg = qci_it->second;
+  const rrc_cfg_qci_t& qci_cfg = cfg->qci_cfg[qos.qci];
 
   // perform checks on QCI config
   if (addr.length() > 32) {
@@ -291,7 +290,7 @@ int bearer_cfg_handler::addmod_erab(uint8_t
   }
 
   // If it is an E-RAB modification, remove previous DRB object
-  if (erabs.count(erab_id) > 0) {
+  if (erabs.contains(erab_id)) {
     for (auto& drb : current_drbs) {
       if (drb.eps_bearer_id_present and drb.eps_bearer_id == erab_id) {
         srsran::rem_rrc_obj_id(current_drbs, drb.drb_id);
@@ -301,14 +300,18 @@ int bearer_cfg_handler::addmod_erab(uint8_t
   }
 
   // Consider ERAB as accepted
-  erabs[erab_id].id         = erab_id;
-  erabs[erab_id].lcid       = lcid;
-  erabs[erab_id].qos_params = qos;
-  erabs[erab_id].address    = addr;
-  erabs[erab_id].teid_out   = teid_out;
+  if (not erabs.contains(erab_id)) {
+    erabs.insert(erab_id, erab_t{});
+  }
+  erab_t& erab    = erabs[erab_id];
+  erab.id         = erab_id;
+  erab.lcid       = lcid;
+  erab.qos_params = qos;
+  erab.address    = addr;
+  erab.teid_out   = teid_out;
 
   if (not nas_pdu.empty()) {
-    erab_info_list[erab_id].assign(nas_pdu.begin(), nas_pdu.end());
+    erab_info_list.overwrite(erab_id, std::vector<uint8_t>(nas_pdu.begin(), nas_pdu.end()));
     logger->info(
         &erab_info_list[erab_id][0], erab_info_list[erab_id].size(), "setup_erab nas_pdu -> erab_info rnti 0x%x", rnti);
   }
@@ -363,7 +366,7 @@ int bearer_cfg_handler::modify_erab(uint8_t                                    e
                                     asn1::s1ap::cause_c&                       cause)
 {
   logger->info("Modifying E-RAB %d", erab_id);
-  std::map<uint8_t, erab_t>::iterator erab_it = erabs.find(erab_id);
+  auto erab_it = erabs.find(erab_id);
   if (erab_it == erabs.end()) {
     logger->error("Could not find E-RAB to modify");
     cause.set_radio_network().value = asn1::s1ap::cause_radio_network_opts::unknown_erab_id;
@@ -1251,7 +1251,7 @@ int rrc::ue::setup_erab(uint16_t                                           erab_
                         uint32_t                                           gtpu_teid_out,
                         asn1::s1ap::cause_c&                               cause)
 {
-  if (bearer_list.get_erabs().count(erab_id) > 0) {
+  if (bearer_list.get_erabs().contains(erab_id)) {
     cause.set_radio_network().value = asn1::s1ap::cause_radio_network_opts::multiple_erab_id_instances;
     return SRSRAN_ERROR;
   }
@@ -1604,7 +1604,7 @@ void rrc::ue::apply_rlc_rb_updates(const rr_cfg_ded_s& pending_rr_cfg)
       parent->logger.warning("Default RLC DRB config not supported");
     }
     srsran::rlc_config_t              rlc_cfg = srsran::make_rlc_config_t(drb.rlc_cfg);
-    const bearer_cfg_handler::erab_t& erab    = bearer_list.get_erabs().at(drb.eps_bearer_id);
+    const bearer_cfg_handler::erab_t& erab    = bearer_list.get_erabs()[drb.eps_bearer_id];
     if (rlc_cfg.rlc_mode == srsran::rlc_mode_t::am and
         parent->cfg.qci_cfg.at(erab.qos_params.qci).enb_dl_max_retx_thres > 0) {
       rlc_cfg.am.max_retx_thresh = parent->cfg.qci_cfg.at(erab.qos_params.qci).enb_dl_max_retx_thres;
@@ -484,7 +484,7 @@ void s1ap::user_mod(uint16_t old_rnti, uint16_t new_rnti)
     logger.error("New rnti already exists, aborting.");
     return;
   }
-  users.find_ue_rnti(old_rnti)->ctxt.rnti = new_rnti;
+  users.set_rnti(users.find_ue_rnti(old_rnti), new_rnti);
 }
 
 void s1ap::ue_ctxt_setup_complete(uint16_t rnti)
@@ -1296,7 +1296,10 @@ bool s1ap::send_ho_req_ack(const asn1::s1ap::ho_request_s&                msg,
     logger.error("The MME-S1AP-UE-ID=%ld is not valid", msg->mme_ue_s1ap_id.value.value);
     return false;
   }
-  ue_ptr->ctxt.rnti       = rnti;
+  if (not users.set_rnti(ue_ptr, rnti)) {
+    logger.error("The rnti=0x%x is already in use", rnti);
+    return false;
+  }
   ue_ptr->ctxt.enb_cc_idx = enb_cc_idx;
 
   container->mme_ue_s1ap_id.value = msg->mme_ue_s1ap_id.value.value;
@@ -1930,9 +1933,8 @@ s1ap::ue* s1ap::user_list::find_ue_rnti(uint16_t rnti)
   if (rnti == SRSRAN_INVALID_RNTI) {
     return nullptr;
   }
-  auto it = std::find_if(
-      users.begin(), users.end(), [rnti](const user_list::pair_type& v) { return v.second->ctxt.rnti == rnti; });
-  return it != users.end() ? it->second.get() : nullptr;
+  auto it = rnti_index.find(rnti);
+  return it != rnti_index.end() ? it->second : nullptr;
 }
 
 s1ap::ue* s1ap::user_list::find_ue_enbid(uint32_t enbid)
@@ -1943,10 +1945,8 @@ s1ap::ue* s1ap::user_list::find_ue_enbid(uint32_t enbid)
 
 s1ap::ue* s1ap::user_list::find_ue_mmeid(uint32_t mmeid)
 {
-  auto it = std::find_if(users.begin(), users.end(), [mmeid](const user_list::pair_type& v) {
-    return v.second->ctxt.mme_ue_s1ap_id == mmeid;
-  });
-  return it != users.end() ? it->second.get() : nullptr;
+  auto it = mmeid_index.find(mmeid);
+  return it != mmeid_index.end() ? it->second : nullptr;
 }
 
 /**
@@ -1971,7 +1971,17 @@ s1ap::ue* s1ap::user_list::add_user(std::unique_ptr<s1ap::ue> user)
     return nullptr;
   }
   auto p = users.insert(std::make_pair(user->ctxt.enb_ue_s1ap_id, std::move(user)));
-  return p.second ? p.first->second.get() : nullptr;
+  if (not p.second) {
+    return nullptr;
+  }
+  ue* u = p.first->second.get();
+  if (u->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_index.emplace(u->ctxt.rnti, u);
+  }
+  if (u->ctxt.mme_ue_s1ap_id.has_value()) {
+    mmeid_index.emplace(u->ctxt.mme_ue_s1ap_id.value(), u);
+  }
+  return u;
 }
 
 void s1ap::user_list::erase(ue* ue_ptr)
@@ -1982,9 +1992,57 @@ void s1ap::user_list::erase(ue* ue_ptr)
     logger.error("User to be erased does not exist");
     return;
   }
+  if (ue_ptr->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_index.erase(ue_ptr->ctxt.rnti);
+  }
+  if (ue_ptr->ctxt.mme_ue_s1ap_id.has_value()) {
+    mmeid_index.erase(ue_ptr->ctxt.mme_ue_s1ap_id.value());
+  }
   users.erase(it);
 }
 
+/**
+ * @brief Changes the RNTI of a user in the list, keeping the RNTI index consistent
+ * @return false if another user already holds %rnti
+ */
+bool s1ap::user_list::set_rnti(ue* ue_ptr, uint16_t rnti)
+{
+  if (ue_ptr->ctxt.rnti == rnti) {
+    return true;
+  }
+  if (find_ue_rnti(rnti) != nullptr) {
+    return false;
+  }
+  if (ue_ptr->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_index.erase(ue_ptr->ctxt.rnti);
+  }
+  ue_ptr->ctxt.rnti = rnti;
+  if (rnti != SRSRAN_INVALID_RNTI) {
+    rnti_index.emplace(rnti, ue_ptr);
+  }
+  return true;
+}
+
+/**
+ * @brief Sets the MME_UE_S1AP_ID of a user in the list, keeping the MME_UE_S1AP_ID index consistent
+ * @return false if another user already holds %mmeid
+ */
+bool s1ap::user_list::set_mmeid(ue* ue_ptr, uint32_t mmeid)
+{
+  if (ue_ptr->ctxt.mme_ue_s1ap_id == mmeid) {
+    return true;
+  }
+  if (find_ue_mmeid(mmeid) != nullptr) {
+    return false;
+  }
+  if (ue_ptr->ctxt.mme_ue_s1ap_id.has_value()) {
+    mmeid_index.erase(ue_ptr->ctxt.mme_ue_s1ap_id.value());
+  }
+  ue_ptr->ctxt.mme_ue_s1ap_id = mmeid;
+  mmeid_index.emplace(mmeid, ue_ptr);
+  return true;
+}
+
 /*******************************************************************************
 /* General helpers
 ********************************************************************************/
@@ -2076,7 +2134,7 @@ s1ap::ue* s1ap::handle_s1apmsg_ue_id(uint32_t enb_id, uint32_t mme_id)
     user_mme_ptr = users.find_ue_mmeid(mme_id);
     if (not user_ptr->ctxt.mme_ue_s1ap_id.has_value() and user_mme_ptr == nullptr) {
       // First "returned message", no inconsistency found (see 36.413, Section 10.6)
-      user_ptr->ctxt.mme_ue_s1ap_id = mme_id;
+      users.set_mmeid(user_ptr, mme_id);
       return user_ptr;
     }
 
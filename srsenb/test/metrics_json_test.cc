@@ -0,0 +1,442 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/metrics_json.h"
+#include "srsenb/hdr/stack/mac/common/mac_tprof.h"
+#include "srsran/srslog/srslog.h"
+#include "srsran/common/test_common.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+using namespace srsenb;
+
+namespace {
+
+/// Sink that stores in memory everything written to it.
+class string_sink : public srslog::sink
+{
+public:
+  string_sink() : sink(srslog::get_default_sink().get_formatter().clone()) {}
+
+  srslog::detail::error_string write(srslog::detail::memory_buffer buffer) override
+  {
+    contents.append(buffer.data(), buffer.size());
+    return {};
+  }
+
+  srslog::detail::error_string flush() override { return {}; }
+
+  std::string contents;
+};
+
+/// The eNb interface is only checked for being present.
+class enb_dummy : public enb_metrics_interface
+{
+public:
+  bool get_metrics(enb_metrics_t* m) override { return true; }
+};
+
+/// Writes a report of the given metrics and returns it, with the timestamp set to zero.
+std::string write_report(const enb_metrics_t& m)
+{
+  static string_sink   sink;
+  srslog::log_channel& channel = srslog::fetch_log_channel("METRICS_JSON_TEST", sink, {});
+  enb_dummy            enb;
+  metrics_json         writer(channel, &enb);
+
+  sink.contents.clear();
+  writer.set_metrics(m, 1000000);
+  srslog::flush();
+
+  std::string report = sink.contents;
+  size_t      begin  = report.find("\"timestamp\": ");
+  if (begin != std::string::npos) {
+    begin += sizeof("\"timestamp\": ") - 1;
+    report.replace(begin, report.find(',', begin) - begin, "0");
+  }
+  return report;
+}
+
+bool check_report(const std::string& report, const char* expected)
+{
+  if (report != expected) {
+    std::cout << "Unexpected JSON report:\n" << report << "Expected:\n" << expected;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int test_tprof_list()
+{
+  enb_metrics_t m = {};
+  m.stack.mac.cc_info.resize(1);
+  m.stack.mac.cc_info[0].pci             = 1;
+  m.stack.mac.cc_info[0].cc_rach_counter = 2;
+
+  m.tprof.resize(2);
+  m.tprof[0].name    = "mac_rach";
+  m.tprof[0].count   = 10;
+  m.tprof[0].mean_us = 12.5;
+  m.tprof[0].p50_us  = 11;
+  m.tprof[0].p90_us  = 20.25;
+  m.tprof[0].p99_us  = 31;
+  m.tprof[0].max_us  = 31.5;
+  m.tprof[1].name    = "mac_nr_rach";
+
+  const char* expected = "{\n"
+                         "  \"type\": \"metrics\",\n"
+                         "  \"timestamp\": 0,\n"
+                         "  \"cell_list\": [\n"
+                         "    {\n"
+                         "      \"cell_container\": {\n"
+                         "        \"carrier_id\": 0,\n"
+                         "        \"pci\": 1,\n"
+                         "        \"nof_rach\": 2,\n"
+                         "        \"ue_list\": [\n"
+                         "        ]\n"
+                         "      }\n"
+                         "    }\n"
+                         "  ],\n"
+                         "  \"tprof_list\": [\n"
+                         "    {\n"
+                         "      \"tprof_container\": {\n"
+                         "        \"name\": \"mac_rach\",\n"
+                         "        \"count\": 10,\n"
+                         "        \"mean\": 12.5,\n"
+                         "        \"p50\": 11.0,\n"
+                         "        \"p90\": 20.25,\n"
+                         "        \"p99\": 31.0,\n"
+                         "        \"max\": 31.5\n"
+                         "      }\n"
+                         "    },\n"
+                         "    {\n"
+                         "      \"tprof_container\": {\n"
+                         "        \"name\": \"mac_nr_rach\",\n"
+                         "        \"count\": 0,\n"
+                         "        \"mean\": 0.0,\n"
+                         "        \"p50\": 0.0,\n"
+                         "        \"p90\": 0.0,\n"
+                         "        \"p99\": 0.0,\n"
+                         "        \"max\": 0.0\n"
+                         "      }\n"
+                         "    }\n"
+                         "  ],\n"
+                         "  \"thread_list\": [\n"
+                         "  ]\n"
+                         "}\n";
+
+  TESTASSERT(check_report(write_report(m), expected));
+  return SRSRAN_SUCCESS;
+}
+
+/// The MAC RACH profilers are enabled in every build, so the report always lists them
+int test_mac_tprof_list()
+{
+  mac_rach_tprof.start().stop();
+
+  enb_metrics_t m = {};
+  m.stack.mac.cc_info.resize(1);
+  m.tprof = srsran::get_tprof_metrics();
+
+  uint32_t nof_rach_tprof = 0;
+  for (const srsran::tprof_metrics_t& prof : m.tprof) {
+    if (prof.name == "mac_rach") {
+      TESTASSERT(prof.count == 1);
+      nof_rach_tprof++;
+    } else if (prof.name == "mac_nr_rach") {
+      TESTASSERT(prof.count == 0);
+      nof_rach_tprof++;
+    }
+  }
+  TESTASSERT(nof_rach_tprof == 2);
+
+  std::string report = write_report(m);
+  TESTASSERT(report.find("\"name\": \"mac_rach\",\n        \"count\": 1,") != std::string::npos);
+  TESTASSERT(report.find("\"name\": \"mac_nr_rach\",\n        \"count\": 0,") != std::string::npos);
+  return SRSRAN_SUCCESS;
+}
+
+int test_full_report()
+{
+  enb_metrics_t m = {};
+  m.stack.mac.cc_info.resize(2);
+  m.stack.mac.cc_info[0].pci             = 1;
+  m.stack.mac.cc_info[0].cc_rach_counter = 3;
+  m.stack.mac.cc_info[1].pci             = 2;
+  m.stack.mac.cc_info[1].cc_rach_counter = 0;
+
+  // The first and last UEs are in the second cell, the UE in the first cell has no PHY measurements.
+  m.stack.rrc.ues.resize(3);
+  m.stack.mac.ues.resize(3);
+  m.stack.rlc.ues.resize(3);
+  m.stack.pdcp.ues.resize(3);
+  m.phy.resize(3);
+
+  mac_ue_metrics_t& mac0 = m.stack.mac.ues[0];
+  mac0.rnti              = 0x46;
+  mac0.cc_idx            = 1;
+  mac0.nof_tti           = 1000;
+  mac0.tx_brate          = 2000000;
+  mac0.tx_pkts           = 100;
+  mac0.tx_errors         = 5;
+  mac0.rx_brate          = 500000;
+  mac0.rx_pkts           = 50;
+  mac0.rx_errors         = 1;
+  mac0.ul_buffer         = 1200;
+  mac0.dl_cqi            = 12.5;
+  mac0.phr               = 20;
+  mac0.dl_cqi_offset     = -0.5;
+  mac0.ul_snr_offset     = 1.5;
+  phy_metrics_t& phy0    = m.phy[0];
+  phy0.dl.mcs            = 27;
+  phy0.dl.pucch_tpc      = 1;
+  phy0.ul.mcs            = 20.5;
+  phy0.ul.pusch_sinr     = 25.25;
+  phy0.ul.pusch_rssi     = -60;
+  phy0.ul.pucch_rssi     = -62.5;
+  phy0.ul.pucch_ni       = -110;
+  phy0.ul.pusch_tpc      = -1;
+
+  m.stack.rrc.ues[0].drb_qci_map = {{3, 9}, {4, 7}};
+
+  srsran::pdcp_bearer_metrics_t& pdcp3 = m.stack.pdcp.ues[0].bearer[3];
+  pdcp3.num_tx_acked_bytes             = 123456789012;
+  pdcp3.num_rx_pdu_bytes               = 4096;
+  pdcp3.tx_notification_latency_ms     = 1500;
+  pdcp3.num_tx_buffered_pdus_bytes     = 300;
+
+  srsran::rlc_bearer_metrics_t& rlc3 = m.stack.rlc.ues[0].bearer[3];
+  rlc3.rx_latency_ms                 = 250;
+  rlc3.rx_buffered_bytes             = 64;
+
+  mac_ue_metrics_t& mac1 = m.stack.mac.ues[1];
+  mac1.rnti              = 0x47;
+  mac1.cc_idx            = 0;
+  mac1.dl_cqi            = 0;
+  mac1.dl_cqi_offset     = NAN;
+  mac1.ul_snr_offset     = NAN;
+  phy_metrics_t& phy1    = m.phy[1];
+  phy1.dl.mcs            = NAN;
+  phy1.ul.mcs            = NAN;
+  phy1.ul.pusch_sinr     = NAN;
+  phy1.ul.pusch_rssi     = NAN;
+  phy1.ul.pucch_rssi     = NAN;
+  phy1.ul.pucch_ni       = NAN;
+
+  // Bearers with an ID out of range are reported without metrics.
+  m.stack.mac.ues[2].rnti        = 0x48;
+  m.stack.mac.ues[2].cc_idx      = 1;
+  m.stack.rrc.ues[2].drb_qci_map = {{40, 8}};
+
+  m.tprof.resize(1);
+  m.tprof[0].name    = "mac_rach";
+  m.tprof[0].count   = 4;
+  m.tprof[0].mean_us = 2.5;
+  m.tprof[0].p50_us  = 2;
+  m.tprof[0].p90_us  = 3;
+  m.tprof[0].p99_us  = 4;
+  m.tprof[0].max_us  = 4.5;
+
+  m.sys.nof_thread_metrics = 2;
+  std::strcpy(m.sys.thread_metrics[0].name.data(), "WORKER0");
+  m.sys.thread_metrics[0].cpu_usage = 45.5;
+  std::strcpy(m.sys.thread_metrics[1].name.data(), "STACK");
+  m.sys.thread_metrics[1].cpu_usage = 3.25;
+
+  const char* expected = "{\n"
+                         "  \"type\": \"metrics\",\n"
+                         "  \"timestamp\": 0,\n"
+                         "  \"cell_list\": [\n"
+                         "    {\n"
+                         "      \"cell_container\": {\n"
+                         "        \"carrier_id\": 0,\n"
+                         "        \"pci\": 1,\n"
+                         "        \"nof_rach\": 3,\n"
+                         "        \"ue_list\": [\n"
+                         "          {\n"
+                         "            \"ue_container\": {\n"
+                         "              \"ue_rnti\": 71,\n"
+                         "              \"dl_cqi\": 0.1,\n"
+                         "              \"dl_mcs\": 0.0,\n"
+                         "              \"ul_pusch_rssi\": 0.0,\n"
+                         "              \"ul_pucch_rssi\": 0.0,\n"
+                         "              \"ul_pucch_ni\": 0.0,\n"
+                         "              \"ul_pusch_tpc\": 0,\n"
+                         "              \"ul_pucch_tpc\": 0,\n"
+                         "              \"dl_cqi_offset\": 0.0,\n"
+                         "              \"ul_snr_offset\": 0.0,\n"
+                         "              \"dl_bitrate\": 0.0,\n"
+                         "              \"dl_bler\": 0.0,\n"
+                         "              \"ul_snr\": 0.0,\n"
+                         "              \"ul_mcs\": 0.0,\n"
+                         "              \"ul_bitrate\": 0.0,\n"
+                         "              \"ul_bler\": 0.0,\n"
+                         "              \"ul_phr\": 0.0,\n"
+                         "              \"ul_bsr\": 0,\n"
+                         "              \"bearer_list\": [\n"
+                         "              ]\n"
+                         "            }\n"
+                         "          }\n"
+                         "        ]\n"
+                         "      }\n"
+                         "    },\n"
+                         "    {\n"
+                         "      \"cell_container\": {\n"
+                         "        \"carrier_id\": 1,\n"
+                         "        \"pci\": 2,\n"
+                         "        \"nof_rach\": 0,\n"
+                         "        \"ue_list\": [\n"
+                         "          {\n"
+                         "            \"ue_container\": {\n"
+                         "              \"ue_rnti\": 70,\n"
+                         "              \"dl_cqi\": 12.5,\n"
+                         "              \"dl_mcs\": 27.0,\n"
+                         "              \"ul_pusch_rssi\": -60.0,\n"
+                         "              \"ul_pucch_rssi\": -62.5,\n"
+                         "              \"ul_pucch_ni\": -110.0,\n"
+                         "              \"ul_pusch_tpc\": -1,\n"
+                         "              \"ul_pucch_tpc\": 1,\n"
+                         "              \"dl_cqi_offset\": -0.5,\n"
+                         "              \"ul_snr_offset\": 1.5,\n"
+                         "              \"dl_bitrate\": 2000000.0,\n"
+                         "              \"dl_bler\": 5.0,\n"
+                         "              \"ul_snr\": 25.25,\n"
+                         "              \"ul_mcs\": 20.5,\n"
+                         "              \"ul_bitrate\": 500000.0,\n"
+                         "              \"ul_bler\": 2.0,\n"
+                         "              \"ul_phr\": 20.0,\n"
+                         "              \"ul_bsr\": 1200,\n"
+                         "              \"bearer_list\": [\n"
+                         "                {\n"
+                         "                  \"bearer_container\": {\n"
+                         "                    \"bearer_id\": 3,\n"
+                         "                    \"qci\": 9,\n"
+                         "                    \"dl_total_bytes\": 123456789012,\n"
+                         "                    \"ul_total_bytes\": 4096,\n"
+                         "                    \"dl_latency\": 1.5,\n"
+                         "                    \"ul_latency\": 0.25,\n"
+                         "                    \"dl_buffered_bytes\": 300,\n"
+                         "                    \"ul_buffered_bytes\": 64\n"
+                         "                  }\n"
+                         "                },\n"
+                         "                {\n"
+                         "                  \"bearer_container\": {\n"
+                         "                    \"bearer_id\": 4,\n"
+                         "                    \"qci\": 7,\n"
+                         "                    \"dl_total_bytes\": 0,\n"
+                         "                    \"ul_total_bytes\": 0,\n"
+                         "                    \"dl_latency\": 0.0,\n"
+                         "                    \"ul_latency\": 0.0,\n"
+                         "                    \"dl_buffered_bytes\": 0,\n"
+                         "                    \"ul_buffered_bytes\": 0\n"
+                         "                  }\n"
+                         "                }\n"
+                         "              ]\n"
+                         "            }\n"
+                         "          },\n"
+                         "          {\n"
+                         "            \"ue_container\": {\n"
+                         "              \"ue_rnti\": 72,\n"
+                         "              \"dl_cqi\": 0.1,\n"
+                         "              \"dl_mcs\": 0.0,\n"
+                         "              \"ul_pusch_rssi\": 0.0,\n"
+                         "              \"ul_pucch_rssi\": 0.0,\n"
+                         "              \"ul_pucch_ni\": 0.0,\n"
+                         "              \"ul_pusch_tpc\": 0,\n"
+                         "              \"ul_pucch_tpc\": 0,\n"
+                         "              \"dl_cqi_offset\": 0.0,\n"
+                         "              \"ul_snr_offset\": 0.0,\n"
+                         "              \"dl_bitrate\": 0.0,\n"
+                         "              \"dl_bler\": 0.0,\n"
+                         "              \"ul_snr\": 0.0,\n"
+                         "              \"ul_mcs\": 0.0,\n"
+                         "              \"ul_bitrate\": 0.0,\n"
+                         "              \"ul_bler\": 0.0,\n"
+                         "              \"ul_phr\": 0.0,\n"
+                         "              \"ul_bsr\": 0,\n"
+                         "              \"bearer_list\": [\n"
+                         "                {\n"
+                         "                  \"bearer_container\": {\n"
+                         "                    \"bearer_id\": 40,\n"
+                         "                    \"qci\": 8,\n"
+                         "                    \"dl_total_bytes\": 0,\n"
+                         "                    \"ul_total_bytes\": 0,\n"
+                         "                    \"dl_latency\": 0.0,\n"
+                         "                    \"ul_latency\": 0.0,\n"
+                         "                    \"dl_buffered_bytes\": 0,\n"
+                         "                    \"ul_buffered_bytes\": 0\n"
+                         "                  }\n"
+                         "                }\n"
+                         "              ]\n"
+                         "            }\n"
+                         "          }\n"
+                         "        ]\n"
+                         "      }\n"
+                         "    }\n"
+                         "  ],\n"
+                         "  \"tprof_list\": [\n"
+                         "    {\n"
+                         "      \"tprof_container\": {\n"
+                         "        \"name\": \"mac_rach\",\n"
+                         "        \"count\": 4,\n"
+                         "        \"mean\": 2.5,\n"
+                         "        \"p50\": 2.0,\n"
+                         "        \"p90\": 3.0,\n"
+                         "        \"p99\": 4.0,\n"
+                         "        \"max\": 4.5\n"
+                         "      }\n"
+                         "    }\n"
+                         "  ],\n"
+                         "  \"thread_list\": [\n"
+                         "    {\n"
+                         "      \"thread_container\": {\n"
+                         "        \"thread_name\": \"WORKER0\",\n"
+                         "        \"thread_cpu_usage\": 45.5\n"
+                         "      }\n"
+                         "    },\n"
+                         "    {\n"
+                         "      \"thread_container\": {\n"
+                         "        \"thread_name\": \"STACK\",\n"
+                         "        \"thread_cpu_usage\": 3.25\n"
+                         "      }\n"
+                         "    }\n"
+                         "  ]\n"
+                         "}\n";
+
+  TESTASSERT(check_report(write_report(m), expected));
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_tprof_list() == SRSRAN_SUCCESS);
+  TESTASSERT(test_mac_tprof_list() == SRSRAN_SUCCESS);
+  TESTASSERT(test_full_report() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
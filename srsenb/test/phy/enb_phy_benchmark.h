@@ -0,0 +1,800 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_ENB_PHY_BENCHMARK_H
+#define SRSENB_ENB_PHY_BENCHMARK_H
+
+#include "srsenb/hdr/phy/phy.h"
+#include "srsran/common/string_helpers.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/srslog/srslog.h"
+#include "srsran/srsran.h"
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Free running radio for the eNb PHY benchmark. Every received subframe is a pre-generated noise buffer, so the eNb
+ * receiver runs its decoders to the maximum number of iterations; transmitted subframes are dropped. It measures the
+ * latency between the reception and the transmission of every TTI.
+ */
+class bench_radio final : public srsran::radio_interface_phy
+{
+private:
+  using clock_t = std::chrono::steady_clock;
+
+  static const uint32_t fifo_sz = 64; ///< Maximum number of TTI in flight
+
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  std::vector<cf_t*>      noise;
+  uint32_t                sf_len      = 0;
+  srsran::rf_timestamp_t  ts_rx       = {};
+  double                  rx_srate    = 0.0;
+  std::atomic<bool>       running     = {true};
+  uint32_t                nof_warmup  = 0;
+  uint32_t                nof_measure = 0;
+  uint32_t                nof_tx      = 0;
+  uint32_t                fifo_r      = 0;
+  uint32_t                fifo_w      = 0;
+
+  std::array<clock_t::time_point, fifo_sz> fifo = {};
+  clock_t::time_point                      t_start;
+  clock_t::time_point                      t_end;
+  std::vector<double>                      latency_us;
+
+public:
+  bench_radio(uint32_t nof_channels, uint32_t nof_prb, uint32_t nof_warmup_, uint32_t nof_measure_) :
+    sf_len(SRSRAN_SF_LEN_PRB(nof_prb)), nof_warmup(std::max(nof_warmup_, 1U)), nof_measure(nof_measure_)
+  {
+    srsran_random_t random_gen = srsran_random_init(0x1234);
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      cf_t* buffer = srsran_vec_cf_malloc(sf_len);
+      if (buffer == nullptr) {
+        ERROR("Allocating noise buffer");
+        continue;
+      }
+      srsran_random_uniform_complex_dist_vector(random_gen, buffer, sf_len, -0.1f, +0.1f);
+      noise.push_back(buffer);
+    }
+    srsran_random_free(random_gen);
+    latency_us.reserve(nof_measure);
+  }
+
+  ~bench_radio()
+  {
+    for (cf_t* buffer : noise) {
+      free(buffer);
+    }
+  }
+
+  void stop() { running = false; }
+
+  /// Waits until all the measured TTI have been transmitted, returns false if it times out
+  bool wait_completion(uint32_t timeout_ms)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    return cvar.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]() {
+      return nof_tx >= nof_warmup + nof_measure;
+    });
+  }
+
+  /// Number of TTI processed per second, measured from the end of the warm-up to the last measured transmission
+  double get_tti_rate() const
+  {
+    double elapsed_s = std::chrono::duration<double>(t_end - t_start).count();
+    return std::isnormal(elapsed_s) ? (double)latency_us.size() / elapsed_s : 0.0;
+  }
+
+  const std::vector<double>& get_latency_us() const { return latency_us; }
+
+  bool tx(srsran::rf_buffer_interface& buffer, const srsran::rf_timestamp_interface& tx_time) override
+  {
+    clock_t::time_point now = clock_t::now();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Workers transmit in order, so the oldest received TTI is the one being transmitted
+    if (fifo_r == fifo_w) {
+      return true;
+    }
+    clock_t::time_point t_rx = fifo[fifo_r % fifo_sz];
+    fifo_r++;
+
+    // The rate interval starts with the last warm-up transmission, every measured TTI gives a latency sample
+    if (nof_tx + 1 == nof_warmup) {
+      t_start = now;
+    } else if (nof_tx >= nof_warmup and nof_tx < nof_warmup + nof_measure) {
+      latency_us.push_back(std::chrono::duration<double, std::micro>(now - t_rx).count());
+      t_end = now;
+    }
+    nof_tx++;
+
+    if (nof_tx >= nof_warmup + nof_measure) {
+      cvar.notify_all();
+    }
+
+    return true;
+  }
+  void tx_end() override {}
+  bool rx_now(srsran::rf_buffer_interface& buffer, srsran::rf_timestamp_interface& rxd_time) override
+  {
+    for (uint32_t i = 0; i < buffer.size(); i++) {
+      if (buffer.get(i) == nullptr) {
+        continue;
+      }
+      if (running and i < noise.size()) {
+        srsran_vec_cf_copy(buffer.get(i), noise[i], buffer.get_nof_samples());
+      } else {
+        srsran_vec_cf_zero(buffer.get(i), buffer.get_nof_samples());
+      }
+    }
+
+    rxd_time = ts_rx;
+    if (std::isnormal(rx_srate)) {
+      ts_rx.add(static_cast<double>(buffer.get_nof_samples()) / rx_srate);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (fifo_w - fifo_r < fifo_sz) {
+      fifo[fifo_w % fifo_sz] = clock_t::now();
+      fifo_w++;
+    }
+
+    return true;
+  }
+  void              release_freq(const uint32_t& carrier_idx) override{};
+  void              set_tx_freq(const uint32_t& channel_idx, const double& freq) override {}
+  void              set_rx_freq(const uint32_t& channel_idx, const double& freq) override {}
+  void              set_rx_gain_th(const float& gain) override {}
+  void              set_rx_gain(const float& gain) override {}
+  void              set_tx_srate(const double& srate) override {}
+  void              set_rx_srate(const double& srate) override { rx_srate = srate; }
+  void              set_channel_rx_offset(uint32_t ch, int32_t offset_samples) override{};
+  void              set_tx_gain(const float& gain) override {}
+  float             get_rx_gain() override { return 0; }
+  double            get_freq_offset() override { return 0; }
+  bool              is_continuous_tx() override { return false; }
+  bool              get_is_start_of_burst() override { return false; }
+  bool              is_init() override { return false; }
+  void              reset() override {}
+  srsran_rf_info_t* get_info() override { return nullptr; }
+};
+
+/**
+ * Round robin stack for the eNb PHY benchmark. Every TTI, it schedules a fixed number of UEs in DL and UL splitting the
+ * bandwidth evenly between them. It counts the PHY feedback without asserting it.
+ */
+class bench_stack final : public srsenb::stack_interface_phy_lte
+{
+public:
+  struct args_t {
+    uint32_t    nof_ues   = 0; ///< Number of configured UEs
+    uint16_t    rnti      = 0; ///< First UE RNTI, the rest are consecutive
+    uint32_t    dl_ues    = 0; ///< Number of UEs scheduled in DL every TTI
+    uint32_t    ul_ues    = 0; ///< Number of UEs scheduled in UL every TTI
+    uint32_t    dl_mcs    = 0; ///< DL MCS
+    uint32_t    ul_mcs    = 0; ///< UL MCS
+    srsran_tm_t tm        = SRSRAN_TM1;
+    uint32_t    nof_cells = 1; ///< Number of eNb cells, UEs are distributed across them
+  };
+
+  struct counters_t {
+    uint32_t nof_dl_tti = 0; ///< Number of scheduled DL TTI
+    uint32_t nof_ul_tti = 0; ///< Number of scheduled UL TTI
+    uint32_t dl_grants  = 0; ///< Number of PDSCH grants
+    uint32_t ul_grants  = 0; ///< Number of PUSCH grants
+  };
+
+private:
+  static const uint32_t cfi        = 3;
+  static const uint32_t pool_depth = 16; ///< Grant buffers are reused every pool_depth TTI, divides 10240
+
+  struct ue_t {
+    uint16_t              rnti                                                           = 0;
+    uint32_t              cc_idx                                                         = 0;
+    uint32_t              nof_locations[SRSRAN_NOF_SF_X_FRAME]                           = {};
+    srsran_dci_location_t dci_locations[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_CANDIDATES_UE] = {};
+  };
+
+  struct cce_map_t {
+    uint32_t         tti = UINT32_MAX;
+    std::bitset<128> used;
+  };
+
+  args_t                                           args;
+  uint32_t                                         nof_prb = 0;
+  std::mutex                                       mutex;
+  std::vector<ue_t>                                ues;
+  std::vector<uint32_t>                            dl_rr;
+  std::vector<uint32_t>                            ul_rr;
+  std::vector<std::array<cce_map_t, pool_depth> >  cce_maps;
+  std::vector<srsran_softbuffer_tx_t>              softbuffer_tx;
+  std::vector<srsran_softbuffer_rx_t>              softbuffer_rx;
+  std::vector<uint8_t*>                            data_ul;
+  uint8_t*                                         data_dl = nullptr;
+  counters_t                                       counters;
+  bool                                             running = true;
+
+  /// Finds a free PDCCH location for a UE, it returns false if all its candidates are in use
+  bool alloc_pdcch(uint32_t cc_idx, uint32_t tti_pdcch, const ue_t& ue, srsran_dci_location_t& location)
+  {
+    cce_map_t& map = cce_maps[cc_idx][tti_pdcch % pool_depth];
+    if (map.tti != tti_pdcch) {
+      map.tti = tti_pdcch;
+      map.used.reset();
+    }
+
+    uint32_t sf_idx = tti_pdcch % SRSRAN_NOF_SF_X_FRAME;
+    for (uint32_t i = 0; i < ue.nof_locations[sf_idx]; i++) {
+      uint32_t ncce = ue.dci_locations[sf_idx][i].ncce;
+      if (ncce < map.used.size() and not map.used.test(ncce)) {
+        map.used.set(ncce);
+        location = ue.dci_locations[sf_idx][i];
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  uint32_t pool_idx(uint32_t tti, uint32_t grant_idx, uint32_t nof_grants) const
+  {
+    return (tti % pool_depth) * nof_grants + grant_idx;
+  }
+
+public:
+  bench_stack(const args_t& args_, const srsenb::phy_cell_cfg_list_t& cell_list) :
+    args(args_), nof_prb(cell_list[0].cell.nof_prb)
+  {
+    // Compute the PDCCH candidates of every UE, it only takes aggregation level 1 candidates
+    srsran_pdcch_t pdcch = {};
+    srsran_regs_t  regs  = {};
+    srsran_regs_init(&regs, cell_list[0].cell);
+    srsran_pdcch_init_enb(&pdcch, cell_list[0].cell.nof_prb);
+    srsran_pdcch_set_cell(&pdcch, &regs, cell_list[0].cell);
+    ues.resize(args.nof_ues);
+    for (uint32_t i = 0; i < args.nof_ues; i++) {
+      ue_t& ue  = ues[i];
+      ue.rnti   = args.rnti + i;
+      ue.cc_idx = i % args.nof_cells;
+      for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+        srsran_dl_sf_cfg_t sf_cfg_dl = {};
+        sf_cfg_dl.tti                = sf_idx;
+        sf_cfg_dl.cfi                = cfi;
+        sf_cfg_dl.sf_type            = SRSRAN_SF_NORM;
+
+        srsran_dci_location_t locations[SRSRAN_MAX_CANDIDATES_UE] = {};
+        uint32_t              nof_locations =
+            srsran_pdcch_ue_locations(&pdcch, &sf_cfg_dl, locations, SRSRAN_MAX_CANDIDATES_UE, ue.rnti);
+        for (uint32_t j = 0; j < nof_locations; j++) {
+          if (locations[j].L == 0) {
+            ue.dci_locations[sf_idx][ue.nof_locations[sf_idx]++] = locations[j];
+          }
+        }
+      }
+    }
+    srsran_pdcch_free(&pdcch);
+    srsran_regs_free(&regs);
+
+    dl_rr.resize(args.nof_cells, 0);
+    ul_rr.resize(args.nof_cells, 0);
+    cce_maps.resize(args.nof_cells);
+
+    // Every grant in flight has its own buffers, so concurrent workers never share them
+    softbuffer_tx.resize(pool_depth * args.dl_ues * args.nof_cells);
+    for (srsran_softbuffer_tx_t& sb : softbuffer_tx) {
+      srsran_softbuffer_tx_init(&sb, nof_prb);
+    }
+    softbuffer_rx.resize(pool_depth * args.ul_ues * args.nof_cells);
+    for (srsran_softbuffer_rx_t& sb : softbuffer_rx) {
+      srsran_softbuffer_rx_init(&sb, nof_prb);
+    }
+    data_ul.resize(pool_depth * args.ul_ues * args.nof_cells);
+    for (uint8_t*& data : data_ul) {
+      data = srsran_vec_u8_malloc(SRSENB_MAX_BUFFER_SIZE_BYTES);
+    }
+    data_dl = srsran_vec_u8_malloc(SRSENB_MAX_BUFFER_SIZE_BYTES);
+    for (uint32_t i = 0; i < SRSENB_MAX_BUFFER_SIZE_BYTES; i++) {
+      data_dl[i] = static_cast<uint8_t>(((i + 257) * (i + 373)) % 255);
+    }
+  }
+
+  ~bench_stack()
+  {
+    for (srsran_softbuffer_tx_t& sb : softbuffer_tx) {
+      srsran_softbuffer_tx_free(&sb);
+    }
+    for (srsran_softbuffer_rx_t& sb : softbuffer_rx) {
+      srsran_softbuffer_rx_free(&sb);
+    }
+    for (uint8_t* data : data_ul) {
+      free(data);
+    }
+    free(data_dl);
+  }
+
+  /// Stops scheduling, the eNb PHY keeps running until it is stopped
+  void stop()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    running = false;
+  }
+
+  counters_t get_counters()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+  }
+
+  int  sr_detected(uint32_t tti, uint16_t rnti) override { return SRSRAN_SUCCESS; }
+  void rach_detected(uint32_t tti, uint32_t primary_cc_idx, uint32_t preamble_idx, uint32_t time_adv) override {}
+  int ri_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t ri_value) override { return SRSRAN_SUCCESS; }
+  int pmi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t pmi_value) override { return SRSRAN_SUCCESS; }
+  int cqi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t cqi_value) override { return SRSRAN_SUCCESS; }
+  int sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t sb_idx, uint32_t cqi_value) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int snr_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, float snr_db, ul_channel_t ch) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override { return SRSRAN_SUCCESS; }
+  int ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int push_pdu(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res, uint32_t grant_nof_prbs)
+      override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int get_dl_sched(uint32_t tti, dl_sched_list_t& dl_sched_res) override
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint32_t nof_rbg = SRSRAN_CEIL(nof_prb, srsran_ra_type0_P(nof_prb));
+    for (uint32_t cc_idx = 0; cc_idx < dl_sched_res.size(); cc_idx++) {
+      dl_sched_t& dl_sched = dl_sched_res[cc_idx];
+      dl_sched.cfi         = cfi;
+      dl_sched.nof_grants  = 0;
+      if (not running) {
+        continue;
+      }
+      counters.nof_dl_tti++;
+
+      // Split the RBG evenly between the scheduled UEs
+      uint32_t nof_grants = SRSRAN_MIN(SRSRAN_MIN(args.dl_ues, nof_rbg), args.nof_ues);
+      uint32_t rbg_per_ue = (nof_grants > 0) ? nof_rbg / nof_grants : 0;
+      for (uint32_t n = 0; n < args.nof_ues and dl_sched.nof_grants < nof_grants; n++) {
+        const ue_t& ue = ues[(dl_rr[cc_idx] + n) % args.nof_ues];
+        if (ue.cc_idx != cc_idx) {
+          continue;
+        }
+
+        srsran_dci_location_t location = {};
+        if (not alloc_pdcch(cc_idx, tti, ue, location)) {
+          continue;
+        }
+
+        uint32_t rbg_start = dl_sched.nof_grants * rbg_per_ue;
+        uint32_t rbg_end   = (dl_sched.nof_grants + 1 == nof_grants) ? nof_rbg : rbg_start + rbg_per_ue;
+        uint32_t bitmask   = 0;
+        for (uint32_t rbg = rbg_start; rbg < rbg_end; rbg++) {
+          bitmask |= 1U << (nof_rbg - rbg - 1);
+        }
+
+        uint32_t idx = pool_idx(tti, dl_sched.nof_grants, args.dl_ues * args.nof_cells) + cc_idx * args.dl_ues;
+        srsran_softbuffer_tx_t* sb = &softbuffer_tx[idx];
+        srsran_softbuffer_tx_reset(sb);
+
+        dl_sched_grant_t& grant           = dl_sched.pdsch[dl_sched.nof_grants];
+        grant                             = {};
+        grant.softbuffer_tx[0]            = sb;
+        grant.softbuffer_tx[1]            = sb;
+        grant.data[0]                     = data_dl;
+        grant.data[1]                     = data_dl;
+        grant.dci.location                = location;
+        grant.dci.rnti                    = ue.rnti;
+        grant.dci.alloc_type              = SRSRAN_RA_ALLOC_TYPE0;
+        grant.dci.type0_alloc.rbg_bitmask = bitmask;
+        grant.dci.tpc_pucch               = location.ncce % SRSRAN_PUCCH_SIZE_AN_CS;
+
+        switch (args.tm) {
+          default:
+          case SRSRAN_TM1:
+          case SRSRAN_TM2:
+            grant.dci.format = SRSRAN_DCI_FORMAT1;
+            break;
+          case SRSRAN_TM3:
+            grant.dci.format = SRSRAN_DCI_FORMAT2A;
+            break;
+          case SRSRAN_TM4:
+            grant.dci.format = SRSRAN_DCI_FORMAT2;
+            break;
+        }
+
+        // Transmission modes 3 and 4 carry two transport blocks
+        bool two_tb = (args.tm == SRSRAN_TM3 or args.tm == SRSRAN_TM4);
+        for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+          bool enabled             = (tb == 0) or two_tb;
+          grant.dci.tb[tb].cw_idx  = enabled ? tb : 0;
+          grant.dci.tb[tb].mcs_idx = enabled ? args.dl_mcs : 0;
+          grant.dci.tb[tb].rv      = enabled ? 0 : 1;
+          grant.dci.tb[tb].ndi     = false;
+        }
+
+        dl_sched.nof_grants++;
+        counters.dl_grants++;
+      }
+      dl_rr[cc_idx] = (dl_rr[cc_idx] + dl_sched.nof_grants) % SRSRAN_MAX(args.nof_ues, 1);
+    }
+
+    return SRSRAN_SUCCESS;
+  }
+  int get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res) override { return SRSRAN_SUCCESS; }
+  int get_ul_sched(uint32_t tti, ul_sched_list_t& ul_sched_res) override
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // PUSCH avoids the PUCCH at the band edges
+    uint32_t nof_pusch_prb = (nof_prb > 2) ? nof_prb - 2 : 0;
+    uint32_t tti_pdcch     = TTI_SUB(tti, FDD_HARQ_DELAY_DL_MS);
+    for (uint32_t cc_idx = 0; cc_idx < ul_sched_res.size(); cc_idx++) {
+      ul_sched_t& ul_sched = ul_sched_res[cc_idx];
+      ul_sched.nof_grants  = 0;
+      ul_sched.nof_phich   = 0;
+      if (not running) {
+        continue;
+      }
+      counters.nof_ul_tti++;
+
+      uint32_t nof_grants = SRSRAN_MIN(SRSRAN_MIN(args.ul_ues, nof_pusch_prb), args.nof_ues);
+      uint32_t prb_per_ue = (nof_grants > 0) ? nof_pusch_prb / nof_grants : 0;
+      while (prb_per_ue > 0 and not srsran_dft_precoding_valid_prb(prb_per_ue)) {
+        prb_per_ue--;
+      }
+
+      for (uint32_t n = 0; n < args.nof_ues and ul_sched.nof_grants < nof_grants and prb_per_ue > 0; n++) {
+        const ue_t& ue = ues[(ul_rr[cc_idx] + n) % args.nof_ues];
+        if (ue.cc_idx != cc_idx) {
+          continue;
+        }
+
+        srsran_dci_location_t location = {};
+        if (not alloc_pdcch(cc_idx, tti_pdcch, ue, location)) {
+          continue;
+        }
+
+        uint32_t idx = pool_idx(tti, ul_sched.nof_grants, args.ul_ues * args.nof_cells) + cc_idx * args.ul_ues;
+        uint32_t          prb_start   = 1 + ul_sched.nof_grants * prb_per_ue;
+        ul_sched_grant_t& grant       = ul_sched.pusch[ul_sched.nof_grants];
+        grant                         = {};
+        grant.dci.rnti                = ue.rnti;
+        grant.dci.format              = SRSRAN_DCI_FORMAT0;
+        grant.dci.location            = location;
+        grant.dci.type2_alloc.riv     = srsran_ra_type2_to_riv(prb_per_ue, prb_start, nof_prb);
+        grant.dci.type2_alloc.n_prb1a = srsran_ra_type2_t::SRSRAN_RA_TYPE2_NPRB1A_2;
+        grant.dci.type2_alloc.n_gap   = srsran_ra_type2_t::SRSRAN_RA_TYPE2_NG1;
+        grant.dci.type2_alloc.mode    = srsran_ra_type2_t::SRSRAN_RA_TYPE2_LOC;
+        grant.dci.freq_hop_fl         = srsran_dci_ul_t::SRSRAN_RA_PUSCH_HOP_DISABLED;
+        grant.dci.tb.mcs_idx          = args.ul_mcs;
+        grant.dci.tb.rv               = 0;
+        grant.dci.tb.ndi              = false;
+        grant.dci.tb.cw_idx           = 0;
+        grant.dci.n_dmrs              = 0;
+        grant.dci.cqi_request         = false;
+        grant.data                    = data_ul[idx];
+        grant.needs_pdcch             = true;
+        grant.softbuffer_rx           = &softbuffer_rx[idx];
+        srsran_softbuffer_rx_reset(grant.softbuffer_rx);
+
+        ul_sched.nof_grants++;
+        counters.ul_grants++;
+      }
+      ul_rr[cc_idx] = (ul_rr[cc_idx] + ul_sched.nof_grants) % SRSRAN_MAX(args.nof_ues, 1);
+    }
+
+    return SRSRAN_SUCCESS;
+  }
+  void set_sched_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs) override {}
+};
+
+/**
+ * eNb PHY load benchmark. For every bandwidth and number of antennas, it runs the complete eNb PHY (workers, PRACH
+ * detector and TTI pipeline) against the free running radio and the round robin stack, and reports the achievable TTI
+ * rate per worker thread and the TTI processing latency.
+ */
+class enb_phy_benchmark : public srsenb::enb_time_interface
+{
+public:
+  struct args_t {
+    bool        enable        = false; ///< Run the benchmark instead of the test
+    std::string nof_prb       = "";    ///< Comma separated bandwidths in PRB, empty for the test cell
+    std::string nof_ports     = "";    ///< Comma separated number of antennas, empty for the test cell
+    uint32_t    nof_ues       = 16;    ///< Number of configured UEs
+    uint32_t    dl_ues        = 4;     ///< Number of UEs scheduled in DL every TTI
+    uint32_t    ul_ues        = 4;     ///< Number of UEs scheduled in UL every TTI
+    uint32_t    dl_mcs        = 27;    ///< DL MCS
+    uint32_t    ul_mcs        = 20;    ///< UL MCS
+    uint32_t    nof_threads   = 1;     ///< Number of PHY worker threads
+    uint32_t    prach_cfg_idx = 3;     ///< PRACH configuration index, 14 has a PRACH opportunity every subframe
+    uint32_t    max_latency   = 0;     ///< Maximum TTI latency in microseconds, set to zero for not asserting it
+  };
+
+private:
+  args_t                args;
+  srsran_cell_t         base_cell = {};
+  srsran_tm_t           base_tm   = SRSRAN_TM1;
+  uint32_t              nof_cells = 1;
+  uint32_t              duration  = 0;
+  uint16_t              rnti      = 0;
+  std::string           ack_mode  = {};
+  std::string           log_level = {};
+  srslog::basic_logger& logger;
+
+  static double percentile(const std::vector<double>& sorted, double p)
+  {
+    if (sorted.empty()) {
+      return 0.0;
+    }
+    size_t idx = std::min(sorted.size() - 1, (size_t)(p * (double)sorted.size()));
+    return sorted[idx];
+  }
+
+  /// Creates the dedicated configuration of a UE, the periodic PUCCH resources are staggered between UEs
+  srsran::phy_cfg_t make_ue_cfg(uint32_t ue_idx, srsran_tm_t tm) const
+  {
+    const uint32_t    N_pucch_1 = SRSRAN_MAX(12, args.nof_ues);
+    srsran::phy_cfg_t dedicated = {};
+
+    dedicated.dl_cfg.tm                             = tm;
+    dedicated.dl_cfg.cqi_report.periodic_configured = true;
+    dedicated.dl_cfg.cqi_report.pmi_idx             = 17 + ue_idx % 20; // 20 ms period, one offset per UE
+    dedicated.dl_cfg.cqi_report.periodic_mode       = SRSRAN_CQI_MODE_20;
+    if (tm == SRSRAN_TM3 or tm == SRSRAN_TM4) {
+      dedicated.dl_cfg.cqi_report.ri_idx_present = true;
+      dedicated.dl_cfg.cqi_report.ri_idx         = 483;
+    }
+
+    dedicated.ul_cfg.pucch.ack_nack_feedback_mode  = srsran_string_ack_nack_feedback_mode(ack_mode.c_str());
+    dedicated.ul_cfg.pucch.delta_pucch_shift       = 1;
+    dedicated.ul_cfg.pucch.n_rb_2                  = 2;
+    dedicated.ul_cfg.pucch.N_cs                    = 0;
+    dedicated.ul_cfg.pucch.n_pucch_sr              = ue_idx;
+    dedicated.ul_cfg.pucch.N_pucch_1               = N_pucch_1;
+    dedicated.ul_cfg.pucch.n_pucch_2               = ue_idx % (SRSRAN_NRE * dedicated.ul_cfg.pucch.n_rb_2);
+    dedicated.ul_cfg.pucch.simul_cqi_ack           = true;
+    dedicated.ul_cfg.pucch.sr_configured           = true;
+    dedicated.ul_cfg.pucch.I_sr                    = 5 + ue_idx % 10; // 10 ms period, one offset per UE
+    dedicated.ul_cfg.pusch.uci_offset.I_offset_ack = 7;
+    dedicated.ul_cfg.pusch.uci_offset.I_offset_ri  = 7;
+    dedicated.ul_cfg.pusch.uci_offset.I_offset_cqi = 7;
+
+    return dedicated;
+  }
+
+  /// Runs a single benchmark point, returns false if the eNb PHY fails or does not meet the latency requirement
+  bool run_point(const srsran_cell_t& cell, srsran_tm_t tm)
+  {
+    srsenb::phy_args_t phy_args = {};
+    phy_args.log.phy_level      = log_level;
+    phy_args.nof_phy_threads    = args.nof_threads;
+
+    srsenb::phy_cfg_t phy_cfg = {};
+    phy_cfg.phy_cell_cfg.resize(nof_cells);
+    for (uint32_t i = 0; i < nof_cells; i++) {
+      auto& q        = phy_cfg.phy_cell_cfg[i];
+      q.cell         = cell;
+      q.cell.id      = i;
+      q.cell_id      = i;
+      q.dl_freq_hz   = 0.0f;
+      q.ul_freq_hz   = 0.0f;
+      q.root_seq_idx = 25 + i;
+      q.rf_port      = i;
+    }
+    phy_cfg.pucch_cnfg.delta_pucch_shift = asn1::rrc::pucch_cfg_common_s::delta_pucch_shift_e_::ds1;
+
+    phy_cfg.prach_cnfg.root_seq_idx                             = 0;
+    phy_cfg.prach_cnfg.prach_cfg_info.high_speed_flag           = false;
+    phy_cfg.prach_cnfg.prach_cfg_info.prach_cfg_idx             = args.prach_cfg_idx;
+    phy_cfg.prach_cnfg.prach_cfg_info.prach_freq_offset         = 2;
+    phy_cfg.prach_cnfg.prach_cfg_info.zero_correlation_zone_cfg = 5;
+
+    bench_stack::args_t stack_args = {};
+    stack_args.nof_ues             = args.nof_ues;
+    stack_args.rnti                = rnti;
+    stack_args.dl_ues              = args.dl_ues;
+    stack_args.ul_ues              = args.ul_ues;
+    stack_args.dl_mcs              = args.dl_mcs;
+    stack_args.ul_mcs              = args.ul_mcs;
+    stack_args.tm                  = tm;
+    stack_args.nof_cells           = nof_cells;
+
+    // The first TTI fill the pipeline and the UL HARQ, they are not measured
+    uint32_t nof_warmup = 2 * (FDD_HARQ_DELAY_DL_MS + FDD_HARQ_DELAY_UL_MS) + args.nof_threads;
+
+    std::unique_ptr<bench_radio> radio(new bench_radio(nof_cells * cell.nof_ports, cell.nof_prb, nof_warmup, duration));
+    std::unique_ptr<bench_stack> stack(new bench_stack(stack_args, phy_cfg.phy_cell_cfg));
+    std::unique_ptr<srsenb::phy> enb_phy(new srsenb::phy(srslog::get_default_sink()));
+
+    if (enb_phy->init(phy_args, phy_cfg, radio.get(), stack.get(), this) < SRSRAN_SUCCESS) {
+      logger.error("Error initialising eNb PHY");
+      return false;
+    }
+
+    for (uint32_t i = 0; i < args.nof_ues; i++) {
+      srsenb::phy_interface_rrc_lte::phy_rrc_cfg_list_t phy_rrc_cfg(1);
+      phy_rrc_cfg[0].enb_cc_idx = i % nof_cells;
+      phy_rrc_cfg[0].configured = true;
+      phy_rrc_cfg[0].phy_cfg    = make_ue_cfg(i, tm);
+
+      std::array<bool, SRSRAN_MAX_CARRIERS> activation = {};
+      activation[0]                                    = true;
+
+      enb_phy->set_config(rnti + i, phy_rrc_cfg);
+      enb_phy->complete_config(rnti + i);
+      enb_phy->set_activation_deactivation_scell(rnti + i, activation);
+    }
+
+    // Give every TTI up to one second, it shall never take that long
+    bool completed = radio->wait_completion(1000 * (nof_warmup + duration));
+
+    stack->stop();
+    radio->stop();
+    enb_phy->stop();
+
+    std::vector<double> latency = radio->get_latency_us();
+    std::sort(latency.begin(), latency.end());
+    double avg = 0.0;
+    for (double v : latency) {
+      avg += v;
+    }
+    avg = latency.empty() ? 0.0 : avg / (double)latency.size();
+
+    double                  tti_rate = radio->get_tti_rate();
+    bench_stack::counters_t cnt      = stack->get_counters();
+    double                  max_us   = latency.empty() ? 0.0 : latency.back();
+
+    printf("| %3d | %5d | %2d | %3d | %6.1f | %6.1f | %9.1f | %9.1f | %8.1f | %8.1f | %8.1f |\n",
+           cell.nof_prb,
+           cell.nof_ports,
+           tm + 1,
+           args.nof_ues,
+           (double)cnt.dl_grants / (double)SRSRAN_MAX(cnt.nof_dl_tti, 1),
+           (double)cnt.ul_grants / (double)SRSRAN_MAX(cnt.nof_ul_tti, 1),
+           tti_rate,
+           tti_rate / (double)args.nof_threads,
+           avg,
+           percentile(latency, 0.99),
+           max_us);
+
+    if (not completed) {
+      logger.error("The eNb PHY did not process %d TTI in time", nof_warmup + duration);
+      return false;
+    }
+
+    if (args.max_latency > 0 and max_us > (double)args.max_latency) {
+      logger.error("Worst TTI latency %.1f us exceeds %d us", max_us, args.max_latency);
+      return false;
+    }
+
+    return true;
+  }
+
+public:
+  enb_phy_benchmark(const args_t&      args_,
+                    const srsran_cell_t& cell_,
+                    srsran_tm_t        tm_,
+                    uint32_t           nof_cells_,
+                    uint32_t           duration_,
+                    uint16_t           rnti_,
+                    const std::string& ack_mode_,
+                    const std::string& log_level_) :
+    args(args_),
+    base_cell(cell_),
+    base_tm(tm_),
+    nof_cells(nof_cells_),
+    duration(duration_),
+    rnti(rnti_),
+    ack_mode(ack_mode_),
+    log_level(log_level_),
+    logger(srslog::fetch_basic_logger("BENCH", false))
+  {
+    logger.set_level(srslog::str_to_basic_level(log_level));
+  }
+
+  /// Runs every bandwidth and number of antennas combination, returns false if any of them fails
+  bool run()
+  {
+    std::vector<uint32_t> nof_prb_list;
+    std::vector<uint32_t> nof_ports_list;
+    srsran::string_parse_list(args.nof_prb, ',', nof_prb_list);
+    srsran::string_parse_list(args.nof_ports, ',', nof_ports_list);
+    if (nof_prb_list.empty()) {
+      nof_prb_list.push_back(base_cell.nof_prb);
+    }
+    if (nof_ports_list.empty()) {
+      nof_ports_list.push_back(base_cell.nof_ports);
+    }
+
+    if (args.nof_ues == 0 or args.nof_threads == 0) {
+      logger.error("Invalid number of UEs (%d) or threads (%d)", args.nof_ues, args.nof_threads);
+      return false;
+    }
+
+    printf("eNb PHY benchmark: %d TTI per point; %d worker threads; DL %d UE/TTI MCS %d; UL %d UE/TTI MCS %d;\n",
+           duration,
+           args.nof_threads,
+           args.dl_ues,
+           args.dl_mcs,
+           args.ul_ues,
+           args.ul_mcs);
+    printf("+-----+-------+----+-----+--------+--------+-----------+-----------+----------+----------+----------+\n");
+    printf("| PRB | Ports | TM | UEs | DL/TTI | UL/TTI |   TTI/s   | TTI/s/thr |  Avg us  |  P99 us  |  Max us  |\n");
+    printf("+-----+-------+----+-----+--------+--------+-----------+-----------+----------+----------+----------+\n");
+
+    bool ret = true;
+    for (uint32_t nof_prb : nof_prb_list) {
+      for (uint32_t nof_ports : nof_ports_list) {
+        srsran_cell_t cell = base_cell;
+        cell.nof_prb       = nof_prb;
+        cell.nof_ports     = nof_ports;
+        if (not srsran_cell_isvalid(&cell)) {
+          logger.error("Skipping invalid cell nof_prb=%d; nof_ports=%d;", nof_prb, nof_ports);
+          continue;
+        }
+
+        // A single antenna only supports TM1, TM1 only supports a single antenna and spatial multiplexing is only
+        // implemented for two antennas
+        srsran_tm_t tm = base_tm;
+        if (nof_ports == 1) {
+          tm = SRSRAN_TM1;
+        } else if (tm == SRSRAN_TM1 or nof_ports > 2) {
+          tm = SRSRAN_TM2;
+        }
+
+        ret &= run_point(cell, tm);
+      }
+    }
+    printf("+-----+-------+----+-----+--------+--------+-----------+-----------+----------+----------+----------+\n");
+
+    return ret;
+  }
+
+  void tti_clock() final
+  {
+    // nothing to do
+  }
+};
+
+#endif // SRSENB_ENB_PHY_BENCHMARK_H
@@ -23,6 +23,7 @@
 #include "srsran/phy/utils/random.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include "enb_phy_benchmark.h"
 #include <boost/program_options.hpp>
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/parsers.hpp>
@@ -1442,12 +1443,15 @@ typedef std::unique_ptr<phy_test_bench> unique_phy_test_bench;
 
 namespace bpo = boost::program_options;
 
+static enb_phy_benchmark::args_t benchmark_args = {};
+
 int parse_args(int argc, char** argv, phy_test_bench::args_t& args)
 {
   int ret = SRSRAN_SUCCESS;
 
   bpo::options_description options;
   bpo::options_description common("Common execution options");
+  bpo::options_description benchmark("Benchmark options");
 
   // clang-format off
   common.add_options()
@@ -1463,7 +1467,21 @@ int parse_args(int argc, char** argv, phy_test_bench::args_t& args)
       ("tm", bpo::value<uint32_t>(&args.tm_u32)->default_value(args.tm_u32),                             "Transmission mode")
       ("rotation", bpo::value<uint32_t>(&args.period_pcell_rotate),                      "Serving cells rotation period in ms, set to zero to disable")
       ;
-  options.add(common).add_options()("help", "Show this message");
+
+  benchmark.add_options()
+      ("benchmark.enable",        bpo::value<bool>(&benchmark_args.enable)->default_value(benchmark_args.enable),                 "Run the eNb PHY benchmark instead of the test, duration is the number of measured subframes")
+      ("benchmark.nof_prb",       bpo::value<std::string>(&benchmark_args.nof_prb)->default_value(benchmark_args.nof_prb),        "Comma separated list of bandwidths, empty for cell.nof_prb")
+      ("benchmark.nof_ports",     bpo::value<std::string>(&benchmark_args.nof_ports)->default_value(benchmark_args.nof_ports),    "Comma separated list of number of antennas, empty for the test cell ports")
+      ("benchmark.nof_ues",       bpo::value<uint32_t>(&benchmark_args.nof_ues)->default_value(benchmark_args.nof_ues),           "Number of configured UEs")
+      ("benchmark.dl_ues",        bpo::value<uint32_t>(&benchmark_args.dl_ues)->default_value(benchmark_args.dl_ues),             "Number of UEs scheduled in DL every subframe")
+      ("benchmark.ul_ues",        bpo::value<uint32_t>(&benchmark_args.ul_ues)->default_value(benchmark_args.ul_ues),             "Number of UEs scheduled in UL every subframe")
+      ("benchmark.dl_mcs",        bpo::value<uint32_t>(&benchmark_args.dl_mcs)->default_value(benchmark_args.dl_mcs),             "DL MCS")
+      ("benchmark.ul_mcs",        bpo::value<uint32_t>(&benchmark_args.ul_mcs)->default_value(benchmark_args.ul_mcs),             "UL MCS")
+      ("benchmark.nof_threads",   bpo::value<uint32_t>(&benchmark_args.nof_threads)->default_value(benchmark_args.nof_threads),   "Number of PHY worker threads")
+      ("benchmark.prach_cfg_idx", bpo::value<uint32_t>(&benchmark_args.prach_cfg_idx)->default_value(benchmark_args.prach_cfg_idx), "PRACH configuration index")
+      ("benchmark.max_latency",   bpo::value<uint32_t>(&benchmark_args.max_latency)->default_value(benchmark_args.max_latency),   "Maximum subframe latency in microseconds, zero disables the check")
+      ;
+  options.add(common).add(benchmark).add_options()("help", "Show this message");
   // clang-format on
 
   bpo::variables_map vm;
@@ -1509,6 +1527,21 @@ int main(int argc, char** argv)
   // Setup logging.
   srslog::init();
 
+  // Run the benchmark instead of the test
+  if (benchmark_args.enable) {
+    enb_phy_benchmark bench(benchmark_args,
+                            test_args.cell,
+                            test_args.tm,
+                            test_args.nof_enb_cells,
+                            test_args.duration,
+                            test_args.rnti,
+                            test_args.ack_mode,
+                            test_args.log_level);
+    bool              ret = bench.run();
+    srslog::flush();
+    return ret ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+  }
+
   // Create Test Bench
   unique_phy_test_bench test_bench = unique_phy_test_bench(new phy_test_bench(test_args, srslog::get_default_sink()));
   int                   err_code   = test_bench->init();
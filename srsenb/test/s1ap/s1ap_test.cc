@@ -23,9 +23,37 @@
 #include "srsenb/test/common/dummy_classes.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
 
 using namespace srsenb;
 
+namespace srsenb {
+
+class s1ap_test_access
+{
+public:
+  using ue        = s1ap::ue;
+  using user_list = s1ap::user_list;
+
+  // The timers of a user are set from the arguments, which are only filled by init()
+  explicit s1ap_test_access(s1ap& s1ap_) : s1ap_obj(s1ap_) { s1ap_obj.args = {}; }
+
+  user_list& users() { return s1ap_obj.users; }
+
+  std::unique_ptr<ue> make_user(uint16_t rnti)
+  {
+    std::unique_ptr<ue> u{new ue{&s1ap_obj}};
+    u->ctxt.rnti = rnti;
+    return u;
+  }
+
+private:
+  s1ap& s1ap_obj;
+};
+
+} // namespace srsenb
+
 struct mme_dummy {
   mme_dummy(const char* addr_str_, int port_) : addr_str(addr_str_), port(port_)
   {
@@ -326,8 +354,155 @@ void test_s1ap_erab_setup(test_event event)
   TESTASSERT(erab_item.erab_id == 5);
 }
 
+/// Checks that the RNTI and MME_UE_S1AP_ID indices of the user list follow the users
+void test_s1ap_user_list()
+{
+  srsran::task_scheduler task_sched;
+  srslog::basic_logger&  logger = srslog::fetch_basic_logger("S1AP");
+  dummy_socket_manager   rx_sockets;
+  s1ap                   s1ap_obj(&task_sched, logger, &rx_sockets);
+  s1ap_test_access       s1ap_access(s1ap_obj);
+
+  s1ap_test_access::user_list& users = s1ap_access.users();
+
+  std::unique_ptr<s1ap_test_access::ue> user = s1ap_access.make_user(0x47);
+  user->ctxt.mme_ue_s1ap_id                   = 10;
+  s1ap_test_access::ue*                 ue2  = users.add_user(std::move(user));
+  s1ap_test_access::ue*                 ue1  = users.add_user(s1ap_access.make_user(0x46));
+  TESTASSERT(ue1 != nullptr and ue2 != nullptr);
+  TESTASSERT(users.find_ue_rnti(0x46) == ue1);
+  TESTASSERT(users.find_ue_enbid(ue1->ctxt.enb_ue_s1ap_id) == ue1);
+  TESTASSERT(users.find_ue_mmeid(10) == ue2);
+  TESTASSERT(users.find_ue_rnti(SRSRAN_INVALID_RNTI) == nullptr);
+
+  // Repeated IDs are rejected
+  TESTASSERT(users.add_user(s1ap_access.make_user(0x46)) == nullptr);
+  TESTASSERT(users.size() == 2);
+
+  // RNTI changes
+  s1ap_obj.user_mod(0x46, 0x48);
+  TESTASSERT(not s1ap_obj.user_exists(0x46));
+  TESTASSERT(users.find_ue_rnti(0x48) == ue1);
+  s1ap_obj.user_mod(0x48, 0x47);
+  TESTASSERT(users.find_ue_rnti(0x48) == ue1 and users.find_ue_rnti(0x47) == ue2);
+  TESTASSERT(not users.set_rnti(ue2, 0x48));
+  TESTASSERT(users.set_rnti(ue2, 0x49));
+  TESTASSERT(users.find_ue_rnti(0x47) == nullptr and users.find_ue_rnti(0x49) == ue2);
+
+  // MME_UE_S1AP_ID changes
+  TESTASSERT(not users.set_mmeid(ue1, 10));
+  TESTASSERT(users.set_mmeid(ue1, 11));
+  TESTASSERT(users.find_ue_mmeid(11) == ue1);
+  TESTASSERT(users.set_mmeid(ue1, 12));
+  TESTASSERT(users.find_ue_mmeid(11) == nullptr and users.find_ue_mmeid(12) == ue1);
+
+  // Erased users leave no index entries behind
+  users.erase(ue1);
+  TESTASSERT(users.size() == 1);
+  TESTASSERT(users.find_ue_rnti(0x48) == nullptr);
+  TESTASSERT(users.find_ue_mmeid(12) == nullptr);
+  TESTASSERT(users.find_ue_rnti(0x49) == ue2 and users.find_ue_mmeid(10) == ue2);
+  ue1 = users.add_user(s1ap_access.make_user(0x48));
+  TESTASSERT(ue1 != nullptr and users.find_ue_rnti(0x48) == ue1);
+  TESTASSERT(users.set_mmeid(ue1, 12));
+  users.erase(ue2);
+  TESTASSERT(users.find_ue_rnti(0x49) == nullptr and users.find_ue_mmeid(10) == nullptr);
+  TESTASSERT(users.find_ue_mmeid(12) == ue1);
+}
+
+/// Measures the cost of RNTI-based S1AP message handling as the number of connected UEs grows
+void test_s1ap_ue_lookup_benchmark()
+{
+  srsran::task_scheduler task_sched;
+  srslog::basic_logger&  logger = srslog::fetch_basic_logger("S1AP");
+  dummy_socket_manager   rx_sockets;
+  s1ap                   s1ap_obj(&task_sched, logger, &rx_sockets);
+  rrc_tester             rrc;
+
+  const char*    mme_addr_str = "127.0.0.1";
+  const uint32_t MME_PORT     = 36412;
+  mme_dummy      mme(mme_addr_str, MME_PORT);
+
+  s1ap_args_t args   = {};
+  args.cell_id       = 0x01;
+  args.enb_id        = 0x19B;
+  args.mcc           = 907;
+  args.mnc           = 70;
+  args.s1c_bind_addr = "127.0.0.100";
+  args.tac           = 7;
+  args.gtp_bind_addr = "127.0.0.100";
+  args.mme_addr      = mme_addr_str;
+  args.enb_name      = "srsenb01";
+
+  TESTASSERT(s1ap_obj.init(args, &rrc) == SRSRAN_SUCCESS);
+  task_sched.run_next_task();
+  run_s1_setup(s1ap_obj, mme);
+
+  // Per-message logging would dominate the measurement
+  logger.set_level(srslog::basic_levels::warning);
+
+  const uint16_t first_rnti = 0x46;
+  const uint32_t nof_msgs   = 1000;
+  uint32_t       nof_ues    = 0;
+  for (uint32_t target_nof_ues : {10u, 100u, 1000u, 10000u}) {
+    for (; nof_ues < target_nof_ues; ++nof_ues) {
+      srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      sdu->N_bytes                     = 8;
+      s1ap_obj.initial_ue(first_rnti + nof_ues, 0, asn1::s1ap::rrc_establishment_cause_opts::mo_sig, std::move(sdu));
+      TESTASSERT(mme.read_msg()->N_bytes > 0);
+    }
+
+    // RRC -> S1AP lookups of UEs spread over the whole user list
+    auto     tp      = std::chrono::steady_clock::now();
+    uint32_t nof_hit = 0;
+    for (uint32_t i = 0; i < nof_msgs; ++i) {
+      nof_hit += s1ap_obj.user_exists(first_rnti + (i * 7919) % nof_ues) ? 1 : 0;
+    }
+    auto lookup_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+    TESTASSERT(nof_hit == nof_msgs);
+    TESTASSERT(not s1ap_obj.user_exists(first_rnti + nof_ues));
+
+    // UL NAS Transport, which looks up the UE by RNTI and sends the message to the MME
+    tp = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < nof_msgs; ++i) {
+      srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      sdu->N_bytes                     = 8;
+      s1ap_obj.write_pdu(first_rnti + (i * 7919) % nof_ues, std::move(sdu));
+      TESTASSERT(mme.read_msg()->N_bytes > 0);
+    }
+    auto ul_nas_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+
+    fmt::print("{:>5} UEs: user lookup {:>6.1f} ns, UL NAS Transport {:>6.1f} usec\n",
+               nof_ues,
+               lookup_ns.count() / (double)nof_msgs,
+               ul_nas_ns.count() / (double)nof_msgs / 1000);
+  }
+
+  // The RNTI index follows RNTI changes
+  s1ap_obj.user_mod(first_rnti, first_rnti + nof_ues);
+  TESTASSERT(not s1ap_obj.user_exists(first_rnti));
+  TESTASSERT(s1ap_obj.user_exists(first_rnti + nof_ues));
+
+  logger.set_level(srslog::basic_levels::debug);
+}
+
 int main(int argc, char** argv)
 {
+  // The benchmark grows the user list to 10k UEs over SCTP, it only runs on request
+  bool                        run_benchmark  = false;
+  static const struct option long_options[] = {{"benchmark", no_argument, nullptr, 'b'}, {nullptr, 0, nullptr, 0}};
+  int                         c;
+  while ((c = getopt_long(argc, argv, "b", long_options, nullptr)) != -1) {
+    switch (c) {
+      case 'b':
+        run_benchmark = true;
+        break;
+      default:
+        fprintf(stderr, "Usage: %s [-b|--benchmark]\n", argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+
   // Setup logging.
   auto& logger = srslog::fetch_basic_logger("S1AP");
   logger.set_level(srslog::basic_levels::debug);
@@ -336,8 +511,12 @@ int main(int argc, char** argv)
   // Start the log backend.
   srsran::test_init(argc, argv);
 
+  test_s1ap_user_list();
   test_s1ap_erab_setup(test_event::success);
   test_s1ap_erab_setup(test_event::wrong_erabid_mod);
   test_s1ap_erab_setup(test_event::wrong_mme_s1ap_id);
   test_s1ap_erab_setup(test_event::repeated_erabid_mod);
+  if (run_benchmark) {
+    test_s1ap_ue_lookup_benchmark();
+  }
 }
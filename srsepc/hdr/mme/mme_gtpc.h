@@ -26,6 +26,8 @@
 #include "srsran/common/buffer_pool.h"
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <unordered_map>
+#include <vector>
 
 namespace srsepc {
 
@@ -40,13 +42,19 @@ public:
     srsran::gtp_fteid_t sgw_ctr_fteid;
   } gtpc_ctx_t;
 
+  // Maximum number of S11 PDUs received in a single system call
+  static const uint32_t s11_max_rx_batch_size = 64;
+
   virtual ~mme_gtpc() = default;
 
   static mme_gtpc* get_instance();
 
-  bool init();
-  bool send_s11_pdu(const srsran::gtpc_pdu& pdu);
-  void handle_s11_pdu(srsran::byte_buffer_t* msg);
+  bool     init();
+  bool     init(const char* mme_addr_name, const char* spgw_addr_name);
+  bool     send_s11_pdu(const srsran::gtpc_pdu& pdu);
+  void     handle_s11_pdu(srsran::byte_buffer_t* msg);
+  // Handles the S11 PDUs pending in the socket. Returns the number of well formed PDUs
+  uint32_t handle_s11_pdus();
 
   virtual bool send_create_session_request(uint64_t imsi);
   bool         handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu);
@@ -66,14 +74,17 @@ private:
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("MME GTPC");
   s1ap*                 m_s1ap;
 
-  uint32_t                            m_next_ctrl_teid;
-  std::map<uint32_t, uint64_t>        m_mme_ctr_teid_to_imsi;
-  std::map<uint64_t, struct gtpc_ctx> m_imsi_to_gtpc_ctx;
+  uint32_t                                      m_next_ctrl_teid;
+  std::unordered_map<uint32_t, uint64_t>        m_mme_ctr_teid_to_imsi;
+  std::unordered_map<uint64_t, struct gtpc_ctx> m_imsi_to_gtpc_ctx;
 
   int                m_s11;
   struct sockaddr_un m_mme_addr, m_spgw_addr;
 
-  bool     init_s11();
+  std::vector<srsran::gtpc_pdu> m_s11_rx_batch;
+
+  bool     init_s11(const char* mme_addr_name, const char* spgw_addr_name);
+  void     handle_s11_gtpc_pdu(srsran::gtpc_pdu* pdu);
   uint32_t get_new_ctrl_teid();
 };
 
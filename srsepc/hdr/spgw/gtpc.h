@@ -22,14 +22,15 @@
 #define SRSEPC_GTPC_H
 
 #include "srsepc/hdr/spgw/spgw.h"
+#include "srsepc/hdr/spgw/ue_ip_pool.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 
-#include <set>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <unordered_map>
 
 namespace srsepc {
 
@@ -53,10 +54,14 @@ public:
   bool send_s11_pdu(const srsran::gtpc_pdu& pdu);
 
   void handle_create_session_request(const srsran::gtpc_create_session_request& cs_req);
+  void handle_create_session_requests(const srsran::gtpc_create_session_request* cs_reqs, uint32_t nof_reqs);
   void handle_modify_bearer_request(const srsran::gtpc_header&                mb_req_hdr,
                                     const srsran::gtpc_modify_bearer_request& mb_req);
   void handle_delete_session_request(const srsran::gtpc_header&                 header,
                                      const srsran::gtpc_delete_session_request& del_req);
+  void handle_delete_session_requests(const srsran::gtpc_header*                 headers,
+                                      const srsran::gtpc_delete_session_request* del_reqs,
+                                      uint32_t                                   nof_reqs);
   void handle_release_access_bearers_request(const srsran::gtpc_header&                         header,
                                              const srsran::gtpc_release_access_bearers_request& rel_req);
   void
@@ -85,13 +90,13 @@ public:
   uint64_t m_next_user_teid;
   uint32_t m_max_paging_queue;
 
-  std::map<uint64_t, uint32_t> m_imsi_to_ctr_teid;           // IMSI to control TEID map. Important to check if UE
+  std::unordered_map<uint64_t, uint32_t> m_imsi_to_ctr_teid; // IMSI to control TEID map. Important to check if UE
                                                              // is previously connected
-  std::map<uint32_t, spgw_tunnel_ctx*> m_teid_to_tunnel_ctx; // Map control TEID to tunnel ctx. Usefull to get
-                                                             // reply ctrl TEID, UE IP, etc.
+  std::unordered_map<uint32_t, spgw_tunnel_ctx*> m_teid_to_tunnel_ctx; // Map control TEID to tunnel ctx. Usefull to
+                                                                       // get reply ctrl TEID, UE IP, etc.
 
-  std::set<uint32_t>                 m_ue_ip_addr_pool;
-  std::map<uint64_t, struct in_addr> m_imsi_to_ip;
+  ue_ip_pool                                   m_ue_ip_pool;
+  std::unordered_map<uint64_t, struct in_addr> m_imsi_to_ip; // Statically assigned UE IPs
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("SPGW GTPC");
 };
@@ -46,6 +46,7 @@ typedef struct {
   std::string sgi_if_addr;
   std::string sgi_if_name;
   uint32_t    max_paging_queue;
+  uint32_t    ue_ip_pool_size;
 } spgw_args_t;
 
 typedef struct spgw_tunnel_ctx {
@@ -65,6 +66,9 @@ class spgw : public srsran::thread
   class gtpc;
   class gtpu;
 
+  // Gives the unit tests access to the GTP-C and GTP-U classes
+  friend class spgw_test_access;
+
 public:
   static spgw* get_instance(void);
   static void  cleanup(void);
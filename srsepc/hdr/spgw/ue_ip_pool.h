@@ -0,0 +1,74 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        ue_ip_pool.h
+ * Description: Pool of UE IPv4 addresses handed out by the SP-GW.
+ *****************************************************************************/
+
+#ifndef SRSEPC_UE_IP_POOL_H
+#define SRSEPC_UE_IP_POOL_H
+
+#include <netinet/in.h>
+#include <stdint.h>
+#include <vector>
+
+namespace srsepc {
+
+/**
+ * Bitmap of the free UE IPv4 addresses in a contiguous range. The lowest free address is always handed out first.
+ * Allocation and release are amortized O(1), so large ranges (e.g. a /8) do not slow down session setup.
+ */
+class ue_ip_pool
+{
+public:
+  /// Sets up the pool with nof_addrs consecutive free addresses, starting at first_addr (network byte order).
+  void init(in_addr_t first_addr, uint32_t nof_addrs);
+
+  /// Removes a free address from the pool. Returns false if the address is outside the pool or already taken.
+  bool reserve(in_addr_t addr);
+
+  /// Takes the lowest free address out of the pool. Returns 0 if the pool is exhausted.
+  in_addr_t allocate();
+
+  /// Gives an address back to the pool. Returns false if the address is outside the pool or already free.
+  bool release(in_addr_t addr);
+
+  bool     contains(in_addr_t addr) const;
+  uint32_t size() const { return m_nof_addrs; }
+  uint32_t nof_free() const { return m_nof_free; }
+
+  /// Netmask (host byte order) of the smallest subnet, at least a /24, that holds nof_addrs UE addresses besides the
+  /// network, SGi and broadcast addresses.
+  static uint32_t netmask(uint32_t nof_addrs);
+
+private:
+  static const uint32_t bits_per_word = 64;
+
+  uint32_t              m_first_addr = 0; // Host byte order
+  uint32_t              m_nof_addrs  = 0;
+  uint32_t              m_nof_free   = 0;
+  uint32_t              m_next_word  = 0; // All words below this index are fully allocated
+  std::vector<uint64_t> m_free_mask;      // One bit per address, set when the address is free
+};
+
+} // namespace srsepc
+#endif // SRSEPC_UE_IP_POOL_H
@@ -165,8 +165,7 @@ void mme::run_thread()
       }
       // Handle S11
       if (FD_ISSET(s11, &m_set)) {
-        pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
-        m_mme_gtpc->handle_s11_pdu(pdu.get());
+        m_mme_gtpc->handle_s11_pdus();
       }
       // Handle NAS Timers
       for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end();) {
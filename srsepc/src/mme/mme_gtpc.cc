@@ -24,6 +24,7 @@
 #include "srsepc/hdr/spgw/spgw.h"
 #include "srsran/asn1/gtpc.h"
 #include <inttypes.h> // for printing uint64_t
+#include <sys/socket.h>
 
 namespace srsepc {
 
@@ -34,12 +35,17 @@ mme_gtpc* mme_gtpc::get_instance()
 }
 
 bool mme_gtpc::init()
+{
+  return init("@mme_s11", "@spgw_s11");
+}
+
+bool mme_gtpc::init(const char* mme_addr_name, const char* spgw_addr_name)
 {
   m_next_ctrl_teid = 1;
 
   m_s1ap = s1ap::get_instance();
 
-  if (!init_s11()) {
+  if (!init_s11(mme_addr_name, spgw_addr_name)) {
     m_logger.error("Error Initializing MME S11 Interface");
     return false;
   }
@@ -49,13 +55,8 @@ bool mme_gtpc::init()
   return true;
 }
 
-bool mme_gtpc::init_s11()
+bool mme_gtpc::init_s11(const char* mme_addr_name, const char* spgw_addr_name)
 {
-
-  socklen_t sock_len;
-  char      mme_addr_name[]  = "@mme_s11";
-  char      spgw_addr_name[] = "@spgw_s11";
-
   // Logs
   m_logger.info("Initializing MME S11 interface.");
 
@@ -65,6 +66,7 @@ bool mme_gtpc::init_s11()
     m_logger.error("Error opening UNIX socket. Error %s", strerror(errno));
     return false;
   }
+  m_s11_rx_batch.resize(s11_max_rx_batch_size);
 
   // Set MME Address
   memset(&m_mme_addr, 0, sizeof(struct sockaddr_un));
@@ -110,9 +112,48 @@ bool mme_gtpc::send_s11_pdu(const srsran::gtpc_pdu& pdu)
 void mme_gtpc::handle_s11_pdu(srsran::byte_buffer_t* msg)
 {
   m_logger.debug("Received S11 message");
+  handle_s11_gtpc_pdu((srsran::gtpc_pdu*)msg->msg);
+}
+
+uint32_t mme_gtpc::handle_s11_pdus()
+{
+  // Drain the pending S11 PDUs without blocking
+  struct iovec   iov[s11_max_rx_batch_size];
+  struct mmsghdr msgs[s11_max_rx_batch_size];
+  for (uint32_t i = 0; i < s11_max_rx_batch_size; ++i) {
+    iov[i].iov_base = &m_s11_rx_batch[i];
+    iov[i].iov_len  = sizeof(srsran::gtpc_pdu);
+    memset(&msgs[i], 0, sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_iov    = &iov[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  int n = recvmmsg(m_s11, msgs, s11_max_rx_batch_size, MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      m_logger.error("Error reading from S11 socket. Error %s", strerror(errno));
+    }
+    return 0;
+  }
+
+  m_logger.debug("Received %d S11 messages", n);
+  uint32_t nof_handled = 0;
+  for (int i = 0; i < n; ++i) {
+    // The batch buffers are reused, so anything not written by this datagram is left over from an earlier one
+    if (msgs[i].msg_len < sizeof(srsran::gtpc_header)) {
+      m_logger.warning("Discarding malformed S11 message of %d bytes", msgs[i].msg_len);
+      continue;
+    }
+    if (msgs[i].msg_len < sizeof(srsran::gtpc_pdu)) {
+      memset((uint8_t*)&m_s11_rx_batch[i] + msgs[i].msg_len, 0, sizeof(srsran::gtpc_pdu) - msgs[i].msg_len);
+    }
+    handle_s11_gtpc_pdu(&m_s11_rx_batch[i]);
+    nof_handled++;
+  }
+  return nof_handled;
+}
 
-  srsran::gtpc_pdu* pdu;
-  pdu = (srsran::gtpc_pdu*)msg->msg;
+void mme_gtpc::handle_s11_gtpc_pdu(srsran::gtpc_pdu* pdu)
+{
   m_logger.debug("MME Received GTP-C PDU. Message type %s", srsran::gtpc_msg_type_to_str(pdu->header.type));
   switch (pdu->header.type) {
     case srsran::GTPC_MSG_TYPE_CREATE_SESSION_RESPONSE:
@@ -133,7 +174,6 @@ void mme_gtpc::handle_s11_pdu(srsran::byte_buffer_t* msg)
 bool mme_gtpc::send_create_session_request(uint64_t imsi)
 {
   m_logger.info("Sending Create Session Request.");
-  srsran::console("Sending Create Session Request.\n");
   struct srsran::gtpc_pdu cs_req_pdu;
   // Initialize GTP-C message to zero
   std::memset(&cs_req_pdu, 0, sizeof(cs_req_pdu));
@@ -151,10 +191,7 @@ bool mme_gtpc::send_create_session_request(uint64_t imsi)
   // Control TEID allocated
   cs_req->sender_f_teid.teid = get_new_ctrl_teid();
 
-  m_logger.info("Next MME control TEID: %d", m_next_ctrl_teid);
-  m_logger.info("Allocated MME control TEID: %d", cs_req->sender_f_teid.teid);
-  srsran::console("Creating Session Response -- IMSI: %" PRIu64 "\n", imsi);
-  srsran::console("Creating Session Response -- MME control TEID: %d\n", cs_req->sender_f_teid.teid);
+  m_logger.info("Allocated MME control TEID: %d. IMSI: %015" PRIu64 "", cs_req->sender_f_teid.teid, imsi);
 
   // APN
   strncpy(cs_req->apn, m_s1ap->m_s1ap_args.mme_apn.c_str(), sizeof(cs_req->apn) - 1);
@@ -167,29 +204,25 @@ bool mme_gtpc::send_create_session_request(uint64_t imsi)
   cs_req->eps_bearer_context_created.ebi = 5;
 
   // Check whether this UE is already registed
-  std::map<uint64_t, struct gtpc_ctx>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
+  auto it = m_imsi_to_gtpc_ctx.find(imsi);
   if (it != m_imsi_to_gtpc_ctx.end()) {
     m_logger.warning("Create Session Request being called for an UE with an active GTP-C connection.");
     m_logger.warning("Deleting previous GTP-C connection.");
-    std::map<uint32_t, uint64_t>::iterator jt = m_mme_ctr_teid_to_imsi.find(it->second.mme_ctr_fteid.teid);
-    if (jt == m_mme_ctr_teid_to_imsi.end()) {
+    if (m_mme_ctr_teid_to_imsi.erase(it->second.mme_ctr_fteid.teid) == 0) {
       m_logger.error("Could not find IMSI from MME Ctrl TEID. MME Ctr TEID: %d", it->second.mme_ctr_fteid.teid);
-    } else {
-      m_mme_ctr_teid_to_imsi.erase(jt);
     }
-    m_imsi_to_gtpc_ctx.erase(it);
     // No need to send delete session request to the SPGW.
     // The create session request will be interpreted as a new request and SPGW will delete locally in existing context.
+  } else {
+    it = m_imsi_to_gtpc_ctx.emplace(imsi, gtpc_ctx_t{}).first;
   }
 
   // Save RX Control TEID
   m_mme_ctr_teid_to_imsi.emplace(cs_req->sender_f_teid.teid, imsi);
 
   // Save GTP-C context
-  gtpc_ctx_t gtpc_ctx;
-  std::memset(&gtpc_ctx, 0, sizeof(gtpc_ctx_t));
-  gtpc_ctx.mme_ctr_fteid = cs_req->sender_f_teid;
-  m_imsi_to_gtpc_ctx.emplace(imsi, gtpc_ctx);
+  std::memset(&it->second, 0, sizeof(gtpc_ctx_t));
+  it->second.mme_ctr_fteid = cs_req->sender_f_teid;
 
   // Send msg to SPGW
   send_s11_pdu(cs_req_pdu);
@@ -200,7 +233,6 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
 {
   struct srsran::gtpc_create_session_response* cs_resp = &cs_resp_pdu->choice.create_session_response;
   m_logger.info("Received Create Session Response");
-  srsran::console("Received Create Session Response\n");
   if (cs_resp_pdu->header.type != srsran::GTPC_MSG_TYPE_CREATE_SESSION_RESPONSE) {
     m_logger.warning("Could not create GTPC session. Not a create session response");
     // TODO Handle error
@@ -213,7 +245,7 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   }
 
   // Get IMSI from the control TEID
-  std::map<uint32_t, uint64_t>::iterator id_it = m_mme_ctr_teid_to_imsi.find(cs_resp_pdu->header.teid);
+  auto id_it = m_mme_ctr_teid_to_imsi.find(cs_resp_pdu->header.teid);
   if (id_it == m_mme_ctr_teid_to_imsi.end()) {
     m_logger.warning("Could not find IMSI from Ctrl TEID.");
     return false;
@@ -232,11 +264,9 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
     m_logger.error("Did not receive SGW S1-U F-TEID in create session response");
     return false;
   }
-  srsran::console("Create Session Response -- SPGW control TEID %d\n", sgw_ctr_fteid.teid);
   m_logger.info("Create Session Response -- SPGW control TEID %d", sgw_ctr_fteid.teid);
   in_addr s1u_addr;
   s1u_addr.s_addr = cs_resp->eps_bearer_context_created.s1_u_sgw_f_teid.ipv4;
-  srsran::console("Create Session Response -- SPGW S1-U Address: %s\n", inet_ntoa(s1u_addr));
   m_logger.info("Create Session Response -- SPGW S1-U Address: %s", inet_ntoa(s1u_addr));
 
   // Check UE Ipv4 address was allocated
@@ -263,7 +293,7 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   srsran::console("SPGW Allocated IP %s to IMSI %015" PRIu64 "\n", inet_ntoa(emm_ctx->ue_ip), emm_ctx->imsi);
 
   // Save SGW ctrl F-TEID in GTP-C context
-  std::map<uint64_t, struct gtpc_ctx>::iterator it_g = m_imsi_to_gtpc_ctx.find(imsi);
+  auto it_g = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_g == m_imsi_to_gtpc_ctx.end()) {
     // Could not find GTP-C Context
     m_logger.error("Could not find GTP-C context");
@@ -288,7 +318,7 @@ bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify
   srsran::gtpc_pdu mb_req_pdu;
   std::memset(&mb_req_pdu, 0, sizeof(mb_req_pdu));
 
-  std::map<uint64_t, gtpc_ctx_t>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
+  auto it = m_imsi_to_gtpc_ctx.find(imsi);
   if (it == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Modify bearer request for UE without GTP-C connection");
     return false;
@@ -317,8 +347,8 @@ bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify
 
 void mme_gtpc::handle_modify_bearer_response(srsran::gtpc_pdu* mb_resp_pdu)
 {
-  uint32_t                               mme_ctrl_teid = mb_resp_pdu->header.teid;
-  std::map<uint32_t, uint64_t>::iterator imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
+  uint32_t mme_ctrl_teid = mb_resp_pdu->header.teid;
+  auto     imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
   if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
     m_logger.error("Could not find IMSI from control TEID");
     return;
@@ -340,7 +370,7 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
   srsran::gtp_fteid_t mme_ctr_fteid;
 
   // Get S-GW Ctr TEID
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  auto it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Could not find GTP-C context to remove");
     return false;
@@ -361,11 +391,8 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
   send_s11_pdu(del_req_pdu);
 
   // Delete GTP-C context
-  std::map<uint32_t, uint64_t>::iterator it_imsi = m_mme_ctr_teid_to_imsi.find(mme_ctr_fteid.teid);
-  if (it_imsi == m_mme_ctr_teid_to_imsi.end()) {
+  if (m_mme_ctr_teid_to_imsi.erase(mme_ctr_fteid.teid) == 0) {
     m_logger.error("Could not find IMSI from MME ctr TEID");
-  } else {
-    m_mme_ctr_teid_to_imsi.erase(it_imsi);
   }
   m_imsi_to_gtpc_ctx.erase(it_ctx);
   return true;
@@ -380,7 +407,7 @@ void mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
   srsran::gtp_fteid_t sgw_ctr_fteid;
 
   // Get S-GW Ctr TEID
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  auto it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Could not find GTP-C context to remove");
     return;
@@ -406,7 +433,7 @@ bool mme_gtpc::handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu)
 {
   uint32_t                                 mme_ctrl_teid = dl_not_pdu->header.teid;
   srsran::gtpc_downlink_data_notification* dl_not        = &dl_not_pdu->choice.downlink_data_notification;
-  std::map<uint32_t, uint64_t>::iterator   imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
+  auto                                     imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
   if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
     m_logger.error("Could not find IMSI from control TEID");
     return false;
@@ -431,7 +458,7 @@ void mme_gtpc::send_downlink_data_notification_acknowledge(uint64_t imsi, enum s
   std::memset(&not_ack_pdu, 0, sizeof(not_ack_pdu));
 
   // get s-gw ctr teid
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  auto it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("could not find gtp-c context to remove");
     return;
@@ -461,7 +488,7 @@ bool mme_gtpc::send_downlink_data_notification_failure_indication(uint64_t imsi,
   std::memset(&not_fail_pdu, 0, sizeof(not_fail_pdu));
 
   // get s-gw ctr teid
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  auto it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("could not find gtp-c context to send paging failure");
     return false;
@@ -41,7 +41,8 @@ namespace srsepc {
  * comminication with the MME
  *
  **********************************************/
-spgw::gtpc::gtpc() : m_h_next_ue_ip(0), m_next_ctrl_teid(1), m_next_user_teid(1), m_max_paging_queue(0)
+spgw::gtpc::gtpc() :
+  m_s11(-1), m_h_next_ue_ip(0), m_next_ctrl_teid(1), m_next_user_teid(1), m_max_paging_queue(0)
 {
   return;
 }
@@ -86,13 +87,13 @@ int spgw::gtpc::init(spgw_args_t*                           args,
 
 void spgw::gtpc::stop()
 {
-  std::map<uint32_t, spgw_tunnel_ctx*>::iterator it = m_teid_to_tunnel_ctx.begin();
-  while (it != m_teid_to_tunnel_ctx.end()) {
-    m_logger.info("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "", it->second->imsi);
-    srsran::console("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "\n", it->second->imsi);
-    delete it->second;
-    m_teid_to_tunnel_ctx.erase(it++);
+  for (auto& teid_ctx : m_teid_to_tunnel_ctx) {
+    m_logger.info("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "", teid_ctx.second->imsi);
+    srsran::console("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "\n", teid_ctx.second->imsi);
+    delete teid_ctx.second;
   }
+  m_teid_to_tunnel_ctx.clear();
+  m_imsi_to_ctr_teid.clear();
   return;
 }
 
@@ -186,10 +187,10 @@ void spgw::gtpc::handle_create_session_request(const struct srsran::gtpc_create_
   spgw_tunnel_ctx_t* tunnel_ctx;
   int                default_bearer_id = 5;
   // Check if IMSI has active GTP-C and/or GTP-U
-  bool gtpc_present = m_imsi_to_ctr_teid.count(cs_req.imsi);
-  if (gtpc_present) {
+  auto ctr_teid_it = m_imsi_to_ctr_teid.find(cs_req.imsi);
+  if (ctr_teid_it != m_imsi_to_ctr_teid.end()) {
     srsran::console("SPGW: GTP-C context for IMSI %015" PRIu64 " already exists.\n", cs_req.imsi);
-    delete_gtpc_ctx(m_imsi_to_ctr_teid[cs_req.imsi]);
+    delete_gtpc_ctx(ctr_teid_it->second);
     srsran::console("SPGW: Deleted previous context.\n");
   }
 
@@ -234,14 +235,24 @@ void spgw::gtpc::handle_create_session_request(const struct srsran::gtpc_create_
   return;
 }
 
+void spgw::gtpc::handle_create_session_requests(const srsran::gtpc_create_session_request* cs_reqs, uint32_t nof_reqs)
+{
+  // Grow the session tables once for the whole burst instead of rehashing while it is handled
+  m_teid_to_tunnel_ctx.reserve(m_teid_to_tunnel_ctx.size() + nof_reqs);
+  m_imsi_to_ctr_teid.reserve(m_imsi_to_ctr_teid.size() + nof_reqs);
+  for (uint32_t i = 0; i < nof_reqs; ++i) {
+    handle_create_session_request(cs_reqs[i]);
+  }
+}
+
 void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&                mb_req_hdr,
                                               const struct srsran::gtpc_modify_bearer_request& mb_req)
 {
   m_logger.info("Received Modified Bearer Request");
 
   // Get control tunnel info from mb_req PDU
-  uint32_t                                         ctrl_teid = mb_req_hdr.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = mb_req_hdr.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID %d to modify", ctrl_teid);
     return;
@@ -303,8 +314,8 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
 void spgw::gtpc::handle_delete_session_request(const srsran::gtpc_header&                 header,
                                                const srsran::gtpc_delete_session_request& del_req_pdu)
 {
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to delete session", ctrl_teid);
     return;
@@ -316,12 +327,22 @@ void spgw::gtpc::handle_delete_session_request(const srsran::gtpc_header&
   return;
 }
 
+void spgw::gtpc::handle_delete_session_requests(const srsran::gtpc_header*                 headers,
+                                                const srsran::gtpc_delete_session_request* del_reqs,
+                                                uint32_t                                   nof_reqs)
+{
+  // Erasing from the session tables never rehashes them, so there is nothing to prepare for the whole burst
+  for (uint32_t i = 0; i < nof_reqs; ++i) {
+    handle_delete_session_request(headers[i], del_reqs[i]);
+  }
+}
+
 void spgw::gtpc::handle_release_access_bearers_request(const srsran::gtpc_header&                         header,
                                                        const srsran::gtpc_release_access_bearers_request& rel_req)
 {
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to release bearers", ctrl_teid);
     return;
@@ -344,7 +365,7 @@ bool spgw::gtpc::send_downlink_data_notification(uint32_t spgw_ctr_teid)
   struct srsran::gtpc_downlink_data_notification* dl_not = &dl_not_pdu.choice.downlink_data_notification;
 
   // Find MME Ctrl TEID
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(spgw_ctr_teid);
+  auto tunnel_it = m_teid_to_tunnel_ctx.find(spgw_ctr_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to send downlink notification.", spgw_ctr_teid);
     return false;
@@ -382,8 +403,8 @@ void spgw::gtpc::handle_downlink_data_notification_acknowledge(
   m_logger.debug("Handling downlink data notification acknowledge");
 
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to handle notification acknowldge", ctrl_teid);
     return;
@@ -410,8 +431,8 @@ void spgw::gtpc::handle_downlink_data_notification_failure_indication(
 {
   m_logger.debug("Handling downlink data notification failure indication");
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to handle notification failure indication", ctrl_teid);
     return;
@@ -444,11 +465,7 @@ spgw_tunnel_ctx_t* spgw::gtpc::create_gtpc_ctx(const struct srsran::gtpc_create_
 
   uint8_t default_bearer_id = 5;
 
-  srsran::console("SPGW: Allocated Ctrl TEID %" PRIu64 "\n", spgw_uplink_ctrl_teid);
-  srsran::console("SPGW: Allocated User TEID %" PRIu64 "\n", spgw_uplink_user_teid);
-  struct in_addr ue_ip_;
-  ue_ip_.s_addr = ue_ip;
-  srsran::console("SPGW: Allocate UE IP %s\n", inet_ntoa(ue_ip_));
+  m_logger.info("Allocated Ctrl TEID %" PRIu64 ", User TEID %" PRIu64, spgw_uplink_ctrl_teid, spgw_uplink_user_teid);
 
   // Save the UE IP to User TEID map
   spgw_tunnel_ctx_t* tunnel_ctx = new spgw_tunnel_ctx_t{};
@@ -471,21 +488,26 @@ spgw_tunnel_ctx_t* spgw::gtpc::create_gtpc_ctx(const struct srsran::gtpc_create_
 
 bool spgw::gtpc::delete_gtpc_ctx(uint32_t ctrl_teid)
 {
-  spgw_tunnel_ctx_t* tunnel_ctx;
-  if (!m_teid_to_tunnel_ctx.count(ctrl_teid)) {
+  auto tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.error("Could not find GTP context to delete.");
     return false;
   }
-  tunnel_ctx = m_teid_to_tunnel_ctx[ctrl_teid];
+  spgw_tunnel_ctx_t* tunnel_ctx = tunnel_it->second;
 
   // Remove Ctrl TEID from GTP-U Mapping
   m_gtpu->delete_gtpc_tunnel(tunnel_ctx->ue_ipv4);
 
+  // Return dynamically allocated UE IP to the pool
+  if (m_imsi_to_ip.count(tunnel_ctx->imsi) == 0) {
+    m_ue_ip_pool.release(tunnel_ctx->ue_ipv4);
+  }
+
   // Remove Ctrl TEID from IMSI to control TEID map
   m_imsi_to_ctr_teid.erase(tunnel_ctx->imsi);
 
   // Remove GTP context from control TEID mapping
-  m_teid_to_tunnel_ctx.erase(ctrl_teid);
+  m_teid_to_tunnel_ctx.erase(tunnel_it);
   delete tunnel_ctx;
   return true;
 }
@@ -496,11 +518,12 @@ bool spgw::gtpc::delete_gtpc_ctx(uint32_t ctrl_teid)
 bool spgw::gtpc::queue_downlink_packet(uint32_t ctrl_teid, srsran::unique_byte_buffer_t msg)
 {
   spgw_tunnel_ctx_t* tunnel_ctx;
-  if (!m_teid_to_tunnel_ctx.count(ctrl_teid)) {
+  auto               tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.error("Could not find GTP context to queue.");
     goto pkt_discard;
   }
-  tunnel_ctx = m_teid_to_tunnel_ctx[ctrl_teid];
+  tunnel_ctx = tunnel_it->second;
   if (!tunnel_ctx->paging_pending) {
     m_logger.error("Paging not pending. Not queueing packet");
     goto pkt_discard;
@@ -561,28 +584,37 @@ int spgw::gtpc::init_ue_ip(spgw_args_t* args, const std::map<std::string, uint64
     }
   }
 
-  // XXX TODO add an upper bound to ip addr range via config, use 254 for now
   // first address is allocated to the epc tun interface, start w/next addr
-  for (uint32_t n = 1; n < 254; ++n) {
-    struct in_addr ue_addr;
-    if (inet_pton(AF_INET, args->sgi_if_addr.c_str(), &ue_addr.s_addr) != 1) {
-      m_logger.error("Invalid sgi_if_addr: %s", args->sgi_if_addr.c_str());
-      srsran::console("Invalid sgi_if_addr: %s\n", args->sgi_if_addr.c_str());
-      perror("inet_pton");
-      return SRSRAN_ERROR;
-    }
-    ue_addr.s_addr = ue_addr.s_addr + htonl(n);
+  struct in_addr sgi_addr;
+  if (inet_pton(AF_INET, args->sgi_if_addr.c_str(), &sgi_addr.s_addr) != 1) {
+    m_logger.error("Invalid sgi_if_addr: %s", args->sgi_if_addr.c_str());
+    srsran::console("Invalid sgi_if_addr: %s\n", args->sgi_if_addr.c_str());
+    perror("inet_pton");
+    return SRSRAN_ERROR;
+  }
+  // the pool must end before the broadcast address of the SGi subnet, sized as done for the tun interface
+  uint32_t first_addr = ntohl(sgi_addr.s_addr) + 1;
+  uint32_t netmask    = ue_ip_pool::netmask(args->ue_ip_pool_size);
+  uint64_t broadcast  = (ntohl(sgi_addr.s_addr) & netmask) | ~netmask;
+  if (args->ue_ip_pool_size == 0 or (uint64_t)first_addr + args->ue_ip_pool_size > broadcast) {
+    m_logger.error("Invalid UE IP pool size %u for sgi_if_addr %s", args->ue_ip_pool_size, args->sgi_if_addr.c_str());
+    srsran::console(
+        "Invalid UE IP pool size %u for sgi_if_addr %s\n", args->ue_ip_pool_size, args->sgi_if_addr.c_str());
+    return SRSRAN_ERROR_OUT_OF_BOUNDS;
+  }
+  m_ue_ip_pool.init(htonl(first_addr), args->ue_ip_pool_size);
 
-    std::map<std::string, uint64_t>::const_iterator iter = ip_to_imsi.find(inet_ntoa(ue_addr));
-    if (iter != ip_to_imsi.end()) {
+  // static addresses inside the pool range are never handed out dynamically
+  for (const auto& imsi_ip : m_imsi_to_ip) {
+    if (m_ue_ip_pool.reserve(imsi_ip.second.s_addr)) {
       m_logger.debug("SPGW: init_ue_ip ue ip addr %s is reserved for imsi %015" PRIu64 ", not adding to pool",
-                     iter->first.c_str(),
-                     iter->second);
-    } else {
-      m_ue_ip_addr_pool.insert(ue_addr.s_addr);
-      m_logger.debug("SPGW: init_ue_ip ue ip addr %s is added to pool", inet_ntoa(ue_addr));
+                     inet_ntoa(imsi_ip.second),
+                     imsi_ip.first);
     }
   }
+  m_logger.info("SPGW: init_ue_ip pool with %u addresses starting at %s",
+                m_ue_ip_pool.nof_free(),
+                inet_ntoa(in_addr{htonl(first_addr)}));
   return SRSRAN_SUCCESS;
 }
 
@@ -590,17 +622,15 @@ in_addr_t spgw::gtpc::get_new_ue_ipv4(uint64_t imsi)
 {
   struct in_addr ue_addr;
 
-  std::map<uint64_t, struct in_addr>::const_iterator iter = m_imsi_to_ip.find(imsi);
+  auto iter = m_imsi_to_ip.find(imsi);
   if (iter != m_imsi_to_ip.end()) {
     ue_addr = iter->second;
     m_logger.info("SPGW: get_new_ue_ipv4 static ip addr %s", inet_ntoa(ue_addr));
   } else {
-    if (m_ue_ip_addr_pool.empty()) {
+    ue_addr.s_addr = m_ue_ip_pool.allocate();
+    if (ue_addr.s_addr == 0) {
       m_logger.error("SPGW: ue address pool is empty");
-      ue_addr.s_addr = 0;
     } else {
-      ue_addr.s_addr = *m_ue_ip_addr_pool.begin();
-      m_ue_ip_addr_pool.erase(ue_addr.s_addr);
       m_logger.info("SPGW: get_new_ue_ipv4 pool ip addr %s", inet_ntoa(ue_addr));
     }
   }
@@ -21,6 +21,7 @@
 
 #include "srsepc/hdr/spgw/gtpu.h"
 #include "srsepc/hdr/mme/mme_gtpc.h"
+#include "srsepc/hdr/spgw/ue_ip_pool.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/upper/gtpu.h"
@@ -155,11 +156,9 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
     return SRSRAN_ERROR_CANT_START;
   }
 
-  ifr.ifr_netmask.sa_family = AF_INET;
-  if (inet_pton(ifr.ifr_netmask.sa_family , "255.255.255.0", &((struct sockaddr_in*)&ifr.ifr_netmask)->sin_addr.s_addr) != 1) {
-    perror("inet_pton");
-    return false;
-  }
+  // Use a /24 netmask, or a wider one if needed to fit the UE IP pool that follows the SGi address
+  ifr.ifr_netmask.sa_family                                = AF_INET;
+  ((struct sockaddr_in*)&ifr.ifr_netmask)->sin_addr.s_addr = htonl(ue_ip_pool::netmask(args->ue_ip_pool_size));
   if (ioctl(sgi_sock, SIOCSIFNETMASK, &ifr) < 0) {
     m_logger.error("Failed to set TUN interface Netmask. Error: %s", strerror(errno));
     close(m_sgi);
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/ue_ip_pool.h"
+#include <arpa/inet.h>
+
+namespace srsepc {
+
+void ue_ip_pool::init(in_addr_t first_addr, uint32_t nof_addrs)
+{
+  m_first_addr = ntohl(first_addr);
+  m_nof_addrs  = nof_addrs;
+  m_nof_free   = nof_addrs;
+  m_next_word  = 0;
+  m_free_mask.assign((nof_addrs + bits_per_word - 1) / bits_per_word, ~0ULL);
+
+  // Addresses past the end of the range are never free
+  uint32_t tail_bits = nof_addrs % bits_per_word;
+  if (tail_bits != 0) {
+    m_free_mask.back() = (1ULL << tail_bits) - 1;
+  }
+}
+
+uint32_t ue_ip_pool::netmask(uint32_t nof_addrs)
+{
+  uint32_t host_bits = 8;
+  while (host_bits < 32 and (1ULL << host_bits) < (uint64_t)nof_addrs + 3) {
+    host_bits++;
+  }
+  return (uint32_t)(~0ULL << host_bits);
+}
+
+bool ue_ip_pool::contains(in_addr_t addr) const
+{
+  return ntohl(addr) - m_first_addr < m_nof_addrs;
+}
+
+bool ue_ip_pool::reserve(in_addr_t addr)
+{
+  if (not contains(addr)) {
+    return false;
+  }
+  uint32_t idx  = ntohl(addr) - m_first_addr;
+  uint64_t mask = 1ULL << (idx % bits_per_word);
+  if ((m_free_mask[idx / bits_per_word] & mask) == 0) {
+    return false;
+  }
+  m_free_mask[idx / bits_per_word] &= ~mask;
+  m_nof_free--;
+  return true;
+}
+
+in_addr_t ue_ip_pool::allocate()
+{
+  if (m_nof_free == 0) {
+    return 0;
+  }
+  while (m_free_mask[m_next_word] == 0) {
+    m_next_word++;
+  }
+  uint64_t& word = m_free_mask[m_next_word];
+  uint32_t  idx  = m_next_word * bits_per_word + __builtin_ctzll(word);
+  word &= word - 1;
+  m_nof_free--;
+  return htonl(m_first_addr + idx);
+}
+
+bool ue_ip_pool::release(in_addr_t addr)
+{
+  if (not contains(addr)) {
+    return false;
+  }
+  uint32_t idx  = ntohl(addr) - m_first_addr;
+  uint32_t w    = idx / bits_per_word;
+  uint64_t mask = 1ULL << (idx % bits_per_word);
+  if ((m_free_mask[w] & mask) != 0) {
+    return false;
+  }
+  m_free_mask[w] |= mask;
+  m_nof_free++;
+  if (w < m_next_word) {
+    m_next_word = w;
+  }
+  return true;
+}
+
+} // namespace srsepc
@@ -0,0 +1,331 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/mme/mme_gtpc.h"
+#include "srsran/common/test_common.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <getopt.h>
+#include <poll.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace srsepc;
+
+/// Stand-in for the SPGW end of S11. It answers Create Session Requests and counts the other requests. Replies are
+/// queued and sent without blocking, so that the MME can send many requests before reading the responses.
+class spgw_stub
+{
+public:
+  std::atomic<uint32_t> nof_create_reqs = {0};
+  std::atomic<uint32_t> nof_modify_reqs = {0};
+  std::atomic<uint32_t> nof_delete_reqs = {0};
+
+  bool start(const char* spgw_addr_name, const char* mme_addr_name)
+  {
+    sock = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (sock < 0) {
+      return false;
+    }
+    struct sockaddr_un spgw_addr = {}, mme_addr = {};
+    spgw_addr.sun_family         = AF_UNIX;
+    mme_addr.sun_family          = AF_UNIX;
+    snprintf(spgw_addr.sun_path, sizeof(spgw_addr.sun_path), "%s", spgw_addr_name);
+    snprintf(mme_addr.sun_path, sizeof(mme_addr.sun_path), "%s", mme_addr_name);
+    spgw_addr.sun_path[0] = '\0';
+    mme_addr.sun_path[0]  = '\0';
+    if (bind(sock, (const struct sockaddr*)&spgw_addr, sizeof(spgw_addr)) == -1 or
+        connect(sock, (const struct sockaddr*)&mme_addr, sizeof(mme_addr)) == -1) {
+      return false;
+    }
+    running = true;
+    thread  = std::thread([this]() { run(); });
+    return true;
+  }
+
+  void stop()
+  {
+    running = false;
+    thread.join();
+    close(sock);
+  }
+
+  /// Sends a datagram to the MME from the calling thread
+  bool send_raw(const void* data, size_t len) { return send(sock, data, len, 0) == (ssize_t)len; }
+
+  void wait_for(const std::atomic<uint32_t>& counter, uint32_t value)
+  {
+    while (counter < value) {
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  static const uint32_t batch_size = 64;
+
+  void run()
+  {
+    std::vector<srsran::gtpc_pdu> rx_pdus(batch_size);
+    std::deque<srsran::gtpc_pdu>  tx_pdus;
+    struct iovec                  iov[batch_size];
+    struct mmsghdr                msgs[batch_size];
+
+    while (running) {
+      struct pollfd pfd = {sock, (short)(POLLIN | (tx_pdus.empty() ? 0 : POLLOUT)), 0};
+      if (poll(&pfd, 1, 10) <= 0) {
+        continue;
+      }
+
+      if (pfd.revents & POLLIN) {
+        for (uint32_t i = 0; i < batch_size; ++i) {
+          iov[i]                     = {&rx_pdus[i], sizeof(srsran::gtpc_pdu)};
+          msgs[i]                    = {};
+          msgs[i].msg_hdr.msg_iov    = &iov[i];
+          msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int n = recvmmsg(sock, msgs, batch_size, MSG_DONTWAIT, nullptr);
+        for (int i = 0; i < n; ++i) {
+          handle_request(rx_pdus[i], tx_pdus);
+        }
+      }
+
+      if ((pfd.revents & POLLOUT) and not tx_pdus.empty()) {
+        uint32_t nof_msgs = std::min<size_t>(tx_pdus.size(), batch_size);
+        for (uint32_t i = 0; i < nof_msgs; ++i) {
+          iov[i]                     = {&tx_pdus[i], sizeof(srsran::gtpc_pdu)};
+          msgs[i]                    = {};
+          msgs[i].msg_hdr.msg_iov    = &iov[i];
+          msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int n = sendmmsg(sock, msgs, nof_msgs, MSG_DONTWAIT);
+        for (int i = 0; i < n; ++i) {
+          tx_pdus.pop_front();
+        }
+      }
+    }
+  }
+
+  void handle_request(const srsran::gtpc_pdu& req, std::deque<srsran::gtpc_pdu>& tx_pdus)
+  {
+    switch (req.header.type) {
+      case srsran::GTPC_MSG_TYPE_CREATE_SESSION_REQUEST: {
+        tx_pdus.emplace_back();
+        srsran::gtpc_pdu& resp = tx_pdus.back();
+        std::memset(&resp, 0, sizeof(resp));
+        resp.header.teid_present = true;
+        resp.header.teid         = req.choice.create_session_request.sender_f_teid.teid;
+        resp.header.type         = srsran::GTPC_MSG_TYPE_CREATE_SESSION_RESPONSE;
+
+        srsran::gtpc_create_session_response& cs_resp              = resp.choice.create_session_response;
+        cs_resp.cause.cause_value                                  = srsran::GTPC_CAUSE_VALUE_REQUEST_ACCEPTED;
+        cs_resp.eps_bearer_context_created.s1_u_sgw_f_teid_present = true;
+        cs_resp.eps_bearer_context_created.s1_u_sgw_f_teid.ipv4    = inet_addr("127.0.1.100");
+        cs_resp.paa_present                                        = true;
+        cs_resp.paa.pdn_type                                       = srsran::GTPC_PDN_TYPE_IPV4;
+        cs_resp.paa.ipv4                                           = inet_addr("172.16.0.2");
+        nof_create_reqs++;
+        break;
+      }
+      case srsran::GTPC_MSG_TYPE_MODIFY_BEARER_REQUEST:
+        nof_modify_reqs++;
+        break;
+      case srsran::GTPC_MSG_TYPE_DELETE_SESSION_REQUEST:
+        nof_delete_reqs++;
+        break;
+      default:
+        break;
+    }
+  }
+
+  int               sock = -1;
+  std::atomic<bool> running{false};
+  std::thread       thread;
+};
+
+/// Receives and handles the given number of S11 PDUs, either one per system call or draining the socket
+void receive_s11_pdus(mme_gtpc* gtpc, uint32_t nof_pdus, bool drain)
+{
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  for (uint32_t count = 0; count < nof_pdus;) {
+    if (drain) {
+      struct pollfd pfd = {gtpc->get_s11(), POLLIN, 0};
+      poll(&pfd, 1, 100);
+      count += gtpc->handle_s11_pdus();
+    } else {
+      buf->N_bytes = recvfrom(gtpc->get_s11(), buf->msg, SRSRAN_MAX_BUFFER_SIZE_BYTES, 0, nullptr, nullptr);
+      gtpc->handle_s11_pdu(buf.get());
+      count++;
+    }
+  }
+}
+
+/// Builds a Create Session Response as the SPGW would send it to the given MME control TEID
+srsran::gtpc_pdu make_create_session_response(uint32_t mme_ctrl_teid)
+{
+  srsran::gtpc_pdu resp = {};
+  resp.header.teid      = mme_ctrl_teid;
+  resp.header.type      = srsran::GTPC_MSG_TYPE_CREATE_SESSION_RESPONSE;
+  resp.choice.create_session_response.cause.cause_value = srsran::GTPC_CAUSE_VALUE_REQUEST_ACCEPTED;
+  resp.choice.create_session_response.eps_bearer_context_created.s1_u_sgw_f_teid_present = true;
+  resp.choice.create_session_response.paa_present                                        = true;
+  resp.choice.create_session_response.paa.pdn_type = srsran::GTPC_PDN_TYPE_IPV4;
+  return resp;
+}
+
+int test_mme_gtpc_contexts(mme_gtpc* gtpc, spgw_stub& spgw)
+{
+  // Contexts are created per IMSI and looked up by the replies of the SPGW
+  TESTASSERT(gtpc->send_create_session_request(1));
+  TESTASSERT(gtpc->send_create_session_request(2));
+  TESTASSERT(gtpc->send_create_session_request(3));
+  receive_s11_pdus(gtpc, 3, true);
+  TESTASSERT(spgw.nof_create_reqs == 3);
+
+  // A repeated attach replaces the context of the UE. Control TEIDs are handed out from 1, so the previous TEID of
+  // IMSI 2 is 2 and the new one is 4. Replies to the previous TEID are not matched to the UE anymore.
+  TESTASSERT(gtpc->send_create_session_request(2));
+  receive_s11_pdus(gtpc, 1, true);
+  TESTASSERT(spgw.nof_create_reqs == 4);
+  srsran::gtpc_pdu old_resp = make_create_session_response(2);
+  TESTASSERT(not gtpc->handle_create_session_response(&old_resp));
+
+  // Only UEs with a GTP-C context get a request
+  srsran::gtp_fteid_t enb_fteid = {};
+  TESTASSERT(gtpc->send_modify_bearer_request(1, 5, &enb_fteid));
+  TESTASSERT(not gtpc->send_modify_bearer_request(4, 5, &enb_fteid));
+  TESTASSERT(gtpc->send_modify_bearer_request(3, 5, &enb_fteid));
+  spgw.wait_for(spgw.nof_modify_reqs, 2);
+
+  TESTASSERT(gtpc->send_delete_session_request(1));
+  TESTASSERT(gtpc->send_delete_session_request(2));
+  TESTASSERT(gtpc->send_delete_session_request(3));
+  TESTASSERT(not gtpc->send_delete_session_request(2));
+  spgw.wait_for(spgw.nof_delete_reqs, 3);
+  TESTASSERT(not gtpc->send_modify_bearer_request(1, 5, &enb_fteid));
+  TESTASSERT(spgw.nof_modify_reqs == 2);
+  return SRSRAN_SUCCESS;
+}
+
+int test_mme_gtpc_malformed_pdus(mme_gtpc* gtpc, spgw_stub& spgw)
+{
+  // Datagrams shorter than a GTP-C header are discarded and not counted
+  uint8_t short_pdu[4] = {};
+  TESTASSERT(spgw.send_raw(short_pdu, sizeof(short_pdu)));
+  struct pollfd pfd = {gtpc->get_s11(), POLLIN, 0};
+  TESTASSERT(poll(&pfd, 1, 1000) == 1);
+  TESTASSERT(gtpc->handle_s11_pdus() == 0);
+
+  // The socket was drained, and well formed replies are still handled
+  TESTASSERT(gtpc->handle_s11_pdus() == 0);
+  TESTASSERT(gtpc->send_create_session_request(5));
+  receive_s11_pdus(gtpc, 1, true);
+  TESTASSERT(gtpc->send_delete_session_request(5));
+  return SRSRAN_SUCCESS;
+}
+
+/// Runs Create Session, Modify Bearer and Delete Session for a set of UEs and returns the time per UE in ns
+double run_session_storm(mme_gtpc* gtpc, spgw_stub& spgw, const std::vector<uint64_t>& imsis, bool drain)
+{
+  uint32_t nof_ues      = imsis.size();
+  uint32_t nof_deleted  = spgw.nof_delete_reqs;
+  auto     tic          = std::chrono::steady_clock::now();
+  for (uint64_t imsi : imsis) {
+    gtpc->send_create_session_request(imsi);
+  }
+  receive_s11_pdus(gtpc, nof_ues, drain);
+  srsran::gtp_fteid_t enb_fteid = {};
+  for (uint64_t imsi : imsis) {
+    gtpc->send_modify_bearer_request(imsi, 5, &enb_fteid);
+  }
+  for (uint64_t imsi : imsis) {
+    gtpc->send_delete_session_request(imsi);
+  }
+  spgw.wait_for(spgw.nof_delete_reqs, nof_deleted + nof_ues);
+  auto toc = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(toc - tic).count() / (double)nof_ues;
+}
+
+/// Times an attach/detach storm, receiving the S11 replies one per system call and draining the socket
+int test_mme_gtpc_storm_benchmark(mme_gtpc* gtpc, spgw_stub& spgw)
+{
+  const uint32_t nof_ues = 10000;
+
+  std::vector<uint64_t> imsis(nof_ues);
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    imsis[i] = 1010123456789 + i;
+  }
+
+  double serial_ns  = run_session_storm(gtpc, spgw, imsis, false);
+  double drained_ns = run_session_storm(gtpc, spgw, imsis, true);
+
+  printf("S11 storm of %d UEs: %.0f ns/UE reading one PDU at a time, %.0f ns/UE draining the socket\n",
+         nof_ues,
+         serial_ns,
+         drained_ns);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  // The attach/detach storm takes a while, it only runs on request
+  bool                        run_benchmark  = false;
+  static const struct option long_options[] = {{"benchmark", no_argument, nullptr, 'b'}, {nullptr, 0, nullptr, 0}};
+  int                         c;
+  while ((c = getopt_long(argc, argv, "b", long_options, nullptr)) != -1) {
+    switch (c) {
+      case 'b':
+        run_benchmark = true;
+        break;
+      default:
+        fprintf(stderr, "Usage: %s [-b|--benchmark]\n", argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+
+  // There are no NAS contexts, so handling the Create Session Responses stops after the GTP-C context lookup
+  srslog::fetch_basic_logger("MME GTPC").set_level(srslog::basic_levels::none);
+  srslog::fetch_basic_logger("S1AP").set_level(srslog::basic_levels::none);
+  srsran::test_init(argc, argv);
+
+  // Socket names of this process, so that the test does not clash with a running EPC or other test instances
+  char mme_addr_name[32], spgw_addr_name[32];
+  snprintf(mme_addr_name, sizeof(mme_addr_name), "@mme_s11_test_%d", (int)getpid());
+  snprintf(spgw_addr_name, sizeof(spgw_addr_name), "@spgw_s11_test_%d", (int)getpid());
+
+  mme_gtpc* gtpc = mme_gtpc::get_instance();
+  TESTASSERT(gtpc->init(mme_addr_name, spgw_addr_name));
+  spgw_stub spgw;
+  TESTASSERT(spgw.start(spgw_addr_name, mme_addr_name));
+
+  TESTASSERT(test_mme_gtpc_contexts(gtpc, spgw) == SRSRAN_SUCCESS);
+  TESTASSERT(test_mme_gtpc_malformed_pdus(gtpc, spgw) == SRSRAN_SUCCESS);
+  if (run_benchmark) {
+    TESTASSERT(test_mme_gtpc_storm_benchmark(gtpc, spgw) == SRSRAN_SUCCESS);
+  }
+
+  spgw.stop();
+  close(gtpc->get_s11());
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -47,6 +47,9 @@ namespace srsenb {
 
 class ngap final : public ngap_interface_rrc_nr
 {
+  // Gives the unit tests access to the user list
+  friend class ngap_test_access;
+
 public:
   class ue;
   ngap(srsran::task_sched_handle   task_sched_,
@@ -167,6 +170,7 @@ private:
     ue*            find_ue_amfid(uint64_t amfid);
     ue*            add_user(value_type user);
     void           erase(ue* ue_ptr);
+    bool           set_amfid(ue* ue_ptr, uint64_t amfid);
     iterator       begin() { return users.begin(); }
     iterator       end() { return users.end(); }
     const_iterator cbegin() const { return users.begin(); }
@@ -175,6 +179,9 @@ private:
 
   private:
     std::unordered_map<uint32_t, std::unique_ptr<ue> > users; // maps ran_ue_ngap_id to user
+    // Secondary indices. Users must only change their amf_ue_ngap_id via set_amfid()
+    std::unordered_map<uint16_t, ue*> rnti_index;  // maps RNTI to user
+    std::unordered_map<uint64_t, ue*> amfid_index; // maps amf_ue_ngap_id to user
   };
   user_list users;
 
@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsenb/hdr/stack/mac/common/mac_tprof.h"
 #include "srsgnb/hdr/stack/mac/mac_nr.h"
 #include "srsgnb/hdr/stack/mac/sched_nr.h"
 #include "srsran/common/buffer_pool.h"
@@ -340,9 +341,8 @@ uint16_t mac_nr::reserve_rnti(uint32_t enb_cc_idx, const sched_nr_ue_cfg_t& uecf
 
 void mac_nr::rach_detected(const rach_info_t& rach_info)
 {
-  static srsran::mutexed_tprof<srsran::avg_time_stats> rach_tprof("rach_tprof", "MAC-NR", 1);
   logger.set_context(rach_info.slot_index);
-  auto rach_tprof_meas = rach_tprof.start();
+  auto rach_tprof_meas = mac_nr_rach_tprof.start();
 
   uint32_t enb_cc_idx = 0;
   stack_task_queue.push([this, rach_info, enb_cc_idx, rach_tprof_meas]() mutable {
@@ -300,9 +300,8 @@ ngap::ue* ngap::user_list::find_ue_rnti(uint16_t rnti)
   if (rnti == SRSRAN_INVALID_RNTI) {
     return nullptr;
   }
-  auto it = std::find_if(
-      users.begin(), users.end(), [rnti](const user_list::pair_type& v) { return v.second->ctxt.rnti == rnti; });
-  return it != users.end() ? it->second.get() : nullptr;
+  auto it = rnti_index.find(rnti);
+  return it != rnti_index.end() ? it->second : nullptr;
 }
 
 ngap::ue* ngap::user_list::find_ue_gnbid(uint32_t gnbid)
@@ -313,10 +312,8 @@ ngap::ue* ngap::user_list::find_ue_gnbid(uint32_t gnbid)
 
 ngap::ue* ngap::user_list::find_ue_amfid(uint64_t amfid)
 {
-  auto it = std::find_if(users.begin(), users.end(), [amfid](const user_list::pair_type& v) {
-    return v.second->ctxt.amf_ue_ngap_id == amfid;
-  });
-  return it != users.end() ? it->second.get() : nullptr;
+  auto it = amfid_index.find(amfid);
+  return it != amfid_index.end() ? it->second : nullptr;
 }
 
 ngap::ue* ngap::user_list::add_user(std::unique_ptr<ngap::ue> user)
@@ -336,7 +333,17 @@ ngap::ue* ngap::user_list::add_user(std::unique_ptr<ngap::ue> user)
     return nullptr;
   }
   auto p = users.insert(std::make_pair(user->ctxt.ran_ue_ngap_id, std::move(user)));
-  return p.second ? p.first->second.get() : nullptr;
+  if (not p.second) {
+    return nullptr;
+  }
+  ue* u = p.first->second.get();
+  if (u->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_index.emplace(u->ctxt.rnti, u);
+  }
+  if (u->ctxt.amf_ue_ngap_id.has_value()) {
+    amfid_index.emplace(u->ctxt.amf_ue_ngap_id.value(), u);
+  }
+  return u;
 }
 
 void ngap::user_list::erase(ue* ue_ptr)
@@ -347,9 +354,32 @@ void ngap::user_list::erase(ue* ue_ptr)
     logger.error("User to be erased does not exist");
     return;
   }
+  if (ue_ptr->ctxt.rnti != SRSRAN_INVALID_RNTI) {
+    rnti_index.erase(ue_ptr->ctxt.rnti);
+  }
+  if (ue_ptr->ctxt.amf_ue_ngap_id.has_value()) {
+    amfid_index.erase(ue_ptr->ctxt.amf_ue_ngap_id.value());
+  }
   users.erase(it);
 }
 
+/// Sets the amf_ue_ngap_id of a user in the list. Returns false if another user already holds it
+bool ngap::user_list::set_amfid(ue* ue_ptr, uint64_t amfid)
+{
+  if (ue_ptr->ctxt.amf_ue_ngap_id == amfid) {
+    return true;
+  }
+  if (find_ue_amfid(amfid) != nullptr) {
+    return false;
+  }
+  if (ue_ptr->ctxt.amf_ue_ngap_id.has_value()) {
+    amfid_index.erase(ue_ptr->ctxt.amf_ue_ngap_id.value());
+  }
+  ue_ptr->ctxt.amf_ue_ngap_id = amfid;
+  amfid_index.emplace(amfid, ue_ptr);
+  return true;
+}
+
 /*******************************************************************************
 /* NGAP message handlers
 ********************************************************************************/
@@ -825,7 +855,7 @@ ngap::ue* ngap::handle_ngapmsg_ue_id(uint32_t gnb_id, uint64_t amf_id)
 
     user_amf_ptr = users.find_ue_amfid(amf_id);
     if (not user_ptr->ctxt.amf_ue_ngap_id.has_value() and user_amf_ptr == nullptr) {
-      user_ptr->ctxt.amf_ue_ngap_id = amf_id;
+      users.set_amfid(user_ptr, amf_id);
       return user_ptr;
     }
 
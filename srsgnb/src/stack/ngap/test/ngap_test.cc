@@ -20,11 +20,37 @@
  */
 
 #include "srsgnb/hdr/stack/ngap/ngap.h"
+#include "srsgnb/hdr/stack/ngap/ngap_ue.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/test_common.h"
 
 using namespace srsenb;
 
+namespace srsenb {
+
+class ngap_test_access
+{
+public:
+  using ue        = ngap::ue;
+  using user_list = ngap::user_list;
+
+  explicit ngap_test_access(ngap& ngap_) : ngap_obj(ngap_) {}
+
+  user_list& users() { return ngap_obj.users; }
+
+  std::unique_ptr<ue> make_user(uint16_t rnti)
+  {
+    std::unique_ptr<ue> u{new ue{&ngap_obj, nullptr, nullptr, ngap_obj.logger}};
+    u->ctxt.rnti = rnti;
+    return u;
+  }
+
+private:
+  ngap& ngap_obj;
+};
+
+} // namespace srsenb
+
 struct amf_dummy {
   amf_dummy(const char* addr_str_, int port_) : addr_str(addr_str_), port(port_)
   {
@@ -285,6 +311,55 @@ void run_ng_initial_ue(ngap& ngap_obj, amf_dummy& amf, rrc_nr_dummy& rrc)
   TESTASSERT(rrc.sec_mod_proc_started);
 }
 
+/// Checks that the RNTI and AMF_UE_NGAP_ID indices of the user list follow the users
+void test_ngap_user_list()
+{
+  srsran::task_scheduler task_sched;
+  srslog::basic_logger&  logger = srslog::fetch_basic_logger("NGAP");
+  dummy_socket_manager   rx_sockets;
+  ngap                   ngap_obj(&task_sched, logger, &rx_sockets);
+  ngap_test_access       ngap_access(ngap_obj);
+
+  ngap_test_access::user_list& users = ngap_access.users();
+
+  std::unique_ptr<ngap_test_access::ue> user = ngap_access.make_user(0x47);
+  user->ctxt.amf_ue_ngap_id                   = 10;
+  ngap_test_access::ue*                 ue2  = users.add_user(std::move(user));
+  ngap_test_access::ue*                 ue1  = users.add_user(ngap_access.make_user(0x46));
+  TESTASSERT(ue1 != nullptr and ue2 != nullptr);
+  TESTASSERT(users.find_ue_rnti(0x46) == ue1);
+  TESTASSERT(users.find_ue_gnbid(ue1->ctxt.ran_ue_ngap_id) == ue1);
+  TESTASSERT(users.find_ue_amfid(10) == ue2);
+  TESTASSERT(users.find_ue_rnti(SRSRAN_INVALID_RNTI) == nullptr);
+
+  // Repeated IDs are rejected
+  TESTASSERT(users.add_user(ngap_access.make_user(0x46)) == nullptr);
+  user                      = ngap_access.make_user(0x48);
+  user->ctxt.amf_ue_ngap_id = 10;
+  TESTASSERT(users.add_user(std::move(user)) == nullptr);
+  TESTASSERT(users.size() == 2);
+
+  // AMF_UE_NGAP_ID changes
+  TESTASSERT(not users.set_amfid(ue1, 10));
+  TESTASSERT(users.set_amfid(ue1, 11));
+  TESTASSERT(users.find_ue_amfid(11) == ue1);
+  TESTASSERT(users.set_amfid(ue1, 12));
+  TESTASSERT(users.find_ue_amfid(11) == nullptr and users.find_ue_amfid(12) == ue1);
+
+  // Erased users leave no index entries behind
+  users.erase(ue1);
+  TESTASSERT(users.size() == 1);
+  TESTASSERT(users.find_ue_rnti(0x46) == nullptr);
+  TESTASSERT(users.find_ue_amfid(12) == nullptr);
+  TESTASSERT(users.find_ue_rnti(0x47) == ue2 and users.find_ue_amfid(10) == ue2);
+  ue1 = users.add_user(ngap_access.make_user(0x46));
+  TESTASSERT(ue1 != nullptr and users.find_ue_rnti(0x46) == ue1);
+  TESTASSERT(users.set_amfid(ue1, 12));
+  users.erase(ue2);
+  TESTASSERT(users.find_ue_rnti(0x47) == nullptr and users.find_ue_amfid(10) == nullptr);
+  TESTASSERT(users.find_ue_amfid(12) == ue1);
+}
+
 int main(int argc, char** argv)
 {
   // Setup logging.
@@ -292,6 +367,11 @@ int main(int argc, char** argv)
   logger.set_level(srslog::basic_levels::debug);
   logger.set_hex_dump_max_size(-1);
 
+  // Start the log backend.
+  srsran::test_init(argc, argv);
+
+  test_ngap_user_list();
+
   srsran::task_scheduler task_sched;
   dummy_socket_manager   rx_sockets;
   ngap                   ngap_obj(&task_sched, logger, &rx_sockets);
@@ -315,8 +395,6 @@ int main(int argc, char** argv)
   gtpu_interface_rrc* gtpu = nullptr;
   ngap_obj.init(args, &rrc, gtpu);
 
-  // Start the log backend.
-  srsran::test_init(argc, argv);
   run_ng_setup(ngap_obj, amf);
   run_ng_initial_ue(ngap_obj, amf, rrc);
 }
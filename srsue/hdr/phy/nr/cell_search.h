@@ -25,6 +25,7 @@
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/interfaces/ue_nr_interfaces.h"
 #include "srsran/srsran.h"
+#include <vector>
 
 namespace srsue {
 namespace nr {
@@ -33,7 +34,8 @@ class cell_search
 public:
   struct args_t {
     double                      max_srate_hz;
-    srsran_subcarrier_spacing_t ssb_min_scs = srsran_subcarrier_spacing_15kHz;
+    srsran_subcarrier_spacing_t ssb_min_scs   = srsran_subcarrier_spacing_15kHz;
+    uint32_t                    max_ssb_freqs = 1; ///< Maximum number of SSB center frequencies searched in every slot
   };
 
   struct cfg_t {
@@ -47,6 +49,7 @@ public:
 
   struct ret_t {
     enum { CELL_FOUND = 1, CELL_NOT_FOUND = 0, ERROR = -1 } result;
+    double                  ssb_freq_hz; ///< SSB center frequency the cell was found at
     srsran_ssb_search_res_t ssb_res;
   };
 
@@ -59,8 +62,11 @@ public:
   ret_t run_slot(const cf_t* buffer, uint32_t slot_sz);
 
 private:
-  srslog::basic_logger&        logger;
-  srsran_ssb_t                 ssb    = {};
+  srslog::basic_logger&                logger;
+  srsran_ssb_t                         ssb           = {};
+  uint32_t                             max_ssb_freqs = 1;
+  std::vector<double>                  ssb_freqs_hz; ///< Searched SSB center frequencies, the requested one first
+  std::vector<srsran_ssb_search_res_t> ssb_res;      ///< Search result for each SSB center frequency
 };
 } // namespace nr
 } // namespace srsue
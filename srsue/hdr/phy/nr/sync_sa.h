@@ -47,18 +47,20 @@ class sync_sa : public srsran::thread, public srsran::phy_common_interface
 {
 public:
   struct args_t {
-    double                      srate_hz        = 61.44e6;
-    srsran_subcarrier_spacing_t ssb_min_scs     = srsran_subcarrier_spacing_15kHz;
-    uint32_t                    nof_rx_channels = 1;
-    bool                        disable_cfo     = false;
-    float                       pbch_dmrs_thr   = 0.0f; ///< PBCH DMRS correlation detection threshold (0 means auto)
-    float                       cfo_alpha       = 0.0f; ///< CFO averaging alpha (0 means auto)
-    int                         thread_priority = 1;
+    double                      srate_hz         = 61.44e6;
+    srsran_subcarrier_spacing_t ssb_min_scs      = srsran_subcarrier_spacing_15kHz;
+    uint32_t                    nof_rx_channels  = 1;
+    bool                        disable_cfo      = false;
+    float                       pbch_dmrs_thr    = 0.0f; ///< PBCH DMRS correlation detection threshold (0 means auto)
+    float                       cfo_alpha        = 0.0f; ///< CFO averaging alpha (0 means auto)
+    int                         thread_priority  = 1;
+    uint32_t                    cs_max_ssb_freqs = 1; ///< Maximum number of SSB frequencies searched in every slot
 
     cell_search::args_t get_cell_search() const
     {
       cell_search::args_t ret = {};
       ret.max_srate_hz        = srate_hz;
+      ret.max_ssb_freqs       = cs_max_ssb_freqs;
       return ret;
     }
 
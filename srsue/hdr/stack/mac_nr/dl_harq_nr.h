@@ -26,7 +26,7 @@
 #include "srsran/interfaces/ue_nr_interfaces.h"
 #include "srsran/srslog/logger.h"
 #include "srsue/hdr/stack/mac_nr/mac_nr_interfaces.h"
-#include <mutex>
+#include <atomic>
 
 namespace srsue {
 
@@ -104,10 +104,13 @@ private:
   demux_interface_harq_nr*                                                    demux_unit = nullptr;
   srslog::basic_logger&                                                       logger;
   uint16_t                                                                    last_temporal_crnti = SRSRAN_INVALID_RNTI;
-  dl_harq_metrics_t                                                           metrics             = {};
-  std::mutex                                                                  metrics_mutex;
   uint8_t                                                                     cc_idx = 0;
   pthread_rwlock_t                                                            rwlock;
+
+  // Metrics are updated by PHY workers without locking and read and cleared by the stack
+  std::atomic<uint32_t> metrics_rx_ok    = {0};
+  std::atomic<uint32_t> metrics_rx_ko    = {0};
+  std::atomic<uint32_t> metrics_rx_brate = {0};
 };
 
 typedef std::unique_ptr<dl_harq_entity_nr>                     dl_harq_entity_nr_ptr;
@@ -76,8 +76,6 @@ private:
   static constexpr int32_t MIN_RLC_PDU_LEN =
       5; ///< minimum bytes that need to be available in a MAC PDU for attempting to add another RLC SDU
 
-  srsran::unique_byte_buffer_t rlc_buff = nullptr;
-
   srsran::mac_sch_pdu_nr tx_pdu; /// single MAC PDU for packing
 
   enum bsr_req_t { no_bsr, sbsr_ce, lbsr_ce };
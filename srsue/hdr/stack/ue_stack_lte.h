@@ -30,6 +30,7 @@
 #include "mac_nr/mac_nr.h"
 #include "rrc/rrc.h"
 #include "rrc_nr/rrc_nr.h"
+#include "srsran/adt/pool/obj_pool.h"
 #include "srsran/common/bearer_manager.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/multiqueue.h"
@@ -187,6 +188,7 @@ public:
 
   // Interface for GW
   void write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu) final;
+  void write_sdus(uint32_t eps_bearer_id, ul_sdu_burst_t sdus) final;
   bool has_active_radio_bearer(uint32_t eps_bearer_id) final;
 
   // Interface for RRC
@@ -201,6 +203,7 @@ private:
   void run_thread() final;
   void run_tti_impl(uint32_t tti, uint32_t tti_jump);
   void stop_impl();
+  bool deliver_ul_sdu(const ue_bearer_manager::radio_bearer_t& bearer, srsran::unique_byte_buffer_t sdu);
 
   const uint32_t                  TTI_STAT_PERIOD = 1024;
   const std::chrono::milliseconds TTI_WARN_THRESHOLD_MS{5};
@@ -237,6 +240,15 @@ private:
   gw_interface_stack*      gw     = nullptr;
   phy_interface_stack_nr*  phy_nr = nullptr;
 
+  // Burst of UL SDUs for the same EPS bearer, waiting in the GW queue. The bursts are pooled, as they are too large
+  // to be captured by the task itself. The pool is declared before the task scheduler, which may still hold bursts.
+  struct ul_burst_t {
+    uint32_t                          eps_bearer_id = 0;
+    ue_bearer_manager::radio_bearer_t bearer        = {};
+    ul_sdu_burst_t                    sdus;
+  };
+  srsran::background_obj_pool<ul_burst_t> ul_burst_pool;
+
   // Thread
   static const int                      STACK_MAIN_THREAD_PRIO = 4; // Next lower priority after PHY workers
   srsran::block_queue<stack_metrics_t>  pending_stack_metrics;
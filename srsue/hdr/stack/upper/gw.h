@@ -28,6 +28,7 @@
 #include "srsran/common/interfaces_common.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/ue_gw_interfaces.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include "tft_packet_filter.h"
 #include <atomic>
@@ -37,8 +38,6 @@
 
 namespace srsue {
 
-class stack_interface_gw;
-
 struct gw_args_t {
   struct log_args_t {
     std::string gw_level;
@@ -101,7 +100,13 @@ private:
   uint32_t                                       dl_tput_bytes = 0;
   std::chrono::high_resolution_clock::time_point metrics_tp; // stores time when last metrics have been taken
 
+  // UL packets read from TUN for the same EPS bearer, not yet handed to the stack
+  stack_interface_gw::ul_sdu_burst_t ul_burst;
+  uint32_t                           ul_burst_eps_bearer_id = 0;
+
   void run_thread();
+  void flush_ul_burst();
+  void drop_ul_burst();
   int  init_if(char* err_str);
   int  setup_if_addr4(uint32_t ip_addr, char* err_str);
   int  setup_if_addr6(uint8_t* ipv6_if_id, char* err_str);
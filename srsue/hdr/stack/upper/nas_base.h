@@ -27,6 +27,7 @@
 #include "srsran/common/common.h"
 #include "srsran/common/nas_pcap.h"
 #include "srsran/common/security.h"
+#include "srsran/common/security_key_schedule.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/config.h"
 
@@ -76,6 +77,9 @@ protected:
   nas_sec_ctxt      ctxt      = {};
   nas_5g_sec_ctxt   ctxt_5g   = {};
 
+  // Key schedules of the NAS keys in ctxt_base, rebuilt when a key or algorithm changes
+  srsran::security_key_schedule sec_key_schedule;
+
   int parse_security_algorithm_list(std::string algorithm_string, bool* algorithm_caps);
 
   // Security
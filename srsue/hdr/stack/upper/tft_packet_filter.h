@@ -25,6 +25,7 @@
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <atomic>
 #include <mutex>
 
 namespace srsue {
@@ -63,6 +64,23 @@ const uint8_t IPV6_ADDR_SIZE = 16;
 const uint8_t UDP_PROTOCOL   = 0x11;
 const uint8_t TCP_PROTOCOL   = 0x06;
 
+/// Header fields of an outgoing IP packet that TFT packet filters match against. Parsed once per packet.
+struct tft_ip_header_t {
+  uint8_t        version    = 0;
+  uint8_t        protocol   = 0; // IPv4 protocol or IPv6 next header
+  uint8_t        tos        = 0;
+  bool           has_ports  = false;
+  uint16_t       src_port   = 0; // Network byte order
+  uint16_t       dst_port   = 0; // Network byte order
+  uint32_t       ipv4_saddr = 0;
+  uint32_t       ipv4_daddr = 0;
+  const uint8_t* ipv6_saddr = nullptr;
+  const uint8_t* ipv6_daddr = nullptr;
+  const uint8_t* flow_label = nullptr;
+
+  bool parse(const srsran::byte_buffer_t& pdu);
+};
+
 // TS 24.008 Table 10.5.162
 class tft_packet_filter_t
 {
@@ -70,8 +88,9 @@ public:
   tft_packet_filter_t(uint8_t                                eps_bearer_id_,
                       const LIBLTE_MME_PACKET_FILTER_STRUCT& tft_,
                       srslog::basic_logger&                  logger);
-  bool match(const srsran::unique_byte_buffer_t& pdu);
-  bool filter_contains(uint16_t filtertype);
+  bool match(const srsran::unique_byte_buffer_t& pdu) const;
+  bool match(const tft_ip_header_t& hdr) const;
+  bool filter_contains(uint16_t filtertype) const;
 
   uint8_t  eps_bearer_id             = {};
   uint8_t  id                        = {};
@@ -89,9 +108,9 @@ public:
   uint8_t  ipv6_local_addr_length    = {};
   uint8_t  protocol_id               = {};
   uint16_t single_local_port         = {};
-  uint16_t local_port_range[2]       = {};
+  uint16_t local_port_range[2]       = {}; // Host byte order
   uint16_t single_remote_port        = {};
-  uint16_t remote_port_range[2]      = {};
+  uint16_t remote_port_range[2]      = {}; // Host byte order
   uint32_t security_parameter_index  = {};
   uint8_t  type_of_service           = {};
   uint8_t  type_of_service_mask      = {};
@@ -99,11 +118,11 @@ public:
 
   srslog::basic_logger& logger;
 
-  bool match_ip(const srsran::unique_byte_buffer_t& pdu);
-  bool match_protocol(const srsran::unique_byte_buffer_t& pdu);
-  bool match_type_of_service(const srsran::unique_byte_buffer_t& pdu);
-  bool match_flow_label(const srsran::unique_byte_buffer_t& pdu);
-  bool match_port(const srsran::unique_byte_buffer_t& pdu);
+  bool match_ip(const tft_ip_header_t& hdr) const;
+  bool match_protocol(const tft_ip_header_t& hdr) const;
+  bool match_type_of_service(const tft_ip_header_t& hdr) const;
+  bool match_flow_label(const tft_ip_header_t& hdr) const;
+  bool match_port(const tft_ip_header_t& hdr) const;
 };
 
 /**
@@ -127,6 +146,7 @@ private:
   std::mutex                                      tft_mutex;
   typedef std::map<uint16_t, tft_packet_filter_t> tft_filter_map_t;
   tft_filter_map_t                                tft_filter_map;
+  std::atomic<bool>                               has_filters = {false}; // Lets packets skip the lock without TFTs
 };
 
 } // namespace srsue
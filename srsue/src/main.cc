@@ -85,6 +85,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("ue.phy", bpo::value<string>(&args->phy.type)->default_value("lte"), "Type of the PHY [lte]")
 
     ("rf.srate",        bpo::value<double>(&args->rf.srate_hz)->default_value(0.0),          "Force Tx and Rx sampling rate in Hz")
+    ("rf.resampler",    bpo::value<string>(&args->rf.resampler)->default_value("auto"),      "Resampler for a forced sampling rate (auto, fft, polyphase)")
     ("rf.freq_offset",  bpo::value<float>(&args->rf.freq_offset)->default_value(0),          "(optional) Frequency offset")
     ("rf.rx_gain",      bpo::value<float>(&args->rf.rx_gain)->default_value(-1),             "Front-end receiver gain")
     ("rf.tx_gain",      bpo::value<float>(&args->rf.tx_gain)->default_value(-1),             "Front-end transmitter gain (all channels)")
@@ -446,6 +447,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
       bpo::value<bool>(&args->phy.nr_store_pdsch_ko)->default_value(false),
       "Dumps the PDSCH baseband samples into a file on KO reception.")
 
+    ("phy.nr.cs_max_ssb_freqs",
+      bpo::value<uint32_t>(&args->phy.nr_cs_max_ssb_freqs)->default_value(1),
+      "Maximum number of SSB center frequencies searched in every slot during cell search.")
+
     // UE simulation args
     ("sim.airplane_t_on_ms",
      bpo::value<int>(&args->stack.nas.sim.airplane_t_on_ms)->default_value(-1),
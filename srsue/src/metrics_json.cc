@@ -115,11 +115,16 @@ DECLARE_METRIC("proc_thread_count", metric_thread_count, uint32_t, "");
 DECLARE_METRIC("sys_core_usage", metric_proc_core_usage, uint32_t, "");
 DECLARE_METRIC_SET("cpu_core_container", mset_cpu_core_container, metric_proc_core_usage);
 DECLARE_METRIC_LIST("cpu_core_list", mlist_cpu_core_list, std::vector<mset_cpu_core_container>);
+DECLARE_METRIC("thread_name", metric_thread_name, std::string, "");
+DECLARE_METRIC("thread_cpu_usage", metric_thread_cpu_usage, float, "");
+DECLARE_METRIC_SET("thread_container", mset_thread_container, metric_thread_name, metric_thread_cpu_usage);
+DECLARE_METRIC_LIST("thread_list", mlist_thread_list, std::vector<mset_thread_container>);
 DECLARE_METRIC_SET("sys_cpu_container",
                    mset_sys_cpu_container,
                    metric_proc_cpu_usage,
                    metric_thread_count,
-                   mlist_cpu_core_list);
+                   mlist_cpu_core_list,
+                   mlist_thread_list);
 
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
@@ -237,6 +242,12 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
   for (uint32_t i = 0, e = core_list.size(); i != e; ++i) {
     core_list[i].write<metric_proc_core_usage>(metrics.sys.cpu_load[i]);
   }
+  auto& thread_list = ctx.get<mset_sys_cpu_container>().get<mlist_thread_list>();
+  thread_list.resize(metrics.sys.nof_thread_metrics);
+  for (uint32_t i = 0, e = thread_list.size(); i != e; ++i) {
+    thread_list[i].write<metric_thread_name>(metrics.sys.thread_metrics[i].name.data());
+    thread_list[i].write<metric_thread_cpu_usage>(metrics.sys.thread_metrics[i].cpu_usage);
+  }
 
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
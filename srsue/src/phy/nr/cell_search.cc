@@ -24,6 +24,8 @@
 #include "srsran/common/buffer_pool.h"
 #include "srsran/radio/rf_buffer.h"
 #include "srsran/radio/rf_timestamp.h"
+#include <algorithm>
+#include <cmath>
 
 namespace srsue {
 namespace nr {
@@ -49,6 +51,10 @@ bool cell_search::init(const args_t& args)
     return false;
   }
 
+  max_ssb_freqs = SRSRAN_MAX(1, SRSRAN_MIN(args.max_ssb_freqs, SRSRAN_SSB_MAX_SEARCH_FREQS));
+  ssb_freqs_hz.reserve(max_ssb_freqs);
+  ssb_res.resize(max_ssb_freqs);
+
   return true;
 }
 
@@ -75,6 +81,38 @@ bool cell_search::start(const cfg_t& cfg)
     logger.error("Cell search: Error setting SSB configuration");
     return false;
   }
+
+  // The requested SSB center frequency is searched first
+  ssb_freqs_hz.clear();
+  ssb_freqs_hz.push_back(cfg.ssb_freq_hz);
+  if (max_ssb_freqs == 1) {
+    return true;
+  }
+
+  // Add the sync raster points of the same band that are received in full, aligned to the subcarrier grid
+  srsran::srsran_band_helper                bands;
+  srsran::srsran_band_helper::sync_raster_t sync_raster =
+      bands.get_sync_raster(bands.get_band_from_dl_freq_Hz(cfg.ssb_freq_hz), cfg.ssb_scs);
+  double scs_hz           = SRSRAN_SUBC_SPACING_NR(cfg.ssb_scs);
+  double max_freq_diff_hz = cfg.srate_hz / 2.0 - scs_hz * SRSRAN_SSB_BW_SUBC / 2.0;
+  std::vector<double> raster_freqs_hz;
+  for (; not sync_raster.end(); sync_raster.next()) {
+    double freq_diff_hz = sync_raster.get_frequency() - cfg.center_freq_hz;
+    if (std::abs(freq_diff_hz) <= max_freq_diff_hz and std::abs(std::remainder(freq_diff_hz, scs_hz)) < 1.0 and
+        sync_raster.get_frequency() != cfg.ssb_freq_hz) {
+      raster_freqs_hz.push_back(sync_raster.get_frequency());
+    }
+  }
+
+  // Keep the closest ones to the requested SSB center frequency
+  std::sort(raster_freqs_hz.begin(), raster_freqs_hz.end(), [&cfg](double a, double b) {
+    return std::abs(a - cfg.ssb_freq_hz) < std::abs(b - cfg.ssb_freq_hz);
+  });
+  raster_freqs_hz.resize(SRSRAN_MIN(raster_freqs_hz.size(), max_ssb_freqs - 1));
+  ssb_freqs_hz.insert(ssb_freqs_hz.end(), raster_freqs_hz.begin(), raster_freqs_hz.end());
+
+  logger.info("Cell search: Searching %d SSB center frequencies", (int)ssb_freqs_hz.size());
+
   return true;
 }
 
@@ -82,15 +120,24 @@ cell_search::ret_t cell_search::run_slot(const cf_t* buffer, uint32_t slot_sz)
 {
   cell_search::ret_t ret = {};
 
-  // Search for SSB
-  if (srsran_ssb_search(&ssb, buffer, slot_sz + ssb.ssb_sz, &ret.ssb_res) < SRSRAN_SUCCESS) {
+  // Search for SSB in all the frequencies at once
+  if (srsran_ssb_search_multi(
+          &ssb, buffer, slot_sz + ssb.ssb_sz, ssb_freqs_hz.data(), (uint32_t)ssb_freqs_hz.size(), ssb_res.data()) <
+      SRSRAN_SUCCESS) {
     logger.error("Error occurred searching SSB");
     ret.result = ret_t::ERROR;
-  } else if (ret.ssb_res.measurements.snr_dB >= -10.0f and ret.ssb_res.pbch_msg.crc) {
-    // Consider the SSB is found and decoded if the PBCH CRC matched
-    ret.result = ret_t::CELL_FOUND;
-  } else {
-    ret.result = ret_t::CELL_NOT_FOUND;
+    return ret;
+  }
+
+  // Consider the SSB is found and decoded if the PBCH CRC matched, the requested frequency takes precedence
+  ret.result = ret_t::CELL_NOT_FOUND;
+  for (uint32_t i = 0; i < (uint32_t)ssb_freqs_hz.size(); i++) {
+    if (ssb_res[i].measurements.snr_dB >= -10.0f and ssb_res[i].pbch_msg.crc) {
+      ret.result      = ret_t::CELL_FOUND;
+      ret.ssb_freq_hz = ssb_freqs_hz[i];
+      ret.ssb_res     = ssb_res[i];
+      break;
+    }
   }
   return ret;
 }
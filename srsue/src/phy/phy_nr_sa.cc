@@ -20,6 +20,7 @@
  */
 
 #include "srsue/hdr/phy/phy_nr_sa.h"
+#include "srsran/common/band_helper.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/srsran.h"
 
@@ -106,6 +107,7 @@ void phy_nr_sa::init_background()
   nr::sync_sa::args_t sync_args = {};
   sync_args.srate_hz            = args.srate_hz;
   sync_args.thread_priority     = args.slot_recv_thread_prio;
+  sync_args.cs_max_ssb_freqs    = args.cs_max_ssb_freqs;
   if (not sync.init(sync_args, stack, radio)) {
     logger.error("Error initialising SYNC");
     return;
@@ -189,6 +191,7 @@ bool phy_nr_sa::start_cell_search(const cell_search_args_t& req)
     rrc_interface_phy_nr::cell_search_result_t rrc_cs_ret = {};
     rrc_cs_ret.cell_found                                 = ret.result == nr::cell_search::ret_t::CELL_FOUND;
     if (rrc_cs_ret.cell_found) {
+      rrc_cs_ret.ssb_arfcn    = srsran::srsran_band_helper().freq_to_nr_arfcn(ret.ssb_freq_hz);
       rrc_cs_ret.pci          = ret.ssb_res.N_id;
       rrc_cs_ret.pbch_msg     = ret.ssb_res.pbch_msg;
       rrc_cs_ret.measurements = ret.ssb_res.measurements;
@@ -102,7 +102,7 @@ void demux_nr::handle_pdu(srsran::mac_sch_pdu_nr& pdu_buffer, srsran::unique_byt
 
   bool con_res_rxed = false;
   for (uint32_t i = 0; i < pdu_buffer.get_num_subpdus(); ++i) {
-    srsran::mac_sch_subpdu_nr subpdu = pdu_buffer.get_subpdu(i);
+    srsran::mac_sch_subpdu_nr& subpdu = pdu_buffer.get_subpdu(i);
     logger.debug("Handling subPDU %d/%d: rnti=0x%x lcid=%d, sdu_len=%d",
                  i + 1,
                  pdu_buffer.get_num_subpdus(),
@@ -129,6 +129,7 @@ void demux_nr::handle_pdu(srsran::mac_sch_pdu_nr& pdu_buffer, srsran::unique_byt
       default:
         if (!con_res_rxed or (con_res_rxed and is_uecrid_successful)) {
           if (subpdu.is_sdu()) {
+            // SDUs are handed to RLC as views into the received PDU, no copy is made
             rlc->write_pdu(subpdu.get_lcid(), subpdu.get_sdu(), subpdu.get_sdu_length());
           }
         }
@@ -145,9 +145,10 @@ void dl_harq_entity_nr::reset()
 
 dl_harq_entity_nr::dl_harq_metrics_t dl_harq_entity_nr::get_metrics()
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  dl_harq_metrics_t           tmp = metrics;
-  metrics                         = {};
+  dl_harq_metrics_t tmp = {};
+  tmp.rx_ok             = metrics_rx_ok.exchange(0, std::memory_order_relaxed);
+  tmp.rx_ko             = metrics_rx_ko.exchange(0, std::memory_order_relaxed);
+  tmp.rx_brate          = metrics_rx_brate.exchange(0, std::memory_order_relaxed);
   return tmp;
 }
 
@@ -254,12 +255,10 @@ void dl_harq_entity_nr::dl_harq_process_nr::tb_decoded(const mac_nr_grant_dl_t&
       }
     }
 
-    std::lock_guard<std::mutex> lock(harq_entity->metrics_mutex);
-    harq_entity->metrics.rx_ok++;
-    harq_entity->metrics.rx_brate += grant.tbs * 8;
+    harq_entity->metrics_rx_ok.fetch_add(1, std::memory_order_relaxed);
+    harq_entity->metrics_rx_brate.fetch_add(grant.tbs * 8, std::memory_order_relaxed);
   } else {
-    std::lock_guard<std::mutex> lock(harq_entity->metrics_mutex);
-    harq_entity->metrics.rx_ko++;
+    harq_entity->metrics_rx_ko.fetch_add(1, std::memory_order_relaxed);
   }
 
   logger.info("DL %d:  %s tbs=%d, rv=%d, ack=%s, ndi=%d",
@@ -23,11 +23,15 @@
 #include "srsran/common/test_common.h"
 #include "srsran/test/ue_test_interfaces.h"
 #include "srsue/hdr/stack/mac_nr/mac_nr.h"
+#include <chrono>
 
 using namespace srsue;
 
 #define HAVE_PCAP 0
 #define UE_ID 0
+#define BENCHMARK_NOF_TB 2000
+#define BENCHMARK_TBS 8000
+#define BENCHMARK_NOF_SDU 8
 
 static std::unique_ptr<srsran::mac_pcap> pcap_handle = nullptr;
 
@@ -881,6 +885,115 @@ int mac_nr_dl_retx_test()
   return SRSRAN_SUCCESS;
 }
 
+// MAC-level throughput of UL PDU building and DL PDU demultiplexing with large transport blocks
+int mac_nr_throughput_benchmark()
+{
+  // dummy layers
+  dummy_phy   phy;
+  rlc_dummy   rlc;
+  rrc_dummy   rrc;
+  stack_dummy stack;
+
+  // the actual MAC
+  mac_nr mac(&stack.task_sched);
+
+  mac_nr_args_t args = {};
+  mac.init(args, &phy, &rlc, &rrc);
+
+  srsran::dl_harq_cfg_nr_t harq_cfg;
+  TESTASSERT(mac.set_config(harq_cfg) == SRSRAN_SUCCESS);
+
+  stack.init(&mac, &phy);
+  const uint16_t crnti = 0x1001;
+  mac.set_crnti(crnti);
+
+  srsran::logical_channel_config_t config = {};
+  config.lcid                             = 4;
+  config.lcg                              = 6;
+  config.PBR                              = 0;
+  config.BSD                              = 1000; // 1000ms
+  config.priority                         = 11;
+  TESTASSERT(mac.setup_lcid(config) == SRSRAN_SUCCESS);
+
+  // Logging would dominate the measurement, also let the backend drain the messages of previous tests
+  srslog::fetch_basic_logger("MAC").set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("MAC-NR").set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("RLC").set_level(srslog::basic_levels::warning);
+  srslog::flush();
+
+  // UL: build BENCHMARK_NOF_TB PDUs from a full RLC queue
+  rlc.write_sdu(4, BENCHMARK_NOF_TB * BENCHMARK_TBS);
+  stack.run_tti(0);
+
+  auto t_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < BENCHMARK_NOF_TB; i++) {
+    mac_interface_phy_nr::tb_action_ul_t    ul_action = {};
+    mac_interface_phy_nr::mac_nr_grant_ul_t mac_grant = {};
+    mac_grant.rnti                                    = crnti;
+    mac_grant.pid                                     = i % SRSRAN_MAX_HARQ_PROC_UL_NR;
+    mac_grant.ndi                                     = (i / SRSRAN_MAX_HARQ_PROC_UL_NR) % 2;
+    mac_grant.tbs                                     = BENCHMARK_TBS;
+
+    mac.new_grant_ul(0, mac_grant, &ul_action);
+    TESTASSERT(ul_action.tb.enabled == true);
+    TESTASSERT(ul_action.tb.payload->N_bytes == BENCHMARK_TBS);
+  }
+  auto ul_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
+
+  // DL: the same PDU with BENCHMARK_NOF_SDU SDUs is received in every TB
+  srsran::unique_byte_buffer_t dl_pdu = srsran::make_byte_buffer();
+  TESTASSERT(dl_pdu != nullptr);
+  std::vector<uint8_t>   sdu(BENCHMARK_TBS / BENCHMARK_NOF_SDU - 3, 0x04);
+  srsran::mac_sch_pdu_nr tx_pdu;
+  tx_pdu.init_tx(dl_pdu.get(), BENCHMARK_TBS);
+  for (uint32_t i = 0; i < BENCHMARK_NOF_SDU; i++) {
+    TESTASSERT(tx_pdu.add_sdu(4, sdu.data(), sdu.size()) == SRSRAN_SUCCESS);
+  }
+  tx_pdu.pack();
+  TESTASSERT(dl_pdu->N_bytes == BENCHMARK_TBS);
+
+  uint32_t nof_rx_pdus = rlc.get_received_pdus();
+  t_start              = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < BENCHMARK_NOF_TB; i++) {
+    mac_interface_phy_nr::mac_nr_grant_dl_t mac_grant = {};
+    mac_grant.rnti                                    = crnti;
+    mac_grant.pid                                     = i % harq_cfg.nof_procs;
+    mac_grant.ndi                                     = (i / harq_cfg.nof_procs) % 2;
+    mac_grant.tbs                                     = BENCHMARK_TBS;
+
+    mac_interface_phy_nr::tb_action_dl_t dl_action = {};
+    mac.new_grant_dl(0, mac_grant, &dl_action);
+    TESTASSERT(dl_action.tb.enabled == true);
+
+    // The PHY decodes into a buffer it hands over to MAC
+    mac_interface_phy_nr::tb_action_dl_result_t dl_result = {};
+    dl_result.ack                                         = true;
+    dl_result.payload                                     = srsran::make_byte_buffer();
+    TESTASSERT(dl_result.payload != nullptr);
+    *dl_result.payload = *dl_pdu;
+    mac.tb_decoded(0, mac_grant, std::move(dl_result));
+
+    // process the PDUs in the stack, as it happens once per slot
+    stack.run_tti(i);
+  }
+  auto dl_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
+  TESTASSERT(rlc.get_received_pdus() - nof_rx_pdus == BENCHMARK_NOF_TB * BENCHMARK_NOF_SDU);
+
+  srslog::fetch_basic_logger("MAC").set_level(srslog::basic_levels::debug);
+
+  printf("MAC throughput: UL %.1f Mbps, DL %.1f Mbps (%d TBs of %d B)\n",
+         (double)BENCHMARK_NOF_TB * BENCHMARK_TBS * 8 / (double)SRSRAN_MAX(ul_us, 1),
+         (double)BENCHMARK_NOF_TB * BENCHMARK_TBS * 8 / (double)SRSRAN_MAX(dl_us, 1),
+         BENCHMARK_NOF_TB,
+         BENCHMARK_TBS);
+
+  mac.stop();
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
 #if HAVE_PCAP
@@ -901,6 +1014,7 @@ int main()
 
   TESTASSERT(mac_nr_ul_periodic_bsr_test() == SRSRAN_SUCCESS);
   TESTASSERT(mac_nr_dl_retx_test() == SRSRAN_SUCCESS);
+  TESTASSERT(mac_nr_throughput_benchmark() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
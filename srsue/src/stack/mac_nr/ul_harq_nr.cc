@@ -301,7 +301,14 @@ void ul_harq_entity_nr::ul_harq_process_nr::generate_tx(mac_interface_phy_nr::tb
   action->tb.payload    = harq_buffer.get();
   action->tb.softbuffer = &softbuffer;
 
-  srsran_softbuffer_tx_reset(&softbuffer);
+  // Only clear the code blocks used by this TB, the softbuffer is dimensioned for the largest TB. The LDPC base graph is
+  // not known here, base graph 2 has the shortest code blocks so its segmentation covers both
+  srsran_cbsegm_t cbsegm = {};
+  if (srsran_cbsegm_ldpc_bg2(&cbsegm, current_grant.tbs * 8) == SRSRAN_SUCCESS) {
+    srsran_softbuffer_tx_reset_cb(&softbuffer, cbsegm.C);
+  } else {
+    srsran_softbuffer_tx_reset(&softbuffer);
+  }
 }
 
 } // namespace srsue
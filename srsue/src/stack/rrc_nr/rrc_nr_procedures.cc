@@ -20,6 +20,7 @@
  */
 
 #include "srsue/hdr/stack/rrc_nr/rrc_nr_procedures.h"
+#include "srsran/common/band_helper.h"
 #include "srsran/common/standard_streams.h"
 
 #define Error(fmt, ...) rrc_handle.logger.error("Proc \"%s\" - " fmt, name(), ##__VA_ARGS__)
@@ -454,6 +455,12 @@ rrc_nr::cell_selection_proc::handle_cell_search_result(const rrc_interface_phy_n
   phy_cfg.pdsch.scs_cfg         = mib.scs_common;
   phy_cfg.carrier.pci           = result.pci;
 
+  // The cell may have been found in a sync raster point other than the configured SSB center frequency
+  srsran::srsran_band_helper bands;
+  if (result.ssb_arfcn != 0 and result.ssb_arfcn != bands.freq_to_nr_arfcn(phy_cfg.carrier.ssb_center_freq_hz)) {
+    phy_cfg.carrier.ssb_center_freq_hz = bands.nr_arfcn_to_freq(result.ssb_arfcn);
+  }
+
   // Get pointA and SSB absolute frequencies
   double pointA_abs_freq_Hz = phy_cfg.carrier.dl_center_frequency_hz -
                               phy_cfg.carrier.nof_prb * SRSRAN_NRE * SRSRAN_SUBC_SPACING_NR(phy_cfg.carrier.scs) / 2;
@@ -62,6 +62,9 @@ ue_stack_lte::ue_stack_lte() :
   nas(srslog::fetch_basic_logger("NAS", false), &task_sched),
   nas_5g(srslog::fetch_basic_logger("NAS5G", false), &task_sched),
   thread("STACK"),
+  ul_burst_pool(16, 4, -1, srsran::detail::inplace_default_ctor_operator<ul_burst_t>{}, [](ul_burst_t& burst) {
+    burst.sdus.clear();
+  }),
   task_sched(512, 64),
   tti_tprof("tti_tprof", "STCK", TTI_STAT_PERIOD)
 {
@@ -423,17 +426,8 @@ void ue_stack_lte::write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_
 {
   auto bearer = bearers.get_radio_bearer(eps_bearer_id);
 
-  auto task   = [this, eps_bearer_id, bearer](srsran::unique_byte_buffer_t& sdu) {
-    // route SDU to PDCP entity
-    if (bearer.rat == srsran_rat_t::lte) {
-      pdcp.write_sdu(bearer.lcid, std::move(sdu));
-    } else if (bearer.rat == srsran_rat_t::nr) {
-      if (args.sa_mode) {
-        sdap.write_sdu(bearer.lcid, std::move(sdu));
-      } else {
-        pdcp_nr.write_sdu(bearer.lcid, std::move(sdu));
-      }
-    } else {
+  auto task = [this, eps_bearer_id, bearer](srsran::unique_byte_buffer_t& sdu) {
+    if (not deliver_ul_sdu(bearer, std::move(sdu))) {
       stack_logger.warning("Can't deliver SDU for EPS bearer %d. Dropping it.", eps_bearer_id);
     }
   };
@@ -445,6 +439,60 @@ void ue_stack_lte::write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_
   }
 }
 
+/**
+ * GW calls write_sdus() to push a burst of SDUs for the same EPS bearer to the stack.
+ * The whole burst is delivered to the PDCP entity by a single task, from a pooled buffer.
+ *
+ * @param eps_bearer_id
+ * @param sdus
+ */
+void ue_stack_lte::write_sdus(uint32_t eps_bearer_id, ul_sdu_burst_t sdus)
+{
+  if (sdus.empty()) {
+    return;
+  }
+  srsran::unique_pool_ptr<ul_burst_t> burst = ul_burst_pool.make();
+  burst->eps_bearer_id                      = eps_bearer_id;
+  burst->bearer                             = bearers.get_radio_bearer(eps_bearer_id);
+  burst->sdus                               = std::move(sdus);
+
+  uint32_t nof_sdus = burst->sdus.size();
+  uint32_t lcid     = burst->bearer.lcid;
+
+  auto task = [this](srsran::unique_pool_ptr<ul_burst_t>& burst) {
+    for (srsran::unique_byte_buffer_t& sdu : burst->sdus) {
+      if (not deliver_ul_sdu(burst->bearer, std::move(sdu))) {
+        stack_logger.warning(
+            "Can't deliver %zd SDUs for EPS bearer %d. Dropping them.", burst->sdus.size(), burst->eps_bearer_id);
+        return;
+      }
+    }
+  };
+
+  bool ret = gw_queue_id.try_push(std::bind(task, std::move(burst))).has_value();
+  if (not ret) {
+    pdcp_logger.info("GW burst of %d SDUs with lcid=%d was discarded.", nof_sdus, lcid);
+    ul_dropped_sdus += nof_sdus;
+  }
+}
+
+/// Routes an UL SDU to the PDCP (or SDAP) entity of the given radio bearer. Returns false if the bearer is not valid.
+bool ue_stack_lte::deliver_ul_sdu(const ue_bearer_manager::radio_bearer_t& bearer, srsran::unique_byte_buffer_t sdu)
+{
+  if (bearer.rat == srsran_rat_t::lte) {
+    pdcp.write_sdu(bearer.lcid, std::move(sdu));
+  } else if (bearer.rat == srsran_rat_t::nr) {
+    if (args.sa_mode) {
+      sdap.write_sdu(bearer.lcid, std::move(sdu));
+    } else {
+      pdcp_nr.write_sdu(bearer.lcid, std::move(sdu));
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
 bool ue_stack_lte::has_active_radio_bearer(uint32_t eps_bearer_id)
 {
   return bearers.has_active_radio_bearer(eps_bearer_id);
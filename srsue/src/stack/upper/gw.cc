@@ -32,6 +32,7 @@
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -95,6 +96,7 @@ void gw::stop()
         cnt++;
       }
       wait_thread_finish();
+      drop_ul_burst();
 
       current_ip_addr = 0;
     }
@@ -205,6 +207,7 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
     run_enable = false;
     thread_cancel();
     wait_thread_finish();
+    drop_ul_burst();
   }
   if (pdn_type == LIBLTE_MME_PDN_TYPE_IPV4 || pdn_type == LIBLTE_MME_PDN_TYPE_IPV4V6) {
     err = setup_if_addr4(ip_addr, err_str);
@@ -298,6 +301,21 @@ void gw::run_thread()
       srsran::console("GW pdu buffer full - gw receive thread exiting.\n");
       break;
     }
+
+    if (N_bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      // TUN is drained, hand the burst read so far to the stack and wait for more packets
+      {
+        std::lock_guard<std::mutex> lock(gw_mutex);
+        flush_ul_burst();
+      }
+      struct pollfd pfd = {tun_fd, POLLIN, 0};
+      if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+        logger.error("Failed to poll TUN interface - gw receive thread exiting.");
+        srsran::console("Failed to poll TUN interface - gw receive thread exiting.\n");
+        break;
+      }
+      continue;
+    }
     logger.debug("Read %d bytes from TUN fd=%d, idx=%d", N_bytes, tun_fd, idx);
 
     if (N_bytes <= 0) {
@@ -328,6 +346,9 @@ void gw::run_thread()
         logger.info(pdu->msg, pdu->N_bytes, "TX PDU");
 
         // Make sure UE is attached and has default EPS bearer activated
+        if (default_eps_bearer_id == NOT_ASSIGNED) {
+          flush_ul_burst();
+        }
         while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
           if (!register_wait) {
             logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
@@ -354,6 +375,12 @@ void gw::run_thread()
         uint8_t eps_bearer_id = default_eps_bearer_id;
         tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
 
+        // A burst only carries packets of one EPS bearer
+        if (eps_bearer_id != ul_burst_eps_bearer_id) {
+          flush_ul_burst();
+          ul_burst_eps_bearer_id = eps_bearer_id;
+        }
+
         // Wait for service request if necessary
         while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
           if (!service_wait) {
@@ -371,10 +398,13 @@ void gw::run_thread()
           break;
         }
 
-        // Send PDU directly to PDCP
+        // Collect PDU, the burst is sent to PDCP once TUN is drained
         pdu->set_timestamp();
         ul_tput_bytes += pdu->N_bytes;
-        stack->write_sdu(eps_bearer_id, std::move(pdu));
+        ul_burst.push_back(std::move(pdu));
+        if (ul_burst.full()) {
+          flush_ul_burst();
+        }
         do {
           pdu = srsran::make_byte_buffer();
           if (!pdu) {
@@ -389,10 +419,37 @@ void gw::run_thread()
       }
     } // end of holdering gw_mutex
   }
+
+  // Packets already read are still handed to the stack if the thread exits on an error
+  if (run_enable) {
+    std::lock_guard<std::mutex> lock(gw_mutex);
+    flush_ul_burst();
+  }
   running = false;
   logger.info("GW IP receiver thread exiting.");
 }
 
+void gw::flush_ul_burst()
+{
+  if (ul_burst.empty()) {
+    return;
+  }
+  logger.debug("Writing burst of %zd SDUs for EPS bearer %d", ul_burst.size(), ul_burst_eps_bearer_id);
+  stack->write_sdus(ul_burst_eps_bearer_id, std::move(ul_burst));
+  ul_burst.clear();
+}
+
+void gw::drop_ul_burst()
+{
+  if (ul_burst.empty()) {
+    return;
+  }
+  logger.info("Dropping burst of %zd SDUs for EPS bearer %d read before the receiver thread stopped",
+              ul_burst.size(),
+              ul_burst_eps_bearer_id);
+  ul_burst.clear();
+}
+
 /**************************/
 /* TUN Interface Helpers  */
 /**************************/
@@ -420,7 +477,8 @@ int gw::init_if(char* err_str)
   }
 
   // Construct the TUN device
-  tun_fd = open("/dev/net/tun", O_RDWR);
+  // Non-blocking, so that the receive thread can drain all queued packets before handing them to the stack
+  tun_fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
   logger.info("TUN file descriptor = %d", tun_fd);
   if (0 > tun_fd) {
     err_str = strerror(errno);
@@ -58,21 +58,7 @@ void nas_base::integrity_generate(uint8_t* key_128,
                                   uint32_t msg_len,
                                   uint8_t* mac)
 {
-  switch (ctxt_base.integ_algo) {
-    case INTEGRITY_ALGORITHM_ID_EIA0:
-      break;
-    case INTEGRITY_ALGORITHM_ID_128_EIA1:
-      security_128_eia1(key_128, count, bearer_id, direction, msg, msg_len, mac);
-      break;
-    case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(key_128, count, bearer_id, direction, msg, msg_len, mac);
-      break;
-    case INTEGRITY_ALGORITHM_ID_128_EIA3:
-      security_128_eia3(key_128, count, bearer_id, direction, msg, msg_len, mac);
-      break;
-    default:
-      break;
-  }
+  sec_key_schedule.integrity_generate(ctxt_base.integ_algo, key_128, count, bearer_id, direction, msg, msg_len, mac);
 }
 
 // This function depends to a valid k_nas_int.
@@ -137,99 +123,44 @@ bool nas_base::integrity_check(byte_buffer_t* pdu)
 
 void nas_base::cipher_encrypt(byte_buffer_t* pdu)
 {
-  byte_buffer_t pdu_tmp;
-
   if (ctxt_base.cipher_algo != CIPHERING_ALGORITHM_ID_EEA0) {
     logger.debug("Encrypting PDU. count=%d", ctxt_base.tx_count);
   }
 
-  switch (ctxt_base.cipher_algo) {
-    case CIPHERING_ALGORITHM_ID_EEA0:
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA1:
-      security_128_eea1(&ctxt_base.k_nas_enc[16],
-                        ctxt_base.tx_count,
-                        bearer_id,
-                        SECURITY_DIRECTION_UPLINK,
-                        &pdu->msg[seq_offset + 1],
-                        pdu->N_bytes - seq_offset + 1,
-                        &pdu_tmp.msg[seq_offset + 1]);
-      memcpy(&pdu->msg[seq_offset + 1], &pdu_tmp.msg[seq_offset + 1], pdu->N_bytes - seq_offset + 1);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&ctxt_base.k_nas_enc[16],
-                        ctxt_base.tx_count,
-                        bearer_id,
-                        SECURITY_DIRECTION_UPLINK,
-                        &pdu->msg[seq_offset + 1],
-                        pdu->N_bytes - seq_offset + 1,
-                        &pdu_tmp.msg[seq_offset + 1]);
-      memcpy(&pdu->msg[seq_offset + 1], &pdu_tmp.msg[seq_offset + 1], pdu->N_bytes - seq_offset + 1);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA3:
-      security_128_eea3(&ctxt_base.k_nas_enc[16],
-                        ctxt_base.tx_count,
-                        bearer_id,
-                        SECURITY_DIRECTION_UPLINK,
-                        &pdu->msg[seq_offset + 1],
-                        pdu->N_bytes - seq_offset + 1,
-                        &pdu_tmp.msg[seq_offset + 1]);
-      memcpy(&pdu->msg[seq_offset + 1], &pdu_tmp.msg[seq_offset + 1], pdu->N_bytes - seq_offset + 1);
-      break;
-    default:
-      logger.error("Ciphering algorithm not known");
-      break;
+  // Ciphered in place
+  if (sec_key_schedule.cipher(ctxt_base.cipher_algo,
+                              &ctxt_base.k_nas_enc[16],
+                              ctxt_base.tx_count,
+                              bearer_id,
+                              SECURITY_DIRECTION_UPLINK,
+                              &pdu->msg[seq_offset + 1],
+                              pdu->N_bytes - seq_offset + 1,
+                              &pdu->msg[seq_offset + 1]) != SRSRAN_SUCCESS) {
+    logger.error("Ciphering algorithm not known");
   }
 }
 
 void nas_base::cipher_decrypt(byte_buffer_t* pdu)
 {
-  byte_buffer_t tmp_pdu;
-
   uint32_t count_est = (ctxt_base.rx_count & 0x00FFFF00u) | pdu->msg[5];
-  if (ctxt_base.cipher_algo != CIPHERING_ALGORITHM_ID_EEA0) {
-    logger.debug("Decrypting PDU. Local: count=%d, Received: count=%d", ctxt_base.rx_count, count_est);
+  if (ctxt_base.cipher_algo == CIPHERING_ALGORITHM_ID_EEA0) {
+    return;
   }
-
-  switch (ctxt_base.cipher_algo) {
-    case CIPHERING_ALGORITHM_ID_EEA0:
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA1:
-      security_128_eea1(&ctxt_base.k_nas_enc[16],
-                        count_est,
-                        bearer_id,
-                        SECURITY_DIRECTION_DOWNLINK,
-                        &pdu->msg[seq_offset + 1],
-                        pdu->N_bytes - seq_offset + 1,
-                        &tmp_pdu.msg[seq_offset + 1]);
-      memcpy(&pdu->msg[seq_offset + 1], &tmp_pdu.msg[seq_offset + 1], pdu->N_bytes - seq_offset + 1);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&ctxt_base.k_nas_enc[16],
-                        count_est,
-                        bearer_id,
-                        SECURITY_DIRECTION_DOWNLINK,
-                        &pdu->msg[seq_offset + 1],
-                        pdu->N_bytes - seq_offset + 1,
-                        &tmp_pdu.msg[seq_offset + 1]);
-      logger.debug(tmp_pdu.msg, pdu->N_bytes, "Decrypted");
-      memcpy(&pdu->msg[seq_offset + 1], &tmp_pdu.msg[seq_offset + 1], pdu->N_bytes - seq_offset + 1);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA3:
-      security_128_eea3(&ctxt_base.k_nas_enc[16],
-                        count_est,
-                        bearer_id,
-                        SECURITY_DIRECTION_DOWNLINK,
-                        &pdu->msg[seq_offset + 1],
-                        pdu->N_bytes - seq_offset + 1,
-                        &tmp_pdu.msg[seq_offset + 1]);
-      logger.debug(tmp_pdu.msg, pdu->N_bytes, "Decrypted");
-      memcpy(&pdu->msg[seq_offset + 1], &tmp_pdu.msg[seq_offset + 1], pdu->N_bytes - seq_offset + 1);
-      break;
-    default:
-      logger.error("Ciphering algorithms not known");
-      break;
+  logger.debug("Decrypting PDU. Local: count=%d, Received: count=%d", ctxt_base.rx_count, count_est);
+
+  // Deciphered in place
+  if (sec_key_schedule.cipher(ctxt_base.cipher_algo,
+                              &ctxt_base.k_nas_enc[16],
+                              count_est,
+                              bearer_id,
+                              SECURITY_DIRECTION_DOWNLINK,
+                              &pdu->msg[seq_offset + 1],
+                              pdu->N_bytes - seq_offset + 1,
+                              &pdu->msg[seq_offset + 1]) != SRSRAN_SUCCESS) {
+    logger.error("Ciphering algorithms not known");
+    return;
   }
+  logger.debug(pdu->msg, pdu->N_bytes, "Decrypted");
 }
 
-} // namespace srsue
\ No newline at end of file
+} // namespace srsue
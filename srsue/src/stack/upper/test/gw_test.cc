@@ -24,7 +24,11 @@
 #include "srsran/srslog/srslog.h"
 #include "srsue/hdr/stack/upper/gw.h"
 
+#include <algorithm>
 #include <arpa/inet.h>
+#include <atomic>
+#include <mutex>
+#include <unistd.h>
 
 class test_stack_dummy : public srsue::stack_interface_gw
 {
@@ -72,11 +76,117 @@ int gw_test()
   return SRSRAN_SUCCESS;
 }
 
+/// Counts the UDP packets to the given port that the GW hands over, and how they are grouped in bursts.
+class test_stack_burst : public srsue::stack_interface_gw
+{
+public:
+  explicit test_stack_burst(uint16_t port_) : port(port_) {}
+
+  bool is_registered() override { return true; }
+  bool start_service_request() override { return true; }
+  void write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu) override
+  {
+    ul_sdu_burst_t sdus;
+    sdus.push_back(std::move(sdu));
+    write_sdus(eps_bearer_id, std::move(sdus));
+  }
+  void write_sdus(uint32_t eps_bearer_id, ul_sdu_burst_t sdus) override
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint32_t                    nof_test_sdus = 0;
+    for (const srsran::unique_byte_buffer_t& sdu : sdus) {
+      // IPv4 UDP datagrams to the test port, other traffic (e.g. IPv6 router solicitations) is ignored
+      uint32_t ihl = (sdu->msg[0] & 0x0fU) * 4;
+      if ((sdu->msg[0] >> 4U) == 4 and sdu->msg[9] == IPPROTO_UDP and sdu->N_bytes >= ihl + 8 and
+          ((sdu->msg[ihl + 2] << 8U) | sdu->msg[ihl + 3]) == port) {
+        nof_test_sdus++;
+      }
+    }
+    if (nof_test_sdus > 0) {
+      eps_bearer_ids_ok &= eps_bearer_id == expected_eps_bearer_id;
+      max_burst_size = std::max(max_burst_size, (uint32_t)sdus.size());
+      nof_bursts++;
+      nof_sdus += nof_test_sdus;
+    }
+  }
+  bool has_active_radio_bearer(uint32_t eps_bearer_id) override { return true; }
+
+  const uint16_t        port;
+  uint32_t              expected_eps_bearer_id = 0;
+  std::mutex            mutex;
+  std::atomic<uint32_t> nof_sdus{0};
+  uint32_t              nof_bursts        = 0;
+  uint32_t              max_burst_size    = 0;
+  bool                  eps_bearer_ids_ok = true;
+};
+
+int gw_ul_burst_test()
+{
+  const uint16_t port     = 5005;
+  const uint32_t nof_pkts = 200;
+
+  srsue::gw_args_t gw_args;
+  gw_args.tun_dev_name     = "tun_burst";
+  gw_args.tun_dev_netmask  = "255.255.255.0";
+  gw_args.log.gw_level     = "warning";
+  gw_args.log.gw_hex_limit = 0;
+  test_stack_burst stack(port);
+  srsue::gw        gw(srslog::fetch_basic_logger("GW"));
+  gw.init(gw_args, &stack);
+
+  uint32_t eps_bearer_id       = 5;
+  stack.expected_eps_bearer_id = eps_bearer_id;
+
+  struct in_addr in_addr;
+  if (inet_pton(AF_INET, "192.168.57.32", &in_addr.s_addr) != 1) {
+    perror("inet_pton");
+    return SRSRAN_ERROR;
+  }
+  char* err_str = nullptr;
+  if (gw.setup_if_addr(eps_bearer_id, LIBLTE_MME_PDN_TYPE_IPV4, htonl(in_addr.s_addr), nullptr, err_str) !=
+      SRSRAN_SUCCESS) {
+    srslog::fetch_basic_logger("TEST", false)
+        .error("Failed to setup GW interface. Not possible to test UL bursts. Try to execute with sudo rights.");
+    gw.stop();
+    return SRSRAN_SUCCESS;
+  }
+
+  // Datagrams to another address of the TUN subnet are routed through the interface, i.e. read by the GW
+  int sock = socket(AF_INET, SOCK_DGRAM, 0);
+  TESTASSERT(sock >= 0);
+  struct sockaddr_in dst = {};
+  dst.sin_family         = AF_INET;
+  dst.sin_port           = htons(port);
+  TESTASSERT(inet_pton(AF_INET, "192.168.57.33", &dst.sin_addr) == 1);
+  uint8_t payload[100] = {};
+  for (uint32_t i = 0; i < nof_pkts; ++i) {
+    TESTASSERT(sendto(sock, payload, sizeof(payload), 0, (struct sockaddr*)&dst, sizeof(dst)) == sizeof(payload));
+  }
+  close(sock);
+
+  for (uint32_t i = 0; i < 100 and stack.nof_sdus < nof_pkts; ++i) {
+    usleep(10000);
+  }
+  gw.stop();
+
+  // Every packet is handed over once, in bursts of the same EPS bearer no larger than the limit
+  printf("%d packets handed over in %d bursts (max. %d)\n",
+         stack.nof_sdus.load(),
+         stack.nof_bursts,
+         stack.max_burst_size);
+  TESTASSERT(stack.nof_sdus == nof_pkts);
+  TESTASSERT(stack.eps_bearer_ids_ok);
+  TESTASSERT(stack.max_burst_size <= srsue::stack_interface_gw::max_ul_sdu_burst);
+  TESTASSERT(stack.nof_bursts >= nof_pkts / srsue::stack_interface_gw::max_ul_sdu_burst);
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srslog::init();
 
   TESTASSERT(gw_test() == SRSRAN_SUCCESS);
+  TESTASSERT(gw_ul_burst_test() == SRSRAN_SUCCESS);
 
   return SRSRAN_SUCCESS;
 }
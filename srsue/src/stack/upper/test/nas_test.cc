@@ -30,6 +30,8 @@
 #include "srsue/hdr/stack/upper/test/nas_test_common.h"
 #include "srsue/hdr/stack/upper/usim.h"
 #include "srsue/hdr/stack/upper/usim_base.h"
+#include <chrono>
+#include <random>
 
 using namespace srsue;
 using namespace srsran;
@@ -292,6 +294,169 @@ int dedicated_eps_bearer_test()
   return SRSRAN_SUCCESS;
 }
 
+/// Simulated UE that only holds a NAS security context, used to benchmark the NAS security procedures.
+class nas_sec_bench_ue : public srsue::nas_base
+{
+public:
+  nas_sec_bench_ue(srslog::basic_logger& logger_, std::mt19937& rgen) : nas_base(logger_, 1, 5, 0)
+  {
+    for (uint32_t i = 0; i < 32; i++) {
+      ctxt_base.k_nas_enc[i] = rgen();
+      ctxt_base.k_nas_int[i] = rgen();
+    }
+  }
+
+  void set_algos(CIPHERING_ALGORITHM_ID_ENUM cipher_algo, INTEGRITY_ALGORITHM_ID_ENUM integ_algo)
+  {
+    ctxt_base.cipher_algo = cipher_algo;
+    ctxt_base.integ_algo  = integ_algo;
+    ctxt_base.tx_count    = 0;
+    ctxt_base.rx_count    = 0;
+  }
+
+  // Ciphers and integrity protects an UL message, as nas::apply_security_config() does
+  void protect_ul(byte_buffer_t* pdu)
+  {
+    pdu->msg[5] = ctxt_base.tx_count & 0xff;
+    cipher_encrypt(pdu);
+    integrity_generate(&ctxt_base.k_nas_int[16],
+                       ctxt_base.tx_count,
+                       SECURITY_DIRECTION_UPLINK,
+                       &pdu->msg[5],
+                       pdu->N_bytes - 5,
+                       &pdu->msg[1]);
+    ctxt_base.tx_count++;
+  }
+
+  // Checks and deciphers a DL message, as nas::write_pdu() does
+  bool unprotect_dl(byte_buffer_t* pdu)
+  {
+    if (not integrity_check(pdu)) {
+      return false;
+    }
+    cipher_decrypt(pdu);
+    return true;
+  }
+
+  // Same work as protect_ul() and unprotect_dl(), but calling the EIA/EEA functions directly
+  void protect_ul_ref(byte_buffer_t* pdu) { protect_ref(pdu, ctxt_base.tx_count, SECURITY_DIRECTION_UPLINK); }
+  void protect_dl_ref(byte_buffer_t* pdu) { protect_ref(pdu, ctxt_base.rx_count, SECURITY_DIRECTION_DOWNLINK); }
+
+private:
+  void protect_ref(byte_buffer_t* pdu, uint32_t count, uint8_t direction)
+  {
+    uint8_t  tmp[SRSRAN_MAX_BUFFER_SIZE_BYTES];
+    uint32_t len = pdu->N_bytes - 6;
+    pdu->msg[5]  = count & 0xff;
+    switch (ctxt_base.cipher_algo) {
+      case CIPHERING_ALGORITHM_ID_128_EEA1:
+        security_128_eea1(&ctxt_base.k_nas_enc[16], count, 0, direction, &pdu->msg[6], len, tmp);
+        break;
+      case CIPHERING_ALGORITHM_ID_128_EEA2:
+        security_128_eea2(&ctxt_base.k_nas_enc[16], count, 0, direction, &pdu->msg[6], len, tmp);
+        break;
+      case CIPHERING_ALGORITHM_ID_128_EEA3:
+        security_128_eea3(&ctxt_base.k_nas_enc[16], count, 0, direction, &pdu->msg[6], len, tmp);
+        break;
+      default:
+        memcpy(tmp, &pdu->msg[6], len);
+        break;
+    }
+    memcpy(&pdu->msg[6], tmp, len);
+    switch (ctxt_base.integ_algo) {
+      case INTEGRITY_ALGORITHM_ID_128_EIA1:
+        security_128_eia1(&ctxt_base.k_nas_int[16], count, 0, direction, &pdu->msg[5], pdu->N_bytes - 5, &pdu->msg[1]);
+        break;
+      case INTEGRITY_ALGORITHM_ID_128_EIA2:
+        security_128_eia2(&ctxt_base.k_nas_int[16], count, 0, direction, &pdu->msg[5], pdu->N_bytes - 5, &pdu->msg[1]);
+        break;
+      case INTEGRITY_ALGORITHM_ID_128_EIA3:
+        security_128_eia3(&ctxt_base.k_nas_int[16], count, 0, direction, &pdu->msg[5], pdu->N_bytes - 5, &pdu->msg[1]);
+        break;
+      default:
+        break;
+    }
+  }
+};
+
+// Many UEs with their own security context repeatedly exchanging protected NAS messages
+int nas_security_benchmark()
+{
+  const uint32_t        nof_ues = 100, nof_rounds = 100, msg_len = 40;
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("NAS-SEC", false);
+  logger.set_level(srslog::basic_levels::warning);
+
+  std::mt19937                                   rgen(1234);
+  std::vector<std::unique_ptr<nas_sec_bench_ue> > ues;
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    ues.emplace_back(new nas_sec_bench_ue(logger, rgen));
+  }
+
+  // Plain NAS message: security header, MAC, SEQ and payload
+  byte_buffer_t              plain_msg, ul_msg, dl_msg;
+  std::vector<byte_buffer_t> dl_msgs(nof_ues);
+  plain_msg.N_bytes = msg_len;
+  for (uint32_t i = 0; i < msg_len; i++) {
+    plain_msg.msg[i] = rgen();
+  }
+  plain_msg.msg[0] = 0x27;
+  memset(&plain_msg.msg[1], 0, 5);
+
+  for (uint32_t algo = 1; algo < 4; algo++) {
+    // Check the NAS security procedures against the reference implementation
+    for (uint32_t i = 0; i < nof_ues; i++) {
+      ues[i]->set_algos((CIPHERING_ALGORITHM_ID_ENUM)algo, (INTEGRITY_ALGORITHM_ID_ENUM)algo);
+      dl_msg = plain_msg;
+      ues[i]->protect_ul_ref(&dl_msg);
+      ul_msg = plain_msg;
+      ues[i]->protect_ul(&ul_msg);
+      TESTASSERT(ul_msg.N_bytes == dl_msg.N_bytes and memcmp(ul_msg.msg, dl_msg.msg, ul_msg.N_bytes) == 0);
+
+      dl_msgs[i] = plain_msg;
+      ues[i]->protect_dl_ref(&dl_msgs[i]);
+      dl_msg = dl_msgs[i];
+      TESTASSERT(ues[i]->unprotect_dl(&dl_msg));
+      TESTASSERT(memcmp(&dl_msg.msg[6], &plain_msg.msg[6], msg_len - 6) == 0);
+    }
+
+    // Reference: EIA/EEA functions called directly, i.e. the key is expanded for every message
+    auto tp = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < nof_rounds; r++) {
+      for (auto& ue : ues) {
+        ul_msg = plain_msg;
+        ue->protect_ul_ref(&ul_msg);
+        dl_msg = plain_msg;
+        ue->protect_dl_ref(&dl_msg);
+      }
+    }
+    auto ref_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp).count();
+
+    // NAS security procedures with the cached key schedules
+    tp = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < nof_rounds; r++) {
+      for (uint32_t i = 0; i < nof_ues; i++) {
+        ul_msg = plain_msg;
+        ues[i]->protect_ul(&ul_msg);
+        dl_msg = dl_msgs[i];
+        TESTASSERT(ues[i]->unprotect_dl(&dl_msg));
+      }
+    }
+    auto nas_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp).count();
+
+    printf("NAS security benchmark EEA%d/EIA%d: %d UEs, %d UL+DL messages each. Reference: %.0f ns/msg, NAS: %.0f "
+           "ns/msg\n",
+           algo,
+           algo,
+           nof_ues,
+           nof_rounds,
+           ref_ns / (2.0 * nof_ues * nof_rounds),
+           nas_ns / (2.0 * nof_ues * nof_rounds));
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   // Setup logging.
@@ -315,6 +480,7 @@ int main(int argc, char** argv)
   TESTASSERT(security_command_test() == SRSRAN_SUCCESS);
   TESTASSERT(esm_info_request_test() == SRSRAN_SUCCESS);
   TESTASSERT(dedicated_eps_bearer_test() == SRSRAN_SUCCESS);
+  TESTASSERT(nas_security_benchmark() == SRSRAN_SUCCESS);
 
   return SRSRAN_SUCCESS;
 }
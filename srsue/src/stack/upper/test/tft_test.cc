@@ -409,6 +409,124 @@ int tft_filter_test_ipv4_tos()
   return 0;
 }
 
+int tft_filter_test_port_range()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+
+  srsran::unique_byte_buffer_t ip_msg1, ip_msg2;
+  ip_msg1 = make_byte_buffer();
+  TESTASSERT(ip_msg1 != nullptr);
+  ip_msg2 = make_byte_buffer();
+  TESTASSERT(ip_msg2 != nullptr);
+
+  // Filter length:     5 bytes
+  // Filter type:       Local port range
+  // Local port range:  2500 - 2000 (wrong order)
+  uint8_t local_filter_message[5];
+  local_filter_message[0] = LOCAL_PORT_RANGE_TYPE;
+  srsran::uint16_to_uint8(2500, &local_filter_message[1]);
+  srsran::uint16_to_uint8(2000, &local_filter_message[3]);
+
+  // Filter length:     5 bytes
+  // Filter type:       Remote port range
+  // Remote port range: 8500 - 9500
+  uint8_t remote_filter_message[5];
+  remote_filter_message[0] = REMOTE_PORT_RANGE_TYPE;
+  srsran::uint16_to_uint8(8500, &remote_filter_message[1]);
+  srsran::uint16_to_uint8(9500, &remote_filter_message[3]);
+
+  // Set IP test message
+  ip_msg1->N_bytes = ip_message_len1;
+  memcpy(ip_msg1->msg, ip_tst_message1, ip_message_len1);
+  logger.info(ip_msg1->msg, ip_msg1->N_bytes, "IP test message");
+
+  // Set IP test message
+  ip_msg2->N_bytes = ip_message_len2;
+  memcpy(ip_msg2->msg, ip_tst_message2, ip_message_len2);
+  logger.info(ip_msg2->msg, ip_msg2->N_bytes, "IP test message");
+
+  // Packet filters
+  LIBLTE_MME_PACKET_FILTER_STRUCT packet_filter;
+
+  packet_filter.dir             = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+  packet_filter.id              = 1;
+  packet_filter.eval_precedence = 0;
+  packet_filter.filter_size     = 5;
+  memcpy(packet_filter.filter, local_filter_message, 5);
+  srsue::tft_packet_filter_t local_filter(EPS_BEARER_ID, packet_filter, logger);
+
+  packet_filter.id              = 2;
+  packet_filter.eval_precedence = 1;
+  memcpy(packet_filter.filter, remote_filter_message, 5);
+  srsue::tft_packet_filter_t remote_filter(EPS_BEARER_ID, packet_filter, logger);
+
+  // Check filters
+  TESTASSERT(local_filter.match(ip_msg1));
+  TESTASSERT(!local_filter.match(ip_msg2));
+  TESTASSERT(!remote_filter.match(ip_msg1));
+  TESTASSERT(remote_filter.match(ip_msg2));
+
+  printf("Test TFT packet filter port range successfull\n");
+  return 0;
+}
+
+int tft_filter_test_ipv6_remote_prefix()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+
+  srsran::unique_byte_buffer_t ip_msg1, ip_msg2, ip_msg3;
+  ip_msg1 = make_byte_buffer();
+  TESTASSERT(ip_msg1 != nullptr);
+  ip_msg2 = make_byte_buffer();
+  TESTASSERT(ip_msg2 != nullptr);
+  ip_msg3 = make_byte_buffer();
+  TESTASSERT(ip_msg3 != nullptr);
+
+  // Filter length:  18 bytes
+  // Filter type:    IPv6 remote address/prefix length
+  // Remote address: 2a02:14f:ffc0:51::
+  // Prefix length:  64
+  uint8_t filter_message[18];
+  filter_message[0] = IPV6_REMOTE_ADDR_LENGTH_TYPE;
+  inet_pton(AF_INET6, "2a02:14f:ffc0:51::", &filter_message[1]);
+  filter_message[17] = 64;
+
+  // Set IP test message
+  ip_msg1->N_bytes = sizeof(ipv6_matched_packet);
+  memcpy(ip_msg1->msg, ipv6_matched_packet, sizeof(ipv6_matched_packet));
+  logger.info(ip_msg1->msg, ip_msg1->N_bytes, "IPv6 test message - match");
+
+  // Set IP test message, differs from the filter address only in the interface ID
+  ip_msg2->N_bytes = sizeof(ipv6_unmatched_packet_daddr);
+  memcpy(ip_msg2->msg, ipv6_unmatched_packet_daddr, sizeof(ipv6_unmatched_packet_daddr));
+  logger.info(ip_msg2->msg, ip_msg2->N_bytes, "IPv6 test message - match prefix");
+
+  // Set IP test message, remote address outside of the prefix
+  ip_msg3->N_bytes = sizeof(ipv6_matched_packet);
+  memcpy(ip_msg3->msg, ipv6_matched_packet, sizeof(ipv6_matched_packet));
+  ip_msg3->msg[31] ^= 0x01;
+  logger.info(ip_msg3->msg, ip_msg3->N_bytes, "IPv6 test message - unmatched prefix");
+
+  // Packet filter
+  LIBLTE_MME_PACKET_FILTER_STRUCT packet_filter;
+
+  packet_filter.dir             = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+  packet_filter.id              = 1;
+  packet_filter.eval_precedence = 0;
+  packet_filter.filter_size     = sizeof(filter_message);
+  memcpy(packet_filter.filter, filter_message, sizeof(filter_message));
+
+  srsue::tft_packet_filter_t filter(EPS_BEARER_ID, packet_filter, logger);
+
+  // Check filter
+  TESTASSERT(filter.match(ip_msg1));
+  TESTASSERT(filter.match(ip_msg2));
+  TESTASSERT(!filter.match(ip_msg3));
+
+  printf("Test TFT filter IPv6 remote prefix successfull\n");
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT", false);
@@ -435,4 +553,10 @@ int main(int argc, char** argv)
   if (tft_filter_test_ipv6_combined()) {
     return -1;
   }
+  if (tft_filter_test_port_range()) {
+    return -1;
+  }
+  if (tft_filter_test_ipv6_remote_prefix()) {
+    return -1;
+  }
 }
@@ -26,12 +26,63 @@ extern "C" {
 #include "srsran/config.h"
 }
 
+#include <arpa/inet.h>
 #include <linux/ip.h>
-#include <linux/tcp.h>
-#include <linux/udp.h>
 
 namespace srsue {
 
+bool tft_ip_header_t::parse(const srsran::byte_buffer_t& pdu)
+{
+  *this = {};
+  if (pdu.N_bytes == 0) {
+    return false;
+  }
+
+  uint32_t l4_offset = 0;
+  version            = pdu.msg[0] >> 4U;
+  if (version == 4) {
+    if (pdu.N_bytes < sizeof(iphdr)) {
+      return false;
+    }
+    const iphdr* ip_pkt = (const iphdr*)pdu.msg;
+    protocol            = ip_pkt->protocol;
+    tos                 = ip_pkt->tos;
+    ipv4_saddr          = ip_pkt->saddr;
+    ipv4_daddr          = ip_pkt->daddr;
+    l4_offset           = ip_pkt->ihl * 4;
+  } else if (version == 6) {
+    if (pdu.N_bytes < sizeof(ipv6hdr)) {
+      return false;
+    }
+    const ipv6hdr* ip6_pkt = (const ipv6hdr*)pdu.msg;
+    protocol               = ip6_pkt->nexthdr;
+    ipv6_saddr             = ip6_pkt->saddr.s6_addr;
+    ipv6_daddr             = ip6_pkt->daddr.s6_addr;
+    flow_label             = ip6_pkt->flow_lbl;
+    l4_offset              = sizeof(ipv6hdr);
+  } else {
+    return false;
+  }
+
+  // Source and destination port are the first two fields of both the UDP and the TCP header
+  if ((protocol == UDP_PROTOCOL || protocol == TCP_PROTOCOL) && pdu.N_bytes >= l4_offset + 4) {
+    memcpy(&src_port, &pdu.msg[l4_offset], 2);
+    memcpy(&dst_port, &pdu.msg[l4_offset + 2], 2);
+    has_ports = true;
+  }
+  return true;
+}
+
+static bool match_ipv6_addr(const uint8_t* addr, const uint8_t* filter_addr, const uint8_t* mask)
+{
+  // filter_addr is stored pre-masked, so compare as two 64-bit words
+  uint64_t a[2], f[2], m[2];
+  memcpy(a, addr, IPV6_ADDR_SIZE);
+  memcpy(f, filter_addr, IPV6_ADDR_SIZE);
+  memcpy(m, mask, IPV6_ADDR_SIZE);
+  return (a[0] & m[0]) == f[0] && (a[1] & m[1]) == f[1];
+}
+
 tft_packet_filter_t::tft_packet_filter_t(uint8_t                                eps_bearer_id_,
                                          const LIBLTE_MME_PACKET_FILTER_STRUCT& tft,
                                          srslog::basic_logger&                  logger) :
@@ -124,6 +175,8 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
         active_filters |= LOCAL_PORT_RANGE_FLAG;
         memcpy(&local_port_range[0], &tft.filter[idx], 2);
         memcpy(&local_port_range[1], &tft.filter[idx + 2], 2);
+        local_port_range[0] = ntohs(local_port_range[0]);
+        local_port_range[1] = ntohs(local_port_range[1]);
         if (local_port_range[0] > local_port_range[1]) { // wrong order
           uint16_t t          = local_port_range[0];
           local_port_range[0] = local_port_range[1];
@@ -136,6 +189,8 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
         active_filters |= REMOTE_PORT_RANGE_FLAG;
         memcpy(&remote_port_range[0], &tft.filter[idx], 2);
         memcpy(&remote_port_range[1], &tft.filter[idx + 2], 2);
+        remote_port_range[0] = ntohs(remote_port_range[0]);
+        remote_port_range[1] = ntohs(remote_port_range[1]);
         if (remote_port_range[0] > remote_port_range[1]) { // wrong order
           uint16_t t           = remote_port_range[0];
           remote_port_range[0] = remote_port_range[1];
@@ -176,9 +231,17 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
         return;
     }
   }
+
+  // Pre-mask the addresses so that matching a packet only needs to mask the packet side
+  ipv4_local_addr &= ipv4_local_addr_mask;
+  ipv4_remote_addr &= ipv4_remote_addr_mask;
+  for (uint32_t i = 0; i < IPV6_ADDR_SIZE; i++) {
+    ipv6_local_addr[i] &= ipv6_local_addr_mask[i];
+    ipv6_remote_addr[i] &= ipv6_remote_addr_mask[i];
+  }
 }
 
-bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype)
+bool tft_packet_filter_t::filter_contains(uint16_t filtertype) const
 {
   return (active_filters & filtertype) != 0;
 }
@@ -191,7 +254,16 @@ bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype)
  *
  * Note: 'active_filters' is a bitmask; bits set to '1' represent active filter components.
  */
-bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu) const
+{
+  tft_ip_header_t hdr;
+  if (active_filters == 0 || not hdr.parse(*pdu)) {
+    return false;
+  }
+  return match(hdr);
+}
+
+bool tft_packet_filter_t::match(const tft_ip_header_t& hdr) const
 {
   uint16_t ip_flags = IPV4_REMOTE_ADDR_FLAG | IPV4_LOCAL_ADDR_FLAG | IPV6_REMOTE_ADDR_FLAG |
                       IPV6_REMOTE_ADDR_LENGTH_FLAG | IPV6_LOCAL_ADDR_LENGTH_FLAG;
@@ -204,78 +276,47 @@ bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu)
   }
 
   // Match IP Header to active filters
-  if (filter_contains(ip_flags) && !match_ip(pdu)) {
+  if (filter_contains(ip_flags) && !match_ip(hdr)) {
     return false;
   }
 
   // Check Protocol ID/Next Header Field
-  if (filter_contains(PROTOCOL_ID_FLAG) && !match_protocol(pdu)) {
+  if (filter_contains(PROTOCOL_ID_FLAG) && !match_protocol(hdr)) {
     return false;
   }
 
   // Check Ports/Port Range
-  if (filter_contains(port_flags) && !match_port(pdu)) {
+  if (filter_contains(port_flags) && !match_port(hdr)) {
     return false;
   }
 
   // Check Type of Service/Traffic class
-  if (filter_contains(TYPE_OF_SERVICE_FLAG) && !match_type_of_service(pdu)) {
+  if (filter_contains(TYPE_OF_SERVICE_FLAG) && !match_type_of_service(hdr)) {
     return false;
   }
 
   return true;
 }
 
-bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_ip(const tft_ip_header_t& hdr) const
 {
-  struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
   // It is implied, that this is always an OUTGOING packet
-  if (ip_pkt->version == 4) {
+  if (hdr.version == 4) {
     // Check match on IPv4 packet
-    if (filter_contains(IPV4_LOCAL_ADDR_FLAG)) {
-      if ((ip_pkt->saddr & ipv4_local_addr_mask) != (ipv4_local_addr & ipv4_local_addr_mask)) {
-        return false;
-      }
+    if (filter_contains(IPV4_LOCAL_ADDR_FLAG) && (hdr.ipv4_saddr & ipv4_local_addr_mask) != ipv4_local_addr) {
+      return false;
     }
-
-    if (filter_contains(IPV4_REMOTE_ADDR_FLAG)) {
-      if ((ip_pkt->daddr & ipv4_remote_addr_mask) != (ipv4_remote_addr & ipv4_remote_addr_mask)) {
-        return false;
-      }
+    if (filter_contains(IPV4_REMOTE_ADDR_FLAG) && (hdr.ipv4_daddr & ipv4_remote_addr_mask) != ipv4_remote_addr) {
+      return false;
     }
-  } else if (ip_pkt->version == 6) {
+  } else if (hdr.version == 6) {
     // Check match on IPv6
-    if (filter_contains(IPV6_REMOTE_ADDR_FLAG | IPV6_REMOTE_ADDR_LENGTH_FLAG)) {
-      bool match = true;
-      for (int i = 0; i < ipv6_remote_addr_length; i++) {
-        match &= ((ipv6_remote_addr[i] ^ ip6_pkt->daddr.in6_u.u6_addr8[i]) & ipv6_remote_addr_mask[i]) == 0;
-        if (!match) {
-          return false;
-        }
-      }
-      return true;
-    }
-  } else {
-    // Error
-    return false;
-  }
-  return true;
-}
-
-bool tft_packet_filter_t::match_protocol(const srsran::unique_byte_buffer_t& pdu)
-{
-  struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
-
-  if (ip_pkt->version == 4) {
-    // Check match on IPv4 packet
-    if (ip_pkt->protocol != protocol_id) {
+    if (filter_contains(IPV6_REMOTE_ADDR_FLAG | IPV6_REMOTE_ADDR_LENGTH_FLAG) &&
+        !match_ipv6_addr(hdr.ipv6_daddr, ipv6_remote_addr, ipv6_remote_addr_mask)) {
       return false;
     }
-  } else if (ip_pkt->version == 6) {
-    // Check match on IPv6 packet
-    if (ip6_pkt->nexthdr != protocol_id) {
+    if (filter_contains(IPV6_LOCAL_ADDR_LENGTH_FLAG) &&
+        !match_ipv6_addr(hdr.ipv6_saddr, ipv6_local_addr, ipv6_local_addr_mask)) {
       return false;
     }
   } else {
@@ -285,103 +326,59 @@ bool tft_packet_filter_t::match_protocol(const srsran::unique_byte_buffer_t& pdu
   return true;
 }
 
-bool tft_packet_filter_t::match_type_of_service(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_protocol(const tft_ip_header_t& hdr) const
 {
-  struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
+  // Protocol on IPv4, Next Header on IPv6
+  return (hdr.version == 4 || hdr.version == 6) && hdr.protocol == protocol_id;
+}
 
-  if (ip_pkt->version == 4) {
+bool tft_packet_filter_t::match_type_of_service(const tft_ip_header_t& hdr) const
+{
+  if (hdr.version == 4) {
     // Check match on IPv4 packet
-    if ((ip_pkt->tos ^ type_of_service) & type_of_service_mask) {
+    if ((hdr.tos ^ type_of_service) & type_of_service_mask) {
       return false;
     }
-  } else if (ip_pkt->version == 6) {
+  } else if (hdr.version == 6) {
     // IPv6 traffic class not supported yet
     return false;
   }
   return true;
 }
 
-bool tft_packet_filter_t::match_flow_label(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_flow_label(const tft_ip_header_t& hdr) const
 {
-  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
-
-  if (ip6_pkt->version == 6 && (active_filters & FLOW_LABEL_FLAG)) {
-    // Check match on IPv4 packet
-    if (memcmp(ip6_pkt->flow_lbl, flow_label, 3) != 0) {
+  if (hdr.version == 6 && (active_filters & FLOW_LABEL_FLAG)) {
+    // Check match on IPv6 packet
+    if (memcmp(hdr.flow_label, flow_label, 3) != 0) {
       return false;
     }
   }
   return true;
 }
 
-bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_port(const tft_ip_header_t& hdr) const
 {
-  struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
-  struct udphdr*  udp_pkt;
-  struct tcphdr*  tcp_pkt;
-
-  if (ip_pkt->version == 4) {
-    switch (ip_pkt->protocol) {
-      case UDP_PROTOCOL:
-        udp_pkt = (struct udphdr*)&pdu->msg[ip_pkt->ihl * 4];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (udp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (udp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      case TCP_PROTOCOL:
-        tcp_pkt = (struct tcphdr*)&pdu->msg[ip_pkt->ihl * 4];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (tcp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (tcp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      default:
-        return false;
+  // Only UDP and TCP carry ports
+  if (not hdr.has_ports) {
+    return false;
+  }
+  if (filter_contains(SINGLE_LOCAL_PORT_FLAG) && hdr.src_port != single_local_port) {
+    return false;
+  }
+  if (filter_contains(SINGLE_REMOTE_PORT_FLAG) && hdr.dst_port != single_remote_port) {
+    return false;
+  }
+  if (filter_contains(LOCAL_PORT_RANGE_FLAG)) {
+    uint16_t port = ntohs(hdr.src_port);
+    if (port < local_port_range[0] || port > local_port_range[1]) {
+      return false;
     }
-  } else if (ip_pkt->version == 6) {
-    switch (ip6_pkt->nexthdr) {
-      case UDP_PROTOCOL:
-        udp_pkt = (struct udphdr*)&pdu->msg[sizeof(ipv6hdr)];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (udp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (udp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      case TCP_PROTOCOL:
-        tcp_pkt = (struct tcphdr*)&pdu->msg[sizeof(ipv6hdr)];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (tcp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (tcp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      default:
-        return false;
+  }
+  if (filter_contains(REMOTE_PORT_RANGE_FLAG)) {
+    uint16_t port = ntohs(hdr.dst_port);
+    if (port < remote_port_range[0] || port > remote_port_range[1]) {
+      return false;
     }
   }
   return true;
@@ -389,7 +386,9 @@ bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu)
 
 void tft_pdu_matcher::reset()
 {
+  std::lock_guard<std::mutex> lock(tft_mutex);
   tft_filter_map.clear();
+  has_filters = false;
 }
 
 /**
@@ -401,9 +400,20 @@ void tft_pdu_matcher::reset()
  */
 int tft_pdu_matcher::check_tft_filter_match(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id)
 {
+  // Without TFTs every packet goes to the default bearer, so don't take the lock
+  if (not has_filters.load(std::memory_order_relaxed)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Parse the packet header once and match it against all filters in precedence order
+  tft_ip_header_t hdr;
+  if (not hdr.parse(*pdu)) {
+    return SRSRAN_ERROR;
+  }
+
   std::lock_guard<std::mutex> lock(tft_mutex);
   for (std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : tft_filter_map) {
-    bool match = filter_pair.second.match(pdu);
+    bool match = filter_pair.second.match(hdr);
     if (match) {
       eps_bearer_id = filter_pair.second.eps_bearer_id;
       logger.debug("Found filter match -- EPS bearer Id %d", filter_pair.second.eps_bearer_id);
@@ -428,6 +438,7 @@ void tft_pdu_matcher::delete_tft_for_eps_bearer(const uint8_t eps_bearer_id)
   if (old_filter != tft_filter_map.end()) {
     logger.debug("Deleting TFT for EPS bearer %d", eps_bearer_id);
     tft_filter_map.erase(old_filter);
+    has_filters = not tft_filter_map.empty();
   }
 }
 
@@ -443,6 +454,7 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
                     tft->packet_filter_list[i].eval_precedence);
         tft_packet_filter_t filter(eps_bearer_id, tft->packet_filter_list[i], logger);
         auto                it = tft_filter_map.insert(std::make_pair(filter.eval_precedence, filter));
+        has_filters            = not tft_filter_map.empty();
         if (it.second == false) {
           logger.error("Error inserting TFT Packet Filter");
           return SRSRAN_ERROR_CANT_START;
@@ -463,10 +475,12 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
 
         // release old filter
         tft_filter_map.erase(old_filter);
+        has_filters = not tft_filter_map.empty();
 
         // Add new filter
         tft_packet_filter_t new_filter(eps_bearer_id, tft->packet_filter_list[i], logger);
         auto                it = tft_filter_map.insert(std::make_pair(new_filter.eval_precedence, new_filter));
+        has_filters            = not tft_filter_map.empty();
         if (it.second == false) {
           logger.error("Error inserting TFT Packet Filter");
           return SRSRAN_ERROR_CANT_START;
@@ -91,6 +91,7 @@ int ue::init(const all_args_t& args_)
   phy_args_nr.worker_cpu_mask      = args.phy.worker_cpu_mask;
   phy_args_nr.log                  = args.phy.log;
   phy_args_nr.store_pdsch_ko       = args.phy.nr_store_pdsch_ko;
+  phy_args_nr.cs_max_ssb_freqs     = args.phy.nr_cs_max_ssb_freqs;
   phy_args_nr.srate_hz             = args.rf.srate_hz;
 
   // init layers
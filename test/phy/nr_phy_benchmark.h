@@ -0,0 +1,641 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_NR_PHY_BENCHMARK_H
+#define SRSRAN_NR_PHY_BENCHMARK_H
+
+#include "srsran/build_info.h"
+#include "srsran/common/standard_streams.h"
+#include "srsran/common/string_helpers.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/srslog/bundled/fmt/chrono.h"
+#include "srsran/srslog/srslog.h"
+#include "srsran/srsran.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace nr_phy_bench {
+
+/// Stage processing time metrics, in microseconds.
+DECLARE_METRIC("node", metric_node, std::string, "");
+DECLARE_METRIC("stage", metric_stage, std::string, "");
+DECLARE_METRIC("avg_us", metric_avg_us, double, "us");
+DECLARE_METRIC("p50_us", metric_p50_us, double, "us");
+DECLARE_METRIC("p90_us", metric_p90_us, double, "us");
+DECLARE_METRIC("p99_us", metric_p99_us, double, "us");
+DECLARE_METRIC("max_us", metric_max_us, double, "us");
+DECLARE_METRIC_SET("stage_container",
+                   mset_stage,
+                   metric_node,
+                   metric_stage,
+                   metric_avg_us,
+                   metric_p50_us,
+                   metric_p90_us,
+                   metric_p99_us,
+                   metric_max_us);
+
+/// Sweep point metrics.
+DECLARE_METRIC("nof_prb", metric_nof_prb, uint32_t, "");
+DECLARE_METRIC("alloc_prb", metric_alloc_prb, uint32_t, "");
+DECLARE_METRIC("mcs", metric_mcs, uint32_t, "");
+DECLARE_METRIC("layers", metric_layers, uint32_t, "");
+DECLARE_METRIC("dl_tbs", metric_dl_tbs, uint32_t, "bits");
+DECLARE_METRIC("ul_tbs", metric_ul_tbs, uint32_t, "bits");
+DECLARE_METRIC("dl_crc_ok", metric_dl_crc_ok, double, "");
+DECLARE_METRIC("ul_crc_ok", metric_ul_crc_ok, double, "");
+DECLARE_METRIC("gnb_slots_per_sec", metric_gnb_slots_per_sec, double, "");
+DECLARE_METRIC("ue_slots_per_sec", metric_ue_slots_per_sec, double, "");
+DECLARE_METRIC("chain_slots_per_sec", metric_chain_slots_per_sec, double, "");
+DECLARE_METRIC_LIST("stage_list", mlist_stages, std::vector<mset_stage>);
+DECLARE_METRIC_SET("point_container",
+                   mset_point,
+                   metric_nof_prb,
+                   metric_alloc_prb,
+                   metric_mcs,
+                   metric_layers,
+                   metric_dl_tbs,
+                   metric_ul_tbs,
+                   metric_dl_crc_ok,
+                   metric_ul_crc_ok,
+                   metric_gnb_slots_per_sec,
+                   metric_ue_slots_per_sec,
+                   metric_chain_slots_per_sec,
+                   mlist_stages);
+
+/// Report root object.
+DECLARE_METRIC("timestamp", metric_timestamp, std::string, "");
+DECLARE_METRIC("build_info", metric_build_info, std::string, "");
+DECLARE_METRIC("build_mode", metric_build_mode, std::string, "");
+DECLARE_METRIC("simd_f_size", metric_simd_f_size, uint32_t, "");
+DECLARE_METRIC("repetitions", metric_repetitions, uint32_t, "");
+DECLARE_METRIC_LIST("point_list", mlist_points, std::vector<mset_point>);
+
+/// Report context.
+using report_context_t = srslog::build_context_type<metric_timestamp,
+                                                    metric_build_info,
+                                                    metric_build_mode,
+                                                    metric_simd_f_size,
+                                                    metric_repetitions,
+                                                    mlist_points>;
+
+} // namespace nr_phy_bench
+
+/**
+ * Single thread NR PHY benchmark. For every point of a bandwidth, PRB allocation, MCS and number of layers sweep, it
+ * runs the PDSCH and PUSCH transmit and receive chains slot by slot and collects the processing time of every stage.
+ * Every slot carries a PDSCH and a PUSCH transmission. The gNb and UE slot rates are measured over the complete work of
+ * each node in every slot, and the chain slot rate over the whole sequence of slots running both nodes.
+ */
+class nr_phy_benchmark
+{
+public:
+  struct args_t {
+    bool        enable        = false;                        ///< Run the benchmark instead of the test bench
+    std::string json_filename = "/tmp/nr_phy_benchmark.json"; ///< JSON report file name
+    std::string nof_prb       = "25,52,106";                  ///< Carrier bandwidths in PRB
+    std::string alloc         = "0";                          ///< Allocation lengths in PRB, 0 for the full carrier
+    std::string mcs           = "0,10,20,27";                 ///< MCS indexes
+    std::string layers        = "1";                          ///< Number of layers
+    uint32_t    repetitions   = 100;                          ///< Number of slots per sweep point
+  };
+
+private:
+  enum stage_idx_t {
+    GNB_PDSCH_ENCODE = 0,
+    GNB_OFDM_TX,
+    GNB_OFDM_RX,
+    GNB_CHEST,
+    GNB_EQUALISATION,
+    GNB_DEMODULATION,
+    GNB_LDPC_DECODE,
+    UE_OFDM_RX,
+    UE_CHEST,
+    UE_EQUALISATION,
+    UE_DEMODULATION,
+    UE_LDPC_DECODE,
+    UE_PUSCH_ENCODE,
+    UE_OFDM_TX,
+    NOF_STAGES
+  };
+
+  struct stage_t {
+    const char*         node;
+    const char*         name;
+    std::vector<double> samples_us;
+  };
+
+  struct point_t {
+    srsran_carrier_nr_t carrier;
+    uint32_t            alloc;
+    uint32_t            mcs;
+  };
+
+  using clock_t = std::chrono::steady_clock;
+
+  args_t                              args;
+  srsran_carrier_nr_t                 base_carrier  = {};
+  srslog::log_channel&                json_channel;
+  srsran_random_t                     random_gen    = nullptr;
+  std::array<stage_t, NOF_STAGES>     stages        = {};
+  srsran_ofdm_t                       ofdm_tx       = {};
+  srsran_ofdm_t                       ofdm_rx       = {};
+  srsran_dmrs_sch_t                   dmrs_tx       = {};
+  srsran_dmrs_sch_t                   dmrs_rx       = {};
+  srsran_pdsch_nr_t                   pdsch_tx      = {};
+  srsran_pdsch_nr_t                   pdsch_rx      = {};
+  srsran_pusch_nr_t                   pusch_tx      = {};
+  srsran_pusch_nr_t                   pusch_rx      = {};
+  srsran_chest_dl_res_t               chest         = {};
+  srsran_softbuffer_tx_t              softbuffer_tx = {};
+  srsran_softbuffer_rx_t              softbuffer_rx = {};
+  std::array<cf_t*, SRSRAN_MAX_PORTS> sf_symbols_tx = {};
+  std::array<cf_t*, SRSRAN_MAX_PORTS> sf_symbols_rx = {};
+  cf_t*                               baseband      = nullptr;
+  uint8_t*                            data_tx       = nullptr;
+  uint8_t*                            data_rx       = nullptr;
+  double                              gnb_busy_us   = 0.0; ///< Time the gNb spent in complete slots
+  double                              ue_busy_us    = 0.0; ///< Time the UE spent in complete slots
+
+  static double elapsed_us(const clock_t::time_point& start, const clock_t::time_point& end)
+  {
+    return std::chrono::duration<double, std::micro>(end - start).count();
+  }
+
+  static double percentile(const std::vector<double>& sorted, double p)
+  {
+    if (sorted.empty()) {
+      return 0.0;
+    }
+    size_t idx = std::min(sorted.size() - 1, (size_t)(p * (double)sorted.size()));
+    return sorted[idx];
+  }
+
+  void free_chain()
+  {
+    srsran_ofdm_tx_free(&ofdm_tx);
+    srsran_ofdm_rx_free(&ofdm_rx);
+    srsran_dmrs_sch_free(&dmrs_tx);
+    srsran_dmrs_sch_free(&dmrs_rx);
+    srsran_pdsch_nr_free(&pdsch_tx);
+    srsran_pdsch_nr_free(&pdsch_rx);
+    srsran_pusch_nr_free(&pusch_tx);
+    srsran_pusch_nr_free(&pusch_rx);
+    srsran_chest_dl_res_free(&chest);
+    for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+      if (sf_symbols_tx[i] != nullptr) {
+        free(sf_symbols_tx[i]);
+        sf_symbols_tx[i] = nullptr;
+      }
+      if (sf_symbols_rx[i] != nullptr) {
+        free(sf_symbols_rx[i]);
+        sf_symbols_rx[i] = nullptr;
+      }
+    }
+    if (baseband != nullptr) {
+      free(baseband);
+      baseband = nullptr;
+    }
+    ofdm_tx  = {};
+    ofdm_rx  = {};
+    dmrs_tx  = {};
+    dmrs_rx  = {};
+    pdsch_tx = {};
+    pdsch_rx = {};
+    pusch_tx = {};
+    pusch_rx = {};
+    chest    = {};
+  }
+
+  /// Initialises every transmit and receive object for a given carrier
+  bool init_chain(const srsran_carrier_nr_t& carrier)
+  {
+    free_chain();
+
+    uint32_t slot_len_re = SRSRAN_SLOT_LEN_RE_NR(carrier.nof_prb);
+    baseband             = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB_NR(carrier.nof_prb));
+    if (baseband == nullptr) {
+      return false;
+    }
+    for (uint32_t i = 0; i < carrier.max_mimo_layers; i++) {
+      sf_symbols_tx[i] = srsran_vec_cf_malloc(slot_len_re);
+      sf_symbols_rx[i] = srsran_vec_cf_malloc(slot_len_re);
+      if (sf_symbols_tx[i] == nullptr or sf_symbols_rx[i] == nullptr) {
+        return false;
+      }
+      srsran_vec_cf_zero(sf_symbols_rx[i], slot_len_re);
+    }
+
+    // The same OFDM modulator and demodulator are used for both directions
+    srsran_ofdm_cfg_t ofdm_cfg = {};
+    ofdm_cfg.nof_prb           = carrier.nof_prb;
+    ofdm_cfg.symbol_sz         = srsran_min_symbol_sz_rb(carrier.nof_prb);
+    ofdm_cfg.keep_dc           = true;
+    ofdm_cfg.in_buffer         = sf_symbols_tx[0];
+    ofdm_cfg.out_buffer        = baseband;
+    if (srsran_ofdm_tx_init_cfg(&ofdm_tx, &ofdm_cfg) < SRSRAN_SUCCESS) {
+      return false;
+    }
+    ofdm_cfg.in_buffer  = baseband;
+    ofdm_cfg.out_buffer = sf_symbols_rx[0];
+    if (srsran_ofdm_rx_init_cfg(&ofdm_rx, &ofdm_cfg) < SRSRAN_SUCCESS) {
+      return false;
+    }
+
+    if (srsran_dmrs_sch_init(&dmrs_tx, false) < SRSRAN_SUCCESS or
+        srsran_dmrs_sch_init(&dmrs_rx, true) < SRSRAN_SUCCESS or
+        srsran_dmrs_sch_set_carrier(&dmrs_tx, &carrier) < SRSRAN_SUCCESS or
+        srsran_dmrs_sch_set_carrier(&dmrs_rx, &carrier) < SRSRAN_SUCCESS) {
+      return false;
+    }
+
+    if (srsran_chest_dl_res_init(&chest, carrier.nof_prb) < SRSRAN_SUCCESS) {
+      return false;
+    }
+
+    // Receivers measure the time of every decoding stage
+    srsran_pdsch_nr_args_t pdsch_args = {};
+    pdsch_args.measure_time           = true;
+    if (srsran_pdsch_nr_init_enb(&pdsch_tx, &pdsch_args) < SRSRAN_SUCCESS or
+        srsran_pdsch_nr_init_ue(&pdsch_rx, &pdsch_args) < SRSRAN_SUCCESS or
+        srsran_pdsch_nr_set_carrier(&pdsch_tx, &carrier) < SRSRAN_SUCCESS or
+        srsran_pdsch_nr_set_carrier(&pdsch_rx, &carrier) < SRSRAN_SUCCESS) {
+      return false;
+    }
+
+    srsran_pusch_nr_args_t pusch_args = {};
+    pusch_args.measure_time           = true;
+    if (srsran_pusch_nr_init_ue(&pusch_tx, &pusch_args) < SRSRAN_SUCCESS or
+        srsran_pusch_nr_init_gnb(&pusch_rx, &pusch_args) < SRSRAN_SUCCESS or
+        srsran_pusch_nr_set_carrier(&pusch_tx, &carrier) < SRSRAN_SUCCESS or
+        srsran_pusch_nr_set_carrier(&pusch_rx, &carrier) < SRSRAN_SUCCESS) {
+      return false;
+    }
+
+    return true;
+  }
+
+  /// Fills the grant of a full slot shared channel transmission, returns false if the MCS is not valid
+  bool fill_grant(const point_t& p, bool is_dl, srsran_sch_cfg_nr_t& cfg)
+  {
+    cfg                   = {};
+    cfg.sch_cfg.mcs_table = srsran_mcs_table_64qam;
+
+    int ret = is_dl ? srsran_ra_dl_nr_time_default_A(0, cfg.dmrs.typeA_pos, &cfg.grant)
+                    : srsran_ra_ul_nr_pusch_time_resource_default_A(p.carrier.scs, 0, &cfg.grant);
+    if (ret < SRSRAN_SUCCESS) {
+      return false;
+    }
+
+    cfg.grant.nof_dmrs_cdm_groups_without_data = 1;
+    cfg.grant.nof_layers                       = p.carrier.max_mimo_layers;
+    cfg.grant.dci_format                       = is_dl ? srsran_dci_format_nr_1_0 : srsran_dci_format_nr_0_0;
+    cfg.grant.rnti                             = 0x4601;
+    cfg.grant.nof_prb                          = p.alloc;
+    for (uint32_t n = 0; n < SRSRAN_MAX_PRB_NR; n++) {
+      cfg.grant.prb_idx[n] = (n < p.alloc);
+    }
+
+    return srsran_ra_nr_fill_tb(&cfg, &cfg.grant, p.mcs, &cfg.grant.tb[0]) == SRSRAN_SUCCESS;
+  }
+
+  void record(stage_idx_t idx, double value_us) { stages[idx].samples_us.push_back(value_us); }
+
+  /// Runs a downlink slot, from PDSCH encoding at the gNb to decoding at the UE. Returns true if the CRC matched
+  bool run_dl(const srsran_slot_cfg_t& slot, srsran_sch_cfg_nr_t& cfg)
+  {
+    uint8_t*              data[SRSRAN_MAX_TB] = {data_tx};
+    srsran_pdsch_res_nr_t res                 = {};
+    res.tb[0].payload                         = data_rx;
+
+    clock_t::time_point t0 = clock_t::now();
+    srsran_vec_cf_zero(sf_symbols_tx[0], SRSRAN_SLOT_LEN_RE_NR(pdsch_tx.carrier.nof_prb));
+    cfg.grant.tb[0].softbuffer.tx = &softbuffer_tx;
+    if (srsran_pdsch_nr_encode(&pdsch_tx, &cfg, &cfg.grant, data, sf_symbols_tx.data()) < SRSRAN_SUCCESS or
+        srsran_dmrs_sch_put_sf(&dmrs_tx, &slot, &cfg, &cfg.grant, sf_symbols_tx[0]) < SRSRAN_SUCCESS) {
+      return false;
+    }
+    clock_t::time_point t1 = clock_t::now();
+    srsran_ofdm_tx_sf(&ofdm_tx);
+    clock_t::time_point t2 = clock_t::now();
+    srsran_ofdm_rx_sf(&ofdm_rx);
+    clock_t::time_point t3 = clock_t::now();
+    if (srsran_dmrs_sch_estimate(&dmrs_rx, &slot, &cfg, &cfg.grant, sf_symbols_rx[0], &chest) < SRSRAN_SUCCESS) {
+      return false;
+    }
+    clock_t::time_point t4 = clock_t::now();
+
+    cfg.grant.tb[0].softbuffer.rx = &softbuffer_rx;
+    srsran_softbuffer_rx_reset(&softbuffer_rx);
+    if (srsran_pdsch_nr_decode(&pdsch_rx, &cfg, &cfg.grant, &chest, sf_symbols_rx.data(), &res) < SRSRAN_SUCCESS) {
+      return false;
+    }
+    clock_t::time_point t5 = clock_t::now();
+    gnb_busy_us += elapsed_us(t0, t2);
+    ue_busy_us += elapsed_us(t2, t5);
+
+    record(GNB_PDSCH_ENCODE, elapsed_us(t0, t1));
+    record(GNB_OFDM_TX, elapsed_us(t1, t2));
+    record(UE_OFDM_RX, elapsed_us(t2, t3));
+    record(UE_CHEST, elapsed_us(t3, t4));
+    record(UE_EQUALISATION, pdsch_rx.meas_time_eq_us);
+    record(UE_DEMODULATION, pdsch_rx.meas_time_demod_us);
+    record(UE_LDPC_DECODE, pdsch_rx.meas_time_sch_us);
+
+    return res.tb[0].crc;
+  }
+
+  /// Runs an uplink slot, from PUSCH encoding at the UE to decoding at the gNb. Returns true if the CRC matched
+  bool run_ul(const srsran_slot_cfg_t& slot, srsran_sch_cfg_nr_t& cfg)
+  {
+    srsran_pusch_data_nr_t data = {};
+    srsran_pusch_res_nr_t  res  = {};
+    data.payload[0]             = data_tx;
+    res.tb[0].payload           = data_rx;
+
+    clock_t::time_point t0 = clock_t::now();
+    srsran_vec_cf_zero(sf_symbols_tx[0], SRSRAN_SLOT_LEN_RE_NR(pusch_tx.carrier.nof_prb));
+    cfg.grant.tb[0].softbuffer.tx = &softbuffer_tx;
+    if (srsran_pusch_nr_encode(&pusch_tx, &cfg, &cfg.grant, &data, sf_symbols_tx.data()) < SRSRAN_SUCCESS or
+        srsran_dmrs_sch_put_sf(&dmrs_tx, &slot, &cfg, &cfg.grant, sf_symbols_tx[0]) < SRSRAN_SUCCESS) {
+      return false;
+    }
+    clock_t::time_point t1 = clock_t::now();
+    srsran_ofdm_tx_sf(&ofdm_tx);
+    clock_t::time_point t2 = clock_t::now();
+    srsran_ofdm_rx_sf(&ofdm_rx);
+    clock_t::time_point t3 = clock_t::now();
+    if (srsran_dmrs_sch_estimate(&dmrs_rx, &slot, &cfg, &cfg.grant, sf_symbols_rx[0], &chest) < SRSRAN_SUCCESS) {
+      return false;
+    }
+    clock_t::time_point t4 = clock_t::now();
+
+    cfg.grant.tb[0].softbuffer.rx = &softbuffer_rx;
+    srsran_softbuffer_rx_reset(&softbuffer_rx);
+    if (srsran_pusch_nr_decode(&pusch_rx, &cfg, &cfg.grant, &chest, sf_symbols_rx.data(), &res) < SRSRAN_SUCCESS) {
+      return false;
+    }
+    clock_t::time_point t5 = clock_t::now();
+    ue_busy_us += elapsed_us(t0, t2);
+    gnb_busy_us += elapsed_us(t2, t5);
+
+    record(UE_PUSCH_ENCODE, elapsed_us(t0, t1));
+    record(UE_OFDM_TX, elapsed_us(t1, t2));
+    record(GNB_OFDM_RX, elapsed_us(t2, t3));
+    record(GNB_CHEST, elapsed_us(t3, t4));
+    record(GNB_EQUALISATION, pusch_rx.meas_time_eq_us);
+    record(GNB_DEMODULATION, pusch_rx.meas_time_demod_us);
+    record(GNB_LDPC_DECODE, pusch_rx.meas_time_sch_us);
+
+    return res.tb[0].crc;
+  }
+
+  /// Runs all the repetitions of a sweep point and appends its results to the report
+  bool run_point(const point_t& p, nr_phy_bench::mset_point& report)
+  {
+    srsran_sch_cfg_nr_t pdsch_cfg = {};
+    srsran_sch_cfg_nr_t pusch_cfg = {};
+    if (not fill_grant(p, true, pdsch_cfg) or not fill_grant(p, false, pusch_cfg)) {
+      srsran::console("Skipping invalid point nof_prb=%d; alloc=%d; mcs=%d;\n", p.carrier.nof_prb, p.alloc, p.mcs);
+      return true;
+    }
+
+    // Random payload, the same for both directions
+    uint32_t nof_bytes = SRSRAN_CEIL(SRSRAN_MAX(pdsch_cfg.grant.tb[0].tbs, pusch_cfg.grant.tb[0].tbs), 8);
+    for (uint32_t i = 0; i < nof_bytes; i++) {
+      data_tx[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, UINT8_MAX);
+    }
+
+    for (stage_t& s : stages) {
+      s.samples_us.clear();
+      s.samples_us.reserve(args.repetitions);
+    }
+
+    uint32_t dl_crc_ok = 0;
+    uint32_t ul_crc_ok = 0;
+    gnb_busy_us        = 0.0;
+    ue_busy_us         = 0.0;
+
+    clock_t::time_point start = clock_t::now();
+    for (uint32_t r = 0; r < args.repetitions; r++) {
+      srsran_slot_cfg_t slot = {};
+      slot.idx               = r % SRSRAN_NSLOTS_PER_FRAME_NR(p.carrier.scs);
+      dl_crc_ok += run_dl(slot, pdsch_cfg) ? 1 : 0;
+      ul_crc_ok += run_ul(slot, pusch_cfg) ? 1 : 0;
+    }
+    double chain_us = elapsed_us(start, clock_t::now());
+
+    // Summarise every stage
+    auto& stage_list = report.get<nr_phy_bench::mlist_stages>();
+    srsran::console("nof_prb=%d; alloc=%d; mcs=%d; layers=%d; dl_tbs=%d; ul_tbs=%d;\n",
+                    p.carrier.nof_prb,
+                    p.alloc,
+                    p.mcs,
+                    p.carrier.max_mimo_layers,
+                    pdsch_cfg.grant.tb[0].tbs,
+                    pusch_cfg.grant.tb[0].tbs);
+    srsran::console("   +------+--------------+----------+----------+----------+----------+----------+\n");
+    srsran::console(
+        "   | %4s | %12s | %8s | %8s | %8s | %8s | %8s |\n", "Node", "Stage", "Avg", "P50", "P90", "P99", "Max");
+    srsran::console("   +------+--------------+----------+----------+----------+----------+----------+\n");
+    for (stage_t& s : stages) {
+      std::vector<double> sorted = s.samples_us;
+      std::sort(sorted.begin(), sorted.end());
+      double avg = 0.0;
+      for (double v : sorted) {
+        avg += v;
+      }
+      avg = sorted.empty() ? 0.0 : avg / (double)sorted.size();
+
+      stage_list.emplace_back();
+      auto& stage = stage_list.back();
+      stage.write<nr_phy_bench::metric_node>(s.node);
+      stage.write<nr_phy_bench::metric_stage>(s.name);
+      stage.write<nr_phy_bench::metric_avg_us>(avg);
+      stage.write<nr_phy_bench::metric_p50_us>(percentile(sorted, 0.50));
+      stage.write<nr_phy_bench::metric_p90_us>(percentile(sorted, 0.90));
+      stage.write<nr_phy_bench::metric_p99_us>(percentile(sorted, 0.99));
+      stage.write<nr_phy_bench::metric_max_us>(sorted.empty() ? 0.0 : sorted.back());
+
+      srsran::console("   | %4s | %12s | %8.1f | %8.1f | %8.1f | %8.1f | %8.1f |\n",
+                      s.node,
+                      s.name,
+                      avg,
+                      percentile(sorted, 0.50),
+                      percentile(sorted, 0.90),
+                      percentile(sorted, 0.99),
+                      sorted.empty() ? 0.0 : sorted.back());
+    }
+    srsran::console("   +------+--------------+----------+----------+----------+----------+----------+\n");
+
+    double gnb_slots_per_sec   = std::isnormal(gnb_busy_us) ? 1e6 * args.repetitions / gnb_busy_us : 0.0;
+    double ue_slots_per_sec    = std::isnormal(ue_busy_us) ? 1e6 * args.repetitions / ue_busy_us : 0.0;
+    double chain_slots_per_sec = std::isnormal(chain_us) ? 1e6 * args.repetitions / chain_us : 0.0;
+    double dl_crc_rate         = (double)dl_crc_ok / (double)args.repetitions;
+    double ul_crc_rate         = (double)ul_crc_ok / (double)args.repetitions;
+    srsran::console("   gNb: %.1f slot/s; UE: %.1f slot/s; Chain: %.1f slot/s; DL CRC: %.3f; UL CRC: %.3f;\n\n",
+                    gnb_slots_per_sec,
+                    ue_slots_per_sec,
+                    chain_slots_per_sec,
+                    dl_crc_rate,
+                    ul_crc_rate);
+
+    report.write<nr_phy_bench::metric_nof_prb>(p.carrier.nof_prb);
+    report.write<nr_phy_bench::metric_alloc_prb>(p.alloc);
+    report.write<nr_phy_bench::metric_mcs>(p.mcs);
+    report.write<nr_phy_bench::metric_layers>(p.carrier.max_mimo_layers);
+    report.write<nr_phy_bench::metric_dl_tbs>(pdsch_cfg.grant.tb[0].tbs);
+    report.write<nr_phy_bench::metric_ul_tbs>(pusch_cfg.grant.tb[0].tbs);
+    report.write<nr_phy_bench::metric_dl_crc_ok>(dl_crc_rate);
+    report.write<nr_phy_bench::metric_ul_crc_ok>(ul_crc_rate);
+    report.write<nr_phy_bench::metric_gnb_slots_per_sec>(gnb_slots_per_sec);
+    report.write<nr_phy_bench::metric_ue_slots_per_sec>(ue_slots_per_sec);
+    report.write<nr_phy_bench::metric_chain_slots_per_sec>(chain_slots_per_sec);
+
+    // Without channel impairments, every transport block shall be decoded
+    return dl_crc_ok == args.repetitions and ul_crc_ok == args.repetitions;
+  }
+
+public:
+  nr_phy_benchmark(const args_t& args_, const srsran_carrier_nr_t& carrier_) :
+    args(args_),
+    base_carrier(carrier_),
+    json_channel(srslog::fetch_log_channel(
+        "NR_PHY_BENCH",
+        srslog::fetch_file_sink(args_.json_filename, 0, false, srslog::create_json_formatter()),
+        {}))
+  {
+    stages[GNB_PDSCH_ENCODE] = {"gnb", "pdsch_encode", {}};
+    stages[GNB_OFDM_TX]      = {"gnb", "ofdm_tx", {}};
+    stages[GNB_OFDM_RX]      = {"gnb", "ofdm_rx", {}};
+    stages[GNB_CHEST]        = {"gnb", "chest", {}};
+    stages[GNB_EQUALISATION] = {"gnb", "equalisation", {}};
+    stages[GNB_DEMODULATION] = {"gnb", "demodulation", {}};
+    stages[GNB_LDPC_DECODE]  = {"gnb", "ldpc_decode", {}};
+    stages[UE_OFDM_RX]       = {"ue", "ofdm_rx", {}};
+    stages[UE_CHEST]         = {"ue", "chest", {}};
+    stages[UE_EQUALISATION]  = {"ue", "equalisation", {}};
+    stages[UE_DEMODULATION]  = {"ue", "demodulation", {}};
+    stages[UE_LDPC_DECODE]   = {"ue", "ldpc_decode", {}};
+    stages[UE_PUSCH_ENCODE]  = {"ue", "pusch_encode", {}};
+    stages[UE_OFDM_TX]       = {"ue", "ofdm_tx", {}};
+  }
+
+  ~nr_phy_benchmark()
+  {
+    free_chain();
+    srsran_softbuffer_tx_free(&softbuffer_tx);
+    srsran_softbuffer_rx_free(&softbuffer_rx);
+    if (data_tx != nullptr) {
+      free(data_tx);
+    }
+    if (data_rx != nullptr) {
+      free(data_rx);
+    }
+    if (random_gen != nullptr) {
+      srsran_random_free(random_gen);
+    }
+  }
+
+  /// Runs every point of the sweep and writes the JSON report, returns false if any of the points fails
+  bool run()
+  {
+    std::vector<uint32_t> nof_prb_list;
+    std::vector<uint32_t> alloc_list;
+    std::vector<uint32_t> mcs_list;
+    std::vector<uint32_t> layers_list;
+    srsran::string_parse_list(args.nof_prb, ',', nof_prb_list);
+    srsran::string_parse_list(args.alloc, ',', alloc_list);
+    srsran::string_parse_list(args.mcs, ',', mcs_list);
+    srsran::string_parse_list(args.layers, ',', layers_list);
+    if (nof_prb_list.empty()) {
+      nof_prb_list.push_back(base_carrier.nof_prb);
+    }
+
+    random_gen = srsran_random_init(0x1234);
+    data_tx    = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
+    data_rx    = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
+    if (data_tx == nullptr or data_rx == nullptr or
+        srsran_softbuffer_tx_init_guru(&softbuffer_tx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
+            SRSRAN_SUCCESS or
+        srsran_softbuffer_rx_init_guru(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
+            SRSRAN_SUCCESS) {
+      srsran::console("Error allocating benchmark buffers\n");
+      return false;
+    }
+
+    nr_phy_bench::report_context_t ctx("JSON Report");
+    auto current_time = fmt::localtime(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+    fmt::memory_buffer ts_buffer;
+    fmt::format_to(ts_buffer, "{:%F}T{:%T}", current_time, current_time);
+    ctx.write<nr_phy_bench::metric_timestamp>(srsran::to_c_str(ts_buffer));
+    ctx.write<nr_phy_bench::metric_build_info>(srsran_get_build_info());
+    ctx.write<nr_phy_bench::metric_build_mode>(srsran_get_build_mode());
+    ctx.write<nr_phy_bench::metric_simd_f_size>((uint32_t)SRSRAN_SIMD_F_SIZE);
+    ctx.write<nr_phy_bench::metric_repetitions>(args.repetitions);
+    auto& point_list = ctx.get<nr_phy_bench::mlist_points>();
+
+    bool ret = true;
+    for (uint32_t nof_prb : nof_prb_list) {
+      for (uint32_t layers : layers_list) {
+        point_t p                 = {};
+        p.carrier                 = base_carrier;
+        p.carrier.nof_prb         = nof_prb;
+        p.carrier.max_mimo_layers = layers;
+        if (nof_prb == 0 or nof_prb > SRSRAN_MAX_PRB_NR or layers == 0 or layers > SRSRAN_MAX_LAYERS_NR) {
+          srsran::console("Skipping invalid carrier nof_prb=%d; layers=%d;\n", nof_prb, layers);
+          continue;
+        }
+
+        if (not init_chain(p.carrier)) {
+          srsran::console("Error initialising the PHY chain for nof_prb=%d; layers=%d;\n", nof_prb, layers);
+          ret = false;
+          continue;
+        }
+
+        for (uint32_t alloc : alloc_list) {
+          p.alloc = (alloc == 0) ? nof_prb : alloc;
+          if (p.alloc > nof_prb) {
+            continue;
+          }
+
+          for (uint32_t mcs : mcs_list) {
+            p.mcs = mcs;
+            point_list.emplace_back();
+            if (not run_point(p, point_list.back())) {
+              srsran::console("Benchmark point failed nof_prb=%d; alloc=%d; mcs=%d;\n", nof_prb, p.alloc, mcs);
+              ret = false;
+            }
+          }
+        }
+      }
+    }
+
+    json_channel(ctx);
+
+    return ret;
+  }
+};
+
+#endif // SRSRAN_NR_PHY_BENCHMARK_H
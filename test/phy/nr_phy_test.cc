@@ -21,6 +21,7 @@
 
 #include "dummy_gnb_stack.h"
 #include "dummy_ue_stack.h"
+#include "nr_phy_benchmark.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/test_common.h"
 #include "test_bench.h"
@@ -39,6 +40,8 @@ static double assert_prach_ta_min        = 0.000;
 static double assert_prach_ta_max        = 0.000;
 static double assert_pucch_snr_min       = 0.000;
 
+static nr_phy_benchmark::args_t benchmark_args = {};
+
 test_bench::args_t::args_t(int argc, char** argv)
 {
   std::string              config_file;
@@ -51,6 +54,7 @@ test_bench::args_t::args_t(int argc, char** argv)
   bpo::options_description options_ue_phy("UE PHY options");
   bpo::options_description options_ue_rf("UE RF options");
   bpo::options_description options_assertion("Test assertions");
+  bpo::options_description options_benchmark("Benchmark options");
   bpo::options_description options_conf_file("Configuration file");
 
   uint16_t rnti = 17921;
@@ -123,13 +127,23 @@ test_bench::args_t::args_t(int argc, char** argv)
       ("assert.pucch.snr.min",     bpo::value<double>(&assert_pucch_snr_min)->default_value(assert_pucch_snr_min),         "PUCCH DMRS minimum SNR allowed threshold")
       ;
 
+  options_benchmark.add_options()
+      ("benchmark.enable",      bpo::value<bool>(&benchmark_args.enable)->default_value(benchmark_args.enable),                   "Run the PHY stage benchmark instead of the test bench")
+      ("benchmark.json",        bpo::value<std::string>(&benchmark_args.json_filename)->default_value(benchmark_args.json_filename), "Benchmark JSON report file name")
+      ("benchmark.nof_prb",     bpo::value<std::string>(&benchmark_args.nof_prb)->default_value(benchmark_args.nof_prb),             "Comma separated carrier bandwidths in PRB")
+      ("benchmark.alloc",       bpo::value<std::string>(&benchmark_args.alloc)->default_value(benchmark_args.alloc),                 "Comma separated allocation lengths in PRB, 0 for the full carrier")
+      ("benchmark.mcs",         bpo::value<std::string>(&benchmark_args.mcs)->default_value(benchmark_args.mcs),                     "Comma separated MCS indexes")
+      ("benchmark.layers",      bpo::value<std::string>(&benchmark_args.layers)->default_value(benchmark_args.layers),               "Comma separated number of layers")
+      ("benchmark.repetitions", bpo::value<uint32_t>(&benchmark_args.repetitions)->default_value(benchmark_args.repetitions),        "Number of slots for each benchmark point")
+      ;
+
   options_conf_file.add_options()
       ("config_file", bpo::value<std::string>(&config_file), "Configuration file")
       ;
   bpo::positional_options_description p;
   p.add("config_file", -1);
 
-  options.add(options_tb).add(options_assertion).add(options_gnb_stack).add(options_gnb_phy).add(options_ue_stack)
+  options.add(options_tb).add(options_assertion).add(options_benchmark).add(options_gnb_stack).add(options_gnb_phy).add(options_ue_stack)
       .add(options_ue_phy).add(options_ue_rf).add(options_conf_file).add_options()
         ("help",                      "Show this message")
         ;
@@ -155,6 +169,7 @@ test_bench::args_t::args_t(int argc, char** argv)
     std::cout << options_tb << std::endl << options_assertion << std::endl;
     std::cout << options_gnb_phy << std::endl << options_gnb_stack << std::endl;
     std::cout << options_ue_phy << std::endl << options_ue_stack << std::endl;
+    std::cout << options_benchmark << std::endl;
     exit(0);
   }
 
@@ -229,6 +244,14 @@ int main(int argc, char** argv)
   // Parse arguments
   TESTASSERT(args.valid);
 
+  // Run the PHY stage benchmark alone, the test bench is not required
+  if (benchmark_args.enable) {
+    nr_phy_benchmark benchmark(benchmark_args, args.phy_cfg.carrier);
+    bool             ret = benchmark.run();
+    srslog::flush();
+    return ret ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+  }
+
   // Create test bench
   test_bench tb(args);
 